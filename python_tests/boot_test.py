@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+
+NUM_SERVOS = 18
+
+# Register map
+BOOT_STATS_IDX = 30          # ready time 10 us, first accepted command ms (both since reset)
+PWM_CONFIG_IDX = 114         # PWM frequency Hz, control tick 10 us, auto phase, enabled servos
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def get_registers(ser, start, count):
+    ser.write(bytes([GET_CMD, start, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count or response[0] != GET_CMD:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def first_reply(port, timeout):
+    """Opens the port and sends GETs right away; returns the time to the first reply (s) and the reply"""
+    start = time.time()
+    ser = serial.Serial(port, BAUD_RATE, timeout=0.05)
+    while time.time() < start + timeout:
+        boot = get_registers(ser, BOOT_STATS_IDX, 2)
+        if boot is not None:
+            return ser, time.time() - start, boot
+    ser.close()
+    return None, None, None
+
+def main():
+    parser = argparse.ArgumentParser(description='Boot and reconnect time test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--reconnects', type=int, default=5, help='Number of reconnects (default: 5)')
+    parser.add_argument('--max-ready', type=float, default=100.0,
+                        help='Longest accepted time from reset to ready, ms (default: 100)')
+    parser.add_argument('--max-reply', type=float, default=100.0,
+                        help='Longest accepted time from port open to the first reply, ms (default: 100)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser, latency, boot = first_reply(args.port, 2.0)
+        if ser is None:
+            print("No reply")
+            sys.exit(1)
+        print("Connected!")
+        failed = False
+
+        ready_ms = boot[0] / 100
+        print(f"Reset to ready: {ready_ms:.2f} ms, reset to first accepted command: {boot[1]} ms")
+        print(f"Port open to first reply: {latency * 1000:.1f} ms")
+        failed |= boot[0] == 0 or ready_ms > args.max_ready
+        failed |= boot[1] < int(ready_ms)
+
+        # Servos are already enabled at a safe pose by the time the host talks to the board
+        pwm = get_registers(ser, PWM_CONFIG_IDX, 4)
+        print(f"Servos enabled: {pwm[3]}/{NUM_SERVOS}")
+        failed |= pwm[3] != NUM_SERVOS
+        ser.close()
+
+        # Reconnects don't re-run init: commands are answered at once and the boot times stay
+        worst = 0.0
+        for _ in range(args.reconnects):
+            time.sleep(0.2)
+            ser, latency, again = first_reply(args.port, 2.0)
+            if ser is None:
+                print("No reply after reconnect")
+                sys.exit(1)
+            ser.close()
+            worst = max(worst, latency)
+            failed |= again != boot
+        print(f"{args.reconnects} reconnects: worst port open to first reply {worst * 1000:.1f} ms, "
+              f"boot registers unchanged: {again == boot}")
+        failed |= worst * 1000 > args.max_reply
+
+        print("PASS" if not failed else "FAIL")
+        sys.exit(1 if failed else 0)
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
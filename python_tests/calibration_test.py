@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SET_CMD = 0x53 | 0x80        # 'S' with MSB set = 0xD3
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+ANGLE_CMD = 0x4E | 0x80      # 'N' with MSB set = 0xCE: servo angles in 0.1 degree
+CALIBRATE_CMD = 0x42 | 0x80  # 'B' with MSB set = 0xC2: min, mid, max, direction, offset + curve points
+
+NUM_SERVOS = 18
+CAL_STATS_IDX = 97           # fixed batch us, float batch us, angle frames, clamped angles
+BENCH_BATCHES = 100          # 18-servo conversions per benchmark run
+
+# Firmware defaults: -90..+90 degrees -> 500..2500 us
+DEFAULT_CAL = {'min': 500, 'mid': 1500, 'max': 2500, 'dir': 1, 'offset': 0.0, 'points': []}
+
+def encode_signed(value):
+    value = int(round(value)) & 0x3FFF
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def decode_signed(low_byte, high_byte):
+    value = decode_value(low_byte, high_byte)
+    return value - 0x4000 if value & 0x2000 else value
+
+def get_registers(ser, start, count):
+    ser.write(bytes([GET_CMD, start, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count or response[0] != GET_CMD:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def send_angles(ser, start, angles):
+    """ANGLE command: degrees, sent as signed 0.1 degree values"""
+    payload = [ANGLE_CMD, start, len(angles)]
+    for angle in angles:
+        payload += encode_signed(angle * 10)
+    ser.write(bytes(payload))
+
+def calibrate(ser, servo, cal=None):
+    """Writes a calibration entry (or only queries when cal is None) and returns the device's entry"""
+    values = []
+    if cal is not None:
+        values = [cal['min'], cal['mid'], cal['max'], cal['dir'], cal['offset'] * 10]
+        for angle, pulse in cal['points']:
+            values += [angle * 10, pulse]
+    payload = [CALIBRATE_CMD, servo, len(values)]
+    for v in values:
+        payload += encode_signed(v)
+    ser.write(bytes(payload))
+
+    header = ser.read(3)
+    if len(header) != 3 or header[0] != CALIBRATE_CMD or header[1] != servo:
+        return None
+    body = ser.read(2 * header[2])
+    if len(body) != 2 * header[2]:
+        return None
+    v = [decode_signed(body[2 * i], body[2 * i + 1]) for i in range(header[2])]
+    return {'min': v[0], 'mid': v[1], 'max': v[2], 'dir': v[3], 'offset': v[4] / 10,
+            'points': [(v[5 + 2 * i] / 10, v[6 + 2 * i]) for i in range((len(v) - 5) // 2)]}
+
+def model_pulse(cal, angle):
+    """Float model of the firmware conversion: direction and offset, curve, then pulse limits"""
+    points = cal['points'] or [(-90.0, cal['min']), (0.0, cal['mid']), (90.0, cal['max'])]
+    a = cal['dir'] * angle + cal['offset']
+    a = max(points[0][0], min(points[-1][0], a))
+    for (a0, p0), (a1, p1) in zip(points, points[1:]):
+        if a <= a1:
+            break
+    pulse = p0 + (a - a0) * (p1 - p0) / (a1 - a0)
+    return max(cal['min'], min(cal['max'], pulse))
+
+def check_sweep(ser, servo, cal, angles):
+    """Sends each angle and compares the servo position with the model; returns the largest error"""
+    worst = 0.0
+    for angle in angles:
+        send_angles(ser, servo, [angle])
+        time.sleep(0.03)
+        position = get_registers(ser, servo, 1)
+        if position is None:
+            print(f"  no reply at {angle} degrees")
+            return None
+        expected = model_pulse(cal, angle)
+        worst = max(worst, abs(position[0] - expected))
+    return worst
+
+def main():
+    parser = argparse.ArgumentParser(description='Per-servo calibration test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--servo', type=int, default=0, help='Servo for the min/mid/max test (default: 0)')
+    parser.add_argument('--curve-servo', type=int, default=1, help='Servo for the curve test (default: 1)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+        failed = False
+        sweep = [-120, -90, -45, -10.5, 0, 12.3, 45, 90, 120]
+
+        # Defaults and a plain ANGLE round trip
+        entry = calibrate(ser, args.servo)
+        print(f"Servo {args.servo} calibration: {entry}")
+        if entry != DEFAULT_CAL:
+            print("  not the default entry")
+            failed = True
+        worst = check_sweep(ser, args.servo, DEFAULT_CAL, sweep)
+        print(f"Default mapping: largest error {worst} us")
+        failed |= worst is None or worst > 1
+
+        # Narrow limits, reversed direction and an offset
+        custom = {'min': 900, 'mid': 1450, 'max': 2100, 'dir': -1, 'offset': 4.5, 'points': []}
+        entry = calibrate(ser, args.servo, custom)
+        print(f"Servo {args.servo} calibration: {entry}")
+        failed |= entry != custom
+        worst = check_sweep(ser, args.servo, custom, sweep)
+        print(f"min/mid/max, reversed, +4.5 degree offset: largest error {worst} us")
+        failed |= worst is None or worst > 1
+
+        # SET in microseconds is clamped to the servo's new limits
+        ser.write(bytes([SET_CMD, args.servo, 1] + encode_signed(2400)))
+        time.sleep(0.03)
+        position = get_registers(ser, args.servo, 1)
+        print(f"SET 2400 us with max {custom['max']}: position {position[0] if position else 'no reply'}")
+        failed |= position is None or position[0] != custom['max']
+
+        # Piecewise curve on a second servo
+        curve = {'min': 600, 'mid': 1500, 'max': 2400, 'dir': 1, 'offset': 0.0,
+                 'points': [(-80.0, 600), (-30.0, 1100), (0.0, 1480), (20.0, 1700), (75.0, 2400)]}
+        entry = calibrate(ser, args.curve_servo, curve)
+        print(f"Servo {args.curve_servo} calibration: {entry}")
+        failed |= entry != curve
+        worst = check_sweep(ser, args.curve_servo, curve, sweep + [-55, -30, 5, 20, 60])
+        print(f"Piecewise curve: largest error {worst} us")
+        failed |= worst is None or worst > 1
+
+        # Invalid entries are rejected and the device replies with the current one
+        bad = dict(curve, points=[(10.0, 1500), (-10.0, 1600)])
+        entry = calibrate(ser, args.curve_servo, bad)
+        print(f"Unordered curve rejected: {entry == curve}")
+        failed |= entry != curve
+
+        # Fixed point vs float batch conversion, rerun by writing any value. The
+        # benchmark runs in the background; its times read 0 until it finishes
+        ser.write(bytes([SET_CMD, CAL_STATS_IDX, 1, 0, 0]))
+        deadline = time.time() + 2.0
+        while True:
+            time.sleep(0.05)
+            stats = get_registers(ser, CAL_STATS_IDX, 4)
+            if stats is None:
+                print("No CAL_STATS reply")
+                sys.exit(1)
+            if (stats[0] and stats[1]) or time.time() > deadline:
+                break
+        fixed, floating, frames, clamped = stats
+        conversions = BENCH_BATCHES * NUM_SERVOS
+        speedup = f"{floating / fixed:.1f}x" if fixed else "n/a"
+        print(f"Batch conversion ({BENCH_BATCHES} x {NUM_SERVOS} servos): fixed point {fixed} us "
+              f"({fixed * 1000 / conversions:.0f} ns/servo), float {floating} us "
+              f"({floating * 1000 / conversions:.0f} ns/servo), speedup {speedup}")
+        print(f"Angle frames: {frames}, clamped angles: {clamped}")
+
+        # Restore the defaults
+        for servo in (args.servo, args.curve_servo):
+            calibrate(ser, servo, DEFAULT_CAL)
+            send_angles(ser, servo, [0])
+
+        print("PASS" if not failed else "FAIL")
+        ser.close()
+        sys.exit(1 if failed else 0)
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SET_CMD = 0x53 | 0x80        # 'S' with MSB set = 0xD3
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+
+NUM_SERVOS = 18
+
+# Register map
+GOVERNOR_IDX = 108           # budget mA, filtered current mA, peak current mA, throttled time 10 ms, throttle events, scale (Q8)
+SCALE_ONE = 256
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def set_registers(ser, start, values):
+    payload = [SET_CMD, start, len(values)]
+    for v in values:
+        payload += encode_value(v)
+    ser.write(bytes(payload))
+
+def get_registers(ser, start, count):
+    ser.write(bytes([GET_CMD, start, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count or response[0] != GET_CMD:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def read_governor(ser):
+    values = get_registers(ser, GOVERNOR_IDX, 6)
+    if values is None:
+        return None
+    keys = ('budget', 'current', 'peak', 'throttled_ms', 'events', 'scale')
+    governor = dict(zip(keys, values))
+    governor['throttled_ms'] *= 10
+    return governor
+
+def swing(ser, low, high, period, duration):
+    """Moves all servos between low and high with one SET per half period; the peak is
+    reset after the first period, the governor can only react once the current rises"""
+    start = time.time()
+    target = high
+    peak_reset = False
+    while time.time() < start + duration:
+        set_registers(ser, 0, [target] * NUM_SERVOS)
+        target = low if target == high else high
+        time.sleep(period / 2)
+        if not peak_reset and time.time() >= start + period:
+            set_registers(ser, GOVERNOR_IDX + 2, [0])
+            peak_reset = True
+    return low if target == high else high
+
+def run_swing(ser, budget, args):
+    """Runs the swing under a budget; returns the governor registers and whether every servo reached the last target"""
+    set_registers(ser, GOVERNOR_IDX, [budget])
+    time.sleep(1.0)   # Motion current of the previous run decays
+    before = read_governor(ser)
+    last = swing(ser, args.low, args.high, args.period, args.duration)
+
+    # Nothing is dropped: the outputs catch up with the last SET once the current falls
+    end = time.time() + 3
+    positions = None
+    while time.time() < end:
+        positions = get_registers(ser, 0, NUM_SERVOS)
+        if positions == [last] * NUM_SERVOS:
+            break
+        time.sleep(0.02)
+    after = read_governor(ser)
+    if before is None or after is None:
+        return None, False
+    after['events'] = (after['events'] - before['events']) & 0x3FFF
+    after['throttled_ms'] = (after['throttled_ms'] - before['throttled_ms']) % (0x4000 * 10)
+    return after, positions == [last] * NUM_SERVOS
+
+def main():
+    parser = argparse.ArgumentParser(description='Current budget motion governor test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--low', type=int, default=1350, help='Swing low pulse, us (default: 1350)')
+    parser.add_argument('--high', type=int, default=1650, help='Swing high pulse, us (default: 1650)')
+    parser.add_argument('--period', type=float, default=0.2, help='Swing period, s (default: 0.2)')
+    parser.add_argument('--duration', type=float, default=2.0, help='Swing duration, s (default: 2)')
+    parser.add_argument('--budget', type=int, default=0,
+                        help='Budget, mA (default: half of the unthrottled peak)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+        failed = False
+
+        # Governor off: the swing sets the reference peak
+        free, reached = run_swing(ser, 0, args)
+        if free is None:
+            print("No governor reply")
+            sys.exit(1)
+        print(f"Governor off: peak {free['peak']} mA, throttled {free['throttled_ms']} ms, "
+              f"{free['events']} events, all servos reached the last target: {reached}")
+        failed |= free['events'] != 0 or not reached
+
+        # Same swing under a budget
+        budget = args.budget or max(free['peak'] // 2, 100)
+        governed, reached = run_swing(ser, budget, args)
+        print(f"Budget {budget} mA: peak {governed['peak']} mA, throttled {governed['throttled_ms']} ms, "
+              f"{governed['events']} events, all servos reached the last target: {reached}")
+        failed |= governed['budget'] != budget
+        failed |= governed['peak'] >= free['peak']
+        failed |= governed['events'] == 0 or governed['throttled_ms'] == 0
+        failed |= not reached
+
+        # Idle again: full speed comes back
+        time.sleep(0.5)
+        idle = read_governor(ser)
+        print(f"Idle: current {idle['current']} mA, scale {idle['scale']}/{SCALE_ONE}")
+        failed |= idle['scale'] != SCALE_ONE
+
+        # Governor off, servos centred
+        set_registers(ser, GOVERNOR_IDX, [0])
+        set_registers(ser, 0, [1500] * NUM_SERVOS)
+
+        print("PASS" if not failed else "FAIL")
+        ser.close()
+        sys.exit(1 if failed else 0)
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
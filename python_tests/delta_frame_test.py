@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import math
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+GET_CMD = 0x47 | 0x80    # 'G' with MSB set = 0xC7
+DELTA_CMD = 0x55 | 0x80  # 'U' with MSB set = 0xD5
+
+DELTA_KEY_FLAG = 1 << 20     # Key frame: absolute values, restarts the delta chain
+DELTA_ESCAPE_LEGACY = 0x40   # Followed by a 14-bit delta (2 x 7-bit)
+
+NUM_SERVOS = 18
+DELTA_STATS_IDX = 79  # key frames, deltas applied, deltas rejected, deltas merged, synced
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def encode_mask(mask):
+    return [mask & 0x7F, (mask >> 7) & 0x7F, (mask >> 14) & 0x7F]
+
+def key_frame(pulses):
+    """Absolute frame for all servos, the device accepts deltas after this"""
+    mask = (1 << NUM_SERVOS) - 1
+    payload = [DELTA_CMD] + encode_mask(mask | DELTA_KEY_FLAG)
+    for p in pulses:
+        payload += encode_value(p)
+    return bytes(payload)
+
+def delta_frame(previous, current):
+    """Delta frame carrying only the servos that changed"""
+    mask = 0
+    body = []
+    for i, (a, b) in enumerate(zip(previous, current)):
+        delta = b - a
+        if delta == 0:
+            continue
+        mask |= 1 << i
+        if -63 <= delta <= 63:
+            body.append(delta & 0x7F)
+        else:
+            body += [DELTA_ESCAPE_LEGACY] + encode_value(delta & 0x3FFF)
+    return bytes([DELTA_CMD] + encode_mask(mask) + body)
+
+def set_frame(pulses):
+    """Equivalent legacy SET frame, for size comparison"""
+    payload = [0x53 | 0x80, 0, NUM_SERVOS]
+    for p in pulses:
+        payload += encode_value(p)
+    return bytes(payload)
+
+def get_registers(ser, start_idx, count):
+    ser.reset_input_buffer()
+    ser.write(bytes([GET_CMD, start_idx, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def gait_pose(t):
+    """Tripod-like motion: every leg moves, joints by different small amounts"""
+    pulses = []
+    for leg in range(6):
+        phase = t + (math.pi if leg % 2 else 0.0)
+        pulses.append(1500 + int(120 * math.sin(phase)))          # coxa
+        pulses.append(1500 + int(80 * max(0.0, math.cos(phase))))  # femur
+        pulses.append(1500)                                        # tibia stays
+    return pulses
+
+def main():
+    parser = argparse.ArgumentParser(description='Delta-encoded servo frame test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--frames', type=int, default=1000, help='Number of frames to stream (default: 1000)')
+    parser.add_argument('--step', type=float, default=0.05, help='Gait phase step per frame in radians (default: 0.05)')
+    parser.add_argument('--key-interval', type=int, default=100,
+                        help='Send a key frame every N frames, legacy DELTA has no loss detection (default: 100)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+
+        pose = gait_pose(0.0)
+        ser.write(key_frame(pose))
+
+        delta_bytes = set_bytes = 0
+        start = time.time()
+        for i in range(1, args.frames + 1):
+            nxt = gait_pose(i * args.step)
+            # A lost legacy delta goes unnoticed, so key frames bound the drift
+            frame = key_frame(nxt) if i % args.key_interval == 0 else delta_frame(pose, nxt)
+            ser.write(frame)
+            delta_bytes += len(frame)
+            set_bytes += len(set_frame(nxt))
+            pose = nxt
+        ser.flush()
+        elapsed = time.time() - start
+        print(f"Sent {args.frames} frames in {elapsed:.3f} s: {delta_bytes / args.frames:.1f} bytes/frame "
+              f"(SET: {set_bytes / args.frames:.1f} bytes/frame)")
+
+        # Let the board apply the queued frames before comparing
+        time.sleep(0.5)
+        device = get_registers(ser, 0, NUM_SERVOS)
+        mismatches = [i for i in range(NUM_SERVOS) if device and device[i] != pose[i]]
+        print(f"Device pose matches host model: {device is not None and not mismatches}")
+        if mismatches:
+            print(f"  mismatching servos: {mismatches}")
+
+        stats = get_registers(ser, DELTA_STATS_IDX, 5)
+        if stats:
+            print(f"Device counters: key frames={stats[0]}, deltas={stats[1]}, rejected={stats[2]}, "
+                  f"merged={stats[3]}, synced={stats[4]}")
+        ser.close()
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
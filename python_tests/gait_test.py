@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import math
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SET_CMD = 0x53 | 0x80        # 'S' with MSB set = 0xD3
+SNAPSHOT_CMD = 0x41 | 0x80   # 'A' with MSB set = 0xC1
+GAIT_CMD = 0x4D | 0x80       # 'M' with MSB set = 0xCD: pattern, vx, vy, turn, step height, period ms
+
+SNAPSHOT_HEADER_SIZE = 7     # cmd, count, 5 x 7-bit timestamp (us)
+
+NUM_SERVOS = 18
+GAIT_STATS_IDX = 92          # pattern, phase, cycles, unreachable legs, last update us
+CONTROL_TICK_US = 20000
+
+PATTERNS = {'stop': 0, 'tripod': 1, 'ripple': 2, 'wave': 3}
+SWING_FRACTION = {'tripod': 1 / 2, 'ripple': 1 / 3, 'wave': 1 / 6}
+LEG_NAMES = ['RF', 'LF', 'LM', 'LR', 'RR', 'RM']
+
+# Leg geometry, must match HexapodIK in the firmware (mm, degrees)
+COXA_LENGTH = 30.0
+FEMUR_LENGTH = 80.0
+TIBIA_LENGTH = 120.0
+MOUNTS = [
+    (60.0, -40.0, -45.0, 1),    # right front
+    (60.0, 40.0, 45.0, -1),     # left front
+    (0.0, 55.0, 90.0, -1),      # left middle
+    (-60.0, 40.0, 135.0, -1),   # left rear
+    (-60.0, -40.0, -135.0, 1),  # right rear
+    (0.0, -55.0, -90.0, 1),     # right middle
+]
+BODY_HEIGHT = 90.0           # GaitGenerator::BODY_HEIGHT
+LIFT_THRESHOLD = 3.0         # Foot counts as lifted above this height (mm)
+
+def encode_signed(value):
+    value = int(round(value)) & 0x3FFF
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def decode_u32(data):
+    return sum(data[i] << (7 * i) for i in range(5)) & 0xFFFFFFFF
+
+def send_gait(ser, pattern, vx, vy, turn, step_height, period_ms):
+    """GAIT command: speeds in mm/s, turn in deg/s, step height in mm"""
+    values = [PATTERNS[pattern], vx * 10, vy * 10, turn * 10, step_height * 10, period_ms]
+    payload = [GAIT_CMD]
+    for v in values:
+        payload += encode_signed(v)
+    ser.write(bytes(payload))
+    return len(payload)
+
+def read_snapshot(ser):
+    ser.write(bytes([SNAPSHOT_CMD]))
+    header = ser.read(SNAPSHOT_HEADER_SIZE)
+    if len(header) != SNAPSHOT_HEADER_SIZE or header[0] != SNAPSHOT_CMD:
+        return None
+    count = header[1]
+    body = ser.read(2 * count)
+    if len(body) != 2 * count:
+        return None
+    return decode_u32(header[2:7]), [decode_value(body[2 * i], body[2 * i + 1]) for i in range(count)]
+
+def pulse_to_angle(pulse):
+    return (pulse - 500) * 180.0 / 2000 - 90
+
+def foot_positions(pulses):
+    """Foot positions in the body frame (mm) from the 18 servo pulses"""
+    feet = []
+    for leg, (mx, my, myaw, sign) in enumerate(MOUNTS):
+        coxa, femur, knee = (sign * pulse_to_angle(p) for p in pulses[3 * leg:3 * leg + 3])
+        tibia = femur + knee - 180.0
+        r = COXA_LENGTH + FEMUR_LENGTH * math.cos(math.radians(femur)) + TIBIA_LENGTH * math.cos(math.radians(tibia))
+        z = FEMUR_LENGTH * math.sin(math.radians(femur)) + TIBIA_LENGTH * math.sin(math.radians(tibia))
+        heading = math.radians(myaw + coxa)
+        feet.append((mx + r * math.cos(heading), my + r * math.sin(heading), z))
+    return feet
+
+def record(ser, duration):
+    """(device time us, foot positions, gait registers) samples"""
+    samples = []
+    end = time.time() + duration
+    while time.time() < end:
+        snapshot = read_snapshot(ser)
+        if snapshot:
+            t, values = snapshot
+            samples.append((t, foot_positions(values[:NUM_SERVOS]), values[GAIT_STATS_IDX:GAIT_STATS_IDX + 5]))
+    return samples
+
+def analyse(samples, pattern, vx, period_ms):
+    lifted = [[foot[2] + BODY_HEIGHT > LIFT_THRESHOLD for foot in s[1]] for s in samples]
+    fractions = [sum(l[leg] for l in lifted) / len(lifted) for leg in range(len(MOUNTS))]
+    most = max(sum(l) for l in lifted)
+    print(f"  lifted fraction per leg ({', '.join(LEG_NAMES)}): " + ', '.join(f"{f:.2f}" for f in fractions)
+          + f" (expected about {SWING_FRACTION[pattern]:.2f})")
+    print(f"  most legs lifted at once: {most}")
+
+    # Grounded feet move backwards at the commanded speed. Time comes from the gait
+    # phase register, which is published together with the servo positions
+    distance = 0.0
+    duration = 0.0
+    for leg in range(len(MOUNTS)):
+        segment = None
+        for sample, up in zip(samples + [None], [l[leg] for l in lifted] + [True]):
+            if not up:
+                segment = segment or [sample, sample]
+                segment[1] = sample
+                continue
+            if segment and segment[1][2][1] != segment[0][2][1]:
+                distance += segment[0][1][leg][0] - segment[1][1][leg][0]
+                duration += ((segment[1][2][1] - segment[0][2][1]) & 0x3FFF) / 16384 * period_ms / 1000
+            segment = None
+    if duration > 0:
+        print(f"  grounded foot speed: {distance / duration:.1f} mm/s (commanded {vx} mm/s)")
+
+    first, last = samples[0], samples[-1]
+    elapsed = ((last[0] - first[0]) & 0xFFFFFFFF) / 1e6
+    cycles = (last[2][2] - first[2][2]) & 0x3FFF
+    print(f"  cycles: {cycles} in {elapsed:.2f} s (expected about {elapsed * 1000 / period_ms:.1f}), "
+          f"last update {last[2][4]} us, unreachable legs {last[2][3]}")
+
+def main():
+    parser = argparse.ArgumentParser(description='On-device gait generator test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--speed', type=int, default=60, help='Forward speed, mm/s (default: 60)')
+    parser.add_argument('--step', type=int, default=30, help='Step height, mm (default: 30)')
+    parser.add_argument('--period', type=int, default=1000, help='Gait cycle, ms (default: 1000)')
+    parser.add_argument('--cycles', type=float, default=2.5, help='Cycles recorded per pattern (default: 2.5)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+
+        # Only the GAIT commands move the robot; the host just watches
+        sent = 0
+        duration = args.cycles * args.period / 1000
+        for pattern in ('tripod', 'ripple', 'wave'):
+            sent += send_gait(ser, pattern, args.speed, 0, 0, args.step, args.period)
+            # The new pattern starts at the next cycle boundary
+            time.sleep(args.period / 1000)
+            print(f"{pattern}:")
+            samples = record(ser, duration)
+            if len(samples) < 2:
+                print("  no snapshots")
+                sys.exit(1)
+            analyse(samples, pattern, args.speed, args.period)
+
+        # Stop: every leg takes one more step and lands on its neutral point
+        sent += send_gait(ser, 'stop', 0, 0, 0, 0, 0)
+        stop_start = time.time()
+        stopped = None
+        while time.time() - stop_start < 3 * args.period / 1000:
+            snapshot = read_snapshot(ser)
+            if snapshot and snapshot[1][GAIT_STATS_IDX] == 0:
+                stopped = snapshot
+                break
+        if stopped is None:
+            print("Gait did not stop")
+            sys.exit(1)
+        feet = foot_positions(stopped[1][:NUM_SERVOS])
+        print(f"Stopped after {time.time() - stop_start:.2f} s, foot heights: "
+              + ', '.join(f"{foot[2] + BODY_HEIGHT:.1f}" for foot in feet) + " mm")
+
+        # A SET after the stop is no longer overwritten by the gait
+        ser.write(bytes([SET_CMD, 0, 1] + encode_signed(1500)))
+        time.sleep(0.1)
+        snapshot = read_snapshot(ser)
+        print(f"Servo 0 after SET 1500: {snapshot[1][0] if snapshot else 'no reply'}")
+
+        elapsed = time.time() - stop_start + 3 * (duration + args.period / 1000)
+        streamed = (3 + 2 * NUM_SERVOS) * 1e6 / CONTROL_TICK_US * elapsed
+        print(f"Command bytes sent: {sent} (streaming 18-servo SET frames every control tick: ~{streamed:.0f})")
+        ser.close()
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SET_CMD = 0x53 | 0x80        # 'S' with MSB set = 0xD3
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+EDGES_CMD = 0x45 | 0x80      # 'E' with MSB set = 0xC5, followed by max edges (0 = 32)
+
+# Register map
+GPIO_IDX = 19                # A0 (RELAY), A1, A2 levels
+GPIO_BANK_IDX = 38           # levels (+ write mask << 7), pin modes (4 bits per pin, + edge push << 12)
+
+# Pin modes and pulls (4 bits per pin in the mode register)
+MODE_OUTPUT, MODE_INPUT, MODE_INPUT_EDGE = 0, 1, 2
+PULL_NONE, PULL_UP, PULL_DOWN = 0, 1, 2
+EDGE_PUSH = 1 << 12
+EDGE_RING_SIZE = 64
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def set_registers(ser, start, values):
+    payload = [SET_CMD, start, len(values)]
+    for v in values:
+        payload += encode_value(v)
+    ser.write(bytes(payload))
+
+def get_registers(ser, start, count):
+    ser.write(bytes([GET_CMD, start, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count or response[0] != GET_CMD:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def pin_config(mode, pull=PULL_NONE):
+    return mode | (pull << 2)
+
+def mode_register(configs, push=False):
+    value = EDGE_PUSH if push else 0
+    for pin, config in enumerate(configs):
+        value |= config << (4 * pin)
+    return value
+
+def write_bank(ser, mask, levels):
+    set_registers(ser, GPIO_BANK_IDX, [(mask << 7) | levels])
+
+def read_edges_reply(ser):
+    """Reads one 'E' reply or push; returns (edges, remaining, dropped), edges as (pin, level, time_us)"""
+    header = ser.read(5)
+    if len(header) != 5 or header[0] != EDGES_CMD:
+        return None
+    count, remaining, dropped = header[1], header[2], decode_value(header[3], header[4])
+    body = ser.read(6 * count)
+    if len(body) != 6 * count:
+        return None
+    edges = []
+    for i in range(count):
+        code = body[6 * i]
+        time_us = 0
+        for b in range(5):
+            time_us |= body[6 * i + 1 + b] << (7 * b)
+        edges.append((code & 0x03, (code >> 2) & 1, time_us & 0xFFFFFFFF))
+    return edges, remaining, dropped
+
+def drain_edges(ser):
+    """Empties the edge ring in bulk requests; returns (edges, dropped counter)"""
+    edges = []
+    while True:
+        ser.write(bytes([EDGES_CMD, 0]))
+        reply = read_edges_reply(ser)
+        if reply is None:
+            return None, None
+        batch, remaining, dropped = reply
+        edges += batch
+        if remaining == 0:
+            return edges, dropped
+
+def check_edges(edges, pin, first_level):
+    """Edges must come from one pin, alternate in level and have increasing timestamps"""
+    ok = all(e[0] == pin for e in edges)
+    ok &= all(e[1] == (first_level + i) % 2 for i, e in enumerate(edges))
+    ok &= all(((b[2] - a[2]) & 0xFFFFFFFF) < 0x80000000 for a, b in zip(edges, edges[1:]))
+    return ok
+
+def main():
+    parser = argparse.ArgumentParser(description='GPIO bank and edge capture test for Servo 2040 (needs a jumper from A0 to A1)')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--toggles', type=int, default=20, help='A0 toggles per step (default: 20)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+        failed = False
+
+        # All outputs: one write changes A0 and A2 together, A1 is left alone
+        set_registers(ser, GPIO_BANK_IDX + 1, [mode_register([pin_config(MODE_OUTPUT)] * 3)])
+        write_bank(ser, 0b111, 0b000)
+        write_bank(ser, 0b101, 0b111)
+        bank = get_registers(ser, GPIO_BANK_IDX, 2)
+        pins = get_registers(ser, GPIO_IDX, 3)
+        print(f"Masked write 0b101: bank levels 0b{bank[0] & 0x7:03b}, A0-A2 registers {pins}")
+        failed |= (bank[0] & 0x7) != 0b101 or pins != [1, 0, 1]
+
+        # A1 captures edges with a pull-up, A2 is a plain input with a pull-down
+        modes = mode_register([pin_config(MODE_OUTPUT), pin_config(MODE_INPUT_EDGE, PULL_UP),
+                               pin_config(MODE_INPUT, PULL_DOWN)])
+        set_registers(ser, GPIO_BANK_IDX + 1, [modes])
+        readback = get_registers(ser, GPIO_BANK_IDX + 1, 1)[0]
+        print(f"Mode register 0x{modes:04X}, read back 0x{readback:04X}")
+        failed |= readback != modes
+
+        # Writes to input pins are ignored
+        write_bank(ser, 0b111, 0b000)
+        pins = get_registers(ser, GPIO_IDX, 3)
+        print(f"Write 0 to all: A0-A2 read {pins} (A1 follows A0 through the jumper)")
+        failed |= pins[0] != 0 or pins[1] != 0
+
+        # Toggle A0, drain A1's edges in bulk
+        _, dropped_before = drain_edges(ser)
+        for i in range(args.toggles):
+            write_bank(ser, 0b001, (i + 1) % 2)
+        bank = get_registers(ser, GPIO_BANK_IDX, 1)[0]
+        pending = bank >> 7
+        edges, dropped = drain_edges(ser)
+        span = ((edges[-1][2] - edges[0][2]) & 0xFFFFFFFF) if edges else 0
+        print(f"{args.toggles} toggles: {pending} edges pending, {len(edges)} drained over {span} us, "
+              f"dropped {dropped - dropped_before}")
+        failed |= pending != args.toggles or len(edges) != args.toggles or dropped != dropped_before
+        failed |= not check_edges(edges, 1, 1)
+
+        # More edges than the ring holds: the newest are dropped and counted
+        burst = EDGE_RING_SIZE + 16
+        for i in range(burst):
+            write_bank(ser, 0b001, (i + 1) % 2)
+        get_registers(ser, GPIO_BANK_IDX, 1)
+        edges, dropped_after = drain_edges(ser)
+        print(f"{burst} toggles without draining: {len(edges)} kept, {dropped_after - dropped} dropped")
+        failed |= len(edges) != EDGE_RING_SIZE or dropped_after - dropped != burst - EDGE_RING_SIZE
+        failed |= not check_edges(edges, 1, 1)
+
+        # Push: edges arrive without requests
+        set_registers(ser, GPIO_BANK_IDX + 1, [modes | EDGE_PUSH])
+        pushed = []
+        for i in range(args.toggles):
+            write_bank(ser, 0b001, (i + 1) % 2)
+        end = time.time() + 1.0
+        while len(pushed) < args.toggles and time.time() < end:
+            reply = read_edges_reply(ser)
+            if reply is None:
+                break
+            pushed += reply[0]
+        print(f"Push: {len(pushed)}/{args.toggles} edges received without a request")
+        failed |= len(pushed) != args.toggles or not check_edges(pushed, 1, 1)
+
+        # Back to three low outputs
+        set_registers(ser, GPIO_BANK_IDX + 1, [mode_register([pin_config(MODE_OUTPUT)] * 3)])
+        write_bank(ser, 0b111, 0b000)
+        time.sleep(0.1)
+        ser.reset_input_buffer()
+
+        print("PASS" if not failed else "FAIL")
+        ser.close()
+        sys.exit(1 if failed else 0)
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
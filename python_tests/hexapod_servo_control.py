@@ -13,6 +13,7 @@ BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
 
 # Command constants - as specified in the protocol
 SET_CMD = 0x53 | 0x80  # 'S' with MSB set = 0xD3
+KEYFRAME_CMD = 0x4B | 0x80  # 'K' with MSB set = 0xCB
 SERVO_1 = 0            # First servo index
 
 # Servo range and center positions
@@ -20,6 +21,10 @@ MIN_PULSE = 500    # Minimum pulse width in μs
 MAX_PULSE = 2500   # Maximum pulse width in μs
 CENTER_PULSE = 1500  # Center position
 
+# Keyframe interpolation modes (firmware TrajectoryPlanner::Interpolation)
+KEYFRAME_MODES = {'linear': 0, 'cubic': 1, 'minjerk': 2}
+KEYFRAME_LEAD = 2  # Keyframes kept queued ahead on the device
+
 def encode_value(value):
     """Encode a 14-bit value into two 7-bit bytes as per protocol"""
     low_byte = value & 0x7F
@@ -42,6 +47,20 @@ def send_command(ser, start_idx, count, values):
     if args.verbose:
         print(f"Sent: {' '.join([f'0x{b:02x}' for b in cmd])}")
 
+def send_keyframe(ser, start_idx, values, duration_ms, mode):
+    """Queue a keyframe on the device: targets are reached after duration_ms with on-device interpolation"""
+    duration_ms = max(0, min(0x3FFF, int(duration_ms)))
+    cmd = bytearray([KEYFRAME_CMD, start_idx, len(values), mode, duration_ms & 0x7F, (duration_ms >> 7) & 0x7F])
+    
+    for val in values:
+        low_byte, high_byte = encode_value(val)
+        cmd.extend([low_byte, high_byte])
+    
+    ser.write(cmd)
+    
+    if args.verbose:
+        print(f"Sent: {' '.join([f'0x{b:02x}' for b in cmd])}")
+
 def angle_to_pulse(angle, center_offset=0):
     """Convert angle in degrees to PWM pulse width
     
@@ -164,6 +183,8 @@ def parse_arguments():
     parser.add_argument('--offsets', nargs='+', type=int, help='Center offsets for servos (18 values)')
     parser.add_argument('--delay', type=float, default=0.1, help='Delay between movements in seconds (default: 0.1)')
     parser.add_argument('--cycle-delay', type=float, default=0.5, help='Delay between cycles in seconds (default: 0.5)')
+    parser.add_argument('--keyframes', choices=sorted(KEYFRAME_MODES.keys()),
+                        help='Stream --file positions as on-device keyframes with the given interpolation')
     return parser.parse_args()
 
 def main():
@@ -213,7 +234,15 @@ def main():
                         
                         for i, pos in enumerate(positions):
                             print(f"Hareket {i+1}/{len(positions)} uygulanıyor")
-                            set_kinematic_positions(ser, pos, center_offsets)
+                            if args.keyframes:
+                                # Enterpolasyon kartta yapılır; host sadece kuyruğu dolu tutar
+                                offsets = center_offsets or [0] * 18
+                                pulses = [angle_to_pulse(a, o) for a, o in zip(pos, offsets)]
+                                send_keyframe(ser, SERVO_1, pulses, args.delay * 1000, KEYFRAME_MODES[args.keyframes])
+                                if cycle_count == 1 and i < KEYFRAME_LEAD:
+                                    continue
+                            else:
+                                set_kinematic_positions(ser, pos, center_offsets)
                             time.sleep(args.delay)  # Use the specified delay
                         
                         # Döngü sonunda belirtilen gecikme kadar bekle
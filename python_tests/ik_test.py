@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import math
+import os
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+GET_CMD = 0x47 | 0x80   # 'G' with MSB set = 0xC7
+POSE_CMD = 0x50 | 0x80  # 'P' with MSB set = 0xD0: body x, y, z, roll, pitch, yaw + 6 x foot x, y, z
+
+NUM_SERVOS = 18
+IK_STATS_IDX = 88       # solves, unreachable legs, last solve us, max solve us
+PULSE_TOLERANCE = 3     # Largest accepted pulse error (us): 0.2 degrees plus 1 us rounding
+
+# Leg geometry, must match HexapodIK in the firmware (mm, degrees)
+COXA_LENGTH = 30.0
+FEMUR_LENGTH = 80.0
+TIBIA_LENGTH = 120.0
+# Mount x, y, coxa zero direction, servo direction; legs counter-clockwise from right front
+MOUNTS = [
+    (60.0, -40.0, -45.0, 1),    # right front
+    (60.0, 40.0, 45.0, -1),     # left front
+    (0.0, 55.0, 90.0, -1),      # left middle
+    (-60.0, 40.0, 135.0, -1),   # left rear
+    (-60.0, -40.0, -135.0, 1),  # right rear
+    (0.0, -55.0, -90.0, 1),     # right middle
+]
+
+def encode_signed(value):
+    value = int(round(value)) & 0x3FFF
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def angle_to_pulse(angle):
+    """Same mapping as hexapod_servo_control.py"""
+    angle = max(-90, min(90, angle))
+    return int(500 + (angle + 90) / 180.0 * 2000)
+
+def rotate(point, roll, pitch, yaw):
+    """R = Rz(yaw) Ry(pitch) Rx(roll) applied to a body frame point"""
+    x, y, z = point
+    cr, sr = math.cos(math.radians(roll)), math.sin(math.radians(roll))
+    cp, sp = math.cos(math.radians(pitch)), math.sin(math.radians(pitch))
+    cy, sy = math.cos(math.radians(yaw)), math.sin(math.radians(yaw))
+    y, z = y * cr - z * sr, y * sr + z * cr
+    x, z = x * cp + z * sp, -x * sp + z * cp
+    x, y = x * cy - y * sy, x * sy + y * cy
+    return x, y, z
+
+def forward_kinematics(angles, pose):
+    """Foot positions (mm) in the pose frame for 18 joint angles in degrees"""
+    position, roll, pitch, yaw = pose
+    feet = []
+    for leg, (mx, my, myaw, sign) in enumerate(MOUNTS):
+        coxa, femur, knee = (sign * a for a in angles[3 * leg:3 * leg + 3])
+        tibia = femur + knee - 180.0  # tibia direction from horizontal
+        r = COXA_LENGTH + FEMUR_LENGTH * math.cos(math.radians(femur)) + TIBIA_LENGTH * math.cos(math.radians(tibia))
+        z = FEMUR_LENGTH * math.sin(math.radians(femur)) + TIBIA_LENGTH * math.sin(math.radians(tibia))
+        heading = math.radians(myaw + coxa)
+        body = (mx + r * math.cos(heading), my + r * math.sin(heading), z)
+        x, y, z = rotate(body, roll, pitch, yaw)
+        feet.append((x + position[0], y + position[1], z + position[2]))
+    return feet
+
+def send_pose(ser, pose, feet):
+    """POSE command: lengths in 0.1 mm, angles in 0.1 degree, signed 14-bit"""
+    position, roll, pitch, yaw = pose
+    values = [p * 10 for p in position] + [roll * 10, pitch * 10, yaw * 10]
+    for foot in feet:
+        values += [c * 10 for c in foot]
+    payload = [POSE_CMD]
+    for v in values:
+        payload += encode_signed(v)
+    ser.write(bytes(payload))
+
+def get_registers(ser, start_idx, count):
+    ser.reset_input_buffer()
+    ser.write(bytes([GET_CMD, start_idx, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def read_positions(filename):
+    if not os.path.exists(filename):
+        filename = os.path.join(os.path.dirname(os.path.realpath(__file__)), os.path.basename(filename))
+    positions = []
+    with open(filename) as f:
+        for line in f:
+            line = line.strip()
+            if line and not line.startswith('#'):
+                angles = [float(v) for v in line.replace(',', ' ').split()]
+                if len(angles) == NUM_SERVOS:
+                    positions.append(angles)
+    return positions
+
+def compare(ser, positions, pose, settle, tolerance=PULSE_TOLERANCE):
+    """Sends every position as a pose and returns the largest pulse error (us)"""
+    worst = 0
+    for angles in positions:
+        send_pose(ser, pose, forward_kinematics(angles, pose))
+        expected = [angle_to_pulse(a) for a in angles]
+        # The board may still be applying the previous frame, read again before giving up
+        for _ in range(5):
+            time.sleep(settle)
+            pulses = get_registers(ser, 0, NUM_SERVOS)
+            if pulses is None:
+                return None
+            error = max(abs(p - e) for p, e in zip(pulses, expected))
+            if error <= tolerance:
+                break
+        worst = max(worst, error)
+    return worst
+
+def main():
+    parser = argparse.ArgumentParser(description='On-device inverse kinematics test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--file', default='kinematic_positions.txt', help='Joint angle file (default: kinematic_positions.txt)')
+    parser.add_argument('--settle', type=float, default=0.1, help='Wait before reading servos back, s (default: 0.1)')
+    parser.add_argument('--bench', type=int, default=500, help='Number of poses for the solve time benchmark (default: 500)')
+    args = parser.parse_args()
+
+    positions = read_positions(args.file)
+    print(f"{len(positions)} positions read from {args.file}")
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+        failed = False
+
+        # Level body, then a shifted and tilted body with the same leg angles
+        poses = [
+            ("level body", ((0.0, 0.0, 0.0), 0.0, 0.0, 0.0)),
+            ("moved and tilted body", ((12.0, -8.0, 60.0), 4.0, -6.0, 10.0)),
+        ]
+        for name, pose in poses:
+            worst = compare(ser, positions, pose, args.settle)
+            if worst is None:
+                print(f"{name}: no reply")
+                sys.exit(1)
+            print(f"{name}: largest pulse error against {args.file}: {worst} us")
+            failed |= worst > PULSE_TOLERANCE
+
+        # Solve time: the device times each 6-leg solve (host timing in sim/tests/hexapod_ik_test.cpp)
+        pose = poses[0][1]
+        feet = forward_kinematics(positions[0], pose)
+        for _ in range(args.bench):
+            send_pose(ser, pose, feet)
+        ser.flush()
+        time.sleep(0.5)
+        stats = get_registers(ser, IK_STATS_IDX, 4)
+        if stats:
+            solves, unreachable, last_us, max_us = stats
+            print(f"Device counters: solves={solves}, unreachable legs={unreachable}")
+            print(f"Solve time: last {last_us} us, max {max_us} us")
+        print("PASS" if not failed else "FAIL")
+        ser.close()
+        sys.exit(1 if failed else 0)
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SET_CMD = 0x53 | 0x80        # 'S' with MSB set = 0xD3
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+DIAG_CMD = 0x58 | 0x80       # 'X' with MSB set = 0xD8, followed by page, first value, count
+
+# Register map
+DIAG_IDX = 18                # write: mask of diagnostic pages to reset (bit = page number)
+CONTROL_STATS_IDX = 56       # servo frames committed, host frames coalesced (14-bit, wrap around)
+
+# Diagnostic pages 1-5: one latency histogram each
+PAGE_LATENCY = 1
+PROBES = ['rx -> parse', 'dispatch', 'get handler', 'rx -> servo commit', 'rx -> tx flush']
+NUM_BUCKETS = 16
+PAGE_SIZE = 5 + 2 * NUM_BUCKETS   # count (2 x 14-bit), min, avg, max, buckets (2 x 14-bit each)
+MAX_VALUES = 32
+VALUE_MAX = 0x3FFF                # Legacy values are 14-bit; min, avg and max saturate
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def set_registers(ser, start, values):
+    payload = [SET_CMD, start, len(values)]
+    for v in values:
+        payload += encode_value(v)
+    ser.write(bytes(payload))
+
+def get_registers(ser, start, count):
+    ser.write(bytes([GET_CMD, start, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count or response[0] != GET_CMD:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def read_diag(ser, page, first, count):
+    ser.write(bytes([DIAG_CMD, page, first, count]))
+    response = ser.read(4 + 2 * count)
+    if len(response) != 4 + 2 * count or response[0] != DIAG_CMD or response[1] != page or response[2] != first:
+        return None
+    return [decode_value(response[4 + 2 * i], response[5 + 2 * i]) for i in range(count)]
+
+def read_histogram(ser, probe):
+    """Returns {'count', 'min', 'avg', 'max', 'buckets'} for one probe"""
+    values = []
+    while len(values) < PAGE_SIZE:
+        chunk = read_diag(ser, PAGE_LATENCY + probe, len(values), min(MAX_VALUES, PAGE_SIZE - len(values)))
+        if chunk is None:
+            return None
+        values += chunk
+    buckets = [values[5 + 2 * i] | (values[6 + 2 * i] << 14) for i in range(NUM_BUCKETS)]
+    return {'count': values[0] | (values[1] << 14), 'min': values[2], 'avg': values[3], 'max': values[4],
+            'buckets': buckets}
+
+def bucket_range(bucket):
+    """Bucket k holds latencies with bit width k: 0, 1, 2-3, 4-7, ..., the last one is open"""
+    if bucket == 0:
+        return '0'
+    low = 1 << (bucket - 1)
+    if bucket == NUM_BUCKETS - 1:
+        return f'>={low}'
+    return f'{low}-{(1 << bucket) - 1}' if bucket > 1 else '1'
+
+def bucket_of(value):
+    return min(value.bit_length(), NUM_BUCKETS - 1)
+
+def print_histogram(name, h):
+    print(f"{name}: {h['count']} samples, min {h['min']} us, avg {h['avg']} us, max {h['max']} us")
+    total = max(h['count'], 1)
+    for i, n in enumerate(h['buckets']):
+        if n:
+            print(f"  {bucket_range(i):>9} us {n:>7} {'#' * max(1, round(40 * n / total))}")
+
+def bucket_used(h, value):
+    """The value's bucket holds samples; a value saturated at 14 bits may sit in any bucket above"""
+    bucket = bucket_of(value)
+    return any(h['buckets'][bucket:]) if value == VALUE_MAX else h['buckets'][bucket] > 0
+
+def check_histogram(h):
+    """Buckets add up to the count, min <= avg <= max and the extremes fall into used buckets"""
+    if h['count'] == 0:
+        return False
+    ok = sum(h['buckets']) == h['count'] and h['min'] <= h['avg'] <= h['max']
+    ok &= bucket_used(h, h['min']) and bucket_used(h, h['max'])
+    return ok
+
+def main():
+    parser = argparse.ArgumentParser(description='Latency probe and histogram test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--count', type=int, default=500, help='SET and GET requests to send (default: 500)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+        failed = False
+        reset_mask = ((1 << len(PROBES)) - 1) << PAGE_LATENCY
+
+        # One request at a time, so every latency belongs to a single packet
+        coalesced_before = get_registers(ser, CONTROL_STATS_IDX + 1, 1)[0]
+        set_registers(ser, DIAG_IDX, [reset_mask])
+        time.sleep(0.01)
+        for i in range(args.count):
+            set_registers(ser, 0, [1400 + (i % 2) * 200])
+            get_registers(ser, 0, 1)
+        time.sleep(0.25)   # The control tick loads the last SET (one PWM period, at least 10 Hz)
+
+        histograms = [read_histogram(ser, p) for p in range(len(PROBES))]
+        if any(h is None for h in histograms):
+            print("No DIAG reply")
+            sys.exit(1)
+        for name, h in zip(PROBES, histograms):
+            print_histogram(name, h)
+            failed |= not check_histogram(h)
+        coalesced = (get_registers(ser, CONTROL_STATS_IDX + 1, 1)[0] - coalesced_before) & VALUE_MAX
+
+        # Every SET reaches the PWM or is overwritten by a newer one before the control tick loads it,
+        # every GET is handled and flushed
+        rx_parse, dispatch, get, commit, flush = histograms
+        print(f"SETs committed: {commit['count']}/{args.count} (coalesced {coalesced}), "
+              f"GETs handled: {get['count']}/{args.count}, replies flushed: {flush['count']}")
+        failed |= commit['count'] + coalesced != args.count or get['count'] != args.count
+        failed |= flush['count'] < args.count or rx_parse['count'] < 2 * args.count
+        failed |= dispatch['count'] < 2 * args.count
+
+        # Reset: only the requests since the reset remain
+        set_registers(ser, DIAG_IDX, [reset_mask])
+        time.sleep(0.01)
+        after = read_histogram(ser, 3)
+        print(f"After reset: rx -> servo commit {after['count']} samples")
+        failed |= after['count'] != 0
+
+        print("PASS" if not failed else "FAIL")
+        ser.close()
+        sys.exit(1 if failed else 0)
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
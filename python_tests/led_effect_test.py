@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SET_CMD = 0x53 | 0x80        # 'S' with MSB set = 0xD3
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+LED_FRAME_CMD = 0x4C | 0x80  # 'L' with MSB set = 0xCC, 24-bit colors of all six LEDs
+
+NUM_LEDS = 6
+ALL_LEDS = (1 << NUM_LEDS) - 1
+
+# Register map
+VOLTAGE_IDX = 29
+LED_EFFECT_IDX = 118         # select mask, effect (+ meter source << 7), period ms, meter range (2 x 7-bit, unit 8)
+METER_UNIT = 8
+
+# Effects
+SOLID, PULSE, RAINBOW, METER = range(4)
+FRAME_US = 20000             # Device frame clock
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def set_registers(ser, start, values):
+    payload = [SET_CMD, start, len(values)]
+    for v in values:
+        payload += encode_value(v)
+    ser.write(bytes(payload))
+
+def get_registers(ser, start, count):
+    ser.write(bytes([GET_CMD, start, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count or response[0] != GET_CMD:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def send_led_frame(ser, colors):
+    """Sends six 0xRRGGBB colors, each as 4 x 7-bit with the low bits first"""
+    payload = [LED_FRAME_CMD]
+    for color in colors:
+        payload += [(color >> (7 * i)) & 0x7F for i in range(4)]
+    ser.write(bytes(payload))
+
+def set_effect(ser, mask, effect, period_ms=0, source=0, low=0, high=1016):
+    set_registers(ser, LED_EFFECT_IDX, [mask, effect | (source << 7), period_ms,
+                                        (low // METER_UNIT) | ((high // METER_UNIT) << 7)])
+
+def read_trace(path, since):
+    """Returns the simulator's LED updates (time_us, led, color) after the given time"""
+    updates = []
+    with open(path) as trace:
+        for line in trace:
+            fields = line.strip().split(',')
+            if len(fields) == 4 and fields[1] == 'led' and int(fields[0]) >= since:
+                updates.append((int(fields[0]), int(fields[2]), int(fields[3])))
+    return updates
+
+def trace_end(path):
+    """Time of the last trace record (simulator clock)"""
+    last = 0
+    with open(path) as trace:
+        for line in trace:
+            fields = line.strip().split(',')
+            if len(fields) == 4 and fields[0].isdigit():
+                last = int(fields[0])
+    return last
+
+def main():
+    parser = argparse.ArgumentParser(description='LED effect engine and LED frame test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--trace', default='', help='Simulator trace file (SERVO2040_SIM_TRACE) to check pushed frames')
+    parser.add_argument('--duration', type=float, default=1.0, help='Observation time per effect, s (default: 1)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+        failed = False
+
+        # One packet sets all six LEDs with full 24-bit colors
+        colors = [0x123456, 0xFF0000, 0x00FF00, 0x0000FF, 0xA5C3E1, 0x010203]
+        set_effect(ser, ALL_LEDS, SOLID)
+        send_led_frame(ser, colors)
+        time.sleep(0.1)
+        if args.trace:
+            shown = {}
+            for _, led, color in read_trace(args.trace, 0):
+                shown[led] = color
+            shown = [shown.get(i) for i in range(NUM_LEDS)]
+            print("LED frame: " + ' '.join(f"{c:06X}" if c is not None else '------' for c in shown))
+            failed |= shown != colors
+
+        # Effect registers read back for the first selected LED
+        set_effect(ser, 0b000011, PULSE, 500)
+        set_effect(ser, 0b000100, METER, 0, VOLTAGE_IDX, 0, 1016)
+        set_registers(ser, LED_EFFECT_IDX, [0b000001])
+        pulse = get_registers(ser, LED_EFFECT_IDX, 4)
+        set_registers(ser, LED_EFFECT_IDX, [0b000100])
+        meter = get_registers(ser, LED_EFFECT_IDX, 4)
+        if pulse is None or meter is None:
+            print("No LED_EFFECT reply")
+            sys.exit(1)
+        print(f"LED 0: effect {pulse[1] & 0x7F}, period {pulse[2]} ms")
+        print(f"LED 2: effect {meter[1] & 0x7F}, source register {meter[1] >> 7}, "
+              f"range {(meter[3] & 0x7F) * METER_UNIT}-{(meter[3] >> 7) * METER_UNIT}")
+        failed |= pulse[1] != PULSE or pulse[2] != 500
+        failed |= meter[1] != (METER | (VOLTAGE_IDX << 7)) or meter[3] != (127 << 7)
+
+        # Frames are pushed only when a color changes: nothing while every LED is solid,
+        # at most one frame per frame clock while a rainbow runs
+        if args.trace:
+            for name, effect in (('solid', SOLID), ('rainbow', RAINBOW)):
+                set_effect(ser, ALL_LEDS, effect, 1000)
+                time.sleep(0.2)
+                get_registers(ser, LED_EFFECT_IDX, 1)
+                start = trace_end(args.trace)
+                time.sleep(args.duration)
+                updates = [u for u in read_trace(args.trace, start + 1) if u[0] < start + args.duration * 1e6]
+                # One pushed frame traces its changed LEDs back to back
+                frames = sum(1 for i, u in enumerate(updates) if i == 0 or u[0] - updates[i - 1][0] > FRAME_US // 4)
+                limit = args.duration * 1e6 / FRAME_US + 1
+                print(f"{name}: {frames} frames pushed in {args.duration:.1f} s (frame clock allows {int(limit)})")
+                if effect == SOLID:
+                    failed |= frames != 0
+                else:
+                    failed |= frames == 0 or frames > limit
+
+        # Back to dark solid LEDs
+        set_effect(ser, ALL_LEDS, SOLID)
+        send_led_frame(ser, [0] * NUM_LEDS)
+
+        print("PASS" if not failed else "FAIL")
+        ser.close()
+        sys.exit(1 if failed else 0)
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
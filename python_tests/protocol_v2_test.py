@@ -0,0 +1,258 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import random
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SET_CMD = 0x53 | 0x80   # 'S' with MSB set = 0xD3
+MODE_CMD = 0x56 | 0x80  # 'V' with MSB set = 0xD6, followed by protocol version
+
+# Protocol v2 frame types
+FRAME_SET = 0x53   # 'S': [start_idx][u16 LE values...]
+FRAME_GET = 0x47   # 'G': request [start_idx][count], response [start_idx][u16 LE values...]
+FRAME_MODE = 0x56  # 'V': [version]
+FRAME_DISCOVER = 0x44  # 'D': empty request, response [version][range count][base, length, kind, access]...
+
+# Register kinds reported by DISCOVER
+REGISTER_KINDS = ['none', 'servo', 'gpio', 'touch', 'current', 'voltage', 'led', 'adc age', 'adc rate',
+                  'control stats', 'proto stats', 'rx stats', 'tx stats', 'tx deadline', 'subscription stats',
+                  'delta stats', 'schedule stats', 'ik stats', 'gait state', 'calibration', 'slew config', 'slew status',
+                  'current governor', 'pwm config', 'led effect', 'boot times', 'gpio bank', 'diagnostics']
+
+PROTOCOL_LEGACY = 1
+PROTOCOL_FRAMED = 2
+
+# v2 frame counters: ok, crc, length, cobs, overflow, sequence gaps, rejected
+PROTO_STATS_IDX = 60
+PROTO_STATS_COUNT = 7
+
+# USB RX path counters: FIFO high-water mark, max bytes per loop, budget-limited loops
+RX_STATS_IDX = 67
+RX_STATS_COUNT = 3
+
+# USB TX path: packets, average bytes per packet, flushes (full packet, batch end, deadline),
+# dropped replies, response deadline (us)
+TX_STATS_IDX = 70
+TX_STATS_COUNT = 7
+
+def crc16(data, crc=0xFFFF):
+    """CRC16-CCITT (poly 0x1021, init 0xFFFF) as used by the firmware"""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+def cobs_encode(data):
+    """COBS encode (without the trailing delimiter)"""
+    out = bytearray([0])
+    code_idx = 0
+    code = 1
+    for b in data:
+        if b == 0:
+            out[code_idx] = code
+            code_idx = len(out)
+            out.append(0)
+            code = 1
+        else:
+            out.append(b)
+            code += 1
+            if code == 0xFF:
+                out[code_idx] = code
+                code_idx = len(out)
+                out.append(0)
+                code = 1
+    out[code_idx] = code
+    return bytes(out)
+
+def cobs_decode(data):
+    """COBS decode (without the trailing delimiter), None on invalid input"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        out.extend(data[i:i + code - 1])
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+def encode_frame(seq, frame_type, payload):
+    """Build a complete wire frame: COBS([seq][type][payload][crc16 LE]) + 0x00"""
+    raw = bytes([seq & 0xFF, frame_type]) + bytes(payload)
+    crc = crc16(raw)
+    return cobs_encode(raw + bytes([crc & 0xFF, crc >> 8])) + b'\x00'
+
+def decode_frame(wire):
+    """Decode one wire frame (delimiter stripped), returns (seq, type, payload) or None"""
+    raw = cobs_decode(wire)
+    if raw is None or len(raw) < 4:
+        return None
+    crc = raw[-2] | (raw[-1] << 8)
+    if crc16(raw[:-2]) != crc:
+        return None
+    return raw[0], raw[1], raw[2:-2]
+
+def set_payload(start_idx, values):
+    payload = bytearray([start_idx])
+    for v in values:
+        payload.extend([v & 0xFF, (v >> 8) & 0xFF])
+    return payload
+
+def read_frame(ser, timeout=1.0):
+    """Read bytes up to the next delimiter and decode the frame"""
+    buf = bytearray()
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        b = ser.read(1)
+        if not b:
+            continue
+        if b[0] == 0:
+            if buf:
+                return decode_frame(bytes(buf))
+            continue
+        buf.extend(b)
+    return None
+
+def self_test():
+    """Codec checks that run without hardware"""
+    # CRC16-CCITT-FALSE check value
+    assert crc16(b'123456789') == 0x29B1
+
+    # COBS round trip including zero runs and long blocks
+    for sample in [b'', b'\x00', b'\x00\x00', b'\x11\x00\x22', bytes(range(1, 255)), bytes(range(256)) * 2]:
+        encoded = cobs_encode(sample)
+        assert 0 not in encoded
+        assert cobs_decode(encoded) == sample
+
+    # Frame round trip
+    values = [random.randint(0, 0xFFFF) for _ in range(18)]
+    wire = encode_frame(7, FRAME_SET, set_payload(0, values))
+    seq, frame_type, payload = decode_frame(wire[:-1])
+    assert (seq, frame_type, bytes(payload)) == (7, FRAME_SET, bytes(set_payload(0, values)))
+    print(f"18-servo SET: {len(wire)} bytes (v2) vs {3 + 2 * 18} bytes (legacy)")
+
+    # Single bit error must be rejected, next frame must still decode (resync on delimiter)
+    stream = bytearray(encode_frame(1, FRAME_SET, set_payload(0, values)) + wire)
+    stream[10] ^= 0x04
+    frames = [f for f in bytes(stream).split(b'\x00') if f]
+    assert decode_frame(frames[0]) is None
+    assert decode_frame(frames[1]) is not None
+    print("Self test passed")
+
+def throughput_test(ser, frames, verbose):
+    """Stream 18-servo SET frames, then read the device counters"""
+    # Switch to protocol v2
+    ser.write(bytes([MODE_CMD, PROTOCOL_FRAMED]))
+    time.sleep(0.05)
+
+    # Line noise before the first frame must only cost one rejected frame
+    ser.write(bytes([0x55, 0xAA, 0x13, 0x00]))
+
+    start = time.time()
+    sent = 0
+    for i in range(frames):
+        pulse = 1500 + int(300 * ((i % 50) / 50.0))
+        wire = encode_frame(i, FRAME_SET, set_payload(0, [pulse] * 18))
+        ser.write(wire)
+        sent += len(wire)
+    ser.flush()
+    elapsed = time.time() - start
+    print(f"Sent {frames} frames, {sent} bytes in {elapsed:.3f} s "
+          f"({frames / elapsed:.0f} frames/s, {sent / elapsed / 1024:.1f} KiB/s)")
+
+    # GET round-trip latency over the framed protocol
+    latencies = []
+    for i in range(100):
+        t0 = time.time()
+        ser.write(encode_frame(i, FRAME_GET, bytes([0, 18])))
+        reply = read_frame(ser)
+        if reply is None or reply[1] != FRAME_GET or reply[0] != i:
+            print(f"GET {i}: invalid or missing reply")
+            continue
+        latencies.append((time.time() - t0) * 1000.0)
+    if latencies:
+        latencies.sort()
+        print(f"GET round trip: min {latencies[0]:.2f} ms, "
+              f"median {latencies[len(latencies) // 2]:.2f} ms, max {latencies[-1]:.2f} ms")
+
+    # Frame counters
+    ser.write(encode_frame(0, FRAME_GET, bytes([PROTO_STATS_IDX, PROTO_STATS_COUNT])))
+    reply = read_frame(ser)
+    if reply:
+        payload = reply[2]
+        counters = [payload[1 + 2 * i] | (payload[2 + 2 * i] << 8) for i in range(PROTO_STATS_COUNT)]
+        names = ['ok', 'crc', 'length', 'cobs', 'overflow', 'seq gaps', 'rejected']
+        print("Device counters: " + ", ".join(f"{n}={c}" for n, c in zip(names, counters)))
+
+    ser.write(encode_frame(1, FRAME_GET, bytes([RX_STATS_IDX, RX_STATS_COUNT])))
+    reply = read_frame(ser)
+    if reply:
+        payload = reply[2]
+        counters = [payload[1 + 2 * i] | (payload[2 + 2 * i] << 8) for i in range(RX_STATS_COUNT)]
+        names = ['fifo high-water', 'max bytes/loop', 'budget hits']
+        print("RX path: " + ", ".join(f"{n}={c}" for n, c in zip(names, counters)))
+
+    ser.write(encode_frame(2, FRAME_GET, bytes([TX_STATS_IDX, TX_STATS_COUNT])))
+    reply = read_frame(ser)
+    if reply:
+        payload = reply[2]
+        counters = [payload[1 + 2 * i] | (payload[2 + 2 * i] << 8) for i in range(TX_STATS_COUNT)]
+        names = ['packets', 'bytes/packet', 'full', 'batch end', 'deadline', 'dropped', 'deadline us']
+        print("TX path: " + ", ".join(f"{n}={c}" for n, c in zip(names, counters)))
+
+    # Register map
+    ser.write(encode_frame(3, FRAME_DISCOVER, b''))
+    reply = read_frame(ser)
+    if reply and reply[1] == FRAME_DISCOVER:
+        payload = reply[2]
+        print(f"Register map v{payload[0]}, {payload[1]} ranges")
+        for i in range(payload[1]):
+            base, length, kind, access = payload[2 + 4 * i:6 + 4 * i]
+            name = REGISTER_KINDS[kind] if kind < len(REGISTER_KINDS) else f'kind {kind}'
+            mode = ('R' if access & 1 else '') + ('W' if access & 2 else '')
+            print(f"  {base:3d}-{base + length - 1:3d} {name} ({mode})")
+
+    # Back to the legacy protocol
+    ser.write(encode_frame(0, FRAME_MODE, bytes([PROTOCOL_LEGACY])))
+    time.sleep(0.05)
+    if verbose:
+        print("Returned to legacy protocol")
+
+def main():
+    parser = argparse.ArgumentParser(description='Protocol v2 (framed) test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--frames', type=int, default=2000, help='Number of SET frames to stream (default: 2000)')
+    parser.add_argument('--selftest', action='store_true', help='Only run the codec self test (no hardware)')
+    parser.add_argument('--verbose', '-v', action='store_true', help='Enable verbose output')
+    args = parser.parse_args()
+
+    self_test()
+    if args.selftest:
+        return
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=0.1)
+        print("Connected!")
+        time.sleep(1)
+        throughput_test(ser, args.frames, args.verbose)
+        ser.close()
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
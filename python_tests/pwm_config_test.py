@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+import statistics
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SET_CMD = 0x53 | 0x80        # 'S' with MSB set = 0xD3
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+
+NUM_SERVOS = 18
+
+# Register map
+SLEW_CONFIG_IDX = 101        # select mask servos 0-13, select mask servos 14-17, max velocity us/s, max accel 10 us/s^2
+PWM_CONFIG_IDX = 114         # PWM frequency Hz, control tick 10 us, auto phase, enabled servos
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def set_registers(ser, start, values):
+    payload = [SET_CMD, start, len(values)]
+    for v in values:
+        payload += encode_value(v)
+    ser.write(bytes(payload))
+
+def get_registers(ser, start, count):
+    ser.write(bytes([GET_CMD, start, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count or response[0] != GET_CMD:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def measure_update_interval(ser, servo, distance, velocity):
+    """Moves a rate-limited servo and returns the host-side intervals between output changes (s)"""
+    mask = 1 << servo
+    set_registers(ser, SLEW_CONFIG_IDX, [mask & 0x3FFF, mask >> 14, 0, 0])
+    set_registers(ser, servo, [1500 - distance // 2])
+    time.sleep(0.1)
+    set_registers(ser, SLEW_CONFIG_IDX, [mask & 0x3FFF, mask >> 14, velocity, 0])
+    set_registers(ser, servo, [1500 + distance // 2])
+
+    changes = []
+    last = None
+    end = time.time() + distance / velocity
+    while time.time() < end:
+        position = get_registers(ser, servo, 1)
+        now = time.time()
+        if position is None:
+            continue
+        if last is not None and position[0] != last:
+            changes.append(now)
+        last = position[0]
+
+    set_registers(ser, SLEW_CONFIG_IDX, [mask & 0x3FFF, mask >> 14, 0, 0])
+    set_registers(ser, servo, [1500])
+    return [b - a for a, b in zip(changes, changes[1:])]
+
+def main():
+    parser = argparse.ArgumentParser(description='Servo PWM frequency, phase and startup test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--frequency', type=int, default=0, help='Expected PWM frequency, Hz (default: any)')
+    parser.add_argument('--servo', type=int, default=0, help='Servo used to measure the update rate (default: 0)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+        failed = False
+
+        config = get_registers(ser, PWM_CONFIG_IDX, 4)
+        if config is None:
+            print("No PWM_CONFIG reply")
+            sys.exit(1)
+        frequency, tick_us, auto_phase, enabled = config
+        tick_us *= 10
+        print(f"PWM {frequency} Hz, control tick {tick_us} us, auto phase {'on' if auto_phase else 'off'}, "
+              f"{enabled}/{NUM_SERVOS} servos enabled")
+        failed |= abs(tick_us - 1e6 / frequency) > 10
+        failed |= enabled != NUM_SERVOS
+        if args.frequency:
+            failed |= frequency != args.frequency
+
+        # A rate-limited servo's output changes once per control tick
+        intervals = measure_update_interval(ser, args.servo, 400, 400)
+        if len(intervals) < 3:
+            print("Too few output changes seen")
+            failed = True
+        else:
+            median = statistics.median(intervals)
+            print(f"Output changes: {len(intervals) + 1}, median interval {median * 1000:.1f} ms "
+                  f"(control tick {tick_us / 1000:.1f} ms)")
+            # Host polling adds its own round trip, so only a clearly slower update rate fails
+            failed |= median > 2 * tick_us / 1e6 + 0.005
+
+        print("PASS" if not failed else "FAIL")
+        ser.close()
+        sys.exit(1 if failed else 0)
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
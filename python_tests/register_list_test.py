@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+GET_CMD = 0x47 | 0x80         # 'G' with MSB set = 0xC7
+READ_LIST_CMD = 0x52 | 0x80   # 'R' with MSB set = 0xD2: [count][indices...]
+WRITE_LIST_CMD = 0x57 | 0x80  # 'W' with MSB set = 0xD7: [count][index, lo7, hi7]...
+
+# Registers of a typical control cycle: servo 3, touch sensor 4, CURR
+CYCLE_REGISTERS = [3, 22 + 4, 28]
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def get_range(ser, start_idx, count):
+    """Contiguous GET, returns (values, request bytes, response bytes)"""
+    request = bytes([GET_CMD, start_idx, count])
+    ser.write(request)
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count:
+        return None, len(request), len(response)
+    values = [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+    return values, len(request), len(response)
+
+def read_list(ser, indices):
+    """Scatter-gather read, returns (values, request bytes, response bytes)"""
+    request = bytes([READ_LIST_CMD, len(indices)] + indices)
+    ser.write(request)
+    response = ser.read(2 + 2 * len(indices))
+    if len(response) != 2 + 2 * len(indices) or response[0] != READ_LIST_CMD:
+        return None, len(request), len(response)
+    values = [decode_value(response[2 + 2 * i], response[3 + 2 * i]) for i in range(len(indices))]
+    return values, len(request), len(response)
+
+def write_list(ser, pairs):
+    """Scatter-gather write of (index, value) pairs, no response"""
+    payload = [WRITE_LIST_CMD, len(pairs)]
+    for idx, value in pairs:
+        payload += [idx] + encode_value(value)
+    ser.write(bytes(payload))
+    return len(payload)
+
+def measure(ser, name, cycles, read_fn):
+    start = time.time()
+    sent = received = 0
+    values = None
+    for _ in range(cycles):
+        values, tx, rx = read_fn()
+        sent += tx
+        received += rx
+    elapsed = time.time() - start
+    print(f"{name}: {elapsed / cycles * 1000:.2f} ms/cycle, {sent / cycles:.0f} bytes out, "
+          f"{received / cycles:.0f} bytes in, values {values}")
+
+def main():
+    parser = argparse.ArgumentParser(description='Scatter-gather register list test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--cycles', type=int, default=200, help='Number of read cycles (default: 200)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+
+        # Servos 3 and 12 move in the same PWM frame
+        sent = write_list(ser, [(3, 1400), (12, 1600)])
+        print(f"WRITE_LIST servo 3 = 1400, servo 12 = 1600 ({sent} bytes)")
+        time.sleep(0.1)
+
+        def separate_gets():
+            values = []
+            sent = received = 0
+            for idx in CYCLE_REGISTERS:
+                result, tx, rx = get_range(ser, idx, 1)
+                values += result or [None]
+                sent += tx
+                received += rx
+            return values, sent, received
+
+        def wide_get():
+            first, last = min(CYCLE_REGISTERS), max(CYCLE_REGISTERS)
+            result, tx, rx = get_range(ser, first, last - first + 1)
+            return ([result[i - first] for i in CYCLE_REGISTERS] if result else None), tx, rx
+
+        measure(ser, "3 x GET     ", args.cycles, separate_gets)
+        measure(ser, "wide GET    ", args.cycles, wide_get)
+        measure(ser, "READ_LIST   ", args.cycles, lambda: read_list(ser, CYCLE_REGISTERS))
+        ser.close()
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
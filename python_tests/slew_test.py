@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SET_CMD = 0x53 | 0x80        # 'S' with MSB set = 0xD3
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+SNAPSHOT_CMD = 0x41 | 0x80   # 'A' with MSB set = 0xC1
+
+SNAPSHOT_HEADER_SIZE = 7     # cmd, count, 5 x 7-bit timestamp (us)
+
+# Register map
+SLEW_CONFIG_IDX = 101        # select mask servos 0-13, select mask servos 14-17, max velocity us/s, max accel 10 us/s^2
+SLEW_STATUS_IDX = 105        # reached mask servos 0-13, reached mask servos 14-17, limited servo steps
+ACCEL_UNIT = 10
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def set_registers(ser, start, values):
+    payload = [SET_CMD, start, len(values)]
+    for v in values:
+        payload += encode_value(v)
+    ser.write(bytes(payload))
+
+def get_registers(ser, start, count):
+    ser.write(bytes([GET_CMD, start, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count or response[0] != GET_CMD:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def read_snapshot(ser):
+    ser.write(bytes([SNAPSHOT_CMD]))
+    header = ser.read(SNAPSHOT_HEADER_SIZE)
+    if len(header) != SNAPSHOT_HEADER_SIZE or header[0] != SNAPSHOT_CMD:
+        return None
+    count = header[1]
+    body = ser.read(2 * count)
+    if len(body) != 2 * count:
+        return None
+    timestamp_us = sum(header[2 + i] << (7 * i) for i in range(5)) & 0xFFFFFFFF
+    return timestamp_us, [decode_value(body[2 * i], body[2 * i + 1]) for i in range(count)]
+
+def set_limits(ser, mask, velocity, accel):
+    """Selects the servos in mask and sets their limits with one SET"""
+    set_registers(ser, SLEW_CONFIG_IDX, [mask & 0x3FFF, mask >> 14, velocity, accel])
+
+def reached(values, servo):
+    mask = values[SLEW_STATUS_IDX] | (values[SLEW_STATUS_IDX + 1] << 14)
+    return bool(mask & (1 << servo))
+
+def move_time(distance, velocity, accel):
+    """Trapezoidal (or triangular) profile duration in seconds"""
+    if accel == 0:
+        return distance / velocity
+    ramp = velocity / accel
+    if accel * ramp * ramp >= distance:
+        return 2 * (distance / accel) ** 0.5
+    return distance / velocity + ramp
+
+def record_move(ser, servo, target, timeout):
+    """SET one servo and snapshot it until the reached bit is back; returns [(s, pulse, reached)]"""
+    set_registers(ser, servo, [target])
+    samples = []
+    start = None
+    end = time.time() + timeout
+    while time.time() < end:
+        snapshot = read_snapshot(ser)
+        if snapshot is None:
+            continue
+        t, values = snapshot
+        start = t if start is None else start
+        samples.append((((t - start) & 0xFFFFFFFF) / 1e6, values[servo], reached(values, servo)))
+        if values[servo] == target and reached(values, servo):
+            break
+        time.sleep(0.005)
+    return samples
+
+def analyse(samples, distance, velocity, accel):
+    # Speeds over windows of several control ticks
+    speeds = []
+    last = samples[0]
+    for sample in samples[1:]:
+        if sample[0] - last[0] >= 0.2:
+            speeds.append(((sample[0] + last[0]) / 2, abs(sample[1] - last[1]) / (sample[0] - last[0])))
+            last = sample
+    peak = max(s for _, s in speeds) if speeds else 0
+    accels = [abs(b[1] - a[1]) / (b[0] - a[0]) for a, b in zip(speeds, speeds[1:]) if b[0] > a[0]]
+    moving = [s for s in samples if not s[2]]
+    duration = samples[-1][0]
+    print(f"  reached after {duration:.2f} s (profile {move_time(distance, velocity, accel):.2f} s), "
+          f"{len(moving)} of {len(samples)} snapshots had the reached bit clear")
+    print(f"  peak speed {peak:.0f} us/s (limit {velocity}), "
+          f"peak acceleration ~{max(accels) if accels else 0:.0f} us/s^2 (limit {accel})")
+    return peak, duration
+
+def main():
+    parser = argparse.ArgumentParser(description='Servo velocity/acceleration limiter test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--servo', type=int, default=0, help='Servo to move (default: 0)')
+    parser.add_argument('--velocity', type=int, default=1000, help='Max velocity, us/s (default: 1000)')
+    parser.add_argument('--accel', type=int, default=2000, help='Max acceleration, us/s^2 (default: 2000)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+        failed = False
+        mask = 1 << args.servo
+
+        # Unlimited: the jump shows up at once
+        set_limits(ser, mask, 0, 0)
+        set_registers(ser, args.servo, [1000])
+        time.sleep(0.05)
+        print(f"Unlimited SET 1000: position {get_registers(ser, args.servo, 1)}")
+
+        # Velocity only, then velocity and acceleration
+        for accel in (0, args.accel):
+            set_limits(ser, mask, args.velocity, accel // ACCEL_UNIT)
+            config = get_registers(ser, SLEW_CONFIG_IDX, 4)
+            print(f"Limits: velocity {args.velocity} us/s, acceleration {accel or 'unlimited'} us/s^2 "
+                  f"(registers {config})")
+            for target, distance in ((2000, 1000), (1000, 1000)):
+                print(f" Move to {target}:")
+                samples = record_move(ser, args.servo, target, 2 * move_time(distance, args.velocity, accel) + 1)
+                if not samples or samples[-1][1] != target:
+                    print("  target not reached")
+                    failed = True
+                    continue
+                peak, duration = analyse(samples, distance, args.velocity, accel)
+                failed |= peak > args.velocity * 1.2
+                failed |= duration < move_time(distance, args.velocity, accel) * 0.9
+
+        # A new target while moving: the servo slows down and turns around without overshoot
+        print("Reversal at mid-move:")
+        set_registers(ser, args.servo, [2000])
+        time.sleep(move_time(1000, args.velocity, args.accel) / 2)
+        samples = record_move(ser, args.servo, 1200, 5)
+        furthest = max(s[1] for s in samples)
+        print(f"  furthest position after the reversal {furthest}, settled at {samples[-1][1]}")
+        failed |= samples[-1][1] != 1200
+
+        status = get_registers(ser, SLEW_STATUS_IDX, 3)
+        print(f"Status registers: reached mask {status[0] | (status[1] << 14):#07x}, limited steps {status[2]}")
+
+        # Back to unlimited, the servo is centred
+        set_limits(ser, mask, 0, 0)
+        set_registers(ser, args.servo, [1500])
+
+        print("PASS" if not failed else "FAIL")
+        ser.close()
+        sys.exit(1 if failed else 0)
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
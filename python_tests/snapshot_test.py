@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SNAPSHOT_CMD = 0x41 | 0x80  # 'A' with MSB set = 0xC1, single byte request
+
+SNAPSHOT_HEADER_SIZE = 7  # cmd, count, 5 x 7-bit timestamp (us)
+
+# Register map
+SERVO_START_IDX = 0
+SERVO_COUNT = 18
+GPIO_START_IDX = 19
+TOUCH_START_IDX = 22
+CURRENT_IDX = 28
+VOLTAGE_IDX = 29
+CONTROL_STATS_IDX = 56
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def read_snapshot(ser):
+    """Request a snapshot, returns (timestamp_us, values) or None"""
+    ser.write(bytes([SNAPSHOT_CMD]))
+    header = ser.read(SNAPSHOT_HEADER_SIZE)
+    if len(header) != SNAPSHOT_HEADER_SIZE or header[0] != SNAPSHOT_CMD:
+        return None
+    count = header[1]
+    body = ser.read(2 * count)
+    if len(body) != 2 * count:
+        return None
+    timestamp_us = sum(header[2 + i] << (7 * i) for i in range(5))
+    values = [decode_value(body[2 * i], body[2 * i + 1]) for i in range(count)]
+    return timestamp_us, values
+
+def print_snapshot(timestamp_us, values):
+    print(f"Device time: {timestamp_us / 1e6:.6f} s, {len(values)} registers")
+    print(f"  Servos: {values[SERVO_START_IDX:SERVO_START_IDX + SERVO_COUNT]}")
+    print(f"  GPIO A0-A2: {values[GPIO_START_IDX:GPIO_START_IDX + 3]}")
+    print(f"  Touch: {values[TOUCH_START_IDX:TOUCH_START_IDX + 6]}")
+    print(f"  Current: {(values[CURRENT_IDX] - 512) * 0.0814:.3f} A, voltage: {values[VOLTAGE_IDX] / 310.303:.2f} V")
+    committed, coalesced, dropped, retries = values[CONTROL_STATS_IDX:CONTROL_STATS_IDX + 4]
+    print(f"  Frames committed={committed}, coalesced={coalesced}, commands dropped={dropped}, "
+          f"shadow read retries={retries}")
+
+def main():
+    parser = argparse.ArgumentParser(description='Register snapshot test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--count', type=int, default=200, help='Number of snapshots for the rate test (default: 200)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+
+        snapshot = read_snapshot(ser)
+        if snapshot is None:
+            print("No valid snapshot received")
+            sys.exit(1)
+        print_snapshot(*snapshot)
+
+        # Back-to-back snapshots: device timestamps must never go backwards
+        stamps = []
+        start = time.time()
+        for _ in range(args.count):
+            snapshot = read_snapshot(ser)
+            if snapshot:
+                stamps.append(snapshot[0])
+        elapsed = time.time() - start
+        backwards = sum(1 for a, b in zip(stamps, stamps[1:]) if ((b - a) & 0xFFFFFFFF) >= 0x80000000)
+        print(f"{len(stamps)}/{args.count} snapshots in {elapsed:.3f} s ({len(stamps) / elapsed:.0f}/s), "
+              f"{len(set(stamps))} distinct device timestamps, {backwards} out of order")
+        ser.close()
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+SET_CMD = 0x53 | 0x80        # 'S' with MSB set = 0xD3
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+DIAG_CMD = 0x58 | 0x80       # 'X' with MSB set = 0xD8, followed by page, first value, count
+
+# Register map
+DIAG_IDX = 18                # read: core0 load (permille), write: mask of diagnostic pages to reset
+PWM_CONFIG_IDX = 114         # PWM frequency Hz, control tick 10 us, auto phase, enabled servos
+
+# Diagnostic page 0: [task count, record size, core0 load, core1 load], then one record per task
+PAGE_TASKS = 0
+TASK_HEADER = 4
+TASK_FIELDS = ['period', 'budget', 'priority', 'wcet', 'avg', 'latency', 'load', 'misses', 'overruns']
+TASK_EVENT = 1 << 7
+MAX_VALUES = 32
+CONFIG_UNIT_US = 10          # Period and budget fields are in 10 us units
+
+# Task order in the record list: core0 tasks, then core1 tasks
+TASK_NAMES = ['usb', 'usb rx', 'tx flush', 'telemetry', 'gpio edges', 'leds', 'cal bench',
+              'commands', 'control tick', 'adc scan', 'servo enable', 'publish']
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def set_registers(ser, start, values):
+    payload = [SET_CMD, start, len(values)]
+    for v in values:
+        payload += encode_value(v)
+    ser.write(bytes(payload))
+
+def get_registers(ser, start, count):
+    ser.write(bytes([GET_CMD, start, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count or response[0] != GET_CMD:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def read_diag(ser, page, first, count):
+    ser.write(bytes([DIAG_CMD, page, first, count]))
+    response = ser.read(4 + 2 * count)
+    if len(response) != 4 + 2 * count or response[0] != DIAG_CMD or response[1] != page or response[2] != first:
+        return None
+    return [decode_value(response[4 + 2 * i], response[5 + 2 * i]) for i in range(count)]
+
+def read_page(ser, page, length):
+    """Reads a whole diagnostic page in MAX_VALUES chunks"""
+    values = []
+    while len(values) < length:
+        chunk = read_diag(ser, page, len(values), min(MAX_VALUES, length - len(values)))
+        if chunk is None:
+            return None
+        values += chunk
+    return values
+
+def read_tasks(ser):
+    """Returns (core0 load, core1 load, {name: record dict})"""
+    header = read_diag(ser, PAGE_TASKS, 0, TASK_HEADER)
+    if header is None:
+        return None
+    count, size, load0, load1 = header
+    page = read_page(ser, PAGE_TASKS, TASK_HEADER + count * size)
+    if page is None or size != len(TASK_FIELDS):
+        return None
+    tasks = {}
+    for i in range(count):
+        record = dict(zip(TASK_FIELDS, page[TASK_HEADER + i * size:TASK_HEADER + (i + 1) * size]))
+        record['period'] *= CONFIG_UNIT_US
+        record['budget'] *= CONFIG_UNIT_US
+        tasks[TASK_NAMES[i] if i < len(TASK_NAMES) else f'task {i}'] = record
+    return load0, load1, tasks
+
+def print_tasks(tasks):
+    print(f"  {'task':<13} {'period':>7} {'budget':>6} {'prio':>5} {'wcet':>6} {'avg':>5} "
+          f"{'latency':>7} {'load':>5} {'misses':>6} {'overruns':>8}")
+    for name, t in tasks.items():
+        prio = f"{t['priority'] & 0x7F}{'e' if t['priority'] & TASK_EVENT else ''}"
+        print(f"  {name:<13} {t['period']:>7} {t['budget']:>6} {prio:>5} {t['wcet']:>6} {t['avg']:>5} "
+              f"{t['latency']:>7} {t['load'] / 10:>4.1f}% {t['misses']:>6} {t['overruns']:>8}")
+
+def main():
+    parser = argparse.ArgumentParser(description='Task scheduler statistics test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--duration', type=float, default=3.0, help='Measurement time in seconds (default: 3)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+        failed = False
+
+        # Start from zero, then let the tasks run under a steady GET load
+        set_registers(ser, DIAG_IDX, [1 << PAGE_TASKS])
+        tick_us = get_registers(ser, PWM_CONFIG_IDX + 1, 1)[0] * 10
+        end = time.time() + args.duration
+        gets = 0
+        while time.time() < end:
+            if get_registers(ser, 0, 18) is not None:
+                gets += 1
+
+        result = read_tasks(ser)
+        if result is None:
+            print("No DIAG reply")
+            sys.exit(1)
+        load0, load1, tasks = result
+        core0_register = get_registers(ser, DIAG_IDX, 1)[0]
+        print(f"{gets} GETs in {args.duration:.1f} s; core0 load {load0 / 10:.1f}% "
+              f"(register {core0_register / 10:.1f}%), core1 load {load1 / 10:.1f}%")
+        print_tasks(tasks)
+
+        # Control tick runs at the PWM period and finishes before its next release
+        tick = tasks.get('control tick')
+        ok = tick is not None and tick['period'] == tick_us and tick['wcet'] > 0 and tick['wcet'] < tick_us
+        ok &= tick is not None and tick['misses'] == 0
+        print(f"Control tick: period {tick['period']} us (PWM period {tick_us} us), wcet {tick['wcet']} us, "
+              f"misses {tick['misses']}")
+        failed |= not ok
+
+        # Event tasks carry their flag, USB receive ran for the GETs
+        failed |= not tasks['usb rx']['priority'] & TASK_EVENT or tasks['usb rx']['wcet'] == 0
+        failed |= tasks['leds']['priority'] & TASK_EVENT != 0
+
+        # Reset clears the counters on both cores
+        set_registers(ser, DIAG_IDX, [1 << PAGE_TASKS])
+        time.sleep(0.01)
+        _, _, after = read_tasks(ser)
+        print(f"After reset: usb rx wcet {after['usb rx']['wcet']} us, control tick misses {after['control tick']['misses']}, "
+              f"adc scan latency {after['adc scan']['latency']} us (was {tasks['adc scan']['latency']})")
+        failed |= after['control tick']['misses'] != 0
+        failed |= after['adc scan']['latency'] > max(tasks['adc scan']['latency'], 1)
+
+        print("PASS" if not failed else "FAIL")
+        ser.close()
+        sys.exit(1 if failed else 0)
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+SUBSCRIBE_CMD = 0x54 | 0x80  # 'T' with MSB set = 0xD4, also used for pushed telemetry
+
+# Register map
+TOUCH_START_IDX = 22
+CURRENT_IDX = 28
+VOLTAGE_IDX = 29
+SUBSCRIPTION_SENT_IDX = 77
+SUBSCRIPTION_DROPPED_IDX = 78
+
+PUSH_HEADER_SIZE = 7  # cmd, slot, start, count, 3 x 7-bit timestamp (ms)
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def subscribe(ser, slot, start_idx, count, period_ms):
+    """Start (period_ms > 0) or cancel (period_ms = 0) a telemetry subscription"""
+    ser.write(bytes([SUBSCRIBE_CMD, start_idx, count, slot] + encode_value(period_ms)))
+
+class PushReader:
+    """Splits the incoming byte stream into pushed telemetry frames"""
+
+    def __init__(self):
+        self.buffer = bytearray()
+
+    def feed(self, data):
+        self.buffer.extend(data)
+        frames = []
+        while True:
+            # Resync on the next push command byte
+            start = self.buffer.find(bytes([SUBSCRIBE_CMD]))
+            if start < 0:
+                self.buffer.clear()
+                break
+            del self.buffer[:start]
+            if len(self.buffer) < PUSH_HEADER_SIZE:
+                break
+            count = self.buffer[3]
+            size = PUSH_HEADER_SIZE + 2 * count
+            if len(self.buffer) < size:
+                break
+            frame = bytes(self.buffer[:size])
+            del self.buffer[:size]
+            timestamp_ms = frame[4] | (frame[5] << 7) | (frame[6] << 14)
+            values = [decode_value(frame[PUSH_HEADER_SIZE + 2 * i], frame[PUSH_HEADER_SIZE + 2 * i + 1])
+                      for i in range(count)]
+            frames.append((frame[1], frame[2], timestamp_ms, values))
+        return frames
+
+def read_counters(ser):
+    """Read the sent/dropped push counters with a GET after the subscriptions are cancelled"""
+    time.sleep(0.1)
+    ser.reset_input_buffer()
+    ser.write(bytes([GET_CMD, SUBSCRIPTION_SENT_IDX, 2]))
+    response = ser.read(7)
+    if len(response) != 7:
+        return None
+    return decode_value(response[3], response[4]), decode_value(response[5], response[6])
+
+def main():
+    parser = argparse.ArgumentParser(description='Telemetry subscription (push) test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--power-period', type=int, default=10, help='CURR/VOLT push period in ms (default: 10)')
+    parser.add_argument('--touch-period', type=int, default=50, help='Touch sensor push period in ms (default: 50)')
+    parser.add_argument('--duration', type=float, default=5.0, help='Test duration in seconds (default: 5)')
+    parser.add_argument('--verbose', '-v', action='store_true', help='Print every pushed frame')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=0.05)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+
+        # Two concurrent subscriptions at different rates
+        subscribe(ser, 0, CURRENT_IDX, 2, args.power_period)
+        subscribe(ser, 1, TOUCH_START_IDX, 6, args.touch_period)
+
+        reader = PushReader()
+        received = {0: [], 1: []}
+        start = time.time()
+        while time.time() - start < args.duration:
+            for slot, start_idx, timestamp_ms, values in reader.feed(ser.read(256)):
+                if slot in received:
+                    received[slot].append(timestamp_ms)
+                if args.verbose:
+                    print(f"slot {slot} @ {timestamp_ms} ms: registers {start_idx}.. = {values}")
+
+        subscribe(ser, 0, CURRENT_IDX, 2, 0)
+        subscribe(ser, 1, TOUCH_START_IDX, 6, 0)
+
+        for slot, period in ((0, args.power_period), (1, args.touch_period)):
+            stamps = received[slot]
+            if len(stamps) < 2:
+                print(f"slot {slot}: {len(stamps)} frames received")
+                continue
+            intervals = [(b - a) & 0x1FFFFF for a, b in zip(stamps, stamps[1:])]
+            print(f"slot {slot}: {len(stamps)} frames, {len(stamps) / args.duration:.1f} frames/s "
+                  f"(expected {1000.0 / period:.1f}), interval min {min(intervals)} ms, max {max(intervals)} ms")
+
+        counters = read_counters(ser)
+        if counters:
+            print(f"Device counters: sent={counters[0]}, dropped={counters[1]}")
+        ser.close()
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
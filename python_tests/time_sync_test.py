@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+import serial
+import time
+import sys
+import random
+import argparse
+
+# Serial port settings
+PORT = '/dev/ttyACM0'  # Linux default, use COM port on Windows
+BAUD_RATE = 115200     # Note: Baudrate doesn't matter for USB CDC
+
+# Command constants - as specified in the protocol
+GET_CMD = 0x47 | 0x80        # 'G' with MSB set = 0xC7
+SNAPSHOT_CMD = 0x41 | 0x80   # 'A' with MSB set = 0xC1
+TIME_SYNC_CMD = 0x43 | 0x80  # 'C' with MSB set = 0xC3: [cookie]
+SCHEDULE_CMD = 0x51 | 0x80   # 'Q' with MSB set = 0xD1: [startIdx][count][apply at us 5 x 7-bit][values...]
+
+TIME_SYNC_REPLY_SIZE = 12    # cmd, cookie, rx us (5 x 7-bit), tx us (5 x 7-bit)
+SNAPSHOT_HEADER_SIZE = 7     # cmd, count, 5 x 7-bit timestamp (us)
+
+CONTROL_TICK_US = 20000
+SCHEDULE_STATS_IDX = 84      # pending, applied, late, overflow
+
+def encode_value(value):
+    return [value & 0x7F, (value >> 7) & 0x7F]
+
+def decode_value(low_byte, high_byte):
+    return (low_byte & 0x7F) | ((high_byte & 0x7F) << 7)
+
+def decode_u32(data):
+    return sum(data[i] << (7 * i) for i in range(5)) & 0xFFFFFFFF
+
+def host_us():
+    return time.monotonic_ns() // 1000
+
+class DeviceClock:
+    """Host model of the device clock: device = host + offset + drift * host (us)"""
+
+    def __init__(self):
+        self.ref_device = None
+        self.offset = 0.0
+        self.drift = 0.0
+
+    def unwrap(self, device_us):
+        """Extends the 32-bit device counter around the first sample"""
+        if self.ref_device is None:
+            return device_us
+        delta = (device_us - self.ref_device) & 0xFFFFFFFF
+        if delta >= 0x80000000:
+            delta -= 0x100000000
+        return self.ref_device + delta
+
+    def fit(self, samples):
+        """Least squares fit over the lowest-delay half of (host time, offset, rtt) samples"""
+        best = sorted(samples, key=lambda s: s[2])[:max(2, len(samples) // 2)]
+        n = len(best)
+        mean_h = sum(s[0] for s in best) / n
+        mean_o = sum(s[1] for s in best) / n
+        var = sum((s[0] - mean_h) ** 2 for s in best)
+        self.drift = sum((s[0] - mean_h) * (s[1] - mean_o) for s in best) / var if var else 0.0
+        self.offset = mean_o - self.drift * mean_h
+        return best
+
+    def to_device(self, host):
+        return int(host + self.offset + self.drift * host) & 0xFFFFFFFF
+
+def time_sync(ser, clock, cookie):
+    """One exchange, returns (host midpoint, offset, round trip) in us or None"""
+    ser.reset_input_buffer()
+    t0 = host_us()
+    ser.write(bytes([TIME_SYNC_CMD, cookie & 0x7F]))
+    reply = ser.read(TIME_SYNC_REPLY_SIZE)
+    t3 = host_us()
+    if len(reply) != TIME_SYNC_REPLY_SIZE or reply[0] != TIME_SYNC_CMD or reply[1] != cookie & 0x7F:
+        return None
+    rx = decode_u32(reply[2:7])
+    tx = decode_u32(reply[7:12])
+    if clock.ref_device is None:
+        clock.ref_device = rx
+    rx = clock.unwrap(rx)
+    tx = clock.unwrap(tx)
+    offset = ((rx - t0) + (tx - t3)) / 2
+    rtt = (t3 - t0) - (tx - rx)
+    return (t0 + t3) / 2, offset, rtt
+
+def schedule_set(ser, apply_at_us, start_idx, values):
+    payload = [SCHEDULE_CMD, start_idx, len(values)]
+    payload += [(apply_at_us >> (7 * i)) & 0x7F for i in range(5)]
+    for v in values:
+        payload += encode_value(v)
+    ser.write(bytes(payload))
+
+def read_snapshot(ser):
+    ser.write(bytes([SNAPSHOT_CMD]))
+    header = ser.read(SNAPSHOT_HEADER_SIZE)
+    if len(header) != SNAPSHOT_HEADER_SIZE or header[0] != SNAPSHOT_CMD:
+        return None
+    count = header[1]
+    body = ser.read(2 * count)
+    if len(body) != 2 * count:
+        return None
+    return decode_u32(header[2:7]), [decode_value(body[2 * i], body[2 * i + 1]) for i in range(count)]
+
+def get_registers(ser, start_idx, count):
+    ser.reset_input_buffer()
+    ser.write(bytes([GET_CMD, start_idx, count]))
+    response = ser.read(3 + 2 * count)
+    if len(response) != 3 + 2 * count:
+        return None
+    return [decode_value(response[3 + 2 * i], response[4 + 2 * i]) for i in range(count)]
+
+def main():
+    parser = argparse.ArgumentParser(description='Clock sync and scheduled SET test for Servo 2040')
+    parser.add_argument('--port', default=PORT, help=f'Serial port (default: {PORT})')
+    parser.add_argument('--samples', type=int, default=64, help='Number of time sync exchanges (default: 64)')
+    parser.add_argument('--moves', type=int, default=8, help='Number of scheduled moves (default: 8)')
+    parser.add_argument('--spacing', type=int, default=150, help='Time between scheduled moves in ms (default: 150)')
+    args = parser.parse_args()
+
+    try:
+        print(f"Trying to connect to {args.port}...")
+        ser = serial.Serial(args.port, BAUD_RATE, timeout=1.0)
+        print("Connected!")
+        time.sleep(1)
+        ser.reset_input_buffer()
+
+        # NTP style exchanges spread over about a second so drift is visible
+        clock = DeviceClock()
+        samples = []
+        for i in range(args.samples):
+            sample = time_sync(ser, clock, i)
+            if sample:
+                samples.append(sample)
+            time.sleep(1.0 / args.samples)
+        if len(samples) < 2:
+            print("Not enough time sync replies")
+            sys.exit(1)
+        best = clock.fit(samples)
+        rtts = sorted(s[2] for s in samples)
+        residual = max(abs(s[1] - (clock.offset + clock.drift * s[0])) for s in best)
+        print(f"{len(samples)}/{args.samples} exchanges, round trip min/median/max: "
+              f"{rtts[0]:.0f}/{rtts[len(rtts) // 2]:.0f}/{rtts[-1]:.0f} us")
+        print(f"Offset model: drift {clock.drift * 1e6:+.1f} ppm, fit residual {residual:.0f} us")
+
+        # Moves are sent in shuffled order, the device applies them by time
+        base = clock.to_device(host_us()) + 300000
+        first = random.randrange(1000, 1100)
+        moves = [(base + k * args.spacing * 1000, first + (k % 2) * 1000 + k * 10) for k in range(args.moves)]
+        for apply_at, pulse in random.sample(moves, len(moves)):
+            schedule_set(ser, apply_at, 0, [pulse])
+
+        # Earliest device timestamp at which each scheduled value is visible
+        pulses = {pulse for _, pulse in moves}
+        seen = {}
+        deadline = time.time() + 0.5 + args.moves * args.spacing / 1000
+        while time.time() < deadline and len(seen) < len(moves):
+            snapshot = read_snapshot(ser)
+            if snapshot and snapshot[1][0] in pulses and snapshot[1][0] not in seen:
+                seen[snapshot[1][0]] = snapshot[0]
+
+        errors = []
+        for apply_at, pulse in moves:
+            if pulse in seen:
+                errors.append(((seen[pulse] - apply_at + 0x80000000) & 0xFFFFFFFF) - 0x80000000)
+        early = sum(1 for e in errors if e < 0)
+        order = [seen[pulse] for _, pulse in moves if pulse in seen]
+        in_order = all(((b - a) & 0xFFFFFFFF) < 0x80000000 for a, b in zip(order, order[1:]))
+        print(f"Observed {len(errors)}/{len(moves)} scheduled moves, applied in time order: {in_order}")
+        if errors:
+            print(f"Applied after scheduled time min/mean/max: {min(errors) / 1000:.1f}/"
+                  f"{sum(errors) / len(errors) / 1000:.1f}/{max(errors) / 1000:.1f} ms "
+                  f"(control tick {CONTROL_TICK_US / 1000:.0f} ms), {early} early")
+
+        stats = get_registers(ser, SCHEDULE_STATS_IDX, 4)
+        if stats:
+            print(f"Device counters: pending={stats[0]}, applied={stats[1]}, late={stats[2]}, overflow={stats[3]}")
+        ser.close()
+    except serial.SerialException as e:
+        print(f"Serial error: {e}")
+        sys.exit(1)
+    except KeyboardInterrupt:
+        print("\nTest stopped by user")
+
+if __name__ == "__main__":
+    main()
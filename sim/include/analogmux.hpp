@@ -0,0 +1,19 @@
+#pragma once
+
+// Host simülasyonu: pimoroni-pico AnalogMux; seçili adres ADC modelini yönlendirir
+
+#include "pico/stdlib.h"
+#include "common/pimoroni_common.hpp"
+
+namespace pimoroni {
+    class AnalogMux {
+    public:
+        AnalogMux(uint addr0_pin, uint addr1_pin = PIN_UNUSED, uint addr2_pin = PIN_UNUSED,
+                  uint en_pin = PIN_UNUSED, uint muxed_pin = PIN_UNUSED);
+        
+        void select(uint8_t address);
+        void disable();
+        void configure_pulls(uint8_t address, bool pullup, bool pulldown);
+        bool read();
+    };
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+// Host simülasyonu: pimoroni-pico "common/pimoroni_common.hpp" alt kümesi
+
+#include <cstdint>
+#include <climits>
+
+namespace pimoroni {
+    constexpr unsigned int PIN_UNUSED = INT_MAX;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// Host simülasyonu: ADC okumaları sim_adc.cpp'deki kanal modelinden gelir
+
+#include <cstdint>
+
+typedef unsigned int uint;
+
+typedef struct {
+    volatile uint32_t cs;
+    volatile uint32_t result;
+    volatile uint32_t fcs;
+    volatile uint32_t fifo;
+    volatile uint32_t div;
+} adc_hw_t;
+
+extern adc_hw_t* const adc_hw;
+
+void adc_init();
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint16_t adc_read();
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_run(bool run);
+void adc_fifo_drain();
@@ -0,0 +1,40 @@
+#pragma once
+
+// Host simülasyonu: 30 GPIO pininin durumu bellekte tutulur
+
+#include <cstdint>
+
+typedef unsigned int uint;
+
+enum {
+    GPIO_IN = 0,
+    GPIO_OUT = 1
+};
+
+enum gpio_irq_level {
+    GPIO_IRQ_LEVEL_LOW = 0x1u,
+    GPIO_IRQ_LEVEL_HIGH = 0x2u,
+    GPIO_IRQ_EDGE_FALL = 0x4u,
+    GPIO_IRQ_EDGE_RISE = 0x8u
+};
+
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+
+void gpio_init(uint gpio);
+void gpio_init_mask(uint32_t mask);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_set_dir_masked(uint32_t mask, uint32_t value);
+bool gpio_get_dir(uint gpio);
+void gpio_put(uint gpio, bool value);
+void gpio_put_masked(uint32_t mask, uint32_t value);
+void gpio_set_mask(uint32_t mask);
+void gpio_clr_mask(uint32_t mask);
+bool gpio_get(uint gpio);
+uint32_t gpio_get_all();
+void gpio_set_pulls(uint gpio, bool up, bool down);
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled);
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback);
+
+static inline void gpio_pull_up(uint gpio) { gpio_set_pulls(gpio, true, false); }
+static inline void gpio_pull_down(uint gpio) { gpio_set_pulls(gpio, false, true); }
+static inline void gpio_disable_pulls(uint gpio) { gpio_set_pulls(gpio, false, false); }
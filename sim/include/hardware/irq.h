@@ -0,0 +1,3 @@
+#pragma once
+
+// Host simülasyonu: kesme denetleyicisi yoktur
@@ -0,0 +1,12 @@
+#pragma once
+
+// Host simülasyonu: PIO blokları sadece kimlik olarak kullanılır
+
+typedef struct pio_hw {
+    int index;
+} pio_hw_t;
+
+typedef pio_hw_t* PIO;
+
+extern PIO const pio0;
+extern PIO const pio1;
@@ -0,0 +1,32 @@
+#pragma once
+
+// Host simülasyonu: bariyer ve uyku komutları
+
+#include <atomic>
+#include <cstdint>
+
+static inline void __dmb() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Olay bekler; simülasyonda __sev() veya kısa bir zaman aşımı ile uyanır
+ */
+void __wfe();
+
+/**
+ * @brief Kesme bekler; simülasyonda __wfe() ile aynı davranır
+ */
+void __wfi();
+
+/**
+ * @brief Bekleyen çekirdekleri uyandırır
+ */
+void __sev();
+
+// Simülasyonda kesme yoktur; kritik bölgeler korumasız çalışır
+static inline uint32_t save_and_disable_interrupts() {
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t) {}
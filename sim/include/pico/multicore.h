@@ -0,0 +1,15 @@
+#pragma once
+
+// Host simülasyonu: core1 bir std::thread olarak çalışır
+
+#include <cstdint>
+
+/**
+ * @brief core1'i verilen giriş fonksiyonuyla başlatır
+ */
+void multicore_launch_core1(void (*entry)(void));
+
+/**
+ * @brief Çağıran iş parçacığının "çekirdek" numarası (0 veya 1)
+ */
+uint32_t get_core_num();
@@ -0,0 +1,3 @@
+#pragma once
+
+// Host simülasyonu: USB stdio kullanılmaz, CDC doğrudan tusb.h üzerinden simüle edilir
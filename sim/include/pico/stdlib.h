@@ -0,0 +1,19 @@
+#pragma once
+
+// Host simülasyonu: pico-sdk "pico/stdlib.h" yerine geçer
+
+#include <cstdint>
+#include <cstddef>
+#include "pico/time.h"
+
+typedef unsigned int uint;
+
+/**
+ * @brief stdio'yu başlatır (simülasyonda stdout zaten hazır)
+ */
+bool stdio_init_all();
+
+/**
+ * @brief Meşgul bekleme döngülerinde çağrılır
+ */
+static inline void tight_loop_contents() {}
@@ -0,0 +1,40 @@
+#pragma once
+
+// Host simülasyonu: pico-sdk "pico/time.h" yerine geçer (monotonik saat)
+
+#include <cstdint>
+
+typedef uint64_t absolute_time_t;
+
+/**
+ * @brief Simülasyon başlangıcından beri geçen süre (μs)
+ * 
+ * Meşgul döngüler tek işlemcili hostlarda diğer "çekirdeği" aç bırakmasın
+ * diye her çağrıda işlemci bırakılır.
+ */
+uint64_t time_us_64();
+uint32_t time_us_32();
+absolute_time_t get_absolute_time();
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+static inline absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+
+/**
+ * @brief Olay veya zaman aşımına kadar bekler
+ * 
+ * Simülasyonda USB kesmesi yoktur (pty tud_task içinde yoklanır), bu yüzden
+ * bekleme __wfe() gibi en fazla kısa bir süre sürer.
+ * 
+ * @param timeout_timestamp Uyanma zamanı
+ * @return true Zaman aşımına ulaşıldı
+ * @return false Bir olayla erken uyanıldı
+ */
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp);
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
@@ -0,0 +1,62 @@
+#pragma once
+
+// Host simülasyonu: pimoroni-pico ServoCluster; yüklenen her darbe zaman damgasıyla kaydedilir
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+namespace servo {
+    enum CalibrationType {
+        ANGULAR,
+        LINEAR,
+        CONTINUOUS
+    };
+    
+    class ServoState {
+    public:
+        static constexpr float DEFAULT_FREQUENCY = 50.0f;
+        static constexpr float DEFAULT_MID_PULSE = 1500.0f;
+    };
+    
+    class ServoCluster {
+    public:
+        static constexpr uint MAX_SERVOS = 30;
+        
+        ServoCluster(PIO pio, uint sm, uint pin_base, uint pin_count, CalibrationType default_type = ANGULAR,
+                     float freq = ServoState::DEFAULT_FREQUENCY, bool auto_phase = true,
+                     void* seq_buffer = nullptr, void* dat_buffer = nullptr);
+        
+        bool init();
+        uint8_t count() const;
+        
+        void enable(const uint8_t servo, bool load = true);
+        void enable_all(bool load = true);
+        void disable(const uint8_t servo, bool load = true);
+        void disable_all(bool load = true);
+        bool is_enabled(const uint8_t servo) const;
+        
+        float pulse(const uint8_t servo) const;
+        void pulse(const uint8_t servo, float pulse, bool load = true);
+        void all_to_pulse(float pulse, bool load = true);
+        
+        float frequency() const;
+        bool frequency(float freq);
+        
+        float phase(const uint8_t servo) const;
+        void phase(const uint8_t servo, float phase, bool load = true);
+        
+        /**
+         * @brief Bekleyen değişiklikleri "PWM'e yükler" ve değişen kanalları kaydeder
+         */
+        void load();
+        
+    private:
+        uint _pin_base;
+        uint _pin_count;
+        float _freq;
+        float _pulses[MAX_SERVOS];       // Ayarlanan (bekleyen) darbeler
+        float _applied[MAX_SERVOS];      // Son yüklenen darbeler (devre dışıysa 0)
+        float _phases[MAX_SERVOS];
+        bool _enabled[MAX_SERVOS];
+    };
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// Host simülasyonu: TinyUSB CDC, /dev/ttyACM0 yerine bir sözde terminal (pty) üzerinden sunulur
+
+#include <cstdint>
+
+/**
+ * @brief pty'yi açar; SERVO2040_SIM_PORT verilmişse bu yola sembolik bağ oluşturur
+ */
+bool tusb_init();
+
+/**
+ * @brief pty'den gelen veriyi RX FIFO'ya alır ve bağlantı durumunu günceller
+ */
+void tud_task();
+
+bool tud_mounted();
+bool tud_cdc_connected();
+uint32_t tud_cdc_available();
+uint32_t tud_cdc_read(void* buffer, uint32_t bufsize);
+void tud_cdc_read_flush();
+uint32_t tud_cdc_write(const void* buffer, uint32_t bufsize);
+uint32_t tud_cdc_write_flush();
+uint32_t tud_cdc_write_available();
+
+// Uygulama tarafından tanımlanır, yeni veri geldiğinde tud_task() içinden çağrılır
+extern "C" void tud_cdc_rx_cb(uint8_t itf);
@@ -0,0 +1,30 @@
+#pragma once
+
+// Host simülasyonu: pimoroni-pico plasma::WS2812; LED renkleri bellekte tutulup kaydedilir
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+namespace plasma {
+    class WS2812 {
+    public:
+        static constexpr uint MAX_LEDS = 64;
+        static constexpr uint DEFAULT_SERIAL_FREQ = 800000;
+        
+        WS2812(uint num_leds, PIO pio, uint sm, uint pin, uint freq = DEFAULT_SERIAL_FREQ);
+        
+        bool start(uint fps = 60);
+        bool stop();
+        void update(bool blocking = false);
+        void clear();
+        void set_rgb(uint32_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0, bool gamma = true);
+        void set_hsv(uint32_t index, float h, float s = 1.0f, float v = 1.0f, uint8_t w = 0, bool gamma = true);
+        void set_brightness(uint8_t brightness);
+        
+    private:
+        uint _num_leds;
+        uint32_t _pending[MAX_LEDS];   // Ayarlanan renkler (0xRRGGBB)
+        uint32_t _shown[MAX_LEDS];     // Son gönderilen renkler
+        uint _fps;                     // 0 değilse her ayar hemen gönderilir (otomatik güncelleme)
+    };
+}
@@ -0,0 +1,274 @@
+#include "sim_model.hpp"
+#include "servo_cluster.hpp"
+#include "ws2812.hpp"
+#include "analogmux.hpp"
+#include "hardware/gpio.h"
+
+#include <cmath>
+#include <cstdlib>
+
+// Pimoroni sürücülerinin (ServoCluster, WS2812, AnalogMux) simülasyonu
+
+namespace servo {
+    ServoCluster::ServoCluster(PIO pio, uint sm, uint pin_base, uint pin_count, CalibrationType default_type,
+                               float freq, bool auto_phase, void* seq_buffer, void* dat_buffer) :
+        _pin_base(pin_base),
+        _pin_count(pin_count < MAX_SERVOS ? pin_count : MAX_SERVOS),
+        _freq(freq) {
+        (void)pio;
+        (void)sm;
+        (void)default_type;
+        (void)seq_buffer;
+        (void)dat_buffer;
+        
+        for (uint i = 0; i < MAX_SERVOS; i++) {
+            _pulses[i] = 0.0f;
+            _applied[i] = 0.0f;
+            _phases[i] = auto_phase ? (float)i / (float)_pin_count : 0.0f;
+            _enabled[i] = false;
+        }
+    }
+    
+    bool ServoCluster::init() {
+        return true;
+    }
+    
+    uint8_t ServoCluster::count() const {
+        return (uint8_t)_pin_count;
+    }
+    
+    void ServoCluster::enable(const uint8_t servo, bool load) {
+        if (servo >= _pin_count) {
+            return;
+        }
+        // Daha önce değer verilmemiş servo orta konumla başlar
+        if (_pulses[servo] == 0.0f) {
+            _pulses[servo] = ServoState::DEFAULT_MID_PULSE;
+        }
+        _enabled[servo] = true;
+        if (load) {
+            this->load();
+        }
+    }
+    
+    void ServoCluster::enable_all(bool load) {
+        for (uint8_t i = 0; i < _pin_count; i++) {
+            enable(i, false);
+        }
+        if (load) {
+            this->load();
+        }
+    }
+    
+    void ServoCluster::disable(const uint8_t servo, bool load) {
+        if (servo >= _pin_count) {
+            return;
+        }
+        _enabled[servo] = false;
+        if (load) {
+            this->load();
+        }
+    }
+    
+    void ServoCluster::disable_all(bool load) {
+        for (uint8_t i = 0; i < _pin_count; i++) {
+            disable(i, false);
+        }
+        if (load) {
+            this->load();
+        }
+    }
+    
+    bool ServoCluster::is_enabled(const uint8_t servo) const {
+        return (servo < _pin_count) && _enabled[servo];
+    }
+    
+    float ServoCluster::pulse(const uint8_t servo) const {
+        return (servo < _pin_count) ? _pulses[servo] : 0.0f;
+    }
+    
+    void ServoCluster::pulse(const uint8_t servo, float pulse, bool load) {
+        if (servo >= _pin_count) {
+            return;
+        }
+        _pulses[servo] = pulse;
+        _enabled[servo] = true;
+        if (load) {
+            this->load();
+        }
+    }
+    
+    void ServoCluster::all_to_pulse(float pulse, bool load) {
+        for (uint8_t i = 0; i < _pin_count; i++) {
+            this->pulse(i, pulse, false);
+        }
+        if (load) {
+            this->load();
+        }
+    }
+    
+    float ServoCluster::frequency() const {
+        return _freq;
+    }
+    
+    bool ServoCluster::frequency(float freq) {
+        if (freq <= 0.0f) {
+            return false;
+        }
+        _freq = freq;
+        return true;
+    }
+    
+    float ServoCluster::phase(const uint8_t servo) const {
+        return (servo < _pin_count) ? _phases[servo] : 0.0f;
+    }
+    
+    void ServoCluster::phase(const uint8_t servo, float phase, bool load) {
+        if (servo >= _pin_count) {
+            return;
+        }
+        _phases[servo] = phase;
+        if (load) {
+            this->load();
+        }
+    }
+    
+    void ServoCluster::load() {
+        uint32_t totalDelta = 0;
+        bool changed = false;
+        
+        for (uint i = 0; i < _pin_count; i++) {
+            float target = _enabled[i] ? _pulses[i] : 0.0f;
+            if (target == _applied[i]) {
+                continue;
+            }
+            
+            if (target != 0.0f && _applied[i] != 0.0f) {
+                totalDelta += (uint32_t)std::fabs(target - _applied[i]);
+            }
+            _applied[i] = target;
+            sim::trace(sim::TraceKind::PWM, _pin_base + i, (uint32_t)std::lround(target));
+            changed = true;
+        }
+        
+        if (changed) {
+            sim::servoLoadEvent(totalDelta);
+            sim::traceFlush();
+        }
+    }
+}
+
+namespace plasma {
+    WS2812::WS2812(uint num_leds, PIO pio, uint sm, uint pin, uint freq) :
+        _num_leds(num_leds < MAX_LEDS ? num_leds : MAX_LEDS),
+        _fps(0) {
+        (void)pio;
+        (void)sm;
+        (void)pin;
+        (void)freq;
+        
+        for (uint i = 0; i < MAX_LEDS; i++) {
+            _pending[i] = 0;
+            _shown[i] = 0;
+        }
+    }
+    
+    bool WS2812::start(uint fps) {
+        _fps = fps;
+        update();
+        return true;
+    }
+    
+    bool WS2812::stop() {
+        _fps = 0;
+        return true;
+    }
+    
+    void WS2812::update(bool blocking) {
+        (void)blocking;
+        bool changed = false;
+        for (uint i = 0; i < _num_leds; i++) {
+            if (_pending[i] != _shown[i]) {
+                _shown[i] = _pending[i];
+                sim::trace(sim::TraceKind::LED, i, _shown[i]);
+                changed = true;
+            }
+        }
+        if (changed) {
+            sim::traceFlush();
+        }
+    }
+    
+    void WS2812::clear() {
+        for (uint i = 0; i < _num_leds; i++) {
+            _pending[i] = 0;
+        }
+        if (_fps != 0) {
+            update();
+        }
+    }
+    
+    void WS2812::set_rgb(uint32_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w, bool gamma) {
+        (void)w;
+        (void)gamma;
+        if (index >= _num_leds) {
+            return;
+        }
+        _pending[index] = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+        
+        // Donanımda start() sonrası DMA sürekli gönderir; simülasyonda değişiklik hemen yansır
+        if (_fps != 0) {
+            update();
+        }
+    }
+    
+    void WS2812::set_hsv(uint32_t index, float h, float s, float v, uint8_t w, bool gamma) {
+        float i = std::floor(h * 6.0f);
+        float f = h * 6.0f - i;
+        v *= 255.0f;
+        uint8_t p = (uint8_t)(v * (1.0f - s));
+        uint8_t q = (uint8_t)(v * (1.0f - f * s));
+        uint8_t t = (uint8_t)(v * (1.0f - (1.0f - f) * s));
+        uint8_t vv = (uint8_t)v;
+        
+        switch (((int)i % 6 + 6) % 6) {
+            case 0: set_rgb(index, vv, t, p, w, gamma); break;
+            case 1: set_rgb(index, q, vv, p, w, gamma); break;
+            case 2: set_rgb(index, p, vv, t, w, gamma); break;
+            case 3: set_rgb(index, p, q, vv, w, gamma); break;
+            case 4: set_rgb(index, t, p, vv, w, gamma); break;
+            default: set_rgb(index, vv, p, q, w, gamma); break;
+        }
+    }
+    
+    void WS2812::set_brightness(uint8_t brightness) {
+        (void)brightness;
+    }
+}
+
+namespace pimoroni {
+    AnalogMux::AnalogMux(uint addr0_pin, uint addr1_pin, uint addr2_pin, uint en_pin, uint muxed_pin) {
+        (void)addr0_pin;
+        (void)addr1_pin;
+        (void)addr2_pin;
+        (void)en_pin;
+        (void)muxed_pin;
+    }
+    
+    void AnalogMux::select(uint8_t address) {
+        sim::setMuxAddress(address);
+    }
+    
+    void AnalogMux::disable() {
+    }
+    
+    void AnalogMux::configure_pulls(uint8_t address, bool pullup, bool pulldown) {
+        (void)address;
+        (void)pullup;
+        (void)pulldown;
+    }
+    
+    bool AnalogMux::read() {
+        return sim::adcSample(3) > 2048;
+    }
+}
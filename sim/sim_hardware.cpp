@@ -0,0 +1,508 @@
+#include "sim_model.hpp"
+#include "hardware/gpio.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
+#include "servo2040.hpp"
+#include "pico/time.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+// GPIO, ADC, DMA ve iz kaydı simülasyonu
+
+using namespace servo::servo2040;
+
+namespace {
+    constexpr uint NUM_GPIOS = 30;
+    constexpr uint NUM_DMA_CHANNELS = 12;
+    constexpr uint NUM_MUX_CHANNELS = 8;
+    constexpr float ADC_REF_VOLTAGE = 3.3f;
+    constexpr float ADC_MAX_COUNT = 4095.0f;
+    
+    // Varsayılan analog model: 2S LiPo, boşta 0.3 A
+    constexpr float DEFAULT_SUPPLY_VOLTAGE = 7.4f;
+    constexpr float DEFAULT_IDLE_CURRENT = 0.3f;
+    
+    // Hareket akımı: darbe değişimi başına tepe akım ve sönüm zaman sabiti
+    constexpr float CURRENT_PER_US = 0.002f;
+    constexpr float CURRENT_DECAY_US = 100000.0f;
+    
+    std::mutex g_traceMutex;
+    FILE* g_traceFile = nullptr;
+    bool g_traceOpened = false;
+    
+    std::atomic<uint32_t> g_gpioOut{0};
+    std::atomic<uint32_t> g_gpioDir{0};
+    std::atomic<uint32_t> g_gpioPullUp{0};
+    
+    // Dış bağlantılar (SERVO2040_SIM_GPIO): girişi başka bir pine bağlı veya sabit seviyede pinler
+    int g_gpioWire[NUM_GPIOS];
+    uint32_t g_gpioTiedMask = 0;
+    uint32_t g_gpioTiedLevel = 0;
+    bool g_gpioWiringReady = false;
+    
+    // Kenar kesmesi modeli: pin başına etkin kenarlar ve son görülen giriş seviyeleri
+    std::mutex g_irqMutex;
+    uint32_t g_irqEvents[NUM_GPIOS] = {};
+    gpio_irq_callback_t g_irqCallback = nullptr;
+    uint32_t g_lastLevels = 0;
+    
+    std::atomic<uint32_t> g_muxAddress{0};
+    uint32_t g_adcInput = 0;
+    
+    // Sabit kanal gerilimleri (V), SERVO2040_SIM_ADC ile değiştirilebilir
+    float g_muxVoltage[NUM_MUX_CHANNELS] = {};
+    float g_directVoltage[3] = {};
+    float g_supplyVoltage = DEFAULT_SUPPLY_VOLTAGE;
+    float g_idleCurrent = DEFAULT_IDLE_CURRENT;
+    bool g_modelReady = false;
+    
+    // Hareket akımı modeli (core1 yazar, her iki çekirdek okuyabilir)
+    std::mutex g_currentMutex;
+    float g_motionCurrent = 0.0f;
+    uint64_t g_motionTime = 0;
+    
+    uint32_t g_dmaClaimed = 0;
+    
+    adc_hw_t g_adcHw = {};
+    pio_hw_t g_pio0 = {0};
+    pio_hw_t g_pio1 = {1};
+    
+    /**
+     * @brief SERVO2040_SIM_ADC değişkenini ayrıştırır
+     * 
+     * Biçim: "V=7.4,I=0.5,T0=3.3,A1=1.2" (V: besleme, I: boşta akım,
+     * T0-T5: dokunmatik sensörler, A0-A2: doğrudan analog girişler)
+     */
+    void _loadModel() {
+        if (g_modelReady) {
+            return;
+        }
+        g_modelReady = true;
+        
+        const char* spec = std::getenv("SERVO2040_SIM_ADC");
+        if (spec == nullptr) {
+            return;
+        }
+        
+        std::string text(spec);
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = text.find(',', pos);
+            if (end == std::string::npos) {
+                end = text.size();
+            }
+            std::string item = text.substr(pos, end - pos);
+            pos = end + 1;
+            
+            size_t eq = item.find('=');
+            if (eq == std::string::npos || eq == 0) {
+                continue;
+            }
+            std::string key = item.substr(0, eq);
+            float value = std::strtof(item.c_str() + eq + 1, nullptr);
+            
+            if (key == "V") {
+                g_supplyVoltage = value;
+            } else if (key == "I") {
+                g_idleCurrent = value;
+            } else if (key.size() == 2 && key[0] == 'T' && key[1] >= '0' && key[1] < '0' + (char)NUM_SENSORS) {
+                g_muxVoltage[SENSOR_1_ADDR + (key[1] - '0')] = value;
+            } else if (key.size() == 2 && key[0] == 'A' && key[1] >= '0' && key[1] <= '2') {
+                g_directVoltage[key[1] - '0'] = value;
+            }
+        }
+    }
+    
+    float _motionCurrent() {
+        std::lock_guard<std::mutex> lock(g_currentMutex);
+        uint64_t now = sim::modelTime();
+        return g_motionCurrent * std::exp(-(float)(now - g_motionTime) / CURRENT_DECAY_US);
+    }
+    
+    float _muxChannelVoltage(uint32_t address) {
+        if (address == VOLTAGE_SENSE_ADDR) {
+            return g_supplyVoltage * VOLTAGE_GAIN;
+        }
+        if (address == CURRENT_SENSE_ADDR) {
+            float current = g_idleCurrent + _motionCurrent();
+            return (current - CURRENT_OFFSET) * SHUNT_RESISTOR * CURRENT_GAIN;
+        }
+        return g_muxVoltage[address];
+    }
+    
+    uint16_t _toCounts(float voltage) {
+        // ±2 LSB gürültü, filtrelerin gerçekçi veri görmesi için
+        int counts = (int)(voltage / ADC_REF_VOLTAGE * ADC_MAX_COUNT + 0.5f) + (std::rand() % 5) - 2;
+        if (counts < 0) {
+            counts = 0;
+        } else if (counts > (int)ADC_MAX_COUNT) {
+            counts = (int)ADC_MAX_COUNT;
+        }
+        return (uint16_t)counts;
+    }
+    
+    /**
+     * @brief SERVO2040_SIM_GPIO değişkenini ayrıştırır
+     * 
+     * Biçim: "A1=A0,A2=1" (A1 girişi A0 çıkışına bağlı, A2 girişi sabit
+     * yüksek). Bağlı pinler çıkış değil girişken bu seviyeyi okur.
+     */
+    void _loadGpioWiring() {
+        if (g_gpioWiringReady) {
+            return;
+        }
+        g_gpioWiringReady = true;
+        for (uint pin = 0; pin < NUM_GPIOS; pin++) {
+            g_gpioWire[pin] = -1;
+        }
+        
+        const char* spec = std::getenv("SERVO2040_SIM_GPIO");
+        if (spec == nullptr) {
+            return;
+        }
+        
+        std::string text(spec);
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = text.find(',', pos);
+            if (end == std::string::npos) {
+                end = text.size();
+            }
+            std::string item = text.substr(pos, end - pos);
+            pos = end + 1;
+            
+            // Anahtar ve kaynak A0-A2, değer 0 veya 1
+            if (item.size() < 4 || item[0] != 'A' || item[1] < '0' || item[1] > '2' || item[2] != '=') {
+                continue;
+            }
+            uint pin = ADC0 + (item[1] - '0');
+            std::string source = item.substr(3);
+            if (source.size() == 2 && source[0] == 'A' && source[1] >= '0' && source[1] <= '2') {
+                g_gpioWire[pin] = (int)(ADC0 + (source[1] - '0'));
+            } else if (source == "0" || source == "1") {
+                g_gpioTiedMask |= 1u << pin;
+                g_gpioTiedLevel |= (source == "1") ? (1u << pin) : 0;
+            }
+        }
+    }
+    
+    /**
+     * @brief Tüm pinlerin seviyesi: çıkışlar sürülen, girişler dış bağlantı veya pull seviyesi
+     */
+    uint32_t _pinLevels() {
+        _loadGpioWiring();
+        uint32_t dir = g_gpioDir.load();
+        uint32_t out = g_gpioOut.load();
+        uint32_t pullUp = g_gpioPullUp.load();
+        
+        uint32_t inputs = (pullUp & ~g_gpioTiedMask) | g_gpioTiedLevel;
+        for (uint pin = 0; pin < NUM_GPIOS; pin++) {
+            int source = g_gpioWire[pin];
+            if (source < 0 || !(dir & (1u << source))) {
+                continue;  // Bağlantı yok veya kaynak sürülmüyor: pull seviyesi
+            }
+            inputs = (inputs & ~(1u << pin)) | (((out >> source) & 1u) << pin);
+        }
+        return (out & dir) | (inputs & ~dir);
+    }
+    
+    /**
+     * @brief Seviyesi değişen girişler için etkin kenar kesmesini çağırır
+     * 
+     * Çıkış, yön veya pull değiştiren her çağrıdan sonra, değişikliği yapan
+     * iş parçacığında çalışır (donanımda kesme aynı çekirdekte hemen gelir).
+     */
+    void _checkEdges() {
+        std::lock_guard<std::mutex> lock(g_irqMutex);
+        uint32_t levels = _pinLevels();
+        uint32_t changed = (levels ^ g_lastLevels) & ~g_gpioDir.load();
+        g_lastLevels = levels;
+        if (changed == 0 || g_irqCallback == nullptr) {
+            return;
+        }
+        for (uint pin = 0; pin < NUM_GPIOS; pin++) {
+            if (!(changed & (1u << pin))) {
+                continue;
+            }
+            uint32_t event = (levels & (1u << pin)) ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+            if (g_irqEvents[pin] & event) {
+                g_irqCallback(pin, event);
+            }
+        }
+    }
+    
+    void _setOutputs(uint32_t mask, uint32_t value) {
+        uint32_t before = g_gpioOut.load();
+        uint32_t after = (before & ~mask) | (value & mask);
+        g_gpioOut.store(after);
+        
+        uint32_t changed = (before ^ after) & g_gpioDir.load();
+        if (changed == 0) {
+            return;
+        }
+        for (uint pin = 0; pin < NUM_GPIOS; pin++) {
+            if (changed & (1u << pin)) {
+                sim::trace(sim::TraceKind::GPIO, pin, (after >> pin) & 1u);
+            }
+        }
+        sim::traceFlush();
+        _checkEdges();
+    }
+}
+
+adc_hw_t* const adc_hw = &g_adcHw;
+PIO const pio0 = &g_pio0;
+PIO const pio1 = &g_pio1;
+
+namespace sim {
+    void trace(TraceKind kind, uint32_t index, uint32_t value) {
+        static const char* const KIND_NAMES[] = {"pwm", "led", "gpio"};
+        uint64_t now = modelTime();
+        
+        std::lock_guard<std::mutex> lock(g_traceMutex);
+        if (!g_traceOpened) {
+            g_traceOpened = true;
+            const char* path = std::getenv("SERVO2040_SIM_TRACE");
+            if (path != nullptr && path[0] != '\0') {
+                g_traceFile = std::fopen(path, "w");
+                if (g_traceFile != nullptr) {
+                    std::fprintf(g_traceFile, "time_us,kind,index,value\n");
+                } else {
+                    std::fprintf(stderr, "sim: cannot open trace file %s\n", path);
+                }
+            }
+        }
+        if (g_traceFile != nullptr) {
+            std::fprintf(g_traceFile, "%llu,%s,%u,%u\n", (unsigned long long)now,
+                         KIND_NAMES[(int)kind], (unsigned)index, (unsigned)value);
+        }
+    }
+    
+    void traceFlush() {
+        std::lock_guard<std::mutex> lock(g_traceMutex);
+        if (g_traceFile != nullptr) {
+            std::fflush(g_traceFile);
+        }
+    }
+    
+    void setMuxAddress(uint32_t address) {
+        g_muxAddress.store(address & (NUM_MUX_CHANNELS - 1));
+    }
+    
+    uint16_t adcSample(uint32_t input) {
+        _loadModel();
+        if (input == SHARED_ADC - ADC0) {
+            return _toCounts(_muxChannelVoltage(g_muxAddress.load()));
+        }
+        if (input < 3) {
+            return _toCounts(g_directVoltage[input]);
+        }
+        return _toCounts(0.7f);  // Dahili sıcaklık sensörü (~27 °C)
+    }
+    
+    void servoLoadEvent(uint32_t pulseDeltaUs) {
+        float current = _motionCurrent() + (float)pulseDeltaUs * CURRENT_PER_US;
+        
+        std::lock_guard<std::mutex> lock(g_currentMutex);
+        g_motionCurrent = current;
+        g_motionTime = sim::modelTime();
+    }
+}
+
+// --- GPIO ---
+
+void gpio_init(uint gpio) {
+    gpio_init_mask(1u << gpio);
+}
+
+void gpio_init_mask(uint32_t mask) {
+    g_gpioDir.fetch_and(~mask);
+    g_gpioOut.fetch_and(~mask);
+    _checkEdges();
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    gpio_set_dir_masked(1u << gpio, out ? (1u << gpio) : 0);
+}
+
+void gpio_set_dir_masked(uint32_t mask, uint32_t value) {
+    uint32_t dir = g_gpioDir.load();
+    g_gpioDir.store((dir & ~mask) | (value & mask));
+    _checkEdges();
+}
+
+bool gpio_get_dir(uint gpio) {
+    return (g_gpioDir.load() >> gpio) & 1u;
+}
+
+void gpio_put(uint gpio, bool value) {
+    _setOutputs(1u << gpio, value ? (1u << gpio) : 0);
+}
+
+void gpio_put_masked(uint32_t mask, uint32_t value) {
+    _setOutputs(mask, value);
+}
+
+void gpio_set_mask(uint32_t mask) {
+    _setOutputs(mask, mask);
+}
+
+void gpio_clr_mask(uint32_t mask) {
+    _setOutputs(mask, 0);
+}
+
+bool gpio_get(uint gpio) {
+    return (gpio_get_all() >> gpio) & 1u;
+}
+
+uint32_t gpio_get_all() {
+    // Çıkış pinleri sürülen seviyeyi, girişler dış bağlantıyı veya pull direncini okur
+    return _pinLevels();
+}
+
+void gpio_set_pulls(uint gpio, bool up, bool down) {
+    (void)down;
+    if (up) {
+        g_gpioPullUp.fetch_or(1u << gpio);
+    } else {
+        g_gpioPullUp.fetch_and(~(1u << gpio));
+    }
+    _checkEdges();
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled) {
+    if (gpio >= NUM_GPIOS) {
+        return;
+    }
+    
+    // SDK gibi: etkinleştirmeden önce bekleyen kenarlar silinir (son seviye yeniden örneklenir)
+    std::lock_guard<std::mutex> lock(g_irqMutex);
+    events &= GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL;
+    if (enabled) {
+        g_irqEvents[gpio] |= events;
+    } else {
+        g_irqEvents[gpio] &= ~events;
+    }
+    g_lastLevels = _pinLevels();
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback) {
+    {
+        std::lock_guard<std::mutex> lock(g_irqMutex);
+        g_irqCallback = callback;
+    }
+    gpio_set_irq_enabled(gpio, events, enabled);
+}
+
+// --- ADC ---
+
+void adc_init() {
+    _loadModel();
+}
+
+void adc_gpio_init(uint gpio) {
+    gpio_init(gpio);
+}
+
+void adc_select_input(uint input) {
+    g_adcInput = input;
+}
+
+uint16_t adc_read() {
+    return sim::adcSample(g_adcInput);
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    (void)en;
+    (void)dreq_en;
+    (void)dreq_thresh;
+    (void)err_in_fifo;
+    (void)byte_shift;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    (void)clkdiv;
+}
+
+void adc_run(bool run) {
+    (void)run;
+}
+
+void adc_fifo_drain() {
+}
+
+// --- DMA ---
+
+int dma_claim_unused_channel(bool required) {
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (!(g_dmaClaimed & (1u << ch))) {
+            g_dmaClaimed |= 1u << ch;
+            return (int)ch;
+        }
+    }
+    if (required) {
+        std::fprintf(stderr, "sim: no free DMA channel\n");
+        std::abort();
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    g_dmaClaimed &= ~(1u << channel);
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    return {DMA_SIZE_32};
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config* c, dma_channel_transfer_size size) {
+    c->ctrl = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config* c, bool incr) {
+    (void)c;
+    (void)incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config* c, bool incr) {
+    (void)c;
+    (void)incr;
+}
+
+void channel_config_set_dreq(dma_channel_config* c, uint dreq) {
+    (void)c;
+    (void)dreq;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config* config, volatile void* write_addr,
+                           const volatile void* read_addr, uint transfer_count, bool trigger) {
+    (void)channel;
+    if (!trigger) {
+        return;
+    }
+    
+    // ADC FIFO'dan okuyan aktarımlar anında tamamlanır; diğer kaynaklar desteklenmez
+    if (read_addr == &adc_hw->fifo && config->ctrl == DMA_SIZE_16) {
+        volatile uint16_t* out = (volatile uint16_t*)write_addr;
+        for (uint i = 0; i < transfer_count; i++) {
+            out[i] = sim::adcSample(g_adcInput);
+        }
+    }
+}
+
+bool dma_channel_is_busy(uint channel) {
+    (void)channel;
+    return false;
+}
+
+void dma_channel_abort(uint channel) {
+    (void)channel;
+}
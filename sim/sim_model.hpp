@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Simülasyon modeli: sahte donanım parçalarının paylaştığı durum
+ * 
+ * SDK ve Pimoroni sürücülerinin yerine geçen sim_*.cpp dosyaları birbirleriyle
+ * sadece bu arayüz üzerinden konuşur (ör. AnalogMux'un seçtiği adres ADC
+ * modelini, servo yükleri akım modelini etkiler).
+ */
+namespace sim {
+    /**
+     * @brief Açılıştan beri geçen süre (μs), model kodu için
+     * 
+     * time_us_64() meşgul bekleme döngüleri için her çağrıda işlemciyi
+     * bırakır; donanımda anında biten model işlemleri (ör. DMA ile ADC
+     * örneği) bunu kullanır, aksi halde tek işlemcili hostta diğer
+     * çekirdeğin zaman dilimi çağıran görevin süresine eklenirdi.
+     */
+    uint64_t modelTime();
+    
+    /**
+     * @brief İz kaydı türleri (CSV "kind" sütunu)
+     */
+    enum class TraceKind {
+        PWM,    // Servo darbe genişliği (μs, devre dışıysa 0)
+        LED,    // LED rengi (0xRRGGBB)
+        GPIO    // GPIO çıkış seviyesi
+    };
+    
+    /**
+     * @brief Bir donanım değişikliğini zaman damgasıyla iz dosyasına yazar
+     * 
+     * İz dosyası SERVO2040_SIM_TRACE ortam değişkeniyle seçilir; verilmemişse
+     * kayıt yapılmaz. Her iki çekirdekten de çağrılabilir.
+     * 
+     * @param kind Kayıt türü
+     * @param index Kanal indeksi (servo, LED veya GPIO numarası)
+     * @param value Uygulanan değer
+     */
+    void trace(TraceKind kind, uint32_t index, uint32_t value);
+    
+    /**
+     * @brief Bekleyen iz kayıtlarını dosyaya yazar
+     */
+    void traceFlush();
+    
+    /**
+     * @brief AnalogMux tarafından seçilen adres (0-7)
+     */
+    void setMuxAddress(uint32_t address);
+    
+    /**
+     * @brief ADC girişinin o anki ham değeri (12-bit)
+     * 
+     * @param input ADC girişi (0-3, 3 = paylaşılan mux girişi)
+     * @return uint16_t Ham ADC değeri
+     */
+    uint16_t adcSample(uint32_t input);
+    
+    /**
+     * @brief Servo yükünden kaynaklanan akımı modele bildirir
+     * 
+     * @param pulseDeltaUs Bir yüklemede tüm servoların toplam darbe değişimi (μs)
+     */
+    void servoLoadEvent(uint32_t pulseDeltaUs);
+}
@@ -0,0 +1,99 @@
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#include "sim_model.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Zaman, çoklu çekirdek ve olay bekleme simülasyonu
+
+namespace {
+    const std::chrono::steady_clock::time_point g_boot = std::chrono::steady_clock::now();
+    
+    thread_local uint32_t t_coreNum = 0;
+    
+    // Donanımdaki gibi her çekirdeğin kendi olay bayrağı vardır, __sev() ikisini de kurar
+    std::mutex g_eventMutex;
+    std::condition_variable g_eventCond;
+    bool g_eventPending[2] = {false, false};
+    
+    // Olay gelmezse __wfe() en fazla bu kadar bekler (donanımda zamanlayıcı kesmesi uyandırır)
+    constexpr auto WFE_TIMEOUT = std::chrono::microseconds(100);
+}
+
+bool stdio_init_all() {
+    return true;
+}
+
+uint64_t sim::modelTime() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - g_boot).count();
+}
+
+uint64_t time_us_64() {
+    // Meşgul bekleme döngüleri tek işlemcili hostlarda diğer çekirdeği aç bırakmasın
+    std::this_thread::yield();
+    return sim::modelTime();
+}
+
+uint32_t time_us_32() {
+    return (uint32_t)time_us_64();
+}
+
+absolute_time_t get_absolute_time() {
+    return time_us_64();
+}
+
+void sleep_us(uint64_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void sleep_ms(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    std::thread([entry]() {
+        t_coreNum = 1;
+        entry();
+    }).detach();
+}
+
+uint32_t get_core_num() {
+    return t_coreNum;
+}
+
+void __wfe() {
+    best_effort_wfe_or_timeout(time_us_64() + WFE_TIMEOUT.count());
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp) {
+    uint64_t now = time_us_64();
+    uint64_t wait = (timeout_timestamp > now) ? timeout_timestamp - now : 0;
+    if (wait > (uint64_t)WFE_TIMEOUT.count()) {
+        wait = WFE_TIMEOUT.count();
+    }
+    
+    bool& pending = g_eventPending[t_coreNum];
+    std::unique_lock<std::mutex> lock(g_eventMutex);
+    g_eventCond.wait_for(lock, std::chrono::microseconds(wait), [&pending] { return pending; });
+    pending = false;
+    lock.unlock();
+    return time_us_64() >= timeout_timestamp;
+}
+
+void __wfi() {
+    __wfe();
+}
+
+void __sev() {
+    {
+        std::lock_guard<std::mutex> lock(g_eventMutex);
+        g_eventPending[0] = true;
+        g_eventPending[1] = true;
+    }
+    g_eventCond.notify_all();
+}
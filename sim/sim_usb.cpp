@@ -0,0 +1,185 @@
+#include "tusb.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+// TinyUSB CDC simülasyonu: cihaz tarafı bir pty master'ıdır, test betikleri
+// slave tarafını /dev/ttyACM0 yerine açar
+
+namespace {
+    // TinyUSB CDC FIFO boyutları ve tam hız paket boyutu (tusb_config.h ile aynı)
+    constexpr uint32_t RX_FIFO_SIZE = 512;
+    constexpr uint32_t TX_FIFO_SIZE = 512;
+    constexpr uint32_t PACKET_SIZE = 64;
+    
+    constexpr const char* DEFAULT_PORT_LINK = "/tmp/ttyServo2040";
+    
+    int g_master = -1;
+    bool g_connected = false;
+    
+    uint8_t g_rxFifo[RX_FIFO_SIZE];
+    uint32_t g_rxHead = 0;   // Okunacak ilk bayt
+    uint32_t g_rxCount = 0;
+    
+    uint8_t g_txFifo[TX_FIFO_SIZE];
+    uint32_t g_txCount = 0;
+    
+    /**
+     * @brief Slave tarafını ham moda alır (yankı ve satır düzenleme kapalı)
+     */
+    void _configureSlave(const char* slaveName) {
+        int slave = open(slaveName, O_RDWR | O_NOCTTY);
+        if (slave < 0) {
+            return;
+        }
+        struct termios tio;
+        if (tcgetattr(slave, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(slave, TCSANOW, &tio);
+        }
+        // Kapatmak master'da EIO durumunu başlatır: istemci açana kadar bağlı değil
+        close(slave);
+    }
+    
+    /**
+     * @brief pty'den okuyabildiği kadar veriyi RX FIFO'ya alır
+     * 
+     * @return true Yeni veri geldi
+     */
+    bool _pollRx() {
+        bool received = false;
+        while (g_rxCount < RX_FIFO_SIZE) {
+            uint32_t tail = (g_rxHead + g_rxCount) % RX_FIFO_SIZE;
+            uint32_t space = RX_FIFO_SIZE - g_rxCount;
+            uint32_t contiguous = RX_FIFO_SIZE - tail;
+            ssize_t n = read(g_master, &g_rxFifo[tail], space < contiguous ? space : contiguous);
+            
+            if (n > 0) {
+                g_connected = true;
+                g_rxCount += (uint32_t)n;
+                received = true;
+                continue;
+            }
+            if (n < 0 && errno == EAGAIN) {
+                g_connected = true;   // Slave açık, veri yok
+            } else if (n < 0 && errno == EIO) {
+                g_connected = false;  // Slave kapalı
+            }
+            break;
+        }
+        return received;
+    }
+}
+
+bool tusb_init() {
+    g_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (g_master < 0 || grantpt(g_master) != 0 || unlockpt(g_master) != 0) {
+        std::perror("sim: posix_openpt");
+        std::exit(1);
+    }
+    fcntl(g_master, F_SETFL, fcntl(g_master, F_GETFL) | O_NONBLOCK);
+    
+    const char* slaveName = ptsname(g_master);
+    _configureSlave(slaveName);
+    
+    const char* link = std::getenv("SERVO2040_SIM_PORT");
+    if (link == nullptr || link[0] == '\0') {
+        link = DEFAULT_PORT_LINK;
+    }
+    unlink(link);
+    if (symlink(slaveName, link) == 0) {
+        std::printf("sim: CDC port %s -> %s\n", link, slaveName);
+    } else {
+        std::printf("sim: CDC port %s (symlink %s failed)\n", slaveName, link);
+    }
+    std::fflush(stdout);
+    return true;
+}
+
+void tud_task() {
+    if (g_master < 0) {
+        return;
+    }
+    
+    bool received = _pollRx();
+    
+    // Bağlantı koptuysa bekleyen veri kimseye ulaşmaz (USB'de de host'ta kalmaz)
+    if (!g_connected) {
+        g_txCount = 0;
+    } else if (g_txCount > 0) {
+        tud_cdc_write_flush();
+    }
+    
+    if (received) {
+        tud_cdc_rx_cb(0);
+    }
+}
+
+bool tud_mounted() {
+    return g_master >= 0;
+}
+
+bool tud_cdc_connected() {
+    return g_connected;
+}
+
+uint32_t tud_cdc_available() {
+    return g_rxCount;
+}
+
+uint32_t tud_cdc_read(void* buffer, uint32_t bufsize) {
+    uint8_t* out = (uint8_t*)buffer;
+    uint32_t count = 0;
+    while (count < bufsize && g_rxCount > 0) {
+        out[count++] = g_rxFifo[g_rxHead];
+        g_rxHead = (g_rxHead + 1) % RX_FIFO_SIZE;
+        g_rxCount--;
+    }
+    return count;
+}
+
+void tud_cdc_read_flush() {
+    g_rxHead = 0;
+    g_rxCount = 0;
+}
+
+uint32_t tud_cdc_write(const void* buffer, uint32_t bufsize) {
+    if (!g_connected) {
+        return 0;
+    }
+    
+    uint32_t space = TX_FIFO_SIZE - g_txCount;
+    uint32_t count = bufsize < space ? bufsize : space;
+    std::memcpy(&g_txFifo[g_txCount], buffer, count);
+    g_txCount += count;
+    
+    // TinyUSB gibi: bir paket dolduğunda kendiliğinden gönder
+    if (g_txCount >= PACKET_SIZE) {
+        tud_cdc_write_flush();
+    }
+    return count;
+}
+
+uint32_t tud_cdc_write_flush() {
+    if (g_master < 0 || g_txCount == 0) {
+        return 0;
+    }
+    
+    ssize_t n = write(g_master, g_txFifo, g_txCount);
+    if (n <= 0) {
+        return 0;  // pty tamponu dolu, sonraki tud_task() tekrar dener
+    }
+    
+    g_txCount -= (uint32_t)n;
+    std::memmove(g_txFifo, &g_txFifo[n], g_txCount);
+    return (uint32_t)n;
+}
+
+uint32_t tud_cdc_write_available() {
+    return TX_FIFO_SIZE - g_txCount;
+}
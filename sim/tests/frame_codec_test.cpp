@@ -0,0 +1,259 @@
+#include "frame_codec.hpp"
+#include "test_check.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// FrameCodec / FrameParser birim testleri: gidiş-dönüş, CRC / uzunluk / COBS
+// reddi, çöpten sonra yeniden senkronizasyon, okumalara bölünmüş çerçeveler
+// ve saniyedeki çerçeve ölçümü
+
+namespace {
+    constexpr uint8_t FRAME_SET = 0x53;
+    constexpr size_t SET_SERVOS = 18;
+    
+    struct Decoded {
+        uint8_t seq;
+        uint8_t type;
+        std::vector<uint8_t> payload;
+    };
+    
+    /**
+     * @brief Akışı verilen parça boyutunda besler, geçerli çerçeveleri toplar
+     */
+    std::vector<Decoded> feedAll(FrameParser& parser, const std::vector<uint8_t>& stream, size_t chunk) {
+        std::vector<Decoded> frames;
+        for (size_t offset = 0; offset < stream.size(); offset += chunk) {
+            size_t len = std::min(chunk, stream.size() - offset);
+            const uint8_t* data = stream.data() + offset;
+            while (len > 0) {
+                bool ready;
+                size_t used = parser.feed(data, len, ready);
+                if (ready) {
+                    const FrameParser::Frame& frame = parser.frame();
+                    frames.push_back({frame.seq, frame.type,
+                                      std::vector<uint8_t>(frame.payload, frame.payload + frame.length)});
+                }
+                data += used;
+                len -= used;
+            }
+        }
+        return frames;
+    }
+    
+    void append(std::vector<uint8_t>& stream, uint8_t seq, uint8_t type, const std::vector<uint8_t>& payload) {
+        uint8_t wire[FrameCodec::MAX_ENCODED];
+        size_t len = FrameCodec::encodeFrame(seq, type, payload.data(), payload.size(), wire);
+        stream.insert(stream.end(), wire, wire + len);
+    }
+    
+    /**
+     * @brief Ham (COBS öncesi) çerçeveyi olduğu gibi kodlar, hatalı çerçeve üretmek için
+     */
+    void appendRaw(std::vector<uint8_t>& stream, const std::vector<uint8_t>& raw) {
+        uint8_t wire[FrameCodec::MAX_ENCODED];
+        size_t len = FrameCodec::cobsEncode(raw.data(), raw.size(), wire);
+        stream.insert(stream.end(), wire, wire + len);
+        stream.push_back(FrameCodec::DELIMITER);
+    }
+    
+    std::vector<uint8_t> setPayload(uint16_t pulse) {
+        std::vector<uint8_t> payload = {0};
+        for (size_t i = 0; i < SET_SERVOS; i++) {
+            payload.push_back(pulse & 0xFF);
+            payload.push_back(pulse >> 8);
+        }
+        return payload;
+    }
+    
+    void testCrcAndCobs() {
+        const char* check = "123456789";
+        CHECK(FrameCodec::crc16((const uint8_t*)check, 9) == 0x29B1);
+        
+        std::vector<std::vector<uint8_t>> samples = {{}, {0}, {0, 0}, {0x11, 0, 0x22}};
+        std::vector<uint8_t> longRun;
+        for (int i = 0; i < 600; i++) {
+            longRun.push_back((i % 300 == 0) ? 0 : (uint8_t)(i | 1));
+        }
+        samples.push_back(longRun);
+        
+        for (const auto& sample : samples) {
+            uint8_t encoded[700];
+            uint8_t decoded[700];
+            size_t len = FrameCodec::cobsEncode(sample.data(), sample.size(), encoded);
+            CHECK(memchr(encoded, 0, len) == nullptr);
+            size_t back = FrameCodec::cobsDecode(encoded, len, decoded, sizeof(decoded));
+            CHECK(back == sample.size());
+            CHECK(sample.empty() || memcmp(decoded, sample.data(), back) == 0);
+        }
+    }
+    
+    void testRoundTrip() {
+        std::vector<uint8_t> stream;
+        for (size_t len = 0; len <= FrameCodec::MAX_PAYLOAD; len += 10) {
+            std::vector<uint8_t> payload(len);
+            for (size_t i = 0; i < len; i++) {
+                payload[i] = (uint8_t)(i * 7);   // Sıfır byte'lar da dahil
+            }
+            append(stream, (uint8_t)len, (uint8_t)(len + 1), payload);
+        }
+        
+        FrameParser parser;
+        std::vector<Decoded> frames = feedAll(parser, stream, stream.size());
+        CHECK(frames.size() == FrameCodec::MAX_PAYLOAD / 10 + 1);
+        for (size_t n = 0; n < frames.size(); n++) {
+            size_t len = n * 10;
+            CHECK(frames[n].seq == (uint8_t)len);
+            CHECK(frames[n].type == (uint8_t)(len + 1));
+            CHECK(frames[n].payload.size() == len);
+            for (size_t i = 0; i < frames[n].payload.size(); i++) {
+                CHECK(frames[n].payload[i] == (uint8_t)(i * 7));
+            }
+        }
+        
+        uint8_t wire[FrameCodec::MAX_ENCODED + 16];
+        std::vector<uint8_t> tooLong(FrameCodec::MAX_PAYLOAD + 1, 1);
+        CHECK(FrameCodec::encodeFrame(0, FRAME_SET, tooLong.data(), tooLong.size(), wire) == 0);
+        
+        // 18 servoluk SET: 2 başlık + 37 yük + 2 CRC, 1 COBS ve 1 ayraç byte'ı
+        CHECK(FrameCodec::encodeFrame(0, FRAME_SET, setPayload(1500).data(), 1 + 2 * SET_SERVOS, wire) == 43);
+    }
+    
+    void testRejection() {
+        std::vector<uint8_t> stream;
+        std::vector<uint8_t> payload = setPayload(1500);
+        
+        // CRC hatası: son byte bozuk
+        std::vector<uint8_t> raw = {1, FRAME_SET};
+        raw.insert(raw.end(), payload.begin(), payload.end());
+        uint16_t crc = FrameCodec::crc16(raw.data(), raw.size());
+        raw.push_back(crc & 0xFF);
+        raw.push_back((crc >> 8) ^ 0x40);
+        appendRaw(stream, raw);
+        
+        // Uzunluk hatası: başlık + CRC'den kısa
+        appendRaw(stream, {1, FRAME_SET, 0x12});
+        
+        // COBS hatası: kod byte'ı bloğun sonunu aşıyor
+        stream.insert(stream.end(), {0x09, 0x11, 0x22, FrameCodec::DELIMITER});
+        
+        // Taşma: ayraçsız çok uzun veri
+        stream.insert(stream.end(), FrameCodec::MAX_ENCODED + 10, 0x5A);
+        stream.push_back(FrameCodec::DELIMITER);
+        
+        append(stream, 2, FRAME_SET, payload);
+        
+        FrameParser parser;
+        std::vector<Decoded> frames = feedAll(parser, stream, 64);
+        const FrameParser::Stats& stats = parser.stats();
+        CHECK(stats.crcErrors == 1);
+        CHECK(stats.lengthErrors == 1);
+        CHECK(stats.encodingErrors == 1);
+        CHECK(stats.overflowErrors == 1);
+        CHECK(stats.framesOk == 1);
+        CHECK(frames.size() == 1 && frames[0].seq == 2 && frames[0].payload == payload);
+    }
+    
+    void testResync() {
+        // Hat gürültüsü bir sonraki ayraçta biter, ilk çerçeve ona yapışırsa kaybolur
+        std::vector<uint8_t> stream = {0x55, 0xAA, 0x13};
+        for (uint8_t seq = 0; seq < 4; seq++) {
+            append(stream, seq, FRAME_SET, setPayload(1000 + seq));
+        }
+        
+        FrameParser parser;
+        std::vector<Decoded> frames = feedAll(parser, stream, stream.size());
+        CHECK(frames.size() == 3);
+        CHECK(!frames.empty() && frames[0].seq == 1);
+        CHECK(parser.stats().framesOk == 3);
+        CHECK(parser.stats().crcErrors + parser.stats().lengthErrors + parser.stats().encodingErrors == 1);
+        
+        // Sıra numarası atlaması
+        stream.clear();
+        append(stream, 10, FRAME_SET, {});
+        append(stream, 11, FRAME_SET, {});
+        append(stream, 13, FRAME_SET, {});
+        parser.reset();
+        feedAll(parser, stream, stream.size());
+        CHECK(parser.stats().sequenceGaps == 1);
+    }
+    
+    void testSplitReads() {
+        std::vector<uint8_t> stream;
+        for (uint8_t seq = 0; seq < 50; seq++) {
+            append(stream, seq, FRAME_SET, setPayload(500 + seq));
+        }
+        
+        for (size_t chunk : {1, 2, 3, 7, 43, 64, 500}) {
+            FrameParser parser;
+            std::vector<Decoded> frames = feedAll(parser, stream, chunk);
+            CHECK(frames.size() == 50);
+            for (size_t n = 0; n < frames.size(); n++) {
+                CHECK(frames[n].seq == n);
+                CHECK(frames[n].payload == setPayload(500 + n));
+            }
+            CHECK(parser.stats().sequenceGaps == 0);
+        }
+    }
+    
+    /**
+     * @brief 18 servoluk SET akışını USB paket boyutunda besler, saniyedeki çerçeveyi ölçer
+     */
+    void benchmark() {
+        constexpr size_t FRAMES = 1000;
+        std::vector<uint8_t> stream;
+        for (size_t i = 0; i < FRAMES; i++) {
+            append(stream, (uint8_t)i, FRAME_SET, setPayload(1000 + i % 1000));
+        }
+        
+        FrameParser parser;
+        size_t total = 0;
+        int rounds = 0;
+        double start = test_check::seconds();
+        double elapsed;
+        do {
+            for (size_t offset = 0; offset < stream.size(); offset += 64) {
+                size_t len = std::min<size_t>(64, stream.size() - offset);
+                const uint8_t* data = stream.data() + offset;
+                while (len > 0) {
+                    bool ready;
+                    size_t used = parser.feed(data, len, ready);
+                    total += ready;
+                    data += used;
+                    len -= used;
+                }
+            }
+            rounds++;
+            elapsed = test_check::seconds() - start;
+        } while (elapsed < 0.2);
+        
+        CHECK(total == rounds * FRAMES);
+        std::printf("decode: %.0f frames/s, %.1f MiB/s (%zu-byte 18-servo SET)\n",
+                    total / elapsed, rounds * stream.size() / elapsed / (1024 * 1024), stream.size() / FRAMES);
+        
+        uint8_t wire[FrameCodec::MAX_ENCODED];
+        std::vector<uint8_t> payload = setPayload(1500);
+        size_t encoded = 0;
+        start = test_check::seconds();
+        do {
+            for (int i = 0; i < 1000; i++) {
+                payload[1] = (uint8_t)i;
+                encoded += FrameCodec::encodeFrame((uint8_t)i, FRAME_SET, payload.data(), payload.size(), wire) != 0;
+            }
+            elapsed = test_check::seconds() - start;
+        } while (elapsed < 0.2);
+        std::printf("encode: %.0f frames/s\n", encoded / elapsed);
+    }
+}
+
+int main() {
+    testCrcAndCobs();
+    testRoundTrip();
+    testRejection();
+    testResync();
+    testSplitReads();
+    benchmark();
+    return TEST_RESULT();
+}
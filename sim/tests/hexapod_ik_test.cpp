@@ -0,0 +1,196 @@
+#include "hexapod_ik.hpp"
+#include "test_check.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// HexapodIK birim testleri: kinematic_positions.txt'deki her pozisyonun ileri
+// kinematikle bulunan ayak noktalarından açıların geri çözülmesi, tam int16
+// girişte taşmasızlık ve solve() süre ölçümü
+
+namespace {
+    using Angles = std::vector<double>;
+    
+    constexpr double ANGLE_TOLERANCE_CDEG = 20;   // 0.2°: ~2 μs darbe, ik_test.py yuvarlamayla 3 μs kabul eder
+    
+    struct Pose {
+        const char* name;
+        double x, y, z;           // 0.1 mm
+        double roll, pitch, yaw;  // Derece
+    };
+    
+    constexpr Pose POSES[] = {
+        {"level body", 0, 0, 0, 0, 0, 0},
+        {"moved and tilted body", 120, -80, 600, 4, -6, 10},
+    };
+    
+    double radians(double degrees) {
+        return degrees * 3.14159265358979323846 / 180.0;
+    }
+    
+    std::vector<Angles> readPositions(const char* path) {
+        std::vector<Angles> positions;
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            for (char& ch : line) {
+                ch = (ch == ',') ? ' ' : ch;
+            }
+            std::istringstream values(line);
+            Angles angles;
+            double angle;
+            while (values >> angle) {
+                angles.push_back(angle);
+            }
+            if (angles.size() == HexapodIK::NUM_JOINTS) {
+                positions.push_back(angles);
+            }
+        }
+        return positions;
+    }
+    
+    /**
+     * @brief İleri kinematik (double): eklem açılarından poz çerçevesinde ayak noktaları (0.1 mm)
+     */
+    void forwardKinematics(const Angles& angles, const Pose& pose, HexapodIK::Vec3* feet) {
+        double cr = std::cos(radians(pose.roll)), sr = std::sin(radians(pose.roll));
+        double cp = std::cos(radians(pose.pitch)), sp = std::sin(radians(pose.pitch));
+        double cy = std::cos(radians(pose.yaw)), sy = std::sin(radians(pose.yaw));
+        
+        for (size_t leg = 0; leg < HexapodIK::NUM_LEGS; leg++) {
+            const HexapodIK::Mount& mount = HexapodIK::MOUNTS[leg];
+            double coxa = mount.sign * angles[3 * leg];
+            double femur = mount.sign * angles[3 * leg + 1];
+            double knee = mount.sign * angles[3 * leg + 2];
+            double tibia = femur + knee - 180.0;
+            
+            double r = HexapodIK::COXA_LENGTH + HexapodIK::FEMUR_LENGTH * std::cos(radians(femur)) +
+                       HexapodIK::TIBIA_LENGTH * std::cos(radians(tibia));
+            double heading = radians(mount.yaw / 10.0 + coxa);
+            double x = mount.x + r * std::cos(heading);
+            double y = mount.y + r * std::sin(heading);
+            double z = HexapodIK::FEMUR_LENGTH * std::sin(radians(femur)) +
+                       HexapodIK::TIBIA_LENGTH * std::sin(radians(tibia));
+            
+            // R = Rz(yaw) Ry(pitch) Rx(roll)
+            double ry = y * cr - z * sr;
+            z = y * sr + z * cr;
+            y = ry;
+            double rx = x * cp + z * sp;
+            z = -x * sp + z * cp;
+            x = rx;
+            rx = x * cy - y * sy;
+            y = x * sy + y * cy;
+            x = rx;
+            
+            feet[leg] = {(int32_t)std::lround(x + pose.x), (int32_t)std::lround(y + pose.y),
+                         (int32_t)std::lround(z + pose.z)};
+        }
+    }
+    
+    HexapodIK::BodyPose toBodyPose(const Pose& pose) {
+        HexapodIK::BodyPose body;
+        body.position = {(int32_t)pose.x, (int32_t)pose.y, (int32_t)pose.z};
+        body.roll = (int16_t)std::lround(pose.roll * 10);
+        body.pitch = (int16_t)std::lround(pose.pitch * 10);
+        body.yaw = (int16_t)std::lround(pose.yaw * 10);
+        return body;
+    }
+    
+    void testRoundTrip(const std::vector<Angles>& positions) {
+        CHECK(!positions.empty());
+        
+        HexapodIK ik;
+        for (const Pose& pose : POSES) {
+            double worst = 0;
+            for (const Angles& angles : positions) {
+                HexapodIK::Vec3 feet[HexapodIK::NUM_LEGS];
+                forwardKinematics(angles, pose, feet);
+                
+                int32_t solved[HexapodIK::NUM_JOINTS];
+                CHECK(ik.solve(toBodyPose(pose), feet, solved) == 0);
+                for (size_t i = 0; i < HexapodIK::NUM_JOINTS; i++) {
+                    worst = std::fmax(worst, std::fabs(solved[i] - angles[i] * 100));
+                }
+            }
+            CHECK(worst <= ANGLE_TOLERANCE_CDEG);
+            std::printf("%s: %zu positions, largest angle error %.2f deg\n", pose.name, positions.size(), worst / 100);
+        }
+    }
+    
+    void testFullRange() {
+        // v2 POSE tam int16 taşır: en uç gövde konumu ve ayaklar, 45° yaw ile
+        HexapodIK ik;
+        HexapodIK::BodyPose pose;
+        pose.position = {-32768, -32768, -32768};
+        pose.roll = 0;
+        pose.pitch = 0;
+        pose.yaw = 450;
+        HexapodIK::Vec3 feet[HexapodIK::NUM_LEGS];
+        for (HexapodIK::Vec3& foot : feet) {
+            foot = {32767, 32767, 32767};
+        }
+        
+        // Hedefler erişilmez, ama coxa hâlâ hedefe döner (gövdede yaklaşık +x yönü)
+        int32_t angles[HexapodIK::NUM_JOINTS];
+        CHECK(ik.solve(pose, feet, angles) == HexapodIK::NUM_LEGS);
+        for (size_t leg = 0; leg < HexapodIK::NUM_LEGS; leg++) {
+            const HexapodIK::Mount& mount = HexapodIK::MOUNTS[leg];
+            double heading = std::atan2(-mount.y, 65535.0 * std::sqrt(2.0) - mount.x) * 180.0 / 3.14159265358979323846;
+            double expected = heading - mount.yaw / 10.0;
+            expected -= 360.0 * std::floor((expected + 180.0) / 360.0);
+            CHECK(std::fabs(mount.sign * angles[3 * leg] / 100.0 - expected) < 0.5);
+        }
+    }
+    
+    /**
+     * @brief Altı bacaklı solve() süresini ölçer
+     */
+    void benchmark(const std::vector<Angles>& positions) {
+        if (positions.empty()) {
+            return;
+        }
+        
+        HexapodIK ik;
+        std::vector<HexapodIK::BodyPose> poses;
+        std::vector<HexapodIK::Vec3> feet(positions.size() * HexapodIK::NUM_LEGS);
+        for (size_t i = 0; i < positions.size(); i++) {
+            const Pose& pose = POSES[i % 2];
+            forwardKinematics(positions[i], pose, &feet[i * HexapodIK::NUM_LEGS]);
+            poses.push_back(toBodyPose(pose));
+        }
+        
+        int32_t angles[HexapodIK::NUM_JOINTS];
+        volatile int32_t sink = 0;
+        size_t solves = 0;
+        double start = test_check::seconds();
+        double elapsed;
+        do {
+            for (int n = 0; n < 1000; n++) {
+                size_t i = solves % positions.size();
+                ik.solve(poses[i], &feet[i * HexapodIK::NUM_LEGS], angles);
+                sink = sink + angles[n % HexapodIK::NUM_JOINTS];
+                solves++;
+            }
+            elapsed = test_check::seconds() - start;
+        } while (elapsed < 0.2);
+        
+        std::printf("solve (6 legs): %.0f ns/solve\n", elapsed * 1e9 / solves);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<Angles> positions = readPositions((argc > 1) ? argv[1] : "kinematic_positions.txt");
+    testRoundTrip(positions);
+    testFullRange();
+    benchmark(positions);
+    return TEST_RESULT();
+}
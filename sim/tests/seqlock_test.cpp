@@ -0,0 +1,86 @@
+#include "seqlock.hpp"
+#include "test_check.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Seqlock çekirdekler arası kullanım testi: yazıcı durmadan yeni durum
+// yayınlarken okuyucu ayrı bir iş parçacığında kopya alır. Her kopya tek
+// bir yayına ait olmalı (yırtık yok) ve yayın numaraları geri gitmemeli.
+
+namespace {
+    constexpr uint32_t PUBLISHES = 500000;
+    constexpr size_t STATE_WORDS = 40;   // Gölge register boyutunda bir durum
+    
+    struct State {
+        uint32_t seq;
+        uint32_t words[STATE_WORDS];     // seq'ten türetilir
+    };
+    
+    uint32_t word(uint32_t seq, size_t i) {
+        return seq ^ (uint32_t)(i * 0x9E3779B9u);
+    }
+    
+    void testConsistency() {
+        Seqlock<State> lock;
+        std::atomic<bool> done(false);
+        
+        std::thread writer([&]() {
+            State state;
+            for (uint32_t seq = 1; seq <= PUBLISHES; seq++) {
+                state.seq = seq;
+                for (size_t i = 0; i < STATE_WORDS; i++) {
+                    state.words[i] = word(seq, i);
+                }
+                lock.write(state);
+            }
+            done.store(true, std::memory_order_release);
+        });
+        
+        uint32_t reads = 0;
+        uint32_t torn = 0;
+        uint32_t backwards = 0;
+        uint32_t mismatched = 0;
+        uint32_t lastSeq = 0;
+        double start = test_check::seconds();
+        while (!done.load(std::memory_order_acquire)) {
+            State state;
+            uint32_t version = lock.read(state);
+            reads++;
+            
+            if (version == 0) {
+                continue;   // Henüz yayın yok
+            }
+            if (version != state.seq) {
+                mismatched++;
+            }
+            if (state.seq < lastSeq) {
+                backwards++;
+            }
+            lastSeq = state.seq;
+            for (size_t i = 0; i < STATE_WORDS; i++) {
+                if (state.words[i] != word(state.seq, i)) {
+                    torn++;
+                    break;
+                }
+            }
+        }
+        double elapsed = test_check::seconds() - start;
+        writer.join();
+        
+        State last;
+        CHECK(lock.read(last) == PUBLISHES && last.seq == PUBLISHES);
+        CHECK(torn == 0);
+        CHECK(backwards == 0);
+        CHECK(mismatched == 0);
+        CHECK(reads > 0);
+        std::printf("seqlock: %u publishes, %u reads in %.3f s, %u retried reads\n",
+                    PUBLISHES, reads, elapsed, lock.retries());
+    }
+}
+
+int main() {
+    testConsistency();
+    return TEST_RESULT();
+}
@@ -0,0 +1,111 @@
+#include "spsc_queue.hpp"
+#include "test_check.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// SpscQueue çekirdekler arası kullanım testi: üretici ve tüketici ayrı
+// iş parçacıklarında, core0 -> core1 komut kuyruğuyla aynı derinlikte.
+// Sıra korunmalı, eleman kaybolmamalı veya yarım kopyalanmamalı.
+
+namespace {
+    constexpr size_t DEPTH = 16;
+    constexpr uint32_t ITEMS = 500000;
+    constexpr size_t PAYLOAD_WORDS = 15;
+    
+    struct Item {
+        uint32_t seq;
+        uint32_t payload[PAYLOAD_WORDS];   // seq'ten türetilir, yarım kopya uyuşmaz
+    };
+    
+    uint32_t word(uint32_t seq, size_t i) {
+        return seq * 2654435761u + (uint32_t)i;
+    }
+    
+    void testOrdering() {
+        SpscQueue<Item, DEPTH> queue;
+        std::atomic<uint32_t> fullSpins(0);
+        
+        std::thread producer([&]() {
+            uint32_t spins = 0;
+            for (uint32_t seq = 0; seq < ITEMS; seq++) {
+                Item item;
+                item.seq = seq;
+                for (size_t i = 0; i < PAYLOAD_WORDS; i++) {
+                    item.payload[i] = word(seq, i);
+                }
+                while (!queue.push(item)) {
+                    spins++;
+                    std::this_thread::yield();
+                }
+            }
+            fullSpins.store(spins, std::memory_order_relaxed);
+        });
+        
+        uint32_t expected = 0;
+        uint32_t outOfOrder = 0;
+        uint32_t torn = 0;
+        size_t maxSize = 0;
+        double start = test_check::seconds();
+        while (expected < ITEMS) {
+            size_t size = queue.size();
+            if (size > maxSize) {
+                maxSize = size;
+            }
+            
+            Item item;
+            if (!queue.pop(item)) {
+                std::this_thread::yield();   // Tek çekirdekli host'ta üreticiye sıra ver
+                continue;
+            }
+            if (item.seq != expected) {
+                outOfOrder++;
+                expected = item.seq;
+            }
+            for (size_t i = 0; i < PAYLOAD_WORDS; i++) {
+                if (item.payload[i] != word(item.seq, i)) {
+                    torn++;
+                    break;
+                }
+            }
+            expected++;
+        }
+        double elapsed = test_check::seconds() - start;
+        producer.join();
+        
+        CHECK(outOfOrder == 0);
+        CHECK(torn == 0);
+        CHECK(expected == ITEMS);
+        CHECK(queue.empty());
+        CHECK(maxSize <= DEPTH);
+        
+        Item item;
+        CHECK(!queue.pop(item));
+        std::printf("spsc: %u items in %.3f s (%.1f M/s), producer found the queue full %u times\n",
+                    ITEMS, elapsed, ITEMS / elapsed / 1e6, fullSpins.load());
+    }
+    
+    void testCapacity() {
+        SpscQueue<uint32_t, DEPTH> queue;
+        for (uint32_t i = 0; i < DEPTH; i++) {
+            CHECK(queue.push(i));
+        }
+        CHECK(!queue.push(DEPTH));
+        CHECK(queue.size() == DEPTH);
+        
+        // Serbest sayaçlar 32-bit taşmasında da doğru sayar
+        for (uint32_t round = 0; round < 100000; round++) {
+            uint32_t value;
+            CHECK(queue.pop(value) && value == round);
+            CHECK(queue.push(round + DEPTH));
+        }
+        CHECK(queue.size() == DEPTH);
+    }
+}
+
+int main() {
+    testCapacity();
+    testOrdering();
+    return TEST_RESULT();
+}
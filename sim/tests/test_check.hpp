@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// Host birim testleri için en küçük denetim yardımcıları: başarısız bir
+// CHECK satırı yazdırır ve sayaca ekler, testin main() fonksiyonu
+// TEST_RESULT() ile çıkış kodunu döndürür (ctest 0 dışını hata sayar)
+
+namespace test_check {
+    inline int g_failures = 0;
+    
+    /**
+     * @brief Saniye cinsinden monoton zaman (ölçüm döngüleri için)
+     */
+    inline double seconds() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            test_check::g_failures++; \
+        } \
+    } while (0)
+
+#define TEST_RESULT() \
+    (test_check::g_failures == 0 \
+        ? (std::printf("all checks passed\n"), 0) \
+        : (std::printf("%d checks failed\n", test_check::g_failures), 1))
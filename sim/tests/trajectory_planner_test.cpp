@@ -0,0 +1,209 @@
+#include "trajectory_planner.hpp"
+#include "test_check.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+
+// TrajectoryPlanner birim testleri: eğri uç noktaları ve monotonluk, sıfır
+// süreli segmentler, kuyruk taşması, update() zincirinde kaymasızlık ve
+// update() süre ölçümü
+
+namespace {
+    using Interpolation = TrajectoryPlanner::Interpolation;
+    
+    constexpr int32_t Q15_ONE = 1 << 15;
+    constexpr Interpolation MODES[] = {Interpolation::LINEAR, Interpolation::CUBIC, Interpolation::MIN_JERK};
+    
+    void fill(uint16_t* pulses, uint16_t value) {
+        for (size_t i = 0; i < TrajectoryPlanner::NUM_SERVOS; i++) {
+            pulses[i] = value;
+        }
+    }
+    
+    void testShape() {
+        for (Interpolation mode : MODES) {
+            CHECK(TrajectoryPlanner::shape(mode, 0) == 0);
+            CHECK(TrajectoryPlanner::shape(mode, Q15_ONE) == Q15_ONE);
+            
+            int32_t previous = 0;
+            for (int32_t u = 0; u <= Q15_ONE; u += 16) {
+                int32_t value = TrajectoryPlanner::shape(mode, u);
+                CHECK(value >= previous);
+                CHECK(value <= Q15_ONE);
+                previous = value;
+            }
+        }
+        
+        // Simetrik eğriler yarı zamanda yarı yoldadır
+        CHECK(std::abs(TrajectoryPlanner::shape(Interpolation::CUBIC, Q15_ONE / 2) - Q15_ONE / 2) <= 1);
+        CHECK(std::abs(TrajectoryPlanner::shape(Interpolation::MIN_JERK, Q15_ONE / 2) - Q15_ONE / 2) <= 1);
+    }
+    
+    void testSegment() {
+        for (Interpolation mode : MODES) {
+            // Uzun süre normalize() kaydırmasını da kapsar
+            for (uint32_t duration : {20000u, 10000000u}) {
+                TrajectoryPlanner planner;
+                uint16_t pulses[TrajectoryPlanner::NUM_SERVOS];
+                fill(pulses, 1000);
+                planner.reset(pulses);
+                
+                uint32_t start = 5000;
+                CHECK(planner.push(3, 2000, duration, mode, start));
+                CHECK(planner.activeMask() == (1u << 3));
+                
+                uint16_t previous = 1000;
+                for (uint32_t t = 0; t < duration; t += duration / 200) {
+                    CHECK(planner.update(start + t, pulses) == (1u << 3));
+                    CHECK(pulses[3] >= previous && pulses[3] <= 2000);
+                    previous = pulses[3];
+                    if (t == 0) {
+                        CHECK(pulses[3] == 1000);
+                    }
+                    if (t == duration / 2) {
+                        CHECK(std::abs(pulses[3] - 1500) <= 1);
+                    }
+                }
+                CHECK(pulses[0] == 1000);
+                
+                planner.update(start + duration, pulses);
+                CHECK(pulses[3] == 2000);
+                CHECK(planner.activeMask() == 0);
+            }
+        }
+    }
+    
+    void testZeroLength() {
+        TrajectoryPlanner planner;
+        uint16_t pulses[TrajectoryPlanner::NUM_SERVOS];
+        fill(pulses, 1500);
+        planner.reset(pulses);
+        
+        // Sıfır süreli kare anında hedefe atlar, sıradaki oradan devam eder
+        uint32_t start = 100;
+        CHECK(planner.push(0, 1800, 0, Interpolation::CUBIC, start));
+        CHECK(planner.push(0, 1200, 10000, Interpolation::LINEAR, start));
+        CHECK(planner.push(0, 1300, 0, Interpolation::MIN_JERK, start));
+        
+        planner.update(start, pulses);
+        CHECK(pulses[0] == 1800);
+        planner.update(start + 5000, pulses);
+        CHECK(pulses[0] == 1500);
+        planner.update(start + 10000, pulses);
+        CHECK(pulses[0] == 1300);
+        CHECK(planner.activeMask() == 0);
+    }
+    
+    void testQueue() {
+        TrajectoryPlanner planner;
+        
+        // İlk kare hemen çalışmaya başlar, kuyrukta QUEUE_DEPTH yer kalır
+        for (size_t i = 0; i <= TrajectoryPlanner::QUEUE_DEPTH; i++) {
+            CHECK(planner.push(5, 1000 + i * 10, 1000, Interpolation::LINEAR, 0));
+        }
+        CHECK(planner.freeSlots(5) == 0);
+        CHECK(!planner.push(5, 900, 1000, Interpolation::LINEAR, 0));
+        CHECK(planner.freeSlots(6) == TrajectoryPlanner::QUEUE_DEPTH);
+        
+        CHECK(!planner.push(TrajectoryPlanner::NUM_SERVOS, 1000, 1000, Interpolation::LINEAR, 0));
+        CHECK(!planner.push(0, 1000, 1000, (Interpolation)3, 0));
+        
+        // Taşan kare kaybolmuş, önceki kareler sırayla biter
+        uint16_t pulses[TrajectoryPlanner::NUM_SERVOS];
+        planner.update(1000 * (TrajectoryPlanner::QUEUE_DEPTH + 1), pulses);
+        CHECK(pulses[5] == 1000 + TrajectoryPlanner::QUEUE_DEPTH * 10);
+        CHECK(planner.activeMask() == 0);
+        
+        planner.push(5, 2000, 1000, Interpolation::LINEAR, 0);
+        planner.cancel(5, 1234);
+        CHECK(planner.activeMask() == 0);
+        CHECK(planner.freeSlots(5) == TrajectoryPlanner::QUEUE_DEPTH);
+    }
+    
+    void testChaining() {
+        // Düzensiz adımlarla güncellenen zincir: her segment bir öncekinin
+        // gerçek bitiş anında başlar, 32-bit zaman taşması dahil kayma birikmez
+        constexpr uint32_t SEGMENT_US = 3333;
+        constexpr int SEGMENTS = 200;
+        
+        for (Interpolation mode : MODES) {
+            TrajectoryPlanner planner;
+            uint16_t pulses[TrajectoryPlanner::NUM_SERVOS];
+            fill(pulses, 1500);
+            planner.reset(pulses);
+            
+            uint32_t start = 0xFFFFFFFFu - 100000;
+            int pushed = 0;
+            uint32_t t = start;
+            for (int k = 1; k <= SEGMENTS; k++) {
+                while (pushed < SEGMENTS && planner.freeSlots(0) > 0) {
+                    pushed++;
+                    planner.push(0, (pushed & 1) ? 1000 : 2000, SEGMENT_US, mode, start);
+                }
+                
+                // Segmentin ortasına düzensiz adımlarla, sonra tam bitişine git
+                uint32_t end = start + k * SEGMENT_US;
+                while ((int32_t)(end - t) > 997) {
+                    t += 997;
+                    planner.update(t, pulses);
+                }
+                t = end;
+                planner.update(t, pulses);
+                CHECK(pulses[0] == ((k & 1) ? 1000 : 2000));
+            }
+            CHECK(planner.activeMask() == 0);
+            
+            // Son segment bitişten 1 μs önce hâlâ çalışıyor olmalı
+            TrajectoryPlanner check;
+            check.reset(pulses);
+            check.push(0, 1000, SEGMENT_US, mode, start);
+            check.push(0, 2000, SEGMENT_US, mode, start);
+            check.update(start + 2 * SEGMENT_US - 1, pulses);
+            CHECK(check.activeMask() == 1);
+            check.update(start + 2 * SEGMENT_US, pulses);
+            CHECK(check.activeMask() == 0);
+        }
+    }
+    
+    /**
+     * @brief 18 servonun tamamı yörüngedeyken update() süresini ölçer
+     */
+    void benchmark() {
+        for (Interpolation mode : MODES) {
+            TrajectoryPlanner planner;
+            uint16_t pulses[TrajectoryPlanner::NUM_SERVOS];
+            uint32_t now = 0;
+            size_t calls = 0;
+            double start = test_check::seconds();
+            double elapsed;
+            do {
+                for (int i = 0; i < 1000; i++) {
+                    for (uint8_t servo = 0; servo < TrajectoryPlanner::NUM_SERVOS; servo++) {
+                        if (planner.freeSlots(servo) > 0) {
+                            planner.push(servo, (now & 0x1000) ? 1000 : 2000, 20000 + servo * 100, mode, now);
+                        }
+                    }
+                    now += 1000;
+                    planner.update(now, pulses);
+                    calls++;
+                }
+                elapsed = test_check::seconds() - start;
+            } while (elapsed < 0.2);
+            
+            std::printf("update (%s, 18 servos): %.0f ns/call\n",
+                        mode == Interpolation::LINEAR ? "linear" : (mode == Interpolation::CUBIC ? "cubic" : "min-jerk"),
+                        elapsed * 1e9 / calls);
+        }
+    }
+}
+
+int main() {
+    testShape();
+    testSegment();
+    testZeroLength();
+    testQueue();
+    testChaining();
+    benchmark();
+    return TEST_RESULT();
+}
@@ -1,7 +1,11 @@
 #include "comm_protocol.hpp"
+#include "register_map.hpp"
 #include "tusb.h"
 
-CommProtocol::CommProtocol() {
+CommProtocol::CommProtocol() :
+    _awaitingVersion(false),
+    _protocolVersion(PROTOCOL_LEGACY),
+    _rejectedFrames(0) {
     _resetPacketState();
 }
 
@@ -9,6 +13,23 @@ bool CommProtocol::processByte(uint8_t byte) {
     // MSB=1 ise yeni bir komut başlat
     if (byte & 0x80) {
         _resetPacketState();
+        
+        // Protokol değiştirme komutu, ardından sürüm byte'ı gelir
+        if (byte == MODE_CMD) {
+            _awaitingVersion = true;
+            return false;
+        }
+        
+        // Harita ve anlık görüntü sorguları parametre taşımaz, komut byte'ıyla tamamlanır
+        if (byte == DISCOVER_CMD) {
+            _currentPacket.type = CommandType::DISCOVER;
+            return true;
+        }
+        if (byte == SNAPSHOT_CMD) {
+            _currentPacket.type = CommandType::SNAPSHOT;
+            return true;
+        }
+        
         _receivingPacket = true;
         
         // Komut tipini belirle
@@ -16,6 +37,37 @@ bool CommProtocol::processByte(uint8_t byte) {
             _currentPacket.type = CommandType::SET;
         } else if (byte == GET_CMD) {
             _currentPacket.type = CommandType::GET;
+        } else if (byte == KEYFRAME_CMD) {
+            _currentPacket.type = CommandType::KEYFRAME;
+        } else if (byte == SUBSCRIBE_CMD) {
+            _currentPacket.type = CommandType::SUBSCRIBE;
+        } else if (byte == READ_LIST_CMD) {
+            _currentPacket.type = CommandType::READ_LIST;
+        } else if (byte == WRITE_LIST_CMD) {
+            _currentPacket.type = CommandType::WRITE_LIST;
+        } else if (byte == DELTA_CMD) {
+            _currentPacket.type = CommandType::DELTA;
+        } else if (byte == TIME_SYNC_CMD) {
+            _currentPacket.type = CommandType::TIME_SYNC;
+        } else if (byte == SCHEDULE_CMD) {
+            _currentPacket.type = CommandType::SCHEDULE;
+        } else if (byte == POSE_CMD) {
+            _currentPacket.type = CommandType::POSE;
+            _currentPacket.count = POSE_VALUES;
+        } else if (byte == GAIT_CMD) {
+            _currentPacket.type = CommandType::GAIT;
+            _currentPacket.count = GAIT_VALUES;
+        } else if (byte == ANGLE_CMD) {
+            _currentPacket.type = CommandType::ANGLE;
+        } else if (byte == CALIBRATE_CMD) {
+            _currentPacket.type = CommandType::CALIBRATE;
+        } else if (byte == LED_FRAME_CMD) {
+            _currentPacket.type = CommandType::LED_FRAME;
+            _currentPacket.count = 2 * LED_FRAME_LEDS;
+        } else if (byte == GPIO_EDGES_CMD) {
+            _currentPacket.type = CommandType::GPIO_EDGES;
+        } else if (byte == DIAG_CMD) {
+            _currentPacket.type = CommandType::DIAG;
         } else {
             // Tanınmayan komut
             _receivingPacket = false;
@@ -26,11 +78,126 @@ bool CommProtocol::processByte(uint8_t byte) {
         return false;  // Paket henüz tamamlanmadı
     }
     
+    // Sürüm byte'ı: v2 istenirse bundan sonraki veri çerçeve olarak işlenir
+    if (_awaitingVersion) {
+        _awaitingVersion = false;
+        if (byte == PROTOCOL_FRAMED) {
+            _protocolVersion = PROTOCOL_FRAMED;
+        }
+        return false;
+    }
+    
     // Paket alınmıyorsa işleme
     if (!_receivingPacket) {
         return false;
     }
     
+    if (_currentPacket.type == CommandType::DELTA) {
+        return _processDeltaByte(byte);
+    }
+    
+    // Saat eşitleme: tek byte'lık çerez yanıtta geri gönderilir
+    if (_currentPacket.type == CommandType::TIME_SYNC) {
+        _currentPacket.seq = byte;
+        _receivingPacket = false;
+        return true;
+    }
+    
+    // Kenar halkası boşaltma: tek byte'lık en fazla kenar sayısı
+    if (_currentPacket.type == CommandType::GPIO_EDGES) {
+        _currentPacket.count = byte;
+        _receivingPacket = false;
+        return true;
+    }
+    
+    // Tanılama: sayfa, ilk değer, sayı
+    if (_currentPacket.type == CommandType::DIAG) {
+        if (_byteCounter == 0) {
+            _currentPacket.slot = byte;
+        } else if (_byteCounter == 1) {
+            _currentPacket.startIdx = byte;
+        } else {
+            _currentPacket.count = byte;
+        }
+        _byteCounter++;
+        
+        if (_byteCounter >= DIAG_HEADER_SIZE) {
+            _receivingPacket = false;
+            return true;
+        }
+        return false;
+    }
+    
+    // POSE ve GAIT: sabit sayıda işaretli 14-bit değer (2 x 7-bit), başlık yok
+    if (_currentPacket.type == CommandType::POSE || _currentPacket.type == CommandType::GAIT) {
+        if (_valueByteCounter == 0) {
+            _currentPacket.values[_valueIdx] = byte & 0x7F;
+            _valueByteCounter = 1;
+            return false;
+        }
+        
+        uint16_t value = _currentPacket.values[_valueIdx] | ((byte & 0x7F) << 7);
+        _currentPacket.values[_valueIdx++] = (value & 0x2000) ? (uint16_t)(value | 0xC000) : value;
+        _valueByteCounter = 0;
+        
+        if (_valueIdx >= _currentPacket.count) {
+            _receivingPacket = false;
+            return true;  // Paket tamamlandı
+        }
+        return false;
+    }
+    
+    // LED_FRAME: başlık yok, LED başına 24-bit renk 4 x 7-bit, düşük bitler önce
+    if (_currentPacket.type == CommandType::LED_FRAME) {
+        uint led = _byteCounter / LED_FRAME_COLOR_BYTES;
+        uint part = _byteCounter % LED_FRAME_COLOR_BYTES;
+        uint32_t color = (part == 0) ? 0 :
+            _currentPacket.values[2 * led] | ((uint32_t)_currentPacket.values[2 * led + 1] << 16);
+        color = (color | ((uint32_t)(byte & 0x7F) << (7 * part))) & 0xFFFFFF;
+        _currentPacket.values[2 * led] = color & 0xFFFF;
+        _currentPacket.values[2 * led + 1] = color >> 16;
+        _byteCounter++;
+        
+        if (_byteCounter >= LED_FRAME_LEDS * LED_FRAME_COLOR_BYTES) {
+            _receivingPacket = false;
+            return true;  // Paket tamamlandı
+        }
+        return false;
+    }
+    
+    // Liste komutları: [count][indeksler...] veya [count][indeks, düşük 7-bit, yüksek 7-bit]...
+    if (_currentPacket.type == CommandType::READ_LIST || _currentPacket.type == CommandType::WRITE_LIST) {
+        if (_byteCounter == 0) {
+            _currentPacket.count = byte;
+            _byteCounter++;
+            
+            // Boş veya dizilere sığmayan listeyi at
+            if (_currentPacket.count == 0 || _currentPacket.count > MAX_VALUES) {
+                _receivingPacket = false;
+            }
+            return false;
+        }
+        
+        if (_currentPacket.type == CommandType::READ_LIST) {
+            _currentPacket.indices[_valueIdx++] = byte;
+        } else if (_valueByteCounter == 0) {
+            _currentPacket.indices[_valueIdx] = byte;
+            _valueByteCounter = 1;
+        } else if (_valueByteCounter == 1) {
+            _currentPacket.values[_valueIdx] = byte & 0x7F;
+            _valueByteCounter = 2;
+        } else {
+            _currentPacket.values[_valueIdx++] |= ((byte & 0x7F) << 7);
+            _valueByteCounter = 0;
+        }
+        
+        if (_valueIdx >= _currentPacket.count) {
+            _receivingPacket = false;
+            return true;  // Paket tamamlandı
+        }
+        return false;
+    }
+    
     // Paket verisini işle
     if (_byteCounter == 0) {
         // Başlangıç indeksi
@@ -47,9 +214,50 @@ bool CommProtocol::processByte(uint8_t byte) {
             return true;
         }
         
+        // Değer taşımayan CALIBRATE sadece sorgudur
+        if (_currentPacket.type == CommandType::CALIBRATE && _currentPacket.count == 0) {
+            _receivingPacket = false;
+            return true;
+        }
+        
+        // Değer dizisine sığmayan paketi at
+        if (_currentPacket.count > MAX_VALUES) {
+            _receivingPacket = false;
+            return false;
+        }
+        
         // SET komutu için değerleri beklemeye devam et
         _valueIdx = 0;
         _valueByteCounter = 0;
+    } else if (_currentPacket.type == CommandType::SUBSCRIBE) {
+        // SUBSCRIBE ek başlığı: yuva ve 14-bit periyot (ms), değer taşımaz
+        if (_byteCounter == 2) {
+            _currentPacket.slot = byte;
+        } else if (_byteCounter == 3) {
+            _currentPacket.periodMs = byte & 0x7F;
+        } else {
+            _currentPacket.periodMs |= ((byte & 0x7F) << 7);
+        }
+        _byteCounter++;
+        
+        if (_byteCounter >= SUBSCRIBE_HEADER_SIZE) {
+            _receivingPacket = false;
+            return true;
+        }
+    } else if (_currentPacket.type == CommandType::KEYFRAME && _byteCounter < KEYFRAME_HEADER_SIZE) {
+        // KEYFRAME ek başlığı: enterpolasyon türü ve 14-bit süre (ms)
+        if (_byteCounter == 2) {
+            _currentPacket.interpolation = byte;
+        } else if (_byteCounter == 3) {
+            _currentPacket.durationMs = byte & 0x7F;
+        } else {
+            _currentPacket.durationMs |= ((byte & 0x7F) << 7);
+        }
+        _byteCounter++;
+    } else if (_currentPacket.type == CommandType::SCHEDULE && _byteCounter < SCHEDULE_HEADER_SIZE) {
+        // SCHEDULE ek başlığı: 32-bit uygulama zamanı (μs), 5 x 7-bit, düşük bitler önce
+        _currentPacket.applyAt_us |= (uint32_t)(byte & 0x7F) << (7 * (_byteCounter - 2));
+        _byteCounter++;
     } else {
         // Değerleri işle (her değer iki byte)
         if (_valueByteCounter == 0) {
@@ -60,6 +268,12 @@ bool CommProtocol::processByte(uint8_t byte) {
             // Yüksek 7-bit
             _currentPacket.values[_valueIdx] |= ((byte & 0x7F) << 7);
             _valueByteCounter = 0;
+            
+            // Açı ve kalibrasyon değerleri işaretli 14-bit
+            if ((_currentPacket.type == CommandType::ANGLE || _currentPacket.type == CommandType::CALIBRATE) &&
+                (_currentPacket.values[_valueIdx] & 0x2000)) {
+                _currentPacket.values[_valueIdx] |= 0xC000;
+            }
             _valueIdx++;
             
             // Tüm değerler alındı mı?
@@ -73,47 +287,576 @@ bool CommProtocol::processByte(uint8_t byte) {
     return false;  // Paket henüz tamamlanmadı
 }
 
+bool CommProtocol::_processDeltaByte(uint8_t byte) {
+    // Maske: 3 x 7-bit, düşük bitler önce
+    if (_byteCounter < DELTA_MASK_SIZE) {
+        _currentPacket.mask |= (uint32_t)(byte & 0x7F) << (7 * _byteCounter);
+        _byteCounter++;
+        
+        if (_byteCounter == DELTA_MASK_SIZE) {
+            _currentPacket.count = __builtin_popcount(_currentPacket.mask & DELTA_SERVO_MASK);
+            if (_currentPacket.count == 0) {
+                _receivingPacket = false;
+                return true;  // Değişiklik yok
+            }
+        }
+        return false;
+    }
+    
+    bool key = (_currentPacket.mask & DELTA_KEY_FLAG) != 0;
+    if (key || _valueByteCounter != 0) {
+        // Mutlak değer veya kaçış sonrası 14-bit fark (2 x 7-bit)
+        if (_valueByteCounter == 0 || _valueByteCounter == 1) {
+            _currentPacket.values[_valueIdx] = byte & 0x7F;
+            _valueByteCounter = 2;
+            return false;
+        }
+        uint16_t value = _currentPacket.values[_valueIdx] | ((byte & 0x7F) << 7);
+        if (!key && (value & 0x2000)) {
+            value |= 0xC000;  // 14-bit işaret genişletme
+        }
+        _currentPacket.values[_valueIdx++] = value;
+        _valueByteCounter = 0;
+    } else if (byte == DELTA_ESCAPE_LEGACY) {
+        _valueByteCounter = 1;
+        return false;
+    } else {
+        // 7-bit işaretli fark (-63..63)
+        _currentPacket.values[_valueIdx++] = (byte & 0x40) ? (uint16_t)(byte | 0xFF80) : byte;
+    }
+    
+    if (_valueIdx >= _currentPacket.count) {
+        _receivingPacket = false;
+        return true;  // Paket tamamlandı
+    }
+    return false;
+}
+
+bool CommProtocol::_decodeDelta(const uint8_t* payload, uint length) {
+    if (length < 3) {
+        return false;
+    }
+    
+    uint32_t mask = payload[0] | (payload[1] << 8) | ((uint32_t)payload[2] << 16);
+    if (mask & ~(DELTA_SERVO_MASK | DELTA_KEY_FLAG)) {
+        return false;
+    }
+    
+    _currentPacket.mask = mask;
+    _currentPacket.count = __builtin_popcount(mask & DELTA_SERVO_MASK);
+    bool key = (mask & DELTA_KEY_FLAG) != 0;
+    
+    uint pos = 3;
+    for (uint i = 0; i < _currentPacket.count; i++) {
+        if (key) {
+            // u16 LE mutlak değer
+            if (pos + 2 > length) {
+                return false;
+            }
+            _currentPacket.values[i] = payload[pos] | (payload[pos + 1] << 8);
+            pos += 2;
+        } else if (pos < length && payload[pos] == DELTA_ESCAPE) {
+            // Kaçış: i16 LE fark
+            if (pos + 3 > length) {
+                return false;
+            }
+            _currentPacket.values[i] = payload[pos + 1] | (payload[pos + 2] << 8);
+            pos += 3;
+        } else {
+            // i8 fark
+            if (pos >= length) {
+                return false;
+            }
+            _currentPacket.values[i] = (uint16_t)(int16_t)(int8_t)payload[pos];
+            pos++;
+        }
+    }
+    
+    return pos == length;
+}
+
+uint32_t CommProtocol::processBuffer(const uint8_t* data, uint32_t len, bool& packetReady) {
+    uint32_t consumed = 0;
+    packetReady = false;
+    
+    while (consumed < len) {
+        if (_protocolVersion == PROTOCOL_FRAMED) {
+            // Çerçeveler ayraçlar arasında toplu olarak ayıklanır
+            bool frameReady;
+            consumed += _frameParser.feed(data + consumed, len - consumed, frameReady);
+            if (frameReady && _decodeFrame(_frameParser.frame())) {
+                packetReady = true;
+                return consumed;
+            }
+        } else {
+            if (processByte(data[consumed++])) {
+                packetReady = true;
+                return consumed;
+            }
+        }
+    }
+    
+    return consumed;
+}
+
+bool CommProtocol::_decodeFrame(const FrameParser::Frame& frame) {
+    const uint8_t* payload = frame.payload;
+    
+    switch (frame.type) {
+        case FRAME_SET: {
+            // [startIdx][u16 LE değerler...], değer sayısı uzunluktan çıkarılır
+            uint valueBytes = (frame.length > 0) ? frame.length - 1u : 0u;
+            if (valueBytes < 2 || (valueBytes & 1) || valueBytes / 2 > MAX_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::SET;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.startIdx = payload[0];
+            _currentPacket.count = valueBytes / 2;
+            for (uint i = 0; i < _currentPacket.count; i++) {
+                _currentPacket.values[i] = payload[1 + 2 * i] | (payload[2 + 2 * i] << 8);
+            }
+            return true;
+        }
+        
+        case FRAME_GET: {
+            // [startIdx][count]
+            if (frame.length != 2 || payload[1] > MAX_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::GET;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.startIdx = payload[0];
+            _currentPacket.count = payload[1];
+            return true;
+        }
+        
+        case FRAME_KEYFRAME: {
+            // [startIdx][tür][süre ms u16 LE][u16 LE değerler...]
+            uint valueBytes = (frame.length > 4) ? frame.length - 4u : 0u;
+            if (valueBytes < 2 || (valueBytes & 1) || valueBytes / 2 > MAX_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::KEYFRAME;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.startIdx = payload[0];
+            _currentPacket.interpolation = payload[1];
+            _currentPacket.durationMs = payload[2] | (payload[3] << 8);
+            _currentPacket.count = valueBytes / 2;
+            for (uint i = 0; i < _currentPacket.count; i++) {
+                _currentPacket.values[i] = payload[4 + 2 * i] | (payload[5 + 2 * i] << 8);
+            }
+            return true;
+        }
+        
+        case FRAME_SUBSCRIBE: {
+            // [yuva][startIdx][count][periyot ms u16 LE]
+            if (frame.length != 5 || payload[2] > MAX_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::SUBSCRIBE;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.slot = payload[0];
+            _currentPacket.startIdx = payload[1];
+            _currentPacket.count = payload[2];
+            _currentPacket.periodMs = payload[3] | (payload[4] << 8);
+            return true;
+        }
+        
+        case FRAME_DISCOVER: {
+            // Boş yük
+            if (frame.length != 0) {
+                break;
+            }
+            _currentPacket.type = CommandType::DISCOVER;
+            _currentPacket.seq = frame.seq;
+            return true;
+        }
+        
+        case FRAME_READ_LIST: {
+            // [indeksler...]
+            if (frame.length == 0 || frame.length > MAX_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::READ_LIST;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.count = frame.length;
+            for (uint i = 0; i < _currentPacket.count; i++) {
+                _currentPacket.indices[i] = payload[i];
+            }
+            return true;
+        }
+        
+        case FRAME_WRITE_LIST: {
+            // [indeks][u16 LE değer]...
+            if (frame.length == 0 || frame.length % 3 != 0 || frame.length / 3 > MAX_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::WRITE_LIST;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.count = frame.length / 3;
+            for (uint i = 0; i < _currentPacket.count; i++) {
+                _currentPacket.indices[i] = payload[3 * i];
+                _currentPacket.values[i] = payload[3 * i + 1] | (payload[3 * i + 2] << 8);
+            }
+            return true;
+        }
+        
+        case FRAME_DELTA: {
+            if (!_decodeDelta(payload, frame.length)) {
+                break;
+            }
+            _currentPacket.type = CommandType::DELTA;
+            _currentPacket.seq = frame.seq;
+            return true;
+        }
+        
+        case FRAME_TIME_SYNC: {
+            // Boş yük, çerez çerçeve sıra numarasıdır
+            if (frame.length != 0) {
+                break;
+            }
+            _currentPacket.type = CommandType::TIME_SYNC;
+            _currentPacket.seq = frame.seq;
+            return true;
+        }
+        
+        case FRAME_SCHEDULE: {
+            // [startIdx][uygulama zamanı μs u32 LE][u16 LE değerler...]
+            uint valueBytes = (frame.length > 5) ? frame.length - 5u : 0u;
+            if (valueBytes < 2 || (valueBytes & 1) || valueBytes / 2 > MAX_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::SCHEDULE;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.startIdx = payload[0];
+            _currentPacket.applyAt_us = payload[1] | (payload[2] << 8) | (payload[3] << 16) | ((uint32_t)payload[4] << 24);
+            _currentPacket.count = valueBytes / 2;
+            for (uint i = 0; i < _currentPacket.count; i++) {
+                _currentPacket.values[i] = payload[5 + 2 * i] | (payload[6 + 2 * i] << 8);
+            }
+            return true;
+        }
+        
+        case FRAME_POSE: {
+            // [24 x i16 LE]
+            if (frame.length != 2 * POSE_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::POSE;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.count = POSE_VALUES;
+            for (uint i = 0; i < POSE_VALUES; i++) {
+                _currentPacket.values[i] = payload[2 * i] | (payload[2 * i + 1] << 8);
+            }
+            return true;
+        }
+        
+        case FRAME_GAIT: {
+            // [6 x i16 LE]
+            if (frame.length != 2 * GAIT_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::GAIT;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.count = GAIT_VALUES;
+            for (uint i = 0; i < GAIT_VALUES; i++) {
+                _currentPacket.values[i] = payload[2 * i] | (payload[2 * i + 1] << 8);
+            }
+            return true;
+        }
+        
+        case FRAME_ANGLE: {
+            // [startIdx][i16 LE açılar...]
+            uint valueBytes = (frame.length > 0) ? frame.length - 1u : 0u;
+            if (valueBytes < 2 || (valueBytes & 1) || valueBytes / 2 > MAX_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::ANGLE;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.startIdx = payload[0];
+            _currentPacket.count = valueBytes / 2;
+            for (uint i = 0; i < _currentPacket.count; i++) {
+                _currentPacket.values[i] = payload[1 + 2 * i] | (payload[2 + 2 * i] << 8);
+            }
+            return true;
+        }
+        
+        case FRAME_CALIBRATE: {
+            // [servo] veya [servo][i16 LE değerler...]
+            uint valueBytes = (frame.length > 0) ? frame.length - 1u : 0u;
+            if (frame.length == 0 || (valueBytes & 1) || valueBytes / 2 > MAX_VALUES) {
+                break;
+            }
+            _currentPacket.type = CommandType::CALIBRATE;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.startIdx = payload[0];
+            _currentPacket.count = valueBytes / 2;
+            for (uint i = 0; i < _currentPacket.count; i++) {
+                _currentPacket.values[i] = payload[1 + 2 * i] | (payload[2 + 2 * i] << 8);
+            }
+            return true;
+        }
+        
+        case FRAME_LED: {
+            // [6 x R, G, B]
+            if (frame.length != 3 * LED_FRAME_LEDS) {
+                break;
+            }
+            _currentPacket.type = CommandType::LED_FRAME;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.count = 2 * LED_FRAME_LEDS;
+            for (uint i = 0; i < LED_FRAME_LEDS; i++) {
+                _currentPacket.values[2 * i] = (payload[3 * i + 1] << 8) | payload[3 * i + 2];
+                _currentPacket.values[2 * i + 1] = payload[3 * i];
+            }
+            return true;
+        }
+        
+        case FRAME_GPIO_EDGES: {
+            // Boş yük veya [en fazla kenar]
+            if (frame.length > 1) {
+                break;
+            }
+            _currentPacket.type = CommandType::GPIO_EDGES;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.count = (frame.length == 1) ? payload[0] : 0;
+            return true;
+        }
+        
+        case FRAME_DIAG: {
+            // [sayfa][ilk][count]
+            if (frame.length != DIAG_HEADER_SIZE) {
+                break;
+            }
+            _currentPacket.type = CommandType::DIAG;
+            _currentPacket.seq = frame.seq;
+            _currentPacket.slot = payload[0];
+            _currentPacket.startIdx = payload[1];
+            _currentPacket.count = payload[2];
+            return true;
+        }
+        
+        case FRAME_SNAPSHOT: {
+            // Boş yük
+            if (frame.length != 0) {
+                break;
+            }
+            _currentPacket.type = CommandType::SNAPSHOT;
+            _currentPacket.seq = frame.seq;
+            return true;
+        }
+        
+        case FRAME_MODE: {
+            // [sürüm], eski protokole dönüş
+            if (frame.length != 1) {
+                break;
+            }
+            if (payload[0] == PROTOCOL_LEGACY) {
+                _protocolVersion = PROTOCOL_LEGACY;
+                _resetPacketState();
+            }
+            return false;
+        }
+        
+        default:
+            break;
+    }
+    
+    _rejectedFrames++;
+    return false;
+}
+
 CommProtocol::CommandPacket& CommProtocol::getCurrentPacket() {
     return _currentPacket;
 }
 
+uint8_t CommProtocol::getProtocolVersion() const {
+    return _protocolVersion;
+}
+
+void CommProtocol::setProtocolVersion(uint8_t version) {
+    if (version == _protocolVersion) {
+        return;
+    }
+    
+    _protocolVersion = (version == PROTOCOL_FRAMED) ? PROTOCOL_FRAMED : PROTOCOL_LEGACY;
+    _resetPacketState();
+}
+
+const FrameParser::Stats& CommProtocol::getFrameStats() const {
+    return _frameParser.stats();
+}
+
+uint32_t CommProtocol::getRejectedFrames() const {
+    return _rejectedFrames;
+}
+
+ResponseWriter& CommProtocol::getResponseWriter() {
+    return _writer;
+}
+
 void CommProtocol::sendPacket(const CommandPacket& packet) {
-    uint8_t cmd = (packet.type == CommandType::SET) ? SET_CMD : GET_CMD;
-    uint8_t buffer[3 + 2 * MAX_VALUES]; // Header (3 bytes) + values (2 bytes each)
+    if (packet.type == CommandType::SET) {
+        _sendValues(SET_CMD, FRAME_SET, packet.seq, packet.startIdx, packet.count, packet.values);
+    } else {
+        _sendValues(GET_CMD, FRAME_GET, packet.seq, packet.startIdx, packet.count, nullptr);
+    }
+}
+
+void CommProtocol::sendGetResponse(uint8_t startIdx, uint8_t count, const uint16_t* values, uint8_t seq) {
+    _sendValues(GET_CMD, FRAME_GET, seq, startIdx, count, values);
+}
+
+void CommProtocol::sendListResponse(uint8_t count, const uint16_t* values, uint8_t seq) {
+    if (!tud_cdc_connected() || count > MAX_VALUES) {
+        return;
+    }
+    
+    if (_protocolVersion == PROTOCOL_FRAMED) {
+        // Yük: [u16 LE değerler...]
+        uint8_t payload[2 * MAX_VALUES];
+        uint16_t index = 0;
+        for (uint i = 0; i < count; i++) {
+            payload[index++] = values[i] & 0xFF;
+            payload[index++] = values[i] >> 8;
+        }
+        
+        uint8_t buffer[FrameCodec::MAX_ENCODED];
+        size_t length = FrameCodec::encodeFrame(seq, FRAME_READ_LIST, payload, index, buffer);
+        _writer.write(buffer, length);
+        return;
+    }
+    
+    // [0xD2][count][değerler 2 x 7-bit...]
+    uint8_t buffer[2 + 2 * MAX_VALUES];
     uint16_t index = 0;
     
-    // Komut headerı ekle
-    buffer[index++] = cmd;
-    buffer[index++] = packet.startIdx;
-    buffer[index++] = packet.count;
+    buffer[index++] = READ_LIST_CMD;
+    buffer[index++] = count;
+    for (uint i = 0; i < count; i++) {
+        uint8_t low_byte, high_byte;
+        encodeValue(values[i], low_byte, high_byte);
+        buffer[index++] = low_byte;
+        buffer[index++] = high_byte;
+    }
     
-    // SET komutu için değerleri ekle
-    if (packet.type == CommandType::SET) {
-        for (uint i = 0; i < packet.count; i++) {
-            uint8_t low_byte, high_byte;
-            encodeValue(packet.values[i], low_byte, high_byte);
-            buffer[index++] = low_byte;
-            buffer[index++] = high_byte;
+    _writer.write(buffer, index);
+}
+
+bool CommProtocol::sendTelemetry(uint8_t slot, uint8_t seq, uint8_t startIdx, uint8_t count,
+                                 uint32_t timestamp_us, const uint16_t* values) {
+    if (!tud_cdc_connected() || count > MAX_VALUES) {
+        return false;
+    }
+    
+    if (_protocolVersion == PROTOCOL_FRAMED) {
+        // Yük: [yuva][startIdx][zaman μs u32 LE][u16 LE değerler...]
+        uint8_t payload[6 + 2 * MAX_VALUES];
+        uint16_t index = 0;
+        payload[index++] = slot;
+        payload[index++] = startIdx;
+        for (uint i = 0; i < 4; i++) {
+            payload[index++] = (timestamp_us >> (8 * i)) & 0xFF;
+        }
+        for (uint i = 0; i < count; i++) {
+            payload[index++] = values[i] & 0xFF;
+            payload[index++] = values[i] >> 8;
         }
+        
+        uint8_t buffer[FrameCodec::MAX_ENCODED];
+        size_t length = FrameCodec::encodeFrame(seq, FRAME_SUBSCRIBE, payload, index, buffer);
+        return _writer.write(buffer, length);
     }
     
-    // Tüm buffer'ı bir seferde gönder
-    if (tud_cdc_connected()) {
-        tud_cdc_write(buffer, index);
-        tud_cdc_write_flush();
+    // [0xD4][yuva][startIdx][count][zaman ms 21-bit, 3 x 7-bit][değerler 2 x 7-bit...]
+    uint8_t buffer[7 + 2 * MAX_VALUES];
+    uint16_t index = 0;
+    uint32_t timestampMs = timestamp_us / 1000;
+    
+    buffer[index++] = SUBSCRIBE_CMD;
+    buffer[index++] = slot & 0x7F;
+    buffer[index++] = startIdx & 0x7F;
+    buffer[index++] = count;
+    buffer[index++] = timestampMs & 0x7F;
+    buffer[index++] = (timestampMs >> 7) & 0x7F;
+    buffer[index++] = (timestampMs >> 14) & 0x7F;
+    for (uint i = 0; i < count; i++) {
+        uint8_t low_byte, high_byte;
+        encodeValue(values[i], low_byte, high_byte);
+        buffer[index++] = low_byte;
+        buffer[index++] = high_byte;
     }
+    
+    return _writer.write(buffer, index);
 }
 
-void CommProtocol::sendGetResponse(uint8_t startIdx, uint8_t count, const uint16_t* values) {
-    uint8_t buffer[3 + 2 * MAX_VALUES]; // Header (3 bytes) + values (2 bytes each)
+void CommProtocol::sendDiscovery(uint8_t seq) {
+    if (!tud_cdc_connected()) {
+        return;
+    }
+    
+    // Yük: [sürüm][aralık sayısı][base, uzunluk, tür, erişim]..., her alan 7-bit
+    uint8_t payload[2 + 4 * RegisterMap::NUM_RANGES];
     uint16_t index = 0;
+    payload[index++] = RegisterMap::VERSION;
+    payload[index++] = RegisterMap::NUM_RANGES;
+    for (const RegisterMap::Range& range : RegisterMap::RANGES) {
+        payload[index++] = range.base;
+        payload[index++] = range.length;
+        payload[index++] = (uint8_t)range.kind;
+        payload[index++] = range.access;
+    }
     
-    // Yanıt headerı ekle
-    buffer[index++] = GET_CMD;
-    buffer[index++] = startIdx;
-    buffer[index++] = count;
+    if (_protocolVersion == PROTOCOL_FRAMED) {
+        uint8_t buffer[FrameCodec::MAX_ENCODED];
+        size_t length = FrameCodec::encodeFrame(seq, FRAME_DISCOVER, payload, index, buffer);
+        _writer.write(buffer, length);
+        return;
+    }
     
-    // Değerleri ekle
+    uint8_t buffer[1 + sizeof(payload)];
+    buffer[0] = DISCOVER_CMD;
+    for (uint i = 0; i < index; i++) {
+        buffer[1 + i] = payload[i];
+    }
+    _writer.write(buffer, 1 + index);
+}
+
+void CommProtocol::sendSnapshot(uint32_t timestamp_us, uint8_t count, const uint16_t* values, uint8_t seq) {
+    if (!tud_cdc_connected() || count > RegisterMap::NUM_MAPPED) {
+        return;
+    }
+    
+    if (_protocolVersion == PROTOCOL_FRAMED) {
+        // Yük: [count][zaman μs u32 LE][u16 LE değerler...]
+        static_assert(5 + 2 * RegisterMap::NUM_MAPPED <= FrameCodec::MAX_PAYLOAD, "SNAPSHOT yükü tek çerçeveye sığmalı");
+        uint8_t payload[5 + 2 * RegisterMap::NUM_MAPPED];
+        uint16_t index = 0;
+        payload[index++] = count;
+        for (uint i = 0; i < 4; i++) {
+            payload[index++] = (timestamp_us >> (8 * i)) & 0xFF;
+        }
+        for (uint i = 0; i < count; i++) {
+            payload[index++] = values[i] & 0xFF;
+            payload[index++] = values[i] >> 8;
+        }
+        
+        uint8_t buffer[FrameCodec::MAX_ENCODED];
+        size_t length = FrameCodec::encodeFrame(seq, FRAME_SNAPSHOT, payload, index, buffer);
+        _writer.write(buffer, length);
+        return;
+    }
+    
+    // [0xC1][count][zaman μs 32-bit, 5 x 7-bit][değerler 2 x 7-bit...]
+    uint8_t buffer[7 + 2 * RegisterMap::NUM_MAPPED];
+    uint16_t index = 0;
+    
+    buffer[index++] = SNAPSHOT_CMD;
+    buffer[index++] = count;
+    for (uint i = 0; i < 5; i++) {
+        buffer[index++] = (timestamp_us >> (7 * i)) & 0x7F;
+    }
     for (uint i = 0; i < count; i++) {
         uint8_t low_byte, high_byte;
         encodeValue(values[i], low_byte, high_byte);
@@ -121,11 +864,180 @@ void CommProtocol::sendGetResponse(uint8_t startIdx, uint8_t count, const uint16
         buffer[index++] = high_byte;
     }
     
-    // Tüm buffer'ı bir seferde gönder
-    if (tud_cdc_connected()) {
-        tud_cdc_write(buffer, index);
-        tud_cdc_write_flush();
+    _writer.write(buffer, index);
+}
+
+void CommProtocol::sendCalibration(uint8_t servo, uint8_t count, const uint16_t* values, uint8_t seq) {
+    // Değerler iki tümleyenli; eski protokolde 14-bit'e kırpılınca işaret biti 13. bit olur
+    _sendValues(CALIBRATE_CMD, FRAME_CALIBRATE, seq, servo, count, values);
+}
+
+bool CommProtocol::sendGpioEdges(uint8_t count, uint8_t remaining, uint16_t dropped,
+                                 const uint8_t* codes, const uint32_t* times_us, uint8_t seq) {
+    if (!tud_cdc_connected() || count > GPIO_EDGES_MAX) {
+        return false;
+    }
+    
+    if (remaining > 0x7F) {
+        remaining = 0x7F;
+    }
+    
+    if (_protocolVersion == PROTOCOL_FRAMED) {
+        // Yük: [count][kalan][kayıp u16 LE][kod, zaman μs u32 LE]...
+        uint8_t payload[4 + 5 * GPIO_EDGES_MAX];
+        uint16_t index = 0;
+        payload[index++] = count;
+        payload[index++] = remaining;
+        payload[index++] = dropped & 0xFF;
+        payload[index++] = dropped >> 8;
+        for (uint i = 0; i < count; i++) {
+            payload[index++] = codes[i];
+            for (uint b = 0; b < 4; b++) {
+                payload[index++] = (times_us[i] >> (8 * b)) & 0xFF;
+            }
+        }
+        
+        uint8_t buffer[FrameCodec::MAX_ENCODED];
+        size_t length = FrameCodec::encodeFrame(seq, FRAME_GPIO_EDGES, payload, index, buffer);
+        return _writer.write(buffer, length);
+    }
+    
+    // [0xC5][count][kalan][kayıp 2 x 7-bit][kod, zaman μs 5 x 7-bit]...
+    uint8_t buffer[5 + 6 * GPIO_EDGES_MAX];
+    uint16_t index = 0;
+    
+    buffer[index++] = GPIO_EDGES_CMD;
+    buffer[index++] = count;
+    buffer[index++] = remaining;
+    encodeValue((dropped > 0x3FFF) ? 0x3FFF : dropped, buffer[index], buffer[index + 1]);
+    index += 2;
+    for (uint i = 0; i < count; i++) {
+        buffer[index++] = codes[i] & 0x7F;
+        for (uint b = 0; b < 5; b++) {
+            buffer[index++] = (times_us[i] >> (7 * b)) & 0x7F;
+        }
+    }
+    
+    return _writer.write(buffer, index);
+}
+
+void CommProtocol::sendDiagnostics(uint8_t page, uint8_t first, uint8_t count, const uint16_t* values, uint8_t seq) {
+    if (!tud_cdc_connected() || count > MAX_VALUES) {
+        return;
     }
+    
+    if (_protocolVersion == PROTOCOL_FRAMED) {
+        // Yük: [sayfa][ilk][u16 LE değerler...]
+        uint8_t payload[2 + 2 * MAX_VALUES];
+        uint16_t index = 0;
+        payload[index++] = page;
+        payload[index++] = first;
+        for (uint i = 0; i < count; i++) {
+            payload[index++] = values[i] & 0xFF;
+            payload[index++] = values[i] >> 8;
+        }
+        
+        uint8_t buffer[FrameCodec::MAX_ENCODED];
+        size_t length = FrameCodec::encodeFrame(seq, FRAME_DIAG, payload, index, buffer);
+        _writer.write(buffer, length);
+        return;
+    }
+    
+    // [0xD8][sayfa][ilk][count][değerler 2 x 7-bit...]
+    uint8_t buffer[4 + 2 * MAX_VALUES];
+    uint16_t index = 0;
+    
+    buffer[index++] = DIAG_CMD;
+    buffer[index++] = page & 0x7F;
+    buffer[index++] = first & 0x7F;
+    buffer[index++] = count;
+    for (uint i = 0; i < count; i++) {
+        encodeValue((values[i] > 0x3FFF) ? 0x3FFF : values[i], buffer[index], buffer[index + 1]);
+        index += 2;
+    }
+    
+    _writer.write(buffer, index);
+}
+
+void CommProtocol::sendTimeSync(uint32_t rx_us, uint8_t seq) {
+    if (!tud_cdc_connected()) {
+        return;
+    }
+    
+    // Gönderim zamanı olabildiğince geç alınır, kodlama süresi ölçüme girmez
+    uint32_t tx_us = time_us_32();
+    
+    if (_protocolVersion == PROTOCOL_FRAMED) {
+        // Yük: [alım zamanı μs u32 LE][gönderim zamanı μs u32 LE]
+        uint8_t payload[8];
+        for (uint i = 0; i < 4; i++) {
+            payload[i] = (rx_us >> (8 * i)) & 0xFF;
+            payload[4 + i] = (tx_us >> (8 * i)) & 0xFF;
+        }
+        
+        uint8_t buffer[FrameCodec::MAX_ENCODED];
+        size_t length = FrameCodec::encodeFrame(seq, FRAME_TIME_SYNC, payload, sizeof(payload), buffer);
+        _writer.write(buffer, length);
+        return;
+    }
+    
+    // [0xC3][çerez][alım zamanı μs 5 x 7-bit][gönderim zamanı μs 5 x 7-bit]
+    uint8_t buffer[12];
+    buffer[0] = TIME_SYNC_CMD;
+    buffer[1] = seq & 0x7F;
+    for (uint i = 0; i < 5; i++) {
+        buffer[2 + i] = (rx_us >> (7 * i)) & 0x7F;
+        buffer[7 + i] = (tx_us >> (7 * i)) & 0x7F;
+    }
+    _writer.write(buffer, sizeof(buffer));
+}
+
+void CommProtocol::_sendValues(uint8_t cmd, uint8_t frameType, uint8_t seq,
+                               uint8_t startIdx, uint8_t count, const uint16_t* values) {
+    if (!tud_cdc_connected() || count > MAX_VALUES) {
+        return;
+    }
+    
+    if (_protocolVersion == PROTOCOL_FRAMED) {
+        // Yük: [startIdx][u16 LE değerler...] veya değer yoksa [startIdx][count]
+        uint8_t payload[1 + 2 * MAX_VALUES];
+        uint16_t index = 0;
+        payload[index++] = startIdx;
+        if (values) {
+            for (uint i = 0; i < count; i++) {
+                payload[index++] = values[i] & 0xFF;
+                payload[index++] = values[i] >> 8;
+            }
+        } else {
+            payload[index++] = count;
+        }
+        
+        uint8_t buffer[FrameCodec::MAX_ENCODED];
+        size_t length = FrameCodec::encodeFrame(seq, frameType, payload, index, buffer);
+        _writer.write(buffer, length);
+        return;
+    }
+    
+    uint8_t buffer[3 + 2 * MAX_VALUES]; // Header (3 bytes) + values (2 bytes each)
+    uint16_t index = 0;
+    
+    // Komut headerı ekle
+    buffer[index++] = cmd;
+    buffer[index++] = startIdx;
+    buffer[index++] = count;
+    
+    // Değerleri ekle
+    if (values) {
+        for (uint i = 0; i < count; i++) {
+            uint8_t low_byte, high_byte;
+            encodeValue(values[i], low_byte, high_byte);
+            buffer[index++] = low_byte;
+            buffer[index++] = high_byte;
+        }
+    }
+    
+    // Yanıtı bütün olarak yazıcıya ekle, gönderim zamanını yazıcı belirler
+    _writer.write(buffer, index);
 }
 
 void CommProtocol::encodeValue(uint16_t value, uint8_t& low_byte, uint8_t& high_byte) {
@@ -139,6 +1051,9 @@ uint16_t CommProtocol::decodeValue(uint8_t low_byte, uint8_t high_byte) {
 
 void CommProtocol::_resetPacketState() {
     _receivingPacket = false;
+    _currentPacket.mask = 0;
+    _currentPacket.applyAt_us = 0;
+    _awaitingVersion = false;
     _byteCounter = 0;
     _valueByteCounter = 0;
     _valueIdx = 0;
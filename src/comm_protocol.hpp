@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <vector>
 #include "pico/stdlib.h"
+#include "frame_codec.hpp"
+#include "response_writer.hpp"
 
 /**
  * @brief CDC USB protokolü için komut ve yanıt yapılarını tanımlayan sınıf
@@ -12,6 +14,84 @@ public:
     // Komut sabitleri
     static constexpr uint8_t SET_CMD = 0x53 | 0x80;  // 'S' with MSB set = 0xD3
     static constexpr uint8_t GET_CMD = 0x47 | 0x80;  // 'G' with MSB set = 0xC7
+    static constexpr uint8_t MODE_CMD = 0x56 | 0x80; // 'V' with MSB set = 0xD6, ardından protokol sürümü
+    static constexpr uint8_t KEYFRAME_CMD = 0x4B | 0x80; // 'K' with MSB set = 0xCB
+    static constexpr uint8_t SUBSCRIBE_CMD = 0x54 | 0x80; // 'T' with MSB set = 0xD4, telemetri aboneliği ve push çerçevesi
+    static constexpr uint8_t DISCOVER_CMD = 0x44 | 0x80;  // 'D' with MSB set = 0xC4, register haritası sorgusu (tek byte)
+    static constexpr uint8_t SNAPSHOT_CMD = 0x41 | 0x80;  // 'A' with MSB set = 0xC1, tüm register'ların anlık görüntüsü (tek byte)
+    static constexpr uint8_t READ_LIST_CMD = 0x52 | 0x80; // 'R' with MSB set = 0xD2, indeks listesiyle okuma
+    static constexpr uint8_t WRITE_LIST_CMD = 0x57 | 0x80; // 'W' with MSB set = 0xD7, indeks listesiyle yazma
+    static constexpr uint8_t DELTA_CMD = 0x55 | 0x80;      // 'U' with MSB set = 0xD5, servo fark karesi
+    static constexpr uint8_t TIME_SYNC_CMD = 0x43 | 0x80;  // 'C' with MSB set = 0xC3, saat eşitleme (ardından çerez)
+    static constexpr uint8_t SCHEDULE_CMD = 0x51 | 0x80;   // 'Q' with MSB set = 0xD1, cihaz zamanında uygulanacak SET
+    static constexpr uint8_t POSE_CMD = 0x50 | 0x80;       // 'P' with MSB set = 0xD0, gövde pozu ve ayak hedefleri (cihazda IK)
+    static constexpr uint8_t GAIT_CMD = 0x4D | 0x80;       // 'M' with MSB set = 0xCD, cihazda yürüyüş üreteci komutu
+    static constexpr uint8_t ANGLE_CMD = 0x4E | 0x80;      // 'N' with MSB set = 0xCE, servo açıları (kalibrasyonla darbeye çevrilir)
+    static constexpr uint8_t CALIBRATE_CMD = 0x42 | 0x80;  // 'B' with MSB set = 0xC2, servo kalibrasyonu yazma/sorgulama
+    static constexpr uint8_t LED_FRAME_CMD = 0x4C | 0x80;  // 'L' with MSB set = 0xCC, 6 LED için 24-bit renkler
+    static constexpr uint8_t GPIO_EDGES_CMD = 0x45 | 0x80; // 'E' with MSB set = 0xC5, GPIO kenar halkasını boşaltma (ardından en fazla kenar sayısı)
+    static constexpr uint8_t DIAG_CMD = 0x58 | 0x80;       // 'X' with MSB set = 0xD8, tanılama sayfası okuma (sayfa, ilk değer, sayı)
+    
+    // KEYFRAME başlığı: startIdx, count, tür, süre (2 x 7-bit)
+    static constexpr uint8_t KEYFRAME_HEADER_SIZE = 5;
+    
+    // SUBSCRIBE: startIdx, count, abonelik yuvası, periyot ms (2 x 7-bit)
+    static constexpr uint8_t SUBSCRIBE_HEADER_SIZE = 5;
+    
+    // SCHEDULE başlığı: startIdx, count, uygulama zamanı μs (5 x 7-bit)
+    static constexpr uint8_t SCHEDULE_HEADER_SIZE = 7;
+    
+    // POSE: gövde x, y, z, roll, pitch, yaw ve 6 ayak için x, y, z (işaretli 14-bit, 0.1 mm / 0.1°)
+    static constexpr uint8_t POSE_VALUES = 24;
+    
+    // GAIT: desen, ileri hız, yana hız, dönüş hızı, adım yüksekliği, döngü süresi ms (işaretli 14-bit, 0.1 mm/s / 0.1°/s / 0.1 mm)
+    static constexpr uint8_t GAIT_VALUES = 6;
+    
+    // CALIBRATE: min, mid, max (μs), yön (±1), ofset (0.1°), ardından nokta başına açı (0.1°) ve darbe (μs)
+    static constexpr uint8_t CALIBRATE_BASE_VALUES = 5;
+    
+    // LED_FRAME: LED başına 24-bit renk (0xRRGGBB); eski protokolde 4 x 7-bit, düşük bitler önce
+    static constexpr uint8_t LED_FRAME_LEDS = 6;
+    static constexpr uint8_t LED_FRAME_COLOR_BYTES = 4;
+    
+    // GPIO_EDGES: yanıt veya push başına en fazla kenar; kenar kodu bit 0-1 pin, bit 2 seviye
+    static constexpr uint8_t GPIO_EDGES_MAX = 32;
+    static constexpr uint8_t GPIO_EDGE_LEVEL = 0x04;
+    
+    // DIAG: istek başlığı sayfa, ilk değer, sayı (en fazla MAX_VALUES)
+    static constexpr uint8_t DIAG_HEADER_SIZE = 3;
+    
+    // DELTA: servo maskesi (3 x 7-bit), ardından maskedeki her servo için fark
+    static constexpr uint8_t DELTA_MASK_SIZE = 3;
+    static constexpr uint32_t DELTA_SERVO_MASK = 0x3FFFF;    // 18 servo biti
+    static constexpr uint32_t DELTA_KEY_FLAG = 1u << 20;     // Anahtar kare: değerler mutlak, fark zinciri yeniden başlar
+    static constexpr uint8_t DELTA_ESCAPE_LEGACY = 0x40;     // 7-bit fark yerine 14-bit fark (2 x 7-bit) gelir
+    static constexpr uint8_t DELTA_ESCAPE = 0x80;            // v2: 8-bit fark yerine i16 LE fark gelir
+    
+    // v2 çerçeve tipleri
+    static constexpr uint8_t FRAME_SET = 0x53;       // 'S': [startIdx][değerler (u16 LE)...]
+    static constexpr uint8_t FRAME_GET = 0x47;       // 'G': istek [startIdx][count], yanıt SET ile aynı düzende
+    static constexpr uint8_t FRAME_MODE = 0x56;      // 'V': [sürüm], 1 ile eski protokole dönülür
+    static constexpr uint8_t FRAME_KEYFRAME = 0x4B;  // 'K': [startIdx][tür][süre ms u16 LE][u16 LE hedefler...]
+    static constexpr uint8_t FRAME_SUBSCRIBE = 0x54; // 'T': istek [yuva][startIdx][count][periyot ms u16 LE], push [yuva][startIdx][zaman μs u32 LE][u16 LE değerler...]
+    static constexpr uint8_t FRAME_DISCOVER = 0x44;  // 'D': istek boş, yanıt [sürüm][aralık sayısı][base, uzunluk, tür, erişim]...
+    static constexpr uint8_t FRAME_SNAPSHOT = 0x41;  // 'A': istek boş, yanıt [count][zaman μs u32 LE][u16 LE değerler...]
+    static constexpr uint8_t FRAME_READ_LIST = 0x52; // 'R': istek [indeksler...], yanıt [u16 LE değerler...] istek sırasıyla
+    static constexpr uint8_t FRAME_WRITE_LIST = 0x57; // 'W': [indeks][u16 LE değer]...
+    static constexpr uint8_t FRAME_DELTA = 0x55;     // 'U': [maske u24 LE][i8 fark veya 0x80 + i16 LE fark]..., anahtar karede u16 LE değerler
+    static constexpr uint8_t FRAME_TIME_SYNC = 0x43; // 'C': istek boş (sıra no çerezdir), yanıt [alım zamanı μs u32 LE][gönderim zamanı μs u32 LE]
+    static constexpr uint8_t FRAME_SCHEDULE = 0x51;  // 'Q': [startIdx][uygulama zamanı μs u32 LE][u16 LE değerler...]
+    static constexpr uint8_t FRAME_POSE = 0x50;      // 'P': [24 x i16 LE], POSE komutuyla aynı sıra
+    static constexpr uint8_t FRAME_GAIT = 0x4D;      // 'M': [6 x i16 LE], GAIT komutuyla aynı sıra
+    static constexpr uint8_t FRAME_ANGLE = 0x4E;     // 'N': [startIdx][i16 LE açılar (0.1°)...]
+    static constexpr uint8_t FRAME_CALIBRATE = 0x42; // 'B': istek [servo] (sorgu) veya [servo][i16 LE değerler...], yanıt [servo][i16 LE değerler...]
+    static constexpr uint8_t FRAME_LED = 0x4C;       // 'L': [6 x R, G, B]
+    static constexpr uint8_t FRAME_GPIO_EDGES = 0x45; // 'E': istek boş veya [en fazla kenar], yanıt ve push [count][kalan][kayıp u16 LE][kod, zaman μs u32 LE]...
+    static constexpr uint8_t FRAME_DIAG = 0x58;      // 'X': istek [sayfa][ilk][count], yanıt [sayfa][ilk][u16 LE değerler...]
+    
+    // Protokol sürümleri
+    static constexpr uint8_t PROTOCOL_LEGACY = 1;    // 7-bit paketli 0xD3/0xC7 protokolü
+    static constexpr uint8_t PROTOCOL_FRAMED = 2;    // COBS + sıra no + CRC16
     
     // Maksimum değer sayısı
     static constexpr uint MAX_VALUES = 32;
@@ -20,8 +100,24 @@ public:
      * @brief Komut türleri
      */
     enum class CommandType {
-        SET,  // Değerleri ayarla
-        GET   // Değerleri oku
+        SET,      // Değerleri ayarla
+        GET,      // Değerleri oku
+        KEYFRAME, // Servo yörüngesine anahtar kare ekle
+        SUBSCRIBE, // Periyodik telemetri aboneliği başlat/durdur
+        DISCOVER, // Register haritasını sorgula
+        SNAPSHOT, // Tüm register'ları tek tutarlı yanıtla oku
+        READ_LIST, // Ardışık olmayan register listesini oku
+        WRITE_LIST, // Ardışık olmayan register listesine yaz
+        DELTA,    // Servo fark karesi (veya anahtar kare)
+        TIME_SYNC, // Saat eşitleme isteği
+        SCHEDULE, // Belirli bir cihaz zamanında uygulanacak SET
+        POSE,     // Gövde pozu ve ayak hedefleri, eklem açıları cihazda hesaplanır
+        GAIT,     // Yürüyüş deseni ve hızı, ayak yörüngeleri cihazda üretilir
+        ANGLE,    // Servo açıları, darbe genişliği cihazda kalibrasyonla hesaplanır
+        CALIBRATE, // Servo kalibrasyonunu yaz (değer yoksa sadece sorgula)
+        LED_FRAME, // Tüm LED'lerin 24-bit renkleri tek pakette
+        GPIO_EDGES, // GPIO kenar halkasını boşalt (count: en fazla kenar, 0 = GPIO_EDGES_MAX)
+        DIAG      // Tanılama sayfası oku (slot: sayfa, startIdx: ilk değer, count: değer sayısı)
     };
     
     /**
@@ -31,10 +127,20 @@ public:
         CommandType type;     // Komut türü
         uint8_t startIdx;     // Başlangıç indeksi
         uint8_t count;        // Değer sayısı
-        uint16_t values[MAX_VALUES];  // Değerler dizisi (sadece SET komutu için)
+        uint8_t seq;          // Sıra numarası (v2 çerçeveleri; eski protokolde TIME_SYNC çerezi), yanıtta geri gönderilir
+        uint8_t interpolation; // Enterpolasyon türü (sadece KEYFRAME)
+        uint16_t durationMs;  // Anahtar kare süresi, ms (sadece KEYFRAME)
+        uint8_t slot;         // Abonelik yuvası (SUBSCRIBE), tanılama sayfası (DIAG)
+        uint16_t periodMs;    // Push periyodu, ms, 0 = iptal (sadece SUBSCRIBE)
+        uint32_t mask;        // Servo maskesi ve DELTA_KEY_FLAG (sadece DELTA)
+        uint32_t applyAt_us;  // Uygulama zamanı, cihaz saatiyle μs (sadece SCHEDULE)
+        uint8_t indices[MAX_VALUES];  // Register indeksleri (sadece READ_LIST/WRITE_LIST)
+        uint16_t values[MAX_VALUES];  // Değerler dizisi (SET; DELTA'da maske sırasıyla i16 farklar veya mutlak değerler; POSE, GAIT, ANGLE ve CALIBRATE'te i16; LED_FRAME'de LED başına düşük 16 ve yüksek 8 bit)
         
-        CommandPacket() : type(CommandType::SET), startIdx(0), count(0) {
+        CommandPacket() : type(CommandType::SET), startIdx(0), count(0), seq(0), interpolation(0), durationMs(0),
+                          slot(0), periodMs(0), mask(0), applyAt_us(0) {
             for (uint i = 0; i < MAX_VALUES; i++) {
+                indices[i] = 0;
                 values[i] = 0;
             }
         }
@@ -54,6 +160,47 @@ public:
      */
     bool processByte(uint8_t byte);
     
+    /**
+     * @brief Alınan byte dizisini etkin protokol moduna göre toplu işler
+     * 
+     * Tam bir paket bulunduğunda durur; kalan byte'lar tekrar çağrılarak işlenir.
+     * 
+     * @param data Alınan veri
+     * @param len Veri uzunluğu
+     * @param packetReady Tam bir paket alındıysa true
+     * @return uint32_t Tüketilen byte sayısı
+     */
+    uint32_t processBuffer(const uint8_t* data, uint32_t len, bool& packetReady);
+    
+    /**
+     * @brief Etkin protokol sürümünü döndürür
+     * 
+     * @return uint8_t PROTOCOL_LEGACY veya PROTOCOL_FRAMED
+     */
+    uint8_t getProtocolVersion() const;
+    
+    /**
+     * @brief Protokol sürümünü ayarlar (bağlantı koptuğunda eski moda dönmek için)
+     * 
+     * @param version PROTOCOL_LEGACY veya PROTOCOL_FRAMED
+     */
+    void setProtocolVersion(uint8_t version);
+    
+    /**
+     * @brief v2 çerçeve sayaçlarını döndürür
+     */
+    const FrameParser::Stats& getFrameStats() const;
+    
+    /**
+     * @brief CRC'si geçerli fakat içeriği geçersiz olan v2 çerçeve sayısını döndürür
+     */
+    uint32_t getRejectedFrames() const;
+    
+    /**
+     * @brief Yanıtların gönderildiği yazıcıyı döndürür (grup sonu, son tarih ve sayaçlar için)
+     */
+    ResponseWriter& getResponseWriter();
+    
     /**
      * @brief En son alınan komut paketini alır
      * 
@@ -74,8 +221,123 @@ public:
      * @param startIdx Başlangıç indeksi
      * @param count Değer sayısı
      * @param values Değerler dizisi
+     * @param seq İsteğin sıra numarası (v2)
+     */
+    void sendGetResponse(uint8_t startIdx, uint8_t count, const uint16_t* values, uint8_t seq = 0);
+    
+    /**
+     * @brief READ_LIST yanıtını gönderir (değerler istekteki indeks sırasıyla)
+     * 
+     * Eski protokolde: [0xD2][count][değerler 2 x 7-bit...]
+     * v2'de: 'R' çerçevesi [u16 LE değerler...]
+     * 
+     * @param count Değer sayısı
+     * @param values Değerler dizisi
+     * @param seq İsteğin sıra numarası (v2)
+     */
+    void sendListResponse(uint8_t count, const uint16_t* values, uint8_t seq = 0);
+    
+    /**
+     * @brief Abonelik için zaman damgalı telemetri çerçevesi gönderir (yanıt beklenmez)
+     * 
+     * Eski protokolde: [0xD4][yuva][startIdx][count][zaman ms 3 x 7-bit][değerler 2 x 7-bit...]
+     * v2'de: 'T' çerçevesi, sıra no yuvanın push sayacıdır.
+     * 
+     * @param slot Abonelik yuvası
+     * @param seq Yuvanın push sıra numarası (v2)
+     * @param startIdx Başlangıç indeksi
+     * @param count Değer sayısı
+     * @param timestamp_us Örnek zamanı (μs)
+     * @param values Değerler dizisi
+     * @return true Çerçeve gönderim tamponuna eklendi
+     * @return false Tampon dolu veya bağlantı yok, çerçeve atıldı
      */
-    void sendGetResponse(uint8_t startIdx, uint8_t count, const uint16_t* values);
+    bool sendTelemetry(uint8_t slot, uint8_t seq, uint8_t startIdx, uint8_t count,
+                       uint32_t timestamp_us, const uint16_t* values);
+    
+    /**
+     * @brief DISCOVER yanıtı olarak register haritasını gönderir
+     * 
+     * Eski protokolde: [0xC4][sürüm][aralık sayısı][base, uzunluk, tür, erişim]...
+     * (tüm alanlar 7-bit). v2'de aynı yük 'D' çerçevesiyle gönderilir.
+     * 
+     * @param seq İsteğin sıra numarası (v2)
+     */
+    void sendDiscovery(uint8_t seq = 0);
+    
+    /**
+     * @brief SNAPSHOT yanıtını gönderir (0'dan başlayan tüm register'lar)
+     * 
+     * Eski protokolde: [0xC1][count][zaman μs 5 x 7-bit][değerler 2 x 7-bit...]
+     * v2'de: 'A' çerçevesi [count][zaman μs u32 LE][u16 LE değerler...]
+     * 
+     * @param timestamp_us Değerlerin alındığı zaman (μs)
+     * @param count Değer sayısı (en fazla RegisterMap::NUM_MAPPED)
+     * @param values Değerler dizisi
+     * @param seq İsteğin sıra numarası (v2)
+     */
+    void sendSnapshot(uint32_t timestamp_us, uint8_t count, const uint16_t* values, uint8_t seq = 0);
+    
+    /**
+     * @brief TIME_SYNC yanıtını gönderir
+     * 
+     * Gönderim zamanı kodlamadan hemen önce alınır. Host isteği gönderdiği
+     * (t0) ve yanıtı aldığı (t3) zamanlarla birlikte NTP'deki gibi saat
+     * farkını ((rx - t0) + (tx - t3)) / 2 ve gidiş-dönüş süresini hesaplar.
+     * 
+     * Eski protokolde: [0xC3][çerez][alım zamanı μs 5 x 7-bit][gönderim zamanı μs 5 x 7-bit]
+     * v2'de: 'C' çerçevesi [alım zamanı μs u32 LE][gönderim zamanı μs u32 LE]
+     * 
+     * @param rx_us İsteğin USB'den okunduğu zaman (μs)
+     * @param seq İsteğin sıra numarası veya çerezi
+     */
+    void sendTimeSync(uint32_t rx_us, uint8_t seq = 0);
+    
+    /**
+     * @brief Servonun kalibrasyon kaydını gönderir (CALIBRATE yanıtı)
+     * 
+     * Eski protokolde: [0xC2][servo][count][değerler 2 x 7-bit, işaretli...]
+     * v2'de: 'B' çerçevesi [servo][i16 LE değerler...]
+     * 
+     * @param servo Servo indeksi
+     * @param count Değer sayısı
+     * @param values Değerler (i16, CALIBRATE komutuyla aynı sıra)
+     * @param seq İsteğin sıra numarası (v2)
+     */
+    void sendCalibration(uint8_t servo, uint8_t count, const uint16_t* values, uint8_t seq = 0);
+    
+    /**
+     * @brief Zaman damgalı GPIO kenarlarını gönderir (GPIO_EDGES yanıtı veya push)
+     * 
+     * Eski protokolde: [0xC5][count][kalan][kayıp 2 x 7-bit][kod, zaman μs 5 x 7-bit]...
+     * v2'de: 'E' çerçevesi [count][kalan][kayıp u16 LE][kod, zaman μs u32 LE]...
+     * Kod bit 0-1 banka pini, bit 2 kenardan sonraki seviyedir.
+     * 
+     * @param count Kenar sayısı (en fazla GPIO_EDGES_MAX)
+     * @param remaining Halkada kalan kenar sayısı (127'de doyar)
+     * @param dropped Halka dolu olduğu için kaybedilen kenar sayısı (14-bit'te doyar)
+     * @param codes Kenar kodları
+     * @param times_us Kenar zamanları (μs)
+     * @param seq İsteğin sıra numarası veya push sayacı (v2)
+     * @return true Gönderim tamponuna eklendi
+     * @return false Tampon dolu veya bağlantı yok
+     */
+    bool sendGpioEdges(uint8_t count, uint8_t remaining, uint16_t dropped,
+                       const uint8_t* codes, const uint32_t* times_us, uint8_t seq = 0);
+    
+    /**
+     * @brief Tanılama sayfasından değerleri gönderir (DIAG yanıtı)
+     * 
+     * Eski protokolde: [0xD8][sayfa][ilk][count][değerler 2 x 7-bit]...
+     * v2'de: 'X' çerçevesi [sayfa][ilk][u16 LE değerler...]
+     * 
+     * @param page Sayfa numarası
+     * @param first Sayfadaki ilk değerin indeksi
+     * @param count Değer sayısı (en fazla MAX_VALUES)
+     * @param values Değerler (eski protokolde 14-bit'te doyar)
+     * @param seq İsteğin sıra numarası (v2)
+     */
+    void sendDiagnostics(uint8_t page, uint8_t first, uint8_t count, const uint16_t* values, uint8_t seq = 0);
     
     /**
      * @brief 14-bit değeri iki 7-bit byte'a kodlar
@@ -94,13 +356,57 @@ public:
      * @return uint16_t 14-bit değer
      */
     uint16_t decodeValue(uint8_t low_byte, uint8_t high_byte);
-    
+
 private:
+    /**
+     * @brief Eski protokolde DELTA komutunun bir byte'ını işler
+     * 
+     * @param byte Alınan byte
+     * @return true Paket tamamlandı
+     */
+    bool _processDeltaByte(uint8_t byte);
+    
+    /**
+     * @brief v2 DELTA çerçeve yükünü pakete çözer
+     * 
+     * @param payload Yük
+     * @param length Yük uzunluğu
+     * @return true Yük geçerli
+     */
+    bool _decodeDelta(const uint8_t* payload, uint length);
+    
     CommandPacket _currentPacket;   // Mevcut komut paketi
     bool _receivingPacket;          // Paket alınıyor bayrağı
     uint8_t _byteCounter;           // Paket içinde alınan byte sayısı
     uint8_t _valueByteCounter;      // Değerler dizisinde alınan byte sayısı
     uint8_t _valueIdx;              // Şu anki değer indeksi
+    bool _awaitingVersion;          // MODE_CMD sonrası sürüm byte'ı bekleniyor
+    uint8_t _protocolVersion;       // Etkin protokol sürümü
+    FrameParser _frameParser;       // v2 çerçeve ayrıştırıcı
+    uint32_t _rejectedFrames;       // İçeriği geçersiz v2 çerçeveleri
+    ResponseWriter _writer;         // Yanıt yazıcısı (TX birleştirme)
+    
+    /**
+     * @brief Doğrulanmış bir v2 çerçevesini komut paketine dönüştürür
+     * 
+     * @param frame Çerçeve
+     * @return true Komut paketi hazır
+     * @return false Paket üretmeyen veya geçersiz çerçeve
+     */
+    bool _decodeFrame(const FrameParser::Frame& frame);
+    
+    /**
+     * @brief Etkin moda göre değerli bir yanıt kodlayıp gönderir
+     * 
+     * @param cmd Komut byte'ı (eski protokol)
+     * @param frameType Çerçeve tipi (v2)
+     * @param seq Sıra numarası (v2)
+     * @param startIdx Başlangıç indeksi
+     * @param count Değer sayısı
+     * @param values Değerler dizisi (nullptr ise sadece başlık)
+     */
+    void _sendValues(uint8_t cmd, uint8_t frameType, uint8_t seq,
+                     uint8_t startIdx, uint8_t count, const uint16_t* values);
     
     /**
      * @brief Paket işleme durumunu sıfırlar
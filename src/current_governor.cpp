@@ -0,0 +1,55 @@
+#include "current_governor.hpp"
+
+CurrentGovernor::CurrentGovernor() :
+    _budget_mA(0),
+    _estimate(0),
+    _peak_mA(0),
+    _scale(SCALE_ONE),
+    _throttledMs(0),
+    _throttledRemainderUs(0),
+    _throttleEvents(0) {
+}
+
+void CurrentGovernor::setBudget(uint32_t budget_mA) {
+    _budget_mA = budget_mA;
+}
+
+void CurrentGovernor::sample(int32_t current_mA) {
+    int32_t sample = (current_mA < 0) ? 0 : current_mA;
+    _estimate += ((sample << 4) - _estimate) >> FILTER_SHIFT;
+    
+    uint32_t estimate = getEstimate();
+    if (estimate > _peak_mA) {
+        _peak_mA = estimate;
+    }
+}
+
+uint16_t CurrentGovernor::update(uint32_t dt_us) {
+    uint16_t previous = _scale;
+    uint32_t estimate = getEstimate();
+    
+    if (_budget_mA == 0) {
+        _scale = SCALE_ONE;
+    } else if (estimate >= _budget_mA) {
+        // Bütçe aşıldı: en düşük ölçek, bir sonraki adımda akım düşmeye başlar
+        _scale = SCALE_MIN;
+    } else if (estimate >= _budget_mA - _budget_mA / 8) {
+        // Bütçeye yaklaşıldı: her adımda dörtte bir kısılır
+        uint16_t scale = (uint16_t)(_scale - _scale / 4);
+        _scale = (scale < SCALE_MIN) ? SCALE_MIN : scale;
+    } else if (estimate < _budget_mA - _budget_mA / 4) {
+        // Yeterli pay var: ölçek adım adım açılır (aradaki bantta olduğu gibi kalır)
+        uint32_t scale = (uint32_t)_scale + SCALE_RECOVER;
+        _scale = (scale > SCALE_ONE) ? SCALE_ONE : (uint16_t)scale;
+    }
+    
+    if (previous == SCALE_ONE && _scale < SCALE_ONE) {
+        _throttleEvents++;
+    }
+    if (_scale < SCALE_ONE) {
+        _throttledRemainderUs += dt_us;
+        _throttledMs += _throttledRemainderUs / 1000;
+        _throttledRemainderUs %= 1000;
+    }
+    return _scale;
+}
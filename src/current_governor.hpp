@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Besleme akımı bütçesine göre hareket kısıcı
+ * 
+ * Şönt ölçümünden gelen her akım örneği hızlı bir filtreden geçirilir.
+ * update() her kontrol adımında çağrılır ve filtrelenmiş akım bütçeye
+ * yaklaştıkça hareket ölçeğini (Q8, SCALE_ONE = tam hız) düşürür, akım
+ * bütçenin altına indikçe ölçeği adım adım geri açar. Ölçek hız
+ * sınırlayıcıya verilir: sınırlı servoların hız ve ivme sınırları ölçeklenir,
+ * sınırsız servoların hedefleri ise kontrol adımlarına sırayla dağıtılır.
+ * Komut atılmaz, sadece çıkış hedefe daha geç ulaşır.
+ * 
+ * Tepe akım, kısılmış geçen süre ve kısma olayları gait ayarı için
+ * tutulur. Donanımdan bağımsızdır, host üzerinde de derlenebilir.
+ */
+class CurrentGovernor {
+public:
+    static constexpr uint16_t SCALE_ONE = 256;      // Tam hız (Q8)
+    static constexpr uint16_t SCALE_MIN = 8;        // En düşük ölçek, hareket hiç durmaz
+    static constexpr uint16_t SCALE_RECOVER = 32;   // Akım düşükken adım başına ölçek artışı
+    static constexpr uint32_t FILTER_SHIFT = 1;     // Filtre katsayısı: yeni = eski + (örnek - eski) >> FILTER_SHIFT
+    
+    /**
+     * @brief Yapılandırıcı, bütçe kapalı (0) başlar
+     */
+    CurrentGovernor();
+    
+    /**
+     * @brief Akım bütçesini ayarlar
+     * 
+     * Kısma bütçenin 7/8'inde başlar, tüm bütçe aşılırsa ölçek doğrudan
+     * SCALE_MIN'e iner. Akım bütçenin 3/4'ünün altına inince ölçek geri açılır.
+     * 
+     * @param budget_mA Bütçe (mA), 0 = kısıcı kapalı
+     */
+    void setBudget(uint32_t budget_mA);
+    
+    /**
+     * @brief Akım bütçesini döndürür (mA)
+     */
+    uint32_t getBudget() const {
+        return _budget_mA;
+    }
+    
+    /**
+     * @brief Yeni akım örneğini filtreye ve tepe değere işler
+     * 
+     * @param current_mA Ölçülen akım (mA), negatif değerler 0 sayılır
+     */
+    void sample(int32_t current_mA);
+    
+    /**
+     * @brief Bir kontrol adımı için hareket ölçeğini hesaplar
+     * 
+     * @param dt_us Önceki adımdan bu yana geçen süre (μs)
+     * @return uint16_t Hareket ölçeği (Q8, SCALE_MIN..SCALE_ONE)
+     */
+    uint16_t update(uint32_t dt_us);
+    
+    /**
+     * @brief Tepe akımı sıfırlar, sonraki örnekten yeniden izlenir
+     */
+    void resetPeak() {
+        _peak_mA = 0;
+    }
+    
+    /**
+     * @brief Filtrelenmiş akım (mA)
+     */
+    uint32_t getEstimate() const {
+        return (uint32_t)(_estimate >> 4);
+    }
+    
+    /**
+     * @brief Son sıfırlamadan bu yana görülen en yüksek filtrelenmiş akım (mA)
+     */
+    uint32_t getPeak() const {
+        return _peak_mA;
+    }
+    
+    /**
+     * @brief Hareket ölçeği (Q8)
+     */
+    uint16_t getScale() const {
+        return _scale;
+    }
+    
+    /**
+     * @brief Ölçeğin SCALE_ONE'ın altında geçirdiği toplam süre (ms)
+     */
+    uint32_t getThrottledMs() const {
+        return _throttledMs;
+    }
+    
+    /**
+     * @brief Tam hızdan kısmaya geçiş sayısı
+     */
+    uint32_t getThrottleEvents() const {
+        return _throttleEvents;
+    }
+    
+private:
+    uint32_t _budget_mA;          // Akım bütçesi, 0 = kapalı
+    int32_t _estimate;            // Filtrelenmiş akım (Q4 mA)
+    uint32_t _peak_mA;            // Tepe filtrelenmiş akım
+    uint16_t _scale;              // Hareket ölçeği (Q8)
+    uint32_t _throttledMs;        // Kısılmış geçen süre
+    uint32_t _throttledRemainderUs;  // Henüz ms'ye eklenmemiş kısılmış süre
+    uint32_t _throttleEvents;     // Kısma olayları
+};
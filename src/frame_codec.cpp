@@ -0,0 +1,208 @@
+#include "frame_codec.hpp"
+#include <cstring>
+
+namespace {
+    // CRC16-CCITT tablosu derleme zamanında üretilir
+    struct Crc16Table {
+        uint16_t entries[256];
+        
+        constexpr Crc16Table() : entries() {
+            for (uint16_t i = 0; i < 256; i++) {
+                uint16_t crc = i << 8;
+                for (int bit = 0; bit < 8; bit++) {
+                    crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+                }
+                entries[i] = crc;
+            }
+        }
+    };
+    
+    constexpr Crc16Table CRC16_TABLE;
+}
+
+uint16_t FrameCodec::crc16(const uint8_t* data, size_t len, uint16_t crc) {
+    for (size_t i = 0; i < len; i++) {
+        crc = (uint16_t)(crc << 8) ^ CRC16_TABLE.entries[(crc >> 8) ^ data[i]];
+    }
+    return crc;
+}
+
+size_t FrameCodec::cobsEncode(const uint8_t* in, size_t len, uint8_t* out) {
+    size_t codeIdx = 0;     // Mevcut blok kodunun yazılacağı yer
+    size_t outIdx = 1;
+    uint8_t code = 1;
+    
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[codeIdx] = code;
+            codeIdx = outIdx++;
+            code = 1;
+        } else {
+            out[outIdx++] = in[i];
+            code++;
+            if (code == 0xFF) {
+                out[codeIdx] = code;
+                codeIdx = outIdx++;
+                code = 1;
+            }
+        }
+    }
+    out[codeIdx] = code;
+    
+    return outIdx;
+}
+
+size_t FrameCodec::cobsDecode(const uint8_t* in, size_t len, uint8_t* out, size_t out_size) {
+    size_t inIdx = 0;
+    size_t outIdx = 0;
+    
+    while (inIdx < len) {
+        uint8_t code = in[inIdx++];
+        if (code == 0 || inIdx + code - 1 > len || outIdx + code - 1 > out_size) {
+            return 0;  // Geçersiz kodlama
+        }
+        
+        for (uint8_t i = 1; i < code; i++) {
+            out[outIdx++] = in[inIdx++];
+        }
+        
+        // 0xFF bloğu ve son blok sıfır eklemez
+        if (code != 0xFF && inIdx < len) {
+            if (outIdx >= out_size) {
+                return 0;
+            }
+            out[outIdx++] = 0;
+        }
+    }
+    
+    return outIdx;
+}
+
+size_t FrameCodec::encodeFrame(uint8_t seq, uint8_t type, const uint8_t* payload, size_t len, uint8_t* out) {
+    if (len > MAX_PAYLOAD) {
+        return 0;
+    }
+    
+    uint8_t raw[MAX_FRAME];
+    raw[0] = seq;
+    raw[1] = type;
+    if (len > 0) {
+        memcpy(&raw[HEADER_SIZE], payload, len);
+    }
+    
+    uint16_t crc = crc16(raw, HEADER_SIZE + len);
+    raw[HEADER_SIZE + len] = crc & 0xFF;
+    raw[HEADER_SIZE + len + 1] = crc >> 8;
+    
+    size_t encoded = cobsEncode(raw, HEADER_SIZE + len + CRC_SIZE, out);
+    out[encoded++] = DELIMITER;
+    return encoded;
+}
+
+FrameParser::FrameParser() {
+    reset();
+}
+
+void FrameParser::reset() {
+    _pendingLen = 0;
+    _discarding = false;
+    _frame = {0, 0, 0, _decoded};
+    _stats = {0, 0, 0, 0, 0, 0};
+    _lastSeq = 0;
+    _haveSeq = false;
+}
+
+size_t FrameParser::feed(const uint8_t* data, size_t len, bool& frameReady) {
+    size_t consumed = 0;
+    frameReady = false;
+    
+    while (consumed < len) {
+        const uint8_t* start = data + consumed;
+        size_t remaining = len - consumed;
+        const uint8_t* delim = (const uint8_t*)memchr(start, FrameCodec::DELIMITER, remaining);
+        size_t chunk = delim ? (size_t)(delim - start) : remaining;
+        
+        if (!delim) {
+            // Ayraç yok: parçayı biriktir ve sonraki veriyi bekle
+            if (!_discarding) {
+                if (_pendingLen + chunk > sizeof(_pending)) {
+                    _stats.overflowErrors++;
+                    _pendingLen = 0;
+                    _discarding = true;
+                } else {
+                    memcpy(&_pending[_pendingLen], start, chunk);
+                    _pendingLen += chunk;
+                }
+            }
+            return len;
+        }
+        
+        consumed += chunk + 1;  // Ayraç dahil
+        
+        if (_discarding) {
+            // Taşma sonrası ilk ayraç: yeniden senkronize ol
+            _discarding = false;
+            _pendingLen = 0;
+            continue;
+        }
+        
+        bool valid;
+        if (_pendingLen == 0) {
+            // Çerçeve tamamen gelen tamponda, kopyalamadan çöz
+            if (chunk == 0) {
+                continue;  // Boş çerçeve (ardışık ayraç)
+            }
+            valid = _decodeFrame(start, chunk);
+        } else {
+            if (_pendingLen + chunk > sizeof(_pending)) {
+                _stats.overflowErrors++;
+                _pendingLen = 0;
+                continue;
+            }
+            memcpy(&_pending[_pendingLen], start, chunk);
+            valid = _decodeFrame(_pending, _pendingLen + chunk);
+            _pendingLen = 0;
+        }
+        
+        if (valid) {
+            frameReady = true;
+            return consumed;
+        }
+    }
+    
+    return consumed;
+}
+
+bool FrameParser::_decodeFrame(const uint8_t* encoded, size_t len) {
+    size_t decodedLen = FrameCodec::cobsDecode(encoded, len, _decoded, sizeof(_decoded));
+    if (decodedLen == 0) {
+        _stats.encodingErrors++;
+        return false;
+    }
+    
+    if (decodedLen < FrameCodec::HEADER_SIZE + FrameCodec::CRC_SIZE) {
+        _stats.lengthErrors++;
+        return false;
+    }
+    
+    size_t crcPos = decodedLen - FrameCodec::CRC_SIZE;
+    uint16_t received = _decoded[crcPos] | (_decoded[crcPos + 1] << 8);
+    if (FrameCodec::crc16(_decoded, crcPos) != received) {
+        _stats.crcErrors++;
+        return false;
+    }
+    
+    _frame.length = (uint8_t)(crcPos - FrameCodec::HEADER_SIZE);
+    _frame.seq = _decoded[0];
+    _frame.type = _decoded[1];
+    _frame.payload = &_decoded[FrameCodec::HEADER_SIZE];
+    
+    if (_haveSeq && _frame.seq != (uint8_t)(_lastSeq + 1)) {
+        _stats.sequenceGaps++;
+    }
+    _lastSeq = _frame.seq;
+    _haveSeq = true;
+    
+    _stats.framesOk++;
+    return true;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Protokol v2 çerçeve kodlama yardımcıları (CRC16 ve COBS)
+ * 
+ * Çerçevenin COBS çözülmüş hali:
+ *   [sıra no][tip][yük][CRC16 düşük][CRC16 yüksek]
+ * 
+ * Yük uzunluğu ayraçlar arasındaki çözülmüş boyuttan çıkar, ayrı bir
+ * uzunluk alanı taşınmaz. CRC16-CCITT (0x1021, başlangıç 0xFFFF) sıra
+ * numarasından yükün sonuna kadar hesaplanır. Hat üzerinde çerçeve COBS ile kodlanır ve 0x00 ile
+ * sonlandırılır; böylece bozuk bir byte'tan sonra bir sonraki ayraçta
+ * yeniden senkronize olunur.
+ * 
+ * Donanımdan bağımsızdır, host üzerinde de derlenebilir.
+ */
+class FrameCodec {
+public:
+    static constexpr uint8_t DELIMITER = 0x00;      // Çerçeve ayracı
+    static constexpr size_t HEADER_SIZE = 2;        // sıra no + tip
+    static constexpr size_t CRC_SIZE = 2;           // CRC16 (little-endian)
+    static constexpr size_t MAX_PAYLOAD = 250;      // En büyük yük boyutu
+    static constexpr size_t MAX_FRAME = HEADER_SIZE + MAX_PAYLOAD + CRC_SIZE;
+    
+    // COBS her 254 byte için 1 byte ekler, artı ayraç
+    static constexpr size_t MAX_ENCODED = MAX_FRAME + (MAX_FRAME / 254) + 2;
+    
+    /**
+     * @brief CRC16-CCITT hesaplar
+     * 
+     * @param data Veri
+     * @param len Veri uzunluğu
+     * @param crc Başlangıç değeri (parça parça hesap için)
+     * @return uint16_t CRC değeri
+     */
+    static uint16_t crc16(const uint8_t* data, size_t len, uint16_t crc = 0xFFFF);
+    
+    /**
+     * @brief Veriyi COBS ile kodlar (ayraç eklemez)
+     * 
+     * @param in Giriş verisi
+     * @param len Giriş uzunluğu
+     * @param out Çıkış tamponu (en az len + len / 254 + 1 byte)
+     * @return size_t Kodlanmış uzunluk
+     */
+    static size_t cobsEncode(const uint8_t* in, size_t len, uint8_t* out);
+    
+    /**
+     * @brief COBS kodlu veriyi çözer (ayraç hariç)
+     * 
+     * @param in Kodlanmış veri
+     * @param len Kodlanmış uzunluk
+     * @param out Çıkış tamponu (en az len byte)
+     * @param out_size Çıkış tamponu boyutu
+     * @return size_t Çözülmüş uzunluk, hatalı kodlamada 0
+     */
+    static size_t cobsDecode(const uint8_t* in, size_t len, uint8_t* out, size_t out_size);
+    
+    /**
+     * @brief Tam bir çerçeve oluşturur (başlık, CRC, COBS ve ayraç)
+     * 
+     * @param seq Sıra numarası
+     * @param type Çerçeve tipi
+     * @param payload Yük
+     * @param len Yük uzunluğu (en fazla MAX_PAYLOAD)
+     * @param out Çıkış tamponu (en az MAX_ENCODED byte)
+     * @return size_t Hatta gönderilecek byte sayısı, geçersiz uzunlukta 0
+     */
+    static size_t encodeFrame(uint8_t seq, uint8_t type, const uint8_t* payload, size_t len, uint8_t* out);
+};
+
+/**
+ * @brief Gelen byte akışından v2 çerçevelerini toplu olarak ayıklar
+ */
+class FrameParser {
+public:
+    /**
+     * @brief Doğrulanmış bir çerçeve
+     */
+    struct Frame {
+        uint8_t seq;              // Sıra numarası
+        uint8_t type;             // Çerçeve tipi
+        uint8_t length;           // Yük uzunluğu
+        const uint8_t* payload;   // Yük (bir sonraki feed çağrısına kadar geçerli)
+    };
+    
+    /**
+     * @brief Reddedilen çerçeve sayaçları
+     */
+    struct Stats {
+        uint32_t framesOk;         // Kabul edilen çerçeve
+        uint32_t crcErrors;        // CRC uyuşmazlığı
+        uint32_t lengthErrors;     // Çerçeve başlık ve CRC'den kısa
+        uint32_t encodingErrors;   // Geçersiz COBS kodlaması
+        uint32_t overflowErrors;   // Ayraç gelmeden tampon doldu
+        uint32_t sequenceGaps;     // Sıra numarasında atlama (çerçeve kaybı)
+    };
+    
+    /**
+     * @brief Yapılandırıcı
+     */
+    FrameParser();
+    
+    /**
+     * @brief Ayrıştırıcı durumunu ve sayaçları sıfırlar
+     */
+    void reset();
+    
+    /**
+     * @brief Gelen byte'ları işler, geçerli bir çerçeve bulunduğunda durur
+     * 
+     * Çerçeve tamamen verilen tamponun içindeyse doğrudan oradan çözülür,
+     * aksi halde parçalar iç tamponda biriktirilir.
+     * 
+     * @param data Gelen veri
+     * @param len Veri uzunluğu
+     * @param frameReady Geçerli bir çerçeve bulunduysa true
+     * @return size_t Tüketilen byte sayısı
+     */
+    size_t feed(const uint8_t* data, size_t len, bool& frameReady);
+    
+    /**
+     * @brief Son geçerli çerçeveyi döndürür
+     */
+    const Frame& frame() const { return _frame; }
+    
+    /**
+     * @brief Çerçeve sayaçlarını döndürür
+     */
+    const Stats& stats() const { return _stats; }
+    
+private:
+    uint8_t _pending[FrameCodec::MAX_ENCODED];   // Yarım kalan kodlanmış çerçeve
+    size_t _pendingLen;                          // Biriken byte sayısı
+    bool _discarding;                            // Taşma sonrası ayraca kadar atla
+    uint8_t _decoded[FrameCodec::MAX_FRAME];     // Çözülmüş çerçeve
+    Frame _frame;                                // Son geçerli çerçeve
+    Stats _stats;                                // Sayaçlar
+    uint8_t _lastSeq;                            // Son kabul edilen sıra numarası
+    bool _haveSeq;                               // _lastSeq geçerli mi
+    
+    /**
+     * @brief Kodlanmış bir çerçeveyi çözer ve doğrular
+     * 
+     * @param encoded Kodlanmış çerçeve (ayraç hariç)
+     * @param len Kodlanmış uzunluk
+     * @return true Çerçeve geçerli
+     * @return false Çerçeve reddedildi
+     */
+    bool _decodeFrame(const uint8_t* encoded, size_t len);
+};
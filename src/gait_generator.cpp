@@ -0,0 +1,194 @@
+#include "gait_generator.hpp"
+
+namespace {
+    // Döngü kesirleri (2^32 = tam döngü)
+    constexpr uint32_t SIXTH = 0x2AAAAAAB;
+    constexpr uint32_t THIRD = 0x55555555;
+    constexpr uint32_t HALF = 0x80000000;
+    constexpr uint32_t TWO_THIRDS = 0xAAAAAAAB;
+    constexpr uint32_t FIVE_SIXTHS = 0xD5555555;
+    
+    // 0.1°/s dönüş hızını rad/s'ye çeviren çarpan (Q24): π / 1800 * 2^24
+    constexpr int64_t TURN_TO_RAD_Q24 = 29281;
+    
+    // Bir adımda en fazla çeyrek döngü ilerlenir, uzun bir duraklama bacakları atlatmaz
+    constexpr uint32_t MAX_PHASE_STEP = 0x40000000;
+}
+
+// Bacak sırası: sağ ön, sol ön, sol orta, sol arka, sağ arka, sağ orta
+const GaitGenerator::PatternInfo GaitGenerator::PATTERNS[NUM_PATTERNS] = {
+    {0, {0, 0, 0, 0, 0, 0}},                                        // STOP
+    {HALF, {0, HALF, 0, HALF, 0, HALF}},                            // TRIPOD
+    {THIRD, {TWO_THIRDS, SIXTH, FIVE_SIXTHS, HALF, 0, THIRD}},      // RIPPLE
+    {SIXTH, {2 * SIXTH, FIVE_SIXTHS, 4 * SIXTH, HALF, 0, SIXTH}},   // WAVE
+};
+
+GaitGenerator::GaitGenerator() :
+    _ik(),
+    _legs(),
+    _active(false),
+    _stopping(false),
+    _pattern(Pattern::STOP),
+    _nextPattern(Pattern::STOP),
+    _vx(0),
+    _vy(0),
+    _turnRate(0),
+    _stepHeight(0),
+    _period_us(1000000),
+    _phase(0),
+    _lastUpdate_us(0),
+    _cycles(0),
+    _unreachable(0) {
+    
+    // Nötr ayak noktası montaj yönünde, coxa ekseninden STANCE_REACH uzakta
+    for (size_t leg = 0; leg < NUM_LEGS; leg++) {
+        const HexapodIK::Mount& mount = HexapodIK::MOUNTS[leg];
+        uint16_t yaw = HexapodIK::decidegreesToBam(mount.yaw);
+        _neutral[leg].x = mount.x + ((STANCE_REACH * HexapodIK::cos(yaw) + (1 << 14)) >> 15);
+        _neutral[leg].y = mount.y + ((STANCE_REACH * HexapodIK::sin(yaw) + (1 << 14)) >> 15);
+        _neutral[leg].z = -BODY_HEIGHT;
+    }
+}
+
+void GaitGenerator::setCommand(const Command& cmd) {
+    if (cmd.pattern == Pattern::STOP || (uint8_t)cmd.pattern >= NUM_PATTERNS) {
+        // Bacaklar yerinde adım atarak nötr noktaya iner
+        if (_active) {
+            _stopping = true;
+            _vx = 0;
+            _vy = 0;
+            _turnRate = 0;
+            for (Leg& leg : _legs) {
+                leg.settled = false;
+            }
+        }
+        return;
+    }
+    
+    _vx = cmd.vx;
+    _vy = cmd.vy;
+    _turnRate = cmd.turnRate;
+    _stepHeight = (cmd.stepHeight < 0) ? 0 : cmd.stepHeight;
+    _period_us = (uint32_t)((cmd.periodMs < MIN_PERIOD_MS) ? MIN_PERIOD_MS : cmd.periodMs) * 1000;
+    _nextPattern = cmd.pattern;
+    _stopping = false;
+    
+    if (!_active) {
+        _active = true;
+        _pattern = cmd.pattern;
+        _phase = 0;
+        _lastUpdate_us = 0;
+        for (Leg& leg : _legs) {
+            leg = Leg();
+        }
+        _resetLegs();
+    }
+}
+
+bool GaitGenerator::update(uint32_t now_us, int32_t* angles) {
+    if (!_active) {
+        return false;
+    }
+    
+    // İlk adımda faz ilerlemez, bacaklar nötr duruşa geçer
+    uint32_t dt_us = (_lastUpdate_us == 0) ? 0 : now_us - _lastUpdate_us;
+    _lastUpdate_us = (now_us == 0) ? 1 : now_us;
+    
+    uint64_t step = ((uint64_t)dt_us << 32) / _period_us;
+    uint32_t previous = _phase;
+    _phase += (step > MAX_PHASE_STEP) ? MAX_PHASE_STEP : (uint32_t)step;
+    
+    // Döngü başı: bekleyen desen değişikliği burada uygulanır
+    if (_phase < previous) {
+        _cycles++;
+        if (_nextPattern != _pattern) {
+            _pattern = _nextPattern;
+            _resetLegs();
+        }
+    }
+    
+    HexapodIK::Vec3 feet[NUM_LEGS];
+    bool settled = _stopping;
+    for (size_t leg = 0; leg < NUM_LEGS; leg++) {
+        _stepLeg(leg, dt_us);
+        const Leg& state = _legs[leg];
+        feet[leg].x = _neutral[leg].x + (state.x >> 8);
+        feet[leg].y = _neutral[leg].y + (state.y >> 8);
+        feet[leg].z = _neutral[leg].z + state.z;
+        settled = settled && state.settled;
+    }
+    
+    // Gövde ayakların verildiği çerçevenin orijininde, düz
+    HexapodIK::BodyPose pose = {{0, 0, 0}, 0, 0, 0};
+    _unreachable += _ik.solve(pose, feet, angles);
+    
+    // Son bacak da indiyse yürüyüş biter; açılar nötr duruştadır
+    if (settled) {
+        _active = false;
+        _stopping = false;
+    }
+    return true;
+}
+
+void GaitGenerator::_resetLegs() {
+    const PatternInfo& info = PATTERNS[(uint8_t)_pattern];
+    for (size_t leg = 0; leg < NUM_LEGS; leg++) {
+        Leg& state = _legs[leg];
+        
+        // Konum korunur, sadece faz durumu yeni desene göre kurulur
+        uint32_t legPhase = _phase - info.start[leg];
+        state.swinging = false;
+        state.hold = legPhase < info.swing && legPhase != 0;
+        state.settled = false;
+    }
+}
+
+void GaitGenerator::_stepLeg(size_t leg, uint32_t dt_us) {
+    const PatternInfo& info = PATTERNS[(uint8_t)_pattern];
+    Leg& state = _legs[leg];
+    const HexapodIK::Vec3& neutral = _neutral[leg];
+    uint32_t legPhase = _phase - info.start[leg];
+    
+    // Ayağın gövdeye göre ihtiyaç duyduğu hız: v + ω x p (0.1 mm/s)
+    int32_t vx = _vx - (int32_t)(((int64_t)_turnRate * neutral.y * TURN_TO_RAD_Q24) >> 24);
+    int32_t vy = _vy + (int32_t)(((int64_t)_turnRate * neutral.x * TURN_TO_RAD_Q24) >> 24);
+    
+    // Durdurulurken nötr noktaya inmiş bacak bir daha kalkmaz
+    if (legPhase >= info.swing || state.hold || (_stopping && state.settled)) {
+        // Destek: ayak zeminle birlikte geriye kayar
+        if (legPhase >= info.swing) {
+            state.hold = false;
+        }
+        state.x -= (int32_t)((int64_t)vx * dt_us * 256 / 1000000);
+        state.y -= (int32_t)((int64_t)vy * dt_us * 256 / 1000000);
+        
+        if (state.swinging) {
+            // Salınım bitti, ayak yere iner
+            state.swinging = false;
+            state.settled = _stopping;
+            state.z = 0;
+        } else {
+            // Desen değişikliğinde havada kalan ayak birkaç adımda iner, düşmez
+            state.z >>= 1;
+        }
+        return;
+    }
+    
+    if (!state.swinging) {
+        state.swinging = true;
+        state.liftX = state.x;
+        state.liftY = state.y;
+    }
+    
+    // İniş noktası: destek süresinin ortasında ayak nötr noktadan geçer
+    uint32_t stance_us = (uint32_t)(((uint64_t)_period_us * (uint32_t)(0u - info.swing)) >> 32);
+    int32_t targetX = (int32_t)((int64_t)vx * stance_us * 128 / 1000000);
+    int32_t targetY = (int32_t)((int64_t)vy * stance_us * 128 / 1000000);
+    
+    // Salınım ilerlemesi yarım tur (0..180°) olarak: yatayda yarım kosinüs, düşeyde yarım sinüs
+    uint16_t angle = (uint16_t)(((uint64_t)legPhase << 15) / info.swing);
+    int32_t ease = 32768 - HexapodIK::cos(angle);
+    state.x = state.liftX + (int32_t)(((int64_t)(targetX - state.liftX) * ease) >> 16);
+    state.y = state.liftY + (int32_t)(((int64_t)(targetY - state.liftY) * ease) >> 16);
+    state.z = (_stepHeight * HexapodIK::sin(angle)) >> 15;
+}
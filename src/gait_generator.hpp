@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "hexapod_ik.hpp"
+
+/**
+ * @brief Parametrik yürüme üreteci
+ * 
+ * Gövde hızı, dönüş hızı ve adım yüksekliğinden oluşan kısa bir komuttan
+ * altı bacağın ayak yörüngelerini üretir ve HexapodIK ile eklem açılarına
+ * çevirir. Kontrol adımında çağrılır; faz adım süresi kadar ilerler, bu
+ * yüzden host komut göndermeyi bıraksa da yürüyüş aynı hızla sürer.
+ * 
+ * Her bacak döngünün bir bölümünde havada (salınım), kalanında yerdedir
+ * (destek). Destekteki ayak gövdeye göre zeminin hızıyla geriye kayar;
+ * salınımdaki ayak kalktığı noktadan bir sonraki desteğin ortasına denk
+ * gelecek iniş noktasına yarım kosinüs eğrisiyle taşınır ve yarım sinüs
+ * eğrisiyle kaldırılır. Ayak konumları her adımda bir öncekinden türetildiği
+ * için hız ve dönüş komutları yürürken değiştirilebilir, ayaklar sıçramaz.
+ * 
+ * Desenler (salınım oranı):
+ * - TRIPOD: 1/2, sağ ön/sol orta/sağ arka ile sol ön/sol arka/sağ orta sırayla
+ * - RIPPLE: 1/3, her yanda arkadan öne, iki yan yarım döngü kaydırılmış
+ * - WAVE: 1/6, bacaklar tek tek: sağ arka, sağ orta, sağ ön, sol arka, sol orta, sol ön
+ * 
+ * Tamamen tamsayıdır; donanımdan bağımsızdır, host üzerinde de derlenebilir.
+ */
+class GaitGenerator {
+public:
+    /**
+     * @brief Yürüyüş deseni
+     */
+    enum class Pattern : uint8_t {
+        STOP = 0,       // Bacaklar nötr duruşa inip durur
+        TRIPOD = 1,     // Üçlü, en hızlı
+        RIPPLE = 2,     // Dalgalı, her an en az dört bacak yerde
+        WAVE = 3        // Tek bacak, her an beş bacak yerde
+    };
+    
+    static constexpr size_t NUM_PATTERNS = 4;
+    
+    /**
+     * @brief Yürüyüş komutu
+     */
+    struct Command {
+        Pattern pattern;      // Desen, STOP yürüyüşü bitirir
+        int16_t vx;           // İleri hız (0.1 mm/s)
+        int16_t vy;           // Sola hız (0.1 mm/s)
+        int16_t turnRate;     // Dönüş hızı, saat yönünün tersi pozitif (0.1°/s)
+        int16_t stepHeight;   // Adım yüksekliği (0.1 mm)
+        uint16_t periodMs;    // Bir döngünün süresi (ms)
+    };
+    
+    // Nötr duruş: ayak coxa ekseninden montaj yönünde STANCE_REACH uzakta, gövdenin BODY_HEIGHT altında (0.1 mm)
+    static constexpr int32_t STANCE_REACH = 1100;
+    static constexpr int32_t BODY_HEIGHT = 900;
+    
+    static constexpr uint16_t MIN_PERIOD_MS = 200;   // Daha kısa döngüler bu değere çekilir
+    
+    /**
+     * @brief Yapılandırıcı
+     */
+    GaitGenerator();
+    
+    /**
+     * @brief Yeni yürüyüş komutunu uygular
+     * 
+     * Hız, dönüş ve adım yüksekliği hemen, desen değişikliği bir sonraki
+     * döngü başında geçerli olur. Duran üreteç nötr duruştan başlar. STOP
+     * hızları sıfırlar; her bacak bir kez daha adım atıp nötr noktaya iner
+     * ve tüm bacaklar indiğinde üreteç durur.
+     * 
+     * @param cmd Yürüyüş komutu
+     */
+    void setCommand(const Command& cmd);
+    
+    /**
+     * @brief Fazı ilerletip eklem açılarını hesaplar (kontrol adımında)
+     * 
+     * @param now_us Şu anki zaman (μs)
+     * @param angles NUM_JOINTS eklem açısı (0.01°, servo yönü uygulanmış)
+     * @return true Üreteç çalışıyor, açılar yazıldı
+     * @return false Üreteç duruyor
+     */
+    bool update(uint32_t now_us, int32_t* angles);
+    
+    /**
+     * @brief Üreteç çalışıyor mu
+     */
+    bool isActive() const {
+        return _active;
+    }
+    
+    /**
+     * @brief Etkin desen (duruyorsa STOP)
+     */
+    Pattern getPattern() const {
+        return _active ? _pattern : Pattern::STOP;
+    }
+    
+    /**
+     * @brief Döngü fazı (65536 = tam döngü)
+     */
+    uint16_t getPhase() const {
+        return (uint16_t)(_phase >> 16);
+    }
+    
+    /**
+     * @brief Tamamlanan döngü sayısı
+     */
+    uint32_t getCycles() const {
+        return _cycles;
+    }
+    
+    /**
+     * @brief Hedefi erişim dışında kalan bacak sayısı (adım başına, toplam)
+     */
+    uint32_t getUnreachable() const {
+        return _unreachable;
+    }
+    
+private:
+    static constexpr size_t NUM_LEGS = HexapodIK::NUM_LEGS;
+    
+    /**
+     * @brief Desen tanımı: salınım oranı ve bacakların salınım başlangıç fazları (2^32 = tam döngü)
+     */
+    struct PatternInfo {
+        uint32_t swing;
+        uint32_t start[NUM_LEGS];
+    };
+    
+    static const PatternInfo PATTERNS[NUM_PATTERNS];
+    
+    /**
+     * @brief Bacak durumu; konumlar nötr noktaya göre, Q8 (1/256 x 0.1 mm)
+     */
+    struct Leg {
+        int32_t x;
+        int32_t y;
+        int32_t liftX;        // Salınım başındaki konum
+        int32_t liftY;
+        int32_t z;            // Yerden yükseklik (0.1 mm)
+        bool swinging;        // Salınımda
+        bool hold;            // Salınımın ortasında başladı, ilk destek fazına kadar yerde bekler
+        bool settled;         // Durdurma sırasında nötr noktaya indi
+    };
+    
+    HexapodIK _ik;
+    HexapodIK::Vec3 _neutral[NUM_LEGS];   // Nötr ayak noktaları (gövde çerçevesi, 0.1 mm)
+    Leg _legs[NUM_LEGS];
+    
+    bool _active;
+    bool _stopping;
+    Pattern _pattern;             // Etkin desen
+    Pattern _nextPattern;         // Döngü başında geçilecek desen
+    int32_t _vx;
+    int32_t _vy;
+    int32_t _turnRate;
+    int32_t _stepHeight;
+    uint32_t _period_us;
+    uint32_t _phase;              // Döngü fazı (2^32 = tam döngü)
+    uint32_t _lastUpdate_us;
+    uint32_t _cycles;
+    uint32_t _unreachable;
+    
+    /**
+     * @brief Bacakların faz durumunu etkin desene göre kurar, salınım ortasındakileri bekletir
+     */
+    void _resetLegs();
+    
+    /**
+     * @brief Bacağın bir adımlık hareketi
+     * 
+     * @param leg Bacak indeksi
+     * @param dt_us Adım süresi (μs)
+     */
+    void _stepLeg(size_t leg, uint32_t dt_us);
+};
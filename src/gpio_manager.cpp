@@ -1,67 +1,100 @@
 #include "gpio_manager.hpp"
 #include "hardware/gpio.h"
 
-// Command constants are now defined in the header file
-
-GPIOManager::GPIOManager() {
-}
-
-void GPIOManager::init() {
-    // A0/RELAY pini başlat
-    gpio_init(A0_GPIO_PIN);
-    gpio_set_dir(A0_GPIO_PIN, GPIO_OUT);
-    gpio_put(A0_GPIO_PIN, 0);
+namespace {
+    // GPIO kesme geri çağrısı bağlam almaz, kenarlar tek örneğe yazılır
+    GPIOManager* g_gpioManager = nullptr;
     
-    // A1 pini başlat
-    gpio_init(A1_GPIO_PIN);
-    gpio_set_dir(A1_GPIO_PIN, GPIO_OUT);
-    gpio_put(A1_GPIO_PIN, 0);
-    
-    // A2 pini başlat
-    gpio_init(A2_GPIO_PIN);
-    gpio_set_dir(A2_GPIO_PIN, GPIO_OUT);
-    gpio_put(A2_GPIO_PIN, 0);
-}
-
-void GPIOManager::setA0(bool state) {
-    gpio_put(A0_GPIO_PIN, state);
-}
-
-bool GPIOManager::getA0() {
-    return gpio_get(A0_GPIO_PIN);
-}
-
-void GPIOManager::setA1(bool state) {
-    gpio_put(A1_GPIO_PIN, state);
+    void _gpioIrqCallback(uint gpio, uint32_t events) {
+        if (g_gpioManager) {
+            g_gpioManager->onEdgeInterrupt(gpio, events);
+        }
+    }
 }
 
-bool GPIOManager::getA1() {
-    return gpio_get(A1_GPIO_PIN);
+GPIOManager::GPIOManager() :
+    _modes(),
+    _pulls(),
+    _outputs(BANK_BITS),
+    _capturedEdges(0),
+    _droppedEdges(0) {
 }
 
-void GPIOManager::setA2(bool state) {
-    gpio_put(A2_GPIO_PIN, state);
+void GPIOManager::init() {
+    g_gpioManager = this;
+    
+    // A0 (RELAY), A1, A2: düşük seviyeli çıkış
+    gpio_init_mask(GPIO_BANK_MASK);
+    gpio_put_masked(GPIO_BANK_MASK, 0);
+    gpio_set_dir_masked(GPIO_BANK_MASK, GPIO_BANK_MASK);
 }
 
-bool GPIOManager::getA2() {
-    return gpio_get(A2_GPIO_PIN);
+bool GPIOManager::setMode(uint pin, Mode mode, Pull pull) {
+    if (pin >= NUM_PINS || (uint8_t)mode >= NUM_MODES || (uint8_t)pull >= NUM_PULLS) {
+        return false;
+    }
+    
+    uint gpio = _gpioOf(pin);
+    
+    // Kesme önce kapatılır, mod değişirken sahte kenar kaydedilmez
+    gpio_set_irq_enabled(gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
+    
+    if (mode == Mode::OUTPUT) {
+        gpio_disable_pulls(gpio);
+        gpio_set_dir(gpio, GPIO_OUT);
+        _outputs |= 1u << pin;
+    } else {
+        _outputs &= ~(1u << pin);
+        gpio_set_dir(gpio, GPIO_IN);
+        gpio_set_pulls(gpio, pull == Pull::UP, pull == Pull::DOWN);
+        if (mode == Mode::INPUT_EDGE) {
+            gpio_set_irq_enabled_with_callback(gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true,
+                                               &_gpioIrqCallback);
+        }
+    }
+    
+    _modes[pin] = mode;
+    _pulls[pin] = (mode == Mode::OUTPUT) ? Pull::NONE : pull;
+    return true;
 }
 
-// Private helper methods for pin control
-void GPIOManager::_setPin(uint8_t pin, bool state) {
-    gpio_put(pin, state);
+void GPIOManager::writeBank(uint8_t mask, uint8_t values) {
+    uint32_t pins = (uint32_t)(mask & _outputs) << A0_GPIO_PIN;
+    if (pins != 0) {
+        gpio_put_masked(pins, (uint32_t)values << A0_GPIO_PIN);
+    }
 }
 
-bool GPIOManager::_getPin(uint8_t pin) {
-    return gpio_get(pin);
+uint8_t GPIOManager::readBank() const {
+    return (gpio_get_all() >> A0_GPIO_PIN) & BANK_BITS;
 }
 
-void GPIOManager::handleCommand(uint8_t cmd, uint8_t pin, uint8_t value) {
-    // Check if pin is valid (A0, A1, or A2)
-    if (pin == A0_GPIO_PIN || pin == A1_GPIO_PIN || pin == A2_GPIO_PIN) {
-        if (cmd == CMD_SET_PIN) {
-            // Set pin state
-            _setPin(pin, value > 0);
+void GPIOManager::onEdgeInterrupt(uint gpio, uint32_t events) {
+    uint32_t now = time_us_32();
+    if (gpio < A0_GPIO_PIN || gpio >= A0_GPIO_PIN + NUM_PINS) {
+        return;
+    }
+    
+    // İki kenar birlikte bekliyorsa darbe kesmeden kısaydı; önce karşı kenar yazılır
+    uint8_t pin = gpio - A0_GPIO_PIN;
+    uint8_t level = gpio_get(gpio) ? 1 : 0;
+    if ((events & GPIO_IRQ_EDGE_RISE) && (events & GPIO_IRQ_EDGE_FALL)) {
+        if (_edges.push(Edge{now, pin, (uint8_t)(level ^ 1)})) {
+            _capturedEdges = _capturedEdges + 1;
+        } else {
+            _droppedEdges = _droppedEdges + 1;
         }
+    } else if (events & GPIO_IRQ_EDGE_RISE) {
+        level = 1;
+    } else if (events & GPIO_IRQ_EDGE_FALL) {
+        level = 0;
+    } else {
+        return;
     }
-}
\ No newline at end of file
+    
+    if (_edges.push(Edge{now, pin, level})) {
+        _capturedEdges = _capturedEdges + 1;
+    } else {
+        _droppedEdges = _droppedEdges + 1;
+    }
+}
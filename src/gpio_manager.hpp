@@ -3,6 +3,7 @@
 #include "pico/stdlib.h"
 #include "hardware/gpio.h"
 #include "servo2040.hpp"
+#include "spsc_queue.hpp"
 #include <cstdint>
 
 using namespace servo;
@@ -16,29 +17,151 @@ static constexpr uint8_t A2_GPIO_PIN = 28;  // A2 pin
 static constexpr uint32_t GPIO_A0_MASK = (1u << A0_GPIO_PIN);
 static constexpr uint32_t GPIO_A1_MASK = (1u << A1_GPIO_PIN);
 static constexpr uint32_t GPIO_A2_MASK = (1u << A2_GPIO_PIN);
-static constexpr uint32_t GPIO_OUTPUT_MASK = 0xFFFFFFFF;
-static constexpr uint32_t GPIO_LOW_MASK = 0x00;
-
-// Command constants
-static constexpr uint8_t CMD_SET_PIN = 0xD3;  // Set pin command
-static constexpr uint8_t CMD_GET_PIN = 0xC7;  // Get pin command
+static constexpr uint32_t GPIO_BANK_MASK = GPIO_A0_MASK | GPIO_A1_MASK | GPIO_A2_MASK;
 
 /**
- * @brief GPIO pinlerini (A0, A1, A2) yöneten sınıf
+ * @brief GPIO pinlerini (A0, A1, A2) tek bir banka olarak yöneten sınıf
+ * 
+ * Banka bitleri A0 = bit 0, A1 = bit 1, A2 = bit 2 sırasıyladır ve pinler
+ * ardışık olduğu için tek kaydırmayla SIO bitlerine eşlenir. Yazma tek
+ * gpio_put_masked, okuma tek gpio_get_all işlemidir; röle ve yardımcı
+ * çıkışlar aynı anda değişir.
+ * 
+ * Her pin çıkış, giriş veya kesmeli giriş olabilir. Kesmeli girişlerin
+ * kenarları kesme içinde zaman damgasıyla olay halkasına yazılır; ana döngü
+ * halkayı host'a toplu olarak veya push ile gönderir. Kesme ve ana döngü
+ * aynı çekirdekte (core0) çalışır, halka tek üretici / tek tüketicidir.
  */
 class GPIOManager {
 public:
+    static constexpr uint NUM_PINS = 3;
+    static constexpr uint8_t BANK_BITS = (1u << NUM_PINS) - 1;
+    static constexpr size_t EDGE_QUEUE_SIZE = 64;     // Host'un boşaltmadığı en fazla kenar
+    
+    /**
+     * @brief Pin modu (GPIO_BANK mod register'ındaki numaralar)
+     */
+    enum class Mode : uint8_t {
+        OUTPUT = 0,     // Çıkış, banka yazmasıyla sürülür
+        INPUT = 1,      // Giriş, sadece okunur
+        INPUT_EDGE = 2  // Giriş, her kenar zaman damgasıyla kaydedilir
+    };
+    static constexpr uint8_t NUM_MODES = 3;
+    
+    /**
+     * @brief Giriş pull direnci
+     */
+    enum class Pull : uint8_t {
+        NONE = 0,
+        UP = 1,     // Toprağa kapanan anahtarlar (ör. sınır anahtarları)
+        DOWN = 2
+    };
+    static constexpr uint8_t NUM_PULLS = 3;
+    
+    /**
+     * @brief Kaydedilen giriş kenarı
+     */
+    struct Edge {
+        uint32_t time_us;   // Kesmenin alındığı zaman
+        uint8_t pin;        // Banka biti (0-2)
+        uint8_t level;      // Kenardan sonraki seviye (1: yükselen, 0: düşen)
+    };
+    
     GPIOManager();
+    
+    /**
+     * @brief Tüm pinleri düşük seviyeli çıkış olarak başlatır (çağıran çekirdek kesmeleri alır)
+     */
     void init();
-    void setA0(bool state);
-    void setA1(bool state);
-    void setA2(bool state);
-    bool getA0();
-    bool getA1();
-    bool getA2();
-    void handleCommand(uint8_t cmd, uint8_t pin, uint8_t value);
+    
+    /**
+     * @brief Pinin modunu ve pull direncini ayarlar
+     * 
+     * Çıkışa geçen pin son yazılan seviyeyi sürer; kesmeli girişe geçen pinin
+     * kenarları bu andan itibaren kaydedilir.
+     * 
+     * @param pin Banka biti (0-2)
+     * @param mode Pin modu
+     * @param pull Giriş pull direnci (çıkışta yok sayılır)
+     * @return true Başarılı
+     * @return false Geçersiz pin, mod veya pull
+     */
+    bool setMode(uint pin, Mode mode, Pull pull);
+    
+    Mode getMode(uint pin) const {
+        return (pin < NUM_PINS) ? _modes[pin] : Mode::OUTPUT;
+    }
+    
+    Pull getPull(uint pin) const {
+        return (pin < NUM_PINS) ? _pulls[pin] : Pull::NONE;
+    }
+    
+    /**
+     * @brief Maskedeki çıkış pinlerini tek SIO yazmasıyla değiştirir
+     * 
+     * Giriş pinlerinin maske bitleri yok sayılır.
+     * 
+     * @param mask Değişecek banka bitleri
+     * @param values Yeni seviyeler (banka bitleri)
+     */
+    void writeBank(uint8_t mask, uint8_t values);
+    
+    /**
+     * @brief Tüm pinlerin seviyesini tek SIO okumasıyla döndürür
+     * 
+     * @return uint8_t Banka bitleri (çıkışlarda sürülen, girişlerde okunan seviye)
+     */
+    uint8_t readBank() const;
+    
+    /**
+     * @brief Halkadaki en eski kenarı alır
+     * 
+     * @param edge Alınan kenar
+     * @return true Kenar alındı
+     * @return false Halka boş
+     */
+    bool popEdge(Edge& edge) {
+        return _edges.pop(edge);
+    }
+    
+    /**
+     * @brief Halkada bekleyen kenar sayısı
+     */
+    size_t pendingEdges() const {
+        return _edges.size();
+    }
+    
+    /**
+     * @brief Halka dolu olduğu için kaybedilen kenar sayısı
+     */
+    uint32_t getDroppedEdges() const {
+        return _droppedEdges;
+    }
+    
+    /**
+     * @brief Kaydedilen toplam kenar sayısı
+     */
+    uint32_t getCapturedEdges() const {
+        return _capturedEdges;
+    }
+    
+    /**
+     * @brief GPIO kesmesinden çağrılır, kenarı zaman damgasıyla halkaya yazar
+     * 
+     * @param gpio Kesmeyi üreten GPIO numarası
+     * @param events GPIO_IRQ_EDGE_RISE / GPIO_IRQ_EDGE_FALL bitleri
+     */
+    void onEdgeInterrupt(uint gpio, uint32_t events);
     
 private:
-    void _setPin(uint8_t pin, bool state);
-    bool _getPin(uint8_t pin);
-}; 
\ No newline at end of file
+    static constexpr uint8_t _gpioOf(uint pin) {
+        return A0_GPIO_PIN + pin;
+    }
+    
+    Mode _modes[NUM_PINS];
+    Pull _pulls[NUM_PINS];
+    uint8_t _outputs;                         // Çıkış modundaki pinler (banka bitleri)
+    SpscQueue<Edge, EDGE_QUEUE_SIZE> _edges;  // Kesme -> ana döngü kenar halkası
+    volatile uint32_t _capturedEdges;         // Sadece kesme yazar
+    volatile uint32_t _droppedEdges;          // Sadece kesme yazar
+};
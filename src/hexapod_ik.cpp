@@ -0,0 +1,177 @@
+#include "hexapod_ik.hpp"
+#include "int_math.hpp"
+
+uint32_t HexapodIK::solve(const BodyPose& pose, const Vec3* feet, int32_t* angles) const {
+    uint32_t unreachable = 0;
+    for (size_t leg = 0; leg < NUM_LEGS; leg++) {
+        if (!_solveLeg(leg, _toBody(pose, feet[leg]), &angles[3 * leg])) {
+            unreachable++;
+        }
+    }
+    return unreachable;
+}
+
+bool HexapodIK::_solveLeg(size_t leg, const Vec3& foot, int32_t* angles) const {
+    const Mount& mount = MOUNTS[leg];
+    
+    // Bacak çerçevesi: montaj noktası orijin, x ekseni coxa sıfır yönü
+    uint16_t mountYaw = decidegreesToBam(mount.yaw);
+    int32_t c = cos(mountYaw);
+    int32_t s = sin(mountYaw);
+    int32_t dx = foot.x - mount.x;
+    int32_t dy = foot.y - mount.y;
+    
+    // Tam int16 girişte farklar ~65535.i aşabilir, Q15 çarpımlar 64-bit
+    int32_t lx = (int32_t)(((int64_t)dx * c + (int64_t)dy * s + (1 << 14)) >> 15);
+    int32_t ly = (int32_t)(((int64_t)dy * c - (int64_t)dx * s + (1 << 14)) >> 15);
+    int32_t lz = foot.z;
+    
+    uint16_t coxa = atan2(ly, lx);
+    
+    // Femur ekseninden ayağa olan uzaklık, femur-tibia düzleminde
+    int32_t r = (int32_t)IntMath::isqrt((int64_t)lx * lx + (int64_t)ly * ly) - COXA_LENGTH;
+    int64_t d2 = (int64_t)r * r + (int64_t)lz * lz;
+    
+    // Erişim dışındaki hedef en yakın erişilebilir mesafeye çekilir
+    constexpr int32_t MAX_REACH = FEMUR_LENGTH + TIBIA_LENGTH;
+    constexpr int32_t MIN_REACH = (TIBIA_LENGTH > FEMUR_LENGTH) ? TIBIA_LENGTH - FEMUR_LENGTH : FEMUR_LENGTH - TIBIA_LENGTH;
+    bool reachable = true;
+    if (d2 > (int64_t)MAX_REACH * MAX_REACH) {
+        d2 = (int64_t)MAX_REACH * MAX_REACH;
+        reachable = false;
+    } else if (d2 < (int64_t)MIN_REACH * MIN_REACH) {
+        d2 = (int64_t)MIN_REACH * MIN_REACH;
+        reachable = false;
+    }
+    
+    // Uzaklık 1/16 birim çözünürlükle, kesme hatası femur açısına girmesin
+    int64_t d16 = IntMath::isqrt((uint64_t)d2 << 8);
+    
+    constexpr int64_t F2 = (int64_t)FEMUR_LENGTH * FEMUR_LENGTH;
+    constexpr int64_t T2 = (int64_t)TIBIA_LENGTH * TIBIA_LENGTH;
+    
+    // Diz iç açısı, kosinüs teoremi
+    int32_t kneeCos = (int32_t)((F2 + T2 - d2) * (1 << 15) / (2 * FEMUR_LENGTH * TIBIA_LENGTH));
+    uint16_t knee = acos(kneeCos);
+    
+    // Femur: ayağa doğru uzanan doğrunun açısı + femur ile bu doğru arasındaki açı
+    int32_t liftCos = (int32_t)((F2 + d2 - T2) * (1 << 19) / (2 * FEMUR_LENGTH * d16));
+    uint16_t femur = atan2(lz, r) + acos(liftCos);
+    
+    // Diz açısı 0..180° aralığındadır, işaretli dönüşüm 180°'yi -180° yapardı
+    int32_t kneeAngle = (int32_t)(((uint32_t)knee * 36000 + 32768) >> 16);
+    
+    angles[0] = mount.sign * bamToCentidegrees(coxa);
+    angles[1] = mount.sign * bamToCentidegrees(femur);
+    angles[2] = mount.sign * kneeAngle;
+    return reachable;
+}
+
+HexapodIK::Vec3 HexapodIK::_toBody(const BodyPose& pose, const Vec3& point) {
+    // Gövde yönelimi R = Rz(yaw) Ry(pitch) Rx(roll); gövde çerçevesi için R^T uygulanır
+    int32_t x = point.x - pose.position.x;
+    int32_t y = point.y - pose.position.y;
+    int32_t z = point.z - pose.position.z;
+    
+    // Fark tam int16 girişte ~65535'e ulaşır, Q15 çarpımların toplamı 32 bit'i aşar
+    if (pose.yaw != 0) {
+        uint16_t a = decidegreesToBam(pose.yaw);
+        int32_t c = cos(a);
+        int32_t s = sin(a);
+        int32_t nx = (int32_t)(((int64_t)x * c + (int64_t)y * s + (1 << 14)) >> 15);
+        y = (int32_t)(((int64_t)y * c - (int64_t)x * s + (1 << 14)) >> 15);
+        x = nx;
+    }
+    if (pose.pitch != 0) {
+        uint16_t a = decidegreesToBam(pose.pitch);
+        int32_t c = cos(a);
+        int32_t s = sin(a);
+        int32_t nx = (int32_t)(((int64_t)x * c - (int64_t)z * s + (1 << 14)) >> 15);
+        z = (int32_t)(((int64_t)x * s + (int64_t)z * c + (1 << 14)) >> 15);
+        x = nx;
+    }
+    if (pose.roll != 0) {
+        uint16_t a = decidegreesToBam(pose.roll);
+        int32_t c = cos(a);
+        int32_t s = sin(a);
+        int32_t ny = (int32_t)(((int64_t)y * c + (int64_t)z * s + (1 << 14)) >> 15);
+        z = (int32_t)(((int64_t)z * c - (int64_t)y * s + (1 << 14)) >> 15);
+        y = ny;
+    }
+    
+    return {x, y, z};
+}
+
+uint16_t HexapodIK::decidegreesToBam(int32_t decidegrees) {
+    int32_t scaled = decidegrees * 65536;
+    return (uint16_t)((scaled + ((scaled < 0) ? -1800 : 1800)) / 3600);
+}
+
+int32_t HexapodIK::bamToCentidegrees(uint16_t bam) {
+    return ((int32_t)(int16_t)bam * 36000 + 32768) >> 16;
+}
+
+int32_t HexapodIK::sin(uint16_t bam) {
+    // Çeyrek dalga: 2. ve 4. çeyrekte tablo tersten, 3. ve 4. çeyrekte işaret ters
+    uint32_t quadrant = bam >> 14;
+    uint32_t offset = bam & 0x3FFF;
+    if (quadrant & 1) {
+        offset = 0x4000 - offset;
+    }
+    
+    // 14-bit çeyrek açı: 8-bit tablo indeksi, 6-bit ara değer
+    uint32_t index = offset >> 6;
+    uint32_t frac = offset & 0x3F;
+    int32_t value = _sinTable[index];
+    if (frac != 0) {
+        value += (((int32_t)_sinTable[index + 1] - value) * (int32_t)frac) >> 6;
+    }
+    
+    return (quadrant & 2) ? -value : value;
+}
+
+int32_t HexapodIK::cos(uint16_t bam) {
+    return sin((uint16_t)(bam + 0x4000));
+}
+
+uint16_t HexapodIK::atan2(int32_t y, int32_t x) {
+    if (x == 0 && y == 0) {
+        return 0;
+    }
+    
+    uint32_t ax = (x < 0) ? -(uint32_t)x : (uint32_t)x;
+    uint32_t ay = (y < 0) ? -(uint32_t)y : (uint32_t)y;
+    
+    // Oran 32-bit bölmeyle hesaplanabilsin diye büyük değerler küçültülür
+    while ((ax | ay) >= (1u << 15)) {
+        ax >>= 1;
+        ay >>= 1;
+    }
+    
+    // İlk sekizde bire indir: oran her zaman 0..1
+    bool steep = ay > ax;
+    uint32_t ratio = steep ? (ax << 14) / ay : (ay << 14) / ax;
+    uint32_t index = ratio >> 6;
+    uint32_t frac = ratio & 0x3F;
+    uint32_t angle = _atanTable[index];
+    if (frac != 0) {
+        angle += ((_atanTable[index + 1] - angle) * frac) >> 6;
+    }
+    
+    if (steep) {
+        angle = 0x4000 - angle;
+    }
+    if (x < 0) {
+        angle = 0x8000 - angle;
+    }
+    if (y < 0) {
+        angle = 0x10000 - angle;
+    }
+    return (uint16_t)angle;
+}
+
+uint16_t HexapodIK::acos(int32_t c) {
+    c = (c < -32768) ? -32768 : (c > 32768) ? 32768 : c;
+    int32_t s = (int32_t)IntMath::isqrt((uint64_t)((1 << 30) - c * c));
+    return atan2(s, c);
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Hexapod ters kinematiği (sabit noktalı)
+ * 
+ * Gövde pozu ve altı ayak hedefinden 18 eklem açısını hesaplar. RP2040'ta
+ * FPU olmadığı için tüm hesap tamsayıdır: açılar 16-bit ikili açı biriminde
+ * (BAM, 65536 = 360°), sin ve atan derleme zamanında üretilen çeyrek dalga
+ * tablolarından doğrusal ara değerle, karekök tamsayı olarak bulunur.
+ * Donanımdan bağımsızdır, host üzerinde de derlenebilir.
+ * 
+ * Bacaklar gövdenin üstünden bakıldığında sağ ön bacaktan başlayarak saat
+ * yönünün tersine numaralanır (sağ ön, sol ön, sol orta, sol arka, sağ arka,
+ * sağ orta); bacak i'nin servoları 3i (coxa), 3i+1 (femur), 3i+2 (tibia)'dır.
+ * Açı kuralları kinematic_positions.txt ile aynıdır:
+ * - coxa: bacağın montaj yönüne göre dikey eksen etrafında dönüşü
+ * - femur: femurun yatayla yaptığı açı, yukarı pozitif
+ * - tibia: femur ile tibia arasındaki iç açı (diz)
+ * Sol bacakların servoları ters monte edildiği için açıları ters işaretlidir.
+ * 
+ * Koordinatlar: x ileri, y sol, z yukarı; uzunluklar 0.1 mm, poz açıları 0.1°.
+ */
+class HexapodIK {
+public:
+    static constexpr size_t NUM_LEGS = 6;
+    static constexpr size_t NUM_JOINTS = 18;
+    
+    // Bacak uzunlukları (0.1 mm)
+    static constexpr int32_t COXA_LENGTH = 300;
+    static constexpr int32_t FEMUR_LENGTH = 800;
+    static constexpr int32_t TIBIA_LENGTH = 1200;
+    
+    /**
+     * @brief Bacak montaj noktası
+     */
+    struct Mount {
+        int16_t x;          // Gövde merkezine göre (0.1 mm)
+        int16_t y;          // Gövde merkezine göre (0.1 mm)
+        int16_t yaw;        // Coxa sıfır yönü (0.1°)
+        int8_t sign;        // Servo montaj yönü (sağ +1, sol -1)
+    };
+    
+    static constexpr Mount MOUNTS[NUM_LEGS] = {
+        { 600, -400,  -450,  1},   // Sağ ön
+        { 600,  400,   450, -1},   // Sol ön
+        {   0,  550,   900, -1},   // Sol orta
+        {-600,  400,  1350, -1},   // Sol arka
+        {-600, -400, -1350,  1},   // Sağ arka
+        {   0, -550,  -900,  1},   // Sağ orta
+    };
+    
+    /**
+     * @brief Üç boyutlu nokta (0.1 mm)
+     */
+    struct Vec3 {
+        int32_t x;
+        int32_t y;
+        int32_t z;
+    };
+    
+    /**
+     * @brief Gövde pozu: ayak hedeflerinin verildiği çerçeveye göre gövdenin konumu ve yönelimi
+     */
+    struct BodyPose {
+        Vec3 position;      // Gövde merkezi (0.1 mm)
+        int16_t roll;       // x ekseni etrafında (0.1°)
+        int16_t pitch;      // y ekseni etrafında (0.1°)
+        int16_t yaw;        // z ekseni etrafında (0.1°)
+    };
+    
+    /**
+     * @brief Gövde pozu ve ayak hedeflerinden eklem açılarını hesaplar
+     * 
+     * Erişilemeyen ayak hedefleri en yakın erişilebilir mesafeye çekilir;
+     * bacak o yönde tam uzanır veya tam katlanır.
+     * 
+     * @param pose Gövde pozu
+     * @param feet NUM_LEGS ayak hedefi
+     * @param angles NUM_JOINTS eklem açısı (0.01°, servo yönü uygulanmış)
+     * @return uint32_t Hedefi erişilemeyen bacak sayısı
+     */
+    uint32_t solve(const BodyPose& pose, const Vec3* feet, int32_t* angles) const;
+    
+    /**
+     * @brief 0.1° açıyı ikili açı birimine çevirir
+     */
+    static uint16_t decidegreesToBam(int32_t decidegrees);
+    
+    /**
+     * @brief İkili açıyı işaretli 0.01° açıya çevirir (-180°..180°)
+     */
+    static int32_t bamToCentidegrees(uint16_t bam);
+    
+    /**
+     * @brief Sinüs (Q15)
+     * 
+     * @param bam Açı (65536 = 360°)
+     * @return int32_t -32768..32768
+     */
+    static int32_t sin(uint16_t bam);
+    
+    /**
+     * @brief Kosinüs (Q15)
+     */
+    static int32_t cos(uint16_t bam);
+    
+    /**
+     * @brief Dört bölgeli arktanjant
+     * 
+     * @return uint16_t Açı (BAM)
+     */
+    static uint16_t atan2(int32_t y, int32_t x);
+    
+    /**
+     * @brief Arkkosinüs
+     * 
+     * @param c Kosinüs (Q15, -32768..32768 dışı sınırlanır)
+     * @return uint16_t Açı (BAM, 0..32768)
+     */
+    static uint16_t acos(int32_t c);
+    
+private:
+    static constexpr size_t TABLE_BITS = 8;
+    static constexpr size_t TABLE_SIZE = (1u << TABLE_BITS) + 1;   // Uç nokta dahil
+    
+    /**
+     * @brief Çeyrek dalga sinüs tablosu (Q15, 0..90°) ve atan tablosu (BAM, atan(0..1))
+     */
+    static constexpr std::array<uint16_t, TABLE_SIZE> _buildSinTable();
+    static constexpr std::array<uint16_t, TABLE_SIZE> _buildAtanTable();
+    
+    static const std::array<uint16_t, TABLE_SIZE> _sinTable;
+    static const std::array<uint16_t, TABLE_SIZE> _atanTable;
+    
+    /**
+     * @brief Noktayı z, y ve x eksenleri etrafında ters sırayla döndürür (gövde çerçevesine geçiş)
+     */
+    static Vec3 _toBody(const BodyPose& pose, const Vec3& point);
+    
+    /**
+     * @brief Tek bacağın çözümü
+     * 
+     * @param leg Bacak indeksi
+     * @param foot Ayak hedefi (gövde çerçevesinde)
+     * @param angles Bacağın 3 eklem açısı (0.01°)
+     * @return true Hedef erişilebilir
+     */
+    bool _solveLeg(size_t leg, const Vec3& foot, int32_t* angles) const;
+};
+
+constexpr std::array<uint16_t, HexapodIK::TABLE_SIZE> HexapodIK::_buildSinTable() {
+    // Taylor serisi, derleme zamanında double ile (|x| <= π/2 için yeterli terim)
+    std::array<uint16_t, TABLE_SIZE> table{};
+    const double halfPi = 1.57079632679489661923;
+    for (size_t i = 0; i < TABLE_SIZE; i++) {
+        double x = halfPi * (double)i / (double)(TABLE_SIZE - 1);
+        double term = x;
+        double sum = x;
+        for (int n = 1; n < 12; n++) {
+            term *= -x * x / (double)((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        table[i] = (uint16_t)(sum * 32768.0 + 0.5);
+    }
+    return table;
+}
+
+constexpr std::array<uint16_t, HexapodIK::TABLE_SIZE> HexapodIK::_buildAtanTable() {
+    // atan(t) = 2 atan(t / (1 + sqrt(1 + t²))) ile t <= tan(22.5°) aralığına indirip Taylor serisi
+    std::array<uint16_t, TABLE_SIZE> table{};
+    const double bamPerRadian = 32768.0 / 3.14159265358979323846;
+    for (size_t i = 0; i < TABLE_SIZE; i++) {
+        double t = (double)i / (double)(TABLE_SIZE - 1);
+        double s = 1.0 + t * t;
+        double root = s;
+        for (int n = 0; n < 20; n++) {
+            root = 0.5 * (root + s / root);
+        }
+        double u = t / (1.0 + root);
+        double term = u;
+        double sum = u;
+        for (int n = 1; n < 20; n++) {
+            term *= -u * u;
+            sum += term / (double)(2 * n + 1);
+        }
+        table[i] = (uint16_t)(2.0 * sum * bamPerRadian + 0.5);
+    }
+    return table;
+}
+
+inline constexpr std::array<uint16_t, HexapodIK::TABLE_SIZE> HexapodIK::_sinTable = HexapodIK::_buildSinTable();
+inline constexpr std::array<uint16_t, HexapodIK::TABLE_SIZE> HexapodIK::_atanTable = HexapodIK::_buildAtanTable();
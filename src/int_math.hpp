@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief FPU'suz çekirdek için ortak tamsayı matematik yardımcıları
+ * 
+ * HexapodIK ve SlewLimiter aynı karekökü kullanır. Yalnızca kaydırma,
+ * toplama ve karşılaştırma ile hesaplanır, çarpma ve bölme gerektirmez.
+ */
+class IntMath {
+public:
+    /**
+     * @brief 64-bit tamsayı karekök (aşağı yuvarlar)
+     * 
+     * Bit bit yöntem: her turda sonucun bir biti belirlenir, en fazla 32 tur.
+     */
+    static uint32_t isqrt(uint64_t value) {
+        uint64_t result = 0;
+        uint64_t bit = 1ull << 62;
+        while (bit > value) {
+            bit >>= 2;
+        }
+        
+        while (bit != 0) {
+            if (value >= result + bit) {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return (uint32_t)result;
+    }
+};
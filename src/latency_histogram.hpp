@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief log2 kovalı gecikme histogramı ve min/ortalama/max sayaçları
+ * 
+ * Ölçüm noktaları 64-bit zamanlayıcıyı (time_us_64) okur; iki nokta
+ * arasındaki süre record() ile eklenir. Kova k, bit genişliği k olan
+ * süreleri sayar: kova 0 = 0 μs, kova 1 = 1 μs, kova 2 = 2-3 μs,
+ * kova 3 = 4-7 μs, ... son kova NUM_BUCKETS - 1 ve üstü bit genişliğindeki
+ * tüm süreleri (≥ 16384 μs) toplar. Kova tek CLZ ile bulunur.
+ * 
+ * Histogramı sadece bir çekirdek yazar; diğer çekirdek 32-bit alanları
+ * okuyabilir ve requestReset() ile sıfırlama isteyebilir, istek sonraki
+ * eklemede uygulanır.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t NUM_BUCKETS = 16;
+    
+    LatencyHistogram() : _resetRequested(false) {
+        _clear();
+    }
+    
+    /**
+     * @brief Bir gecikme ekler (sahibi olan çekirdek)
+     * 
+     * @param latency_us Süre (μs), 32-bit'te doyar
+     */
+    void record(uint64_t latency_us) {
+        applyReset();
+        
+        uint32_t value = (latency_us > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (uint32_t)latency_us;
+        uint32_t bucket = (value == 0) ? 0 : 32 - __builtin_clz(value);
+        if (bucket >= NUM_BUCKETS) {
+            bucket = NUM_BUCKETS - 1;
+        }
+        _buckets[bucket]++;
+        
+        _count++;
+        _total_us += value;
+        if (value < _min_us) {
+            _min_us = value;
+        }
+        if (value > _max_us) {
+            _max_us = value;
+        }
+        
+        // Diğer çekirdek 64-bit toplamı değil, 32-bit ortalamayı okur
+        _avg_us = (uint32_t)(_total_us / _count);
+    }
+    
+    /**
+     * @brief Sıfırlama ister (herhangi bir çekirdekten)
+     */
+    void requestReset() {
+        _resetRequested.store(true, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Bekleyen sıfırlama isteğini ekleme beklemeden uygular (sahibi olan çekirdek)
+     */
+    void applyReset() {
+        // Cortex-M0+'da LDREX/STREX yok, exchange yerine okuma ve ayrı yazma: ikisi
+        // arasında gelen istek de hemen ardından yapılan bu sıfırlamayla karşılanır
+        if (_resetRequested.load(std::memory_order_acquire)) {
+            _resetRequested.store(false, std::memory_order_release);
+            _clear();
+        }
+    }
+    
+    /**
+     * @brief Son sıfırlamadan beri eklenen süre sayısı
+     */
+    uint32_t getCount() const {
+        return _count;
+    }
+    
+    /**
+     * @brief En kısa süre (μs), ekleme yoksa 0
+     */
+    uint32_t getMin() const {
+        return (_count == 0) ? 0 : _min_us;
+    }
+    
+    /**
+     * @brief Ortalama süre (μs)
+     */
+    uint32_t getAvg() const {
+        return _avg_us;
+    }
+    
+    /**
+     * @brief En uzun süre (μs)
+     */
+    uint32_t getMax() const {
+        return _max_us;
+    }
+    
+    /**
+     * @brief Kovadaki süre sayısı
+     */
+    uint32_t getBucket(size_t bucket) const {
+        return (bucket < NUM_BUCKETS) ? _buckets[bucket] : 0;
+    }
+    
+private:
+    std::atomic<bool> _resetRequested;
+    uint32_t _count;                    // Eklenen süre sayısı
+    uint32_t _min_us;                   // En kısa süre, ekleme yoksa 0xFFFFFFFF
+    uint32_t _max_us;                   // En uzun süre
+    uint32_t _avg_us;                   // Ortalama süre
+    uint64_t _total_us;                 // Ortalama için toplam (sadece sahibi okur)
+    uint32_t _buckets[NUM_BUCKETS];     // log2 kovaları
+    
+    /**
+     * @brief Tüm sayaçları sıfırlar
+     */
+    void _clear() {
+        _count = 0;
+        _min_us = 0xFFFFFFFFu;
+        _max_us = 0;
+        _avg_us = 0;
+        _total_us = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; i++) {
+            _buckets[i] = 0;
+        }
+    }
+};
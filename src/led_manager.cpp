@@ -1,21 +1,24 @@
 #include "led_manager.hpp"
 
 LedManager::LedManager() :
-    _led_bar(servo_defs::NUM_LEDS, pio1, 0, servo_defs::LED_DATA) {
+    _led_bar(servo_defs::NUM_LEDS, pio1, 0, servo_defs::LED_DATA),
+    _leds(),
+    _shown(),
+    _nextFrame_us(0),
+    _framesPushed(0),
+    _status(Status::NONE),
+    _statusUntil_us(0) {
+    for (uint i = 0; i < NUM_LEDS; i++) {
+        _leds[i].effect = Effect::SOLID;
+        _leds[i].periodMs = DEFAULT_PERIOD_MS;
+        _leds[i].meterHigh = DEFAULT_METER_HIGH;
+    }
 }
 
 void LedManager::init() {
-    _led_bar.start();
-    
-    // Test pattern to ensure LEDs are working
-    setAllLeds(255, 0, 0);  // Red
-    sleep_ms(200);
-    setAllLeds(0, 255, 0);  // Green
-    sleep_ms(200);
-    setAllLeds(0, 0, 255);  // Blue
-    sleep_ms(200);
-    
-    clearAllLeds();
+    // fps = 0: zamanlayıcıyla sürekli gönderim yok, sadece değişen kareler gönderilir
+    _led_bar.start(0);
+    _nextFrame_us = time_us_32();
 }
 
 bool LedManager::setLed(uint index, uint8_t r, uint8_t g, uint8_t b) {
@@ -23,7 +26,7 @@ bool LedManager::setLed(uint index, uint8_t r, uint8_t g, uint8_t b) {
         return false;
     }
     
-    _led_bar.set_rgb(index, r, g, b);
+    _leds[index].color = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
     return true;
 }
 
@@ -33,45 +36,168 @@ bool LedManager::setLedHSV(uint index, float h, float s, float v) {
     }
     
     // v değerini global parlaklık değeriyle çarp
-    _led_bar.set_hsv(index, h, s, v * BRIGHTNESS);
+    uint32_t hue = (uint32_t)(h * HUE_STEPS) % HUE_STEPS;
+    _leds[index].color = _hsv(hue, (uint8_t)(s * 255.0f), (uint8_t)(v * BRIGHTNESS * 255.0f));
     return true;
 }
 
 void LedManager::setAllLeds(uint8_t r, uint8_t g, uint8_t b) {
-    for (uint i = 0; i < servo_defs::NUM_LEDS; i++) {
-        _led_bar.set_rgb(i, r, g, b);
+    for (uint i = 0; i < NUM_LEDS; i++) {
+        setLed(i, r, g, b);
     }
 }
 
 void LedManager::clearAllLeds() {
-    _led_bar.clear();
+    for (uint i = 0; i < NUM_LEDS; i++) {
+        _leds[i].effect = Effect::SOLID;
+        _leds[i].color = 0;
+    }
 }
 
-void LedManager::pendingConnectionAnimation() {
-    static float offset = 0.0f;
-    const uint updates = 10;  // Slow down the animation for better visibility
+bool LedManager::setEffect(uint index, Effect effect, uint16_t periodMs) {
+    if (!_isValidIndex(index) || (uint8_t)effect >= NUM_EFFECTS) {
+        return false;
+    }
     
-    offset += 0.01f;  // Increase speed slightly
+    _leds[index].effect = effect;
+    if (periodMs != 0) {
+        _leds[index].periodMs = periodMs;
+    }
+    return true;
+}
+
+bool LedManager::setMeter(uint index, uint8_t source, uint16_t low, uint16_t high) {
+    if (!_isValidIndex(index)) {
+        return false;
+    }
+    
+    _leds[index].meterSource = source;
+    _leds[index].meterLow = low;
+    _leds[index].meterHigh = high;
+    return true;
+}
+
+void LedManager::setMeterValue(uint index, uint16_t value) {
+    if (_isValidIndex(index)) {
+        _leds[index].meterValue = value;
+    }
+}
+
+bool LedManager::render(uint32_t now_us) {
+    if (!isFrameDue(now_us)) {
+        return false;
+    }
     
-    // Tüm LEDleri güncelle
-    for (uint i = 0; i < servo_defs::NUM_LEDS; i++) {
-        float hue = (float)i / (float)servo_defs::NUM_LEDS;
-        _led_bar.set_hsv(i, hue + offset, 1.0f, BRIGHTNESS * 1.5f);  // Make brighter
+    // Kaçırılan kareler telafi edilmez, saat şimdiden yeniden başlar
+    _nextFrame_us += FRAME_US;
+    if ((int32_t)(now_us - _nextFrame_us) >= 0) {
+        _nextFrame_us = now_us + FRAME_US;
     }
     
-    sleep_ms(1000 / updates);
+    // Süreli durum katmanı dolunca LED efektleri yeniden görünür
+    if ((_status == Status::CONNECTED || _status == Status::DISCONNECTED) &&
+        (int32_t)(now_us - _statusUntil_us) >= 0) {
+        _status = Status::NONE;
+    }
+    
+    LedState overlay = {};
+    overlay.effect = (_status == Status::PENDING) ? Effect::RAINBOW : Effect::SOLID;
+    overlay.color = (_status == Status::CONNECTED) ? 0x004000 : 0x400000;
+    overlay.periodMs = DEFAULT_PERIOD_MS;
+    
+    uint32_t now_ms = now_us / 1000;
+    bool dirty = false;
+    for (uint i = 0; i < NUM_LEDS; i++) {
+        uint32_t color = _renderLed((_status == Status::NONE) ? _leds[i] : overlay, i, now_ms);
+        if (color != _shown[i]) {
+            _led_bar.set_rgb(i, (color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+            _shown[i] = color;
+            dirty = true;
+        }
+    }
+    
+    if (!dirty) {
+        return false;
+    }
+    
+    // DMA ile gönderilir, çağıran beklemez
+    _led_bar.update();
+    _framesPushed++;
+    return true;
+}
+
+void LedManager::pendingConnectionAnimation() {
+    _status = Status::PENDING;
 }
 
 void LedManager::setConnectedStatus(bool connected) {
-    if (connected) {
-        // Bağlantı kuruldu, yeşil LED
-        setAllLeds(0, 64, 0);
-    } else {
-        // Bağlantı kesildi, kırmızı LED
-        setAllLeds(64, 0, 0);
+    // Bağlantı kuruldu: yeşil, bağlantı kesildi: kırmızı
+    _status = connected ? Status::CONNECTED : Status::DISCONNECTED;
+    _statusUntil_us = time_us_32() + STATUS_HOLD_US;
+}
+
+uint32_t LedManager::_renderLed(const LedState& led, uint index, uint32_t now_ms) {
+    uint32_t period = (led.periodMs == 0) ? DEFAULT_PERIOD_MS : led.periodMs;
+    
+    switch (led.effect) {
+        case Effect::PULSE: {
+            // Üçgen dalga: periyodun ilk yarısında yanar, ikinci yarısında söner
+            uint32_t phase = (now_ms % period) * 512 / period;
+            return _scale(led.color, (uint8_t)((phase < 256) ? phase : 511 - phase));
+        }
+        
+        case Effect::RAINBOW: {
+            // LED'ler ton dairesine eşit aralıkla dizilir
+            uint32_t hue = (now_ms % period) * HUE_STEPS / period + index * HUE_STEPS / NUM_LEDS;
+            return _hsv(hue % HUE_STEPS, 255, EFFECT_LEVEL);
+        }
+        
+        case Effect::METER: {
+            // Değer aralıkta 0-256'ya ölçeklenir, ton yeşilden (512) kırmızıya (0) iner
+            int32_t span = (int32_t)led.meterHigh - led.meterLow;
+            int32_t offset = (int32_t)led.meterValue - led.meterLow;
+            int32_t fill;
+            if (span == 0) {
+                fill = (offset >= 0) ? 256 : 0;
+            } else {
+                fill = offset * 256 / span;
+                fill = (fill < 0) ? 0 : (fill > 256) ? 256 : fill;
+            }
+            return _hsv((uint32_t)(512 - fill * 2), 255, EFFECT_LEVEL);
+        }
+        
+        case Effect::SOLID:
+        default:
+            return led.color;
     }
 }
 
-bool LedManager::_isValidIndex(uint index) {
-    return (index < servo_defs::NUM_LEDS);
-} 
\ No newline at end of file
+uint32_t LedManager::_hsv(uint32_t hue, uint8_t sat, uint8_t val) {
+    uint32_t region = hue / 256;
+    uint32_t rem = hue % 256;
+    uint32_t p = val * (255u - sat) / 255;
+    uint32_t q = val * (255u - sat * rem / 255) / 255;
+    uint32_t t = val * (255u - sat * (255u - rem) / 255) / 255;
+    
+    uint32_t r, g, b;
+    switch (region) {
+        case 0:  r = val; g = t;   b = p;   break;
+        case 1:  r = q;   g = val; b = p;   break;
+        case 2:  r = p;   g = val; b = t;   break;
+        case 3:  r = p;   g = q;   b = val; break;
+        case 4:  r = t;   g = p;   b = val; break;
+        default: r = val; g = p;   b = q;   break;
+    }
+    return (r << 16) | (g << 8) | b;
+}
+
+uint32_t LedManager::_scale(uint32_t color, uint8_t level) {
+    uint32_t r = ((color >> 16) & 0xFF) * level / 255;
+    uint32_t g = ((color >> 8) & 0xFF) * level / 255;
+    uint32_t b = (color & 0xFF) * level / 255;
+    return (r << 16) | (g << 8) | b;
+}
+
+bool LedManager::_isValidIndex(uint index) const {
+    return (index < NUM_LEDS);
+}
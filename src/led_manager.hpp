@@ -6,21 +6,48 @@
 
 /**
  * @brief LED yönetim sınıfı - Servo2040 üzerindeki 6 RGB LEDi kontrol eder
+ * 
+ * Her LED'e bir efekt atanır (sabit renk, nabız, gökkuşağı veya bir
+ * register'a bağlı gösterge). render() ana döngüden her turda çağrılır,
+ * kareler sabit FRAME_US saatiyle hesaplanır ve hiçbir çağrı beklemez.
+ * PIO'ya sadece bir LED'in rengi değiştiğinde gönderilir; sabit renkli
+ * LED'ler USB ve kontrol döngüsüne hiç yük getirmez.
+ * 
+ * Bağlantı durumu LED ayarlarının üzerine çizilen bir katmandır: host'un
+ * bağlantı sırasında yaptığı LED ayarları silinmez, katman kalkınca görünür.
  */
 class LedManager {
 public:
+    static constexpr uint NUM_LEDS = servo_defs::NUM_LEDS;
+    static constexpr uint32_t FRAME_US = 20000;            // Efekt kare saati (50 kare/s)
+    static constexpr uint16_t DEFAULT_PERIOD_MS = 2000;    // Nabız ve gökkuşağı varsayılan periyodu
+    static constexpr uint8_t EFFECT_LEVEL = 77;            // Üretilen renklerin parlaklığı (0.3 x 255)
+    static constexpr uint16_t DEFAULT_METER_HIGH = 1016;   // Gösterge varsayılan üst ucu (10-bit sensör değerleri)
+    static constexpr uint32_t STATUS_HOLD_US = 1000000;    // Bağlantı durumu rengi bu kadar gösterilir
+    
+    /**
+     * @brief LED efektleri (LED_EFFECT register numaraları)
+     */
+    enum class Effect : uint8_t {
+        SOLID = 0,    // Sabit renk
+        PULSE = 1,    // Renk periyot boyunca sönüp yanar
+        RAINBOW = 2,  // Ton periyot boyunca döner, LED'ler arasında kaydırılır
+        METER = 3     // Bağlı register değeri yeşilden (düşük) kırmızıya (yüksek)
+    };
+    static constexpr uint8_t NUM_EFFECTS = 4;
+    
     /**
      * @brief Yapılandırıcı, LED çubuğunu başlatır
      */
     LedManager();
     
     /**
-     * @brief LED çubuğunu başlatır
+     * @brief LED çubuğunu başlatır (otomatik güncelleme kapalı, kareleri render() gönderir)
      */
     void init();
     
     /**
-     * @brief Belirli bir LEDi belirtilen renkte ayarlar
+     * @brief Belirli bir LEDin rengini ayarlar (sabit renk ve nabız efektinin rengi)
      * 
      * @param index LED indeksi (0-5)
      * @param r Kırmızı (0-255)
@@ -32,7 +59,7 @@ public:
     bool setLed(uint index, uint8_t r, uint8_t g, uint8_t b);
     
     /**
-     * @brief Belirli bir LEDi HSV renk uzayında ayarlar
+     * @brief Belirli bir LEDin rengini HSV renk uzayında ayarlar
      * 
      * @param index LED indeksi (0-5)
      * @param h Ton (0.0-1.0)
@@ -53,25 +80,171 @@ public:
     void setAllLeds(uint8_t r, uint8_t g, uint8_t b);
     
     /**
-     * @brief Tüm LEDleri temizler (kapatır)
+     * @brief Tüm LEDleri temizler (kapatır), efektler sabit renge döner
      */
     void clearAllLeds();
     
     /**
-     * @brief VCP bağlantısı beklerken çalışan gökkuşağı animasyonu
+     * @brief LED'in efektini ayarlar, renk ve gösterge ayarı korunur
+     * 
+     * @param index LED indeksi (0-5)
+     * @param effect Efekt
+     * @param periodMs Nabız ve gökkuşağı periyodu (ms), 0 = değişmez
+     * @return true Başarılı
+     * @return false Geçersiz indeks
+     */
+    bool setEffect(uint index, Effect effect, uint16_t periodMs = 0);
+    
+    /**
+     * @brief Gösterge efektinin kaynağını ve aralığını ayarlar
+     * 
+     * low > high ise gösterge ters çalışır (ör. düşen gerilim kırmızıya gider).
+     * 
+     * @param index LED indeksi (0-5)
+     * @param source Kaynak register indeksi (değeri çağıran setMeterValue ile verir)
+     * @param low Yeşil uç
+     * @param high Kırmızı uç
+     * @return true Başarılı
+     * @return false Geçersiz indeks
+     */
+    bool setMeter(uint index, uint8_t source, uint16_t low, uint16_t high);
+    
+    /**
+     * @brief Gösterge efektinin güncel kaynak değerini verir
+     * 
+     * @param index LED indeksi (0-5)
+     * @param value Kaynak register değeri
+     */
+    void setMeterValue(uint index, uint16_t value);
+    
+    /**
+     * @brief Kare zamanı geldi mi (gösterge kaynakları sadece o zaman okunur)
+     * 
+     * @param now_us Şu anki zaman (μs)
+     */
+    bool isFrameDue(uint32_t now_us) const {
+        return (int32_t)(now_us - _nextFrame_us) >= 0;
+    }
+    
+    /**
+     * @brief Zamanı geldiyse efektleri hesaplar, değişen kare varsa PIO'ya gönderir
+     * 
+     * @param now_us Şu anki zaman (μs)
+     * @return true Kare gönderildi
+     * @return false Kare zamanı gelmedi veya renkler değişmedi
+     */
+    bool render(uint32_t now_us);
+    
+    /**
+     * @brief VCP bağlantısı beklenirken tüm LED'lerin üzerine gökkuşağı katmanı çizer (beklemez)
+     * 
+     * Katman setConnectedStatus() çağrılana kadar kalır.
      */
     void pendingConnectionAnimation();
     
     /**
-     * @brief Bağlantı durumuna göre LED durumunu ayarlar
+     * @brief Bağlantı durumunu STATUS_HOLD_US boyunca tüm LED'lerin üzerinde gösterir (beklemez)
      * 
-     * @param connected Bağlantı durumu (true: bağlı, false: bağlı değil)
+     * @param connected Bağlantı durumu (true: bağlı, yeşil; false: bağlı değil, kırmızı)
      */
     void setConnectedStatus(bool connected);
     
+    /**
+     * @brief LED'in efekti ve ayarları (geçersiz indekste varsayılanlar)
+     */
+    Effect getEffect(uint index) const {
+        return _isValidIndex(index) ? _leds[index].effect : Effect::SOLID;
+    }
+    
+    uint16_t getPeriodMs(uint index) const {
+        return _isValidIndex(index) ? _leds[index].periodMs : 0;
+    }
+    
+    uint8_t getMeterSource(uint index) const {
+        return _isValidIndex(index) ? _leds[index].meterSource : 0;
+    }
+    
+    uint16_t getMeterLow(uint index) const {
+        return _isValidIndex(index) ? _leds[index].meterLow : 0;
+    }
+    
+    uint16_t getMeterHigh(uint index) const {
+        return _isValidIndex(index) ? _leds[index].meterHigh : 0;
+    }
+    
+    /**
+     * @brief Bağlantı durumu katmanı çiziliyor mu
+     */
+    bool isStatusShown() const {
+        return _status != Status::NONE;
+    }
+    
+    /**
+     * @brief PIO'ya gönderilen kare sayısı
+     */
+    uint32_t getFramesPushed() const {
+        return _framesPushed;
+    }
+    
 private:
+    /**
+     * @brief LED'lerin üzerine çizilen bağlantı durumu katmanı
+     */
+    enum class Status : uint8_t {
+        NONE,         // Katman yok, LED efektleri görünür
+        PENDING,      // Bağlantı bekleniyor, gökkuşağı
+        CONNECTED,    // Bağlantı kuruldu, süre dolana kadar yeşil
+        DISCONNECTED  // Bağlantı koptu, süre dolana kadar kırmızı
+    };
+    
+    /**
+     * @brief LED başına efekt durumu
+     */
+    struct LedState {
+        Effect effect;
+        uint32_t color;       // Sabit renk ve nabız rengi (0xRRGGBB)
+        uint16_t periodMs;    // Nabız ve gökkuşağı periyodu
+        uint8_t meterSource;  // Gösterge kaynak register'ı
+        uint16_t meterLow;    // Gösterge yeşil ucu
+        uint16_t meterHigh;   // Gösterge kırmızı ucu
+        uint16_t meterValue;  // Gösterge kaynağının son değeri
+    };
+    
     plasma::WS2812 _led_bar;               // LED çubuğu nesnesi
     static constexpr float BRIGHTNESS = 0.3f;  // Genel parlaklık seviyesi
+    static constexpr uint16_t HUE_STEPS = 1536;  // Tam ton dairesi (6 x 256)
+    
+    LedState _leds[NUM_LEDS];
+    uint32_t _shown[NUM_LEDS];    // PIO'ya son gönderilen renkler
+    uint32_t _nextFrame_us;       // Sonraki kare zamanı
+    uint32_t _framesPushed;       // PIO'ya gönderilen kare sayısı
+    Status _status;               // Bağlantı durumu katmanı
+    uint32_t _statusUntil_us;     // Süreli katmanın bitiş zamanı
+    
+    /**
+     * @brief Bir LED'in bu karedeki rengini hesaplar
+     * 
+     * @param led LED'in efekt durumu (veya katmanın efekti)
+     * @param index LED indeksi
+     * @param now_ms Kare zamanı (ms)
+     * @return uint32_t Renk (0xRRGGBB)
+     */
+    static uint32_t _renderLed(const LedState& led, uint index, uint32_t now_ms);
+    
+    /**
+     * @brief Tam sayı HSV'den RGB'ye dönüşüm
+     * 
+     * @param hue Ton (0 - HUE_STEPS-1)
+     * @param sat Doygunluk (0-255)
+     * @param val Parlaklık (0-255)
+     * @return uint32_t Renk (0xRRGGBB)
+     */
+    static uint32_t _hsv(uint32_t hue, uint8_t sat, uint8_t val);
+    
+    /**
+     * @brief Rengin her bileşenini level / 255 ile ölçekler
+     */
+    static uint32_t _scale(uint32_t color, uint8_t level);
     
     /**
      * @brief LED indeksinin geçerli olup olmadığını kontrol eder
@@ -80,5 +253,5 @@ private:
      * @return true Geçerli
      * @return false Geçersiz
      */
-    bool _isValidIndex(uint index);
-}; 
\ No newline at end of file
+    bool _isValidIndex(uint index) const;
+};
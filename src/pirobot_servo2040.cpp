@@ -1,5 +1,6 @@
 #include "pirobot_servo2040.hpp"
 #include "pico/stdio_usb.h"
+#include "pico/multicore.h"
 
 // Global instance pointer for callback function
 PirobotServo2040* g_servo2040_instance = nullptr;
@@ -20,6 +21,46 @@ PirobotServo2040::PirobotServo2040() :
     _ledManager(std::make_unique<LedManager>()),
     _gpioManager(std::make_unique<GPIOManager>()),
     _commProtocol(std::make_unique<CommProtocol>()),
+    _trajectory(std::make_unique<TrajectoryPlanner>()),
+    _ik(std::make_unique<HexapodIK>()),
+    _gait(std::make_unique<GaitGenerator>()),
+    _calibration(std::make_unique<ServoCalibration>()),
+    _calibrationView(std::make_unique<ServoCalibration>()),
+    _slew(std::make_unique<SlewLimiter>()),
+    _governor(std::make_unique<CurrentGovernor>()),
+    _core0Tasks(std::make_unique<TaskScheduler>()),
+    _core1Tasks(std::make_unique<TaskScheduler>()),
+    _commandQueue(std::make_unique<CommandQueue>()),
+    _shadow(std::make_unique<ShadowLock>()),
+    _schedule(std::make_unique<Schedule>()),
+    _scheduleStats(),
+    _rxTimestamp_us(0),
+    _commandsDropped(0),
+    _subscriptions(),
+    _subscriptionFramesSent(0),
+    _subscriptionFramesDropped(0),
+    _rxStats(),
+    _delta(),
+    _ikStats(),
+    _gaitUpdateUs(0),
+    _angleStats(),
+    _calBench(),
+    _slewSelect(SlewLimiter::ALL_SERVOS),
+    _slewConfig(),
+    _lastTick_us(0),
+    _submittedRx_us(0),
+    _currentBudget(0),
+    _currentSampleCount(0),
+    _controlTickUs(0),
+    _ledSelect((1u << LedManager::NUM_LEDS) - 1),
+    _linkUp(false),
+    _bootReady_us(0),
+    _firstCommand_us(0),
+    _gpioEdgePush(false),
+    _gpioEdgeSeq(0),
+    _latency(),
+    _rxCallback_us(0),
+    _packetRx_us(0),
     _hasNewData(false) {
     
     // Set the global instance pointer for the callback
@@ -30,187 +71,1689 @@ void PirobotServo2040::init() {
     // Initialize USB and TinyUSB stack
     stdio_init_all();
     
-    // Alt sistemleri başlat
+    // core1'in kullandığı alt sistemler önce: servolar açılışta güvenli pozdadır
     _servoDriver->init();
     _sensorManager->init();
+    
+    // Kontrol adımı her PWM periyodunda bir: yüksek frekanslı servolarda adım da kısalır
+    _controlTickUs = _servoDriver->getPeriodUs();
+    
+    // Yörünge motoru mevcut servo pozisyonlarından başlar
+    uint16_t pulses[TrajectoryPlanner::NUM_SERVOS];
+    for (uint i = 0; i < TrajectoryPlanner::NUM_SERVOS; i++) {
+        pulses[i] = _servoDriver->getServoPosition(i);
+    }
+    _trajectory->reset(pulses);
+    for (uint i = 0; i < SlewLimiter::NUM_SERVOS; i++) {
+        _slew->reset(i, pulses[i]);
+    }
+    
+    // İlk GET'ler core1 başlamadan önce de geçerli servo değerlerini görür
+    _publishShadow(time_us_32());
+    
+    // Görev tabloları core1 başlamadan önce tamamlanır, sonra değişmez
+    _registerTasks();
+    _commProtocol->getResponseWriter().setFlushProbe(&_latency[LATENCY_RX_FLUSH]);
+    
+    // Kontrol döngüsünü core1'de hemen başlat: kademeli servo açılışı bu noktadan
+    // itibaren core1'de ilerler. Bu noktadan sonra servo, sensör ve yörünge
+    // nesnelerine sadece core1 dokunur
+    multicore_launch_core1(_core1Entry);
+    
+    // core0 alt sistemleri; LED'ler bağlantı beklenirken arka planda gökkuşağı gösterir
     _ledManager->init();
+    _ledManager->pendingConnectionAnimation();
     _gpioManager->init();
     
-    // VCP bağlantısı bekle
-    _waitForVCPConnection();
+    // Host bağlantısı beklenmez: komutlar CDC açılır açılmaz run() içinde işlenir
+    _bootReady_us = time_us_32();
+    _core0Tasks->start(_bootReady_us);
+    
+    // Açı dönüşümünün ilk ölçümü açılıştan sonra, diğer görevler boştayken;
+    // core0'ın kendi kopyasıyla, core1'i etkilemez
+    _startCalibrationBenchmark();
 }
 
 void PirobotServo2040::run() {
+    // İlk tur USB yığınını hemen çalıştırır
+    _core0Tasks->signal(TASK_USB);
+    
+    while (true) {
+        if (!_core0Tasks->runNext(time_us_32())) {
+            _core0Tasks->idle();
+        }
+    }
+}
+
+void PirobotServo2040::_registerTasks() {
+    // USB ve alım olay güdümlüdür; USB yığını her uyanışta (kesme) çalışır
+    _core0Tasks->addTask(TASK_USB, [](void* self) {
+        static_cast<PirobotServo2040*>(self)->_runUsb();
+    }, this, {1000, 200, 0, true, true});
+    _core0Tasks->addTask(TASK_USB_RX, [](void* self) {
+        static_cast<PirobotServo2040*>(self)->_runUsbRx();
+    }, this, {1000, 500, 1, true, false});
+    _core0Tasks->addTask(TASK_TX_FLUSH, [](void* self) {
+        PirobotServo2040* app = static_cast<PirobotServo2040*>(self);
+        app->_flushPendingFrame();
+        app->_commProtocol->getResponseWriter().poll();
+    }, this, {TX_FLUSH_TASK_US, 100, 2, false, false});
+    _core0Tasks->addTask(TASK_TELEMETRY, [](void* self) {
+        static_cast<PirobotServo2040*>(self)->_serviceSubscriptions();
+    }, this, {TELEMETRY_TASK_US, 300, 3, false, false});
+    _core0Tasks->addTask(TASK_GPIO_EDGES, [](void* self) {
+        static_cast<PirobotServo2040*>(self)->_serviceGpioEdges();
+    }, this, {1000, 100, 4, true, true});
+    _core0Tasks->addTask(TASK_LEDS, [](void* self) {
+        static_cast<PirobotServo2040*>(self)->_serviceLeds();
+    }, this, {LedManager::FRAME_US, 500, 5, false, false});
+    _core0Tasks->addTask(TASK_CAL_BENCH, [](void* self) {
+        static_cast<PirobotServo2040*>(self)->_benchmarkCalibration();
+    }, this, {LedManager::FRAME_US, 1000, 6, true, false});
+    
+    // Kontrol adımı periyodunun yarısını aşarsa aynı periyottaki komut ve tarama görevleri gecikir
+    _core1Tasks->addTask(TASK_COMMANDS, [](void* self) {
+        static_cast<PirobotServo2040*>(self)->_runCommands();
+    }, this, {_controlTickUs, 200, 0, true, false});
+    _core1Tasks->addTask(TASK_CONTROL_TICK, [](void* self) {
+        static_cast<PirobotServo2040*>(self)->_runControlTick();
+    }, this, {_controlTickUs, _controlTickUs / 2, 1, false, false});
+    _core1Tasks->addTask(TASK_ADC_SCAN, [](void* self) {
+        PirobotServo2040* app = static_cast<PirobotServo2040*>(self);
+        app->_sensorManager->scanStep();
+        app->_sampleCurrent();
+    }, this, {SensorManager::SCAN_STEP_US, 50, 2, false, false});
+    _core1Tasks->addTask(TASK_SERVO_ENABLE, [](void* self) {
+        static_cast<PirobotServo2040*>(self)->_servoDriver->updateEnable(time_us_32());
+    }, this, {ENABLE_TASK_US, 100, 3, false, false});
+    _core1Tasks->addTask(TASK_PUBLISH, [](void* self) {
+        PirobotServo2040* app = static_cast<PirobotServo2040*>(self);
+        app->_latency[LATENCY_RX_COMMIT].applyReset();
+        app->_publishShadow(time_us_32());
+    }, this, {SHADOW_PUBLISH_US, 100, 4, false, false});
+}
+
+void PirobotServo2040::_runUsb() {
+    // Call TinyUSB device task to handle USB events
+    tud_task();
+    
+    // Bağlantı kuruldu veya koptu: LED durumu, yeniden başlatma gerekmez
+    _serviceLink();
+}
+
+void PirobotServo2040::_runUsbRx() {
+    // Kuyruk dolduğu için bekleyen servo karesi yeni komutlardan önce gider
+    _flushPendingFrame();
+    _processCdcData();
+    
+    // Bütçe dolduysa kalan veri sonraki turda; arada diğer görevler çalışır.
+    // Bağlantı yokken veri sonraki bağlantının ilk sinyaliyle işlenir
+    if (_hasNewData && tud_cdc_connected()) {
+        _core0Tasks->signal(TASK_USB_RX);
+    }
+}
+
+void PirobotServo2040::_core1Entry() {
+    g_servo2040_instance->_core1Main();
+}
+
+void PirobotServo2040::_core1Main() {
+    // Sürüm saati core1 başladığında; init() sırasında biriken komutlar ilk turda uygulanır
+    uint32_t now = time_us_32();
+    _core1Tasks->start(now);
+    _core1Tasks->setRelease(TASK_CONTROL_TICK, _nextTickRelease(now));
+    _core1Tasks->signal(TASK_COMMANDS);
+    
     while (true) {
-        // Call TinyUSB device task to handle USB events
-        tud_task();
+        if (!_core1Tasks->runNext(time_us_32())) {
+            _core1Tasks->idle();
+        }
+    }
+}
+
+void PirobotServo2040::_runCommands() {
+    // core0'dan gelen komutlar, her biri ayrı bir servo karesi olarak uygulanır
+    bool changed = false;
+    ControlCommand cmd;
+    while (_commandQueue->pop(cmd)) {
+        _applyControlCommand(cmd);
+        changed = true;
+    }
+    
+    // Servo değişiklikleri hemen yayınlanır
+    if (changed) {
+        _publishShadow(time_us_32());
+    }
+}
+
+void PirobotServo2040::_runControlTick() {
+    uint32_t now = time_us_32();
+    _controlTick(now);
+    _publishShadow(now);
+    
+    // Geç kalan adım da bir sonraki wrap'e göre yeniden hizalanır
+    _core1Tasks->setRelease(TASK_CONTROL_TICK, _nextTickRelease(time_us_32()));
+}
+
+void PirobotServo2040::_applyControlCommand(const ControlCommand& cmd) {
+    if (cmd.kind == ControlCommand::Kind::SET_SERVOS) {
+        // Doğrudan SET servonun yörüngesini iptal eder
+        uint32_t mask = cmd.mask;
+        for (uint servoIdx = 0; mask != 0; servoIdx++, mask >>= 1) {
+            if ((mask & 1) && _stageTarget(servoIdx, cmd.values[servoIdx])) {
+                _trajectory->cancel(servoIdx, _slew->getTarget(servoIdx));
+            }
+        }
         
-        // Process data if available 
-        _processCdcData();
+        // Paketteki tüm servo hedefleri sonraki kontrol adımında tek PWM yüklemesiyle uygulanır
+        _submitFrame(cmd);
+    } else if (cmd.kind == ControlCommand::Kind::SCHEDULE_SERVOS) {
+        // Geç gelen kare atılmaz, bir sonraki kontrol adımında uygulanır
+        if ((int32_t)(cmd.applyAt_us - time_us_32()) < 0) {
+            _scheduleStats.late++;
+        }
+        if (!_schedule->push(cmd.applyAt_us, cmd)) {
+            _scheduleStats.overflow++;
+        }
+    } else if (cmd.kind == ControlCommand::Kind::DELTA_SERVOS) {
+        // Farklar son gönderilen kareye eklenir, yörüngeler SET'teki gibi iptal edilir
+        uint32_t mask = cmd.mask;
+        for (uint servoIdx = 0; mask != 0; servoIdx++, mask >>= 1) {
+            if (!(mask & 1)) {
+                continue;
+            }
+            bool staged = (cmd.absoluteMask & (1u << servoIdx)) ?
+                _stageTarget(servoIdx, cmd.values[servoIdx]) :
+                _stageTargetDelta(servoIdx, (int16_t)cmd.values[servoIdx]);
+            if (staged) {
+                _trajectory->cancel(servoIdx, _slew->getTarget(servoIdx));
+            }
+        }
+        _submitFrame(cmd);
+    } else if (cmd.kind == ControlCommand::Kind::KEYFRAME) {
+        auto mode = static_cast<TrajectoryPlanner::Interpolation>(cmd.interpolation);
+        uint32_t duration_us = (uint32_t)cmd.durationMs * 1000;
+        uint32_t now = time_us_32();
         
-        // Perform other tasks (sensors, servos, etc.)
-        // These tasks should be short and non-blocking
+        // Grup içindeki her servo aynı süre ve türle kuyruğa eklenir
+        for (uint i = 0; i < cmd.count; i++) {
+            _trajectory->push(cmd.startIdx + i, cmd.values[i], duration_us, mode, now);
+        }
+    } else if (cmd.kind == ControlCommand::Kind::GAIT) {
+        _gait->setCommand(cmd.gait);
+    } else if (cmd.kind == ControlCommand::Kind::SET_ANGLES) {
+        // Açılar servo kalibrasyonuyla darbeye çevrilir, sonrası SET ile aynı
+        int32_t angles[ServoCalibration::NUM_SERVOS];
+        uint16_t pulses[ServoCalibration::NUM_SERVOS];
+        for (uint i = 0; i < ServoCalibration::NUM_SERVOS; i++) {
+            angles[i] = (int16_t)cmd.values[i];
+        }
+        _angleStats.clamped += _calibration->toPulses(angles, cmd.mask, pulses);
+        _angleStats.frames++;
+        
+        uint32_t mask = cmd.mask;
+        for (uint servoIdx = 0; mask != 0; servoIdx++, mask >>= 1) {
+            if ((mask & 1) && _stageTarget(servoIdx, pulses[servoIdx])) {
+                _trajectory->cancel(servoIdx, _slew->getTarget(servoIdx));
+            }
+        }
+        _submitFrame(cmd);
+    } else if (cmd.kind == ControlCommand::Kind::CALIBRATE) {
+        // core0 kaydı doğruladı; yeni sınırlar mevcut pozisyona da uygulanır
+        if (_calibration->set(cmd.startIdx, cmd.calibration)) {
+            _servoDriver->setPulseLimits(cmd.startIdx, cmd.calibration.minPulse, cmd.calibration.maxPulse);
+            if (_stageTarget(cmd.startIdx, _slew->getTarget(cmd.startIdx))) {
+                _trajectory->cancel(cmd.startIdx, _slew->getTarget(cmd.startIdx));
+            }
+            _submitFrame(cmd);
+        }
+    } else if (cmd.kind == ControlCommand::Kind::SLEW_VELOCITY || cmd.kind == ControlCommand::Kind::SLEW_ACCEL) {
+        // Sınır kalkan servo bir sonraki kontrol adımında hedefine geçer
+        uint32_t mask = cmd.mask;
+        for (uint servoIdx = 0; mask != 0; servoIdx++, mask >>= 1) {
+            if (!(mask & 1)) {
+                continue;
+            }
+            if (cmd.kind == ControlCommand::Kind::SLEW_VELOCITY) {
+                _slew->setMaxVelocity(servoIdx, cmd.values[0]);
+            } else {
+                _slew->setMaxAccel(servoIdx, cmd.values[0] * SLEW_ACCEL_UNIT);
+            }
+        }
+    } else if (cmd.kind == ControlCommand::Kind::CURRENT_BUDGET) {
+        _governor->setBudget(cmd.values[0]);
+    } else if (cmd.kind == ControlCommand::Kind::CURRENT_PEAK_RESET) {
+        _governor->resetPeak();
+    }
+}
+
+bool PirobotServo2040::_stageTarget(uint servo, uint pulse) {
+    if (servo >= SlewLimiter::NUM_SERVOS) {
+        return false;
+    }
+    
+    uint16_t clamped = (uint16_t)_servoDriver->clampPulse(servo, pulse);
+    if (_slew->isLimited(servo)) {
+        _slew->setTarget(servo, clamped);
+        return true;
+    }
+    
+    // Sınırsız servoda sınırlayıcı çıkışla birlikte tutulur, sınır açılırsa buradan başlar
+    if (!_servoDriver->stageServo(servo, clamped)) {
+        return false;
+    }
+    _slew->reset(servo, clamped);
+    return true;
+}
+
+bool PirobotServo2040::_stageTargetDelta(uint servo, int delta) {
+    if (servo >= SlewLimiter::NUM_SERVOS) {
+        return false;
+    }
+    
+    int base = _slew->isLimited(servo) ? _slew->getTarget(servo) : (int)_servoDriver->getCommittedPosition(servo);
+    int pulse = base + delta;
+    return _stageTarget(servo, (pulse < 0) ? 0u : (uint)pulse);
+}
+
+void PirobotServo2040::_publishShadow(uint32_t now_us) {
+    ShadowRegisters shadow;
+    shadow.timestamp_us = now_us;
+    for (uint i = 0; i < TrajectoryPlanner::NUM_SERVOS; i++) {
+        shadow.pulses[i] = _servoDriver->getServoPosition(i);
+    }
+    
+    // Voltajları 10-bit değere dönüştür (0-1023 arası)
+    for (uint i = 0; i < RegisterMap::NUM_TOUCH; i++) {
+        shadow.touch[i] = (uint16_t)(_sensorManager->readTouchSensor(i) * 310.303f);
+    }
+    shadow.voltage = (uint16_t)(_sensorManager->readVoltage() * 310.303f);
+    
+    // Akımı 10-bit değere dönüştür (0-1023 arası, orta değer = 512 -> 0A)
+    shadow.current = (uint16_t)(_sensorManager->readCurrent() / 0.0814f) + 512;
+    
+    // ADC tarama tanılaması; yaş core0'da okuma anına göre hesaplanır
+    shadow.adcSampled = 0;
+    for (uint i = 0; i < RegisterMap::NUM_ADC_CHANNELS; i++) {
+        SensorManager::ChannelSample sample = _sensorManager->getSample(i);
+        uint rate = _sensorManager->getSampleRate(i);
+        shadow.adcSample_us[i] = sample.timestamp_us;
+        shadow.adcRate[i] = (rate > 0xFFFF) ? 0xFFFF : (uint16_t)rate;
+        if (sample.count > 0) {
+            shadow.adcSampled |= (1u << i);
+        }
     }
+    
+    shadow.framesCommitted = _servoDriver->getFramesCommitted();
+    shadow.framesCoalesced = _servoDriver->getFramesCoalesced();
+    shadow.schedulePending = _schedule->size();
+    shadow.scheduleApplied = _scheduleStats.applied;
+    shadow.scheduleLate = _scheduleStats.late;
+    shadow.scheduleOverflow = _scheduleStats.overflow;
+    shadow.gaitPattern = (uint16_t)_gait->getPattern();
+    shadow.gaitPhase = _gait->getPhase();
+    shadow.gaitCycles = _gait->getCycles();
+    shadow.gaitUnreachable = _gait->getUnreachable();
+    shadow.gaitUpdateUs = _gaitUpdateUs;
+    shadow.angleFrames = _angleStats.frames;
+    shadow.angleClamped = _angleStats.clamped;
+    shadow.slewReached = _slew->reachedMask();
+    shadow.slewLimitedSteps = _slew->getLimitedSteps();
+    shadow.currentEstimate = _governor->getEstimate();
+    shadow.currentPeak = _governor->getPeak();
+    shadow.throttledMs = _governor->getThrottledMs();
+    shadow.throttleEvents = _governor->getThrottleEvents();
+    shadow.governorScale = _governor->getScale();
+    shadow.servosEnabled = (uint16_t)_servoDriver->getEnabledCount();
+    
+    _shadow->write(shadow);
+}
+
+bool PirobotServo2040::_sendControlCommand(const ControlCommand& cmd) {
+    // Bekleyen servo karesi önce gitmeli, aksi halde yeni komut onun önüne geçerdi
+    if (_flushPendingFrame() && _pushCommand(cmd)) {
+        return true;
+    }
+    
+    // Kuyruk dolu: SET atılmaz, tümü mutlak bir fark karesi olarak bekleyen kareyle birleşir
+    if (cmd.kind == ControlCommand::Kind::SET_SERVOS) {
+        ControlCommand frame = cmd;
+        frame.kind = ControlCommand::Kind::DELTA_SERVOS;
+        frame.absoluteMask = cmd.mask;
+        _mergePendingFrame(frame);
+        return true;
+    }
+    
+    _commandsDropped++;
+    return false;
+}
+
+bool PirobotServo2040::_isDue(uint32_t now_us, uint32_t& deadline_us, uint32_t period_us) {
+    if ((int32_t)(now_us - deadline_us) < 0) {
+        return false;
+    }
+    
+    deadline_us += period_us;
+    if ((int32_t)(now_us - deadline_us) >= 0) {
+        deadline_us = now_us + period_us;
+    }
+    return true;
 }
 
 void PirobotServo2040::usbCdcRxCallback() {
-    // This is called from the USB interrupt
-    // Signal the main loop that data is available
+    // tud_task içinden çağrılır; alım görevi USB görevinden sonra çalışır.
+    // Gecikme, FIFO'daki işlenmemiş verinin ilk bildiriminden ölçülür
+    if (!_hasNewData) {
+        _rxCallback_us = time_us_64();
+    }
     _hasNewData = true;
+    _core0Tasks->signal(TASK_USB_RX);
 }
 
 // New method to process CDC data in a non-blocking way
 void PirobotServo2040::_processCdcData() {
-    if (!_hasNewData || !tud_cdc_connected()) {
+    if (!tud_cdc_connected()) {
+        // Yeni bağlantı her zaman eski protokolle başlar, bekleyen yanıtlar atılır
+        _commProtocol->setProtocolVersion(CommProtocol::PROTOCOL_LEGACY);
+        _commProtocol->getResponseWriter().reset();
+        for (uint i = 0; i < MAX_SUBSCRIPTIONS; i++) {
+            _subscriptions[i].active = false;
+        }
+        _delta.synced = false;
         return;
     }
-
-    // Check if data is available
-    uint32_t available = tud_cdc_available();
-    if (available == 0) {
-        _hasNewData = false;
+    
+    if (!_hasNewData) {
         return;
     }
-
-    // Read data from CDC buffer
-    uint32_t count = tud_cdc_read(_cdcRxBuffer, CDC_RX_BUFFER_SIZE);
     
-    // Process each byte
-    for (uint32_t i = 0; i < count; i++) {
-        // Process bytes using CommProtocol
-        if (_commProtocol->processByte(_cdcRxBuffer[i])) {
-            // A complete packet is received
-            auto& packet = _commProtocol->getCurrentPacket();
+    // FIFO boşalana kadar oku; bütçe dolarsa kalan veri bir sonraki turda işlenir
+    uint32_t processed = 0;
+    uint32_t available = tud_cdc_available();
+    while (available > 0 && processed < CDC_RX_BUDGET) {
+        if (available > _rxStats.fifoHighWater) {
+            _rxStats.fifoHighWater = available;
+        }
+        
+        uint32_t count = tud_cdc_read(_cdcRxBuffer, CDC_RX_BUFFER_SIZE);
+        _rxTimestamp_us = time_us_32();
+        processed += count;
+        
+        // Tamponu yerinde işle, her tam pakette dur ve paketi işle
+        uint32_t offset = 0;
+        while (offset < count) {
+            bool packetReady;
+            offset += _commProtocol->processBuffer(&_cdcRxBuffer[offset], count - offset, packetReady);
             
-            // Process packet based on command type
-            if (packet.type == CommProtocol::CommandType::SET) {
-                _processSetCommand(packet);
-            } else if (packet.type == CommProtocol::CommandType::GET) {
-                _processGetCommand(packet);
+            if (packetReady) {
+                _dispatchMeasured(_commProtocol->getCurrentPacket());
             }
         }
+        
+        available = tud_cdc_available();
     }
     
-    // Mark as processed
-    _hasNewData = false;
+    if (processed > _rxStats.maxBytesPerLoop) {
+        _rxStats.maxBytesPerLoop = processed;
+    }
+    
+    // Bu gruptaki yanıtlar birlikte, dolu paketlerle gönderilir
+    _commProtocol->getResponseWriter().endBatch();
+    
+    // Bayrak sadece FIFO gerçekten boşaldığında temizlenir
+    _hasNewData = (available > 0);
+    if (_hasNewData) {
+        _rxStats.budgetExhausted++;
+    }
+}
+
+void PirobotServo2040::_dispatchMeasured(const CommProtocol::CommandPacket& packet) {
+    uint64_t parsed = time_us_64();
+    _latency[LATENCY_RX_PARSE].record(parsed - _rxCallback_us);
+    
+    ResponseWriter& writer = _commProtocol->getResponseWriter();
+    _packetRx_us = _rxCallback_us;
+    writer.setOrigin(_rxCallback_us);
+    _dispatchPacket(packet);
+    writer.setOrigin(0);
+    _packetRx_us = 0;
+    
+    uint64_t handled = time_us_64() - parsed;
+    _latency[LATENCY_DISPATCH].record(handled);
+    if (packet.type == CommProtocol::CommandType::GET) {
+        _latency[LATENCY_GET].record(handled);
+    }
+}
+
+void PirobotServo2040::_dispatchPacket(const CommProtocol::CommandPacket& packet) {
+    // Açılıştan ilk kabul edilen komuta kadar geçen süre (saat açılışta sıfırdan başlar)
+    if (_firstCommand_us == 0) {
+        _firstCommand_us = (_rxTimestamp_us == 0) ? 1 : _rxTimestamp_us;
+    }
+    
+    // Process packet based on command type
+    if (packet.type == CommProtocol::CommandType::SET) {
+        _processSetCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::GET) {
+        _processGetCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::KEYFRAME) {
+        _processKeyframeCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::SUBSCRIBE) {
+        _processSubscribeCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::DISCOVER) {
+        _commProtocol->sendDiscovery(packet.seq);
+    } else if (packet.type == CommProtocol::CommandType::SNAPSHOT) {
+        _processSnapshotCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::READ_LIST) {
+        _processReadListCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::WRITE_LIST) {
+        _processWriteListCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::DELTA) {
+        _processDeltaCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::TIME_SYNC) {
+        _processTimeSyncCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::SCHEDULE) {
+        _processScheduleCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::POSE) {
+        _processPoseCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::GAIT) {
+        _processGaitCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::ANGLE) {
+        _processAngleCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::CALIBRATE) {
+        _processCalibrateCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::LED_FRAME) {
+        _processLedFrameCommand(packet);
+    } else if (packet.type == CommProtocol::CommandType::GPIO_EDGES) {
+        _sendGpioEdges(packet.count, packet.seq);
+    } else if (packet.type == CommProtocol::CommandType::DIAG) {
+        _processDiagCommand(packet);
+    }
 }
 
 void PirobotServo2040::_processSetCommand(const CommProtocol::CommandPacket& packet) {
-    uint startIdx = packet.startIdx;
-    uint count = packet.count;
+    // Paket doğrulama
+    if (packet.count == 0 || packet.count > CommProtocol::MAX_VALUES) {
+        return;  // Geçersiz değer sayısı
+    }
+    
+    _writeRegisters(packet.startIdx, packet.count, packet.values);
+}
+
+void PirobotServo2040::_processGetCommand(const CommProtocol::CommandPacket& packet) {
+    uint16_t values[CommProtocol::MAX_VALUES] = {0}; // Yanıt değerleri için geçici dizi
+    
+    // Paket doğrulama
+    if (packet.count == 0 || packet.count > CommProtocol::MAX_VALUES) {
+        return;  // Geçersiz değer sayısı
+    }
+    
+    ShadowRegisters shadow;
+    _shadow->read(shadow);
+    _readRegisters(shadow, packet.startIdx, packet.count, values);
+    
+    // Yanıtı gönder
+    _commProtocol->sendGetResponse(packet.startIdx, packet.count, values, packet.seq);
+}
+
+void PirobotServo2040::_processReadListCommand(const CommProtocol::CommandPacket& packet) {
+    uint16_t values[CommProtocol::MAX_VALUES] = {0}; // Yanıt değerleri için geçici dizi
     
     // Paket doğrulama
-    if (count == 0 || count > CommProtocol::MAX_VALUES) {
+    if (packet.count == 0 || packet.count > CommProtocol::MAX_VALUES) {
         return;  // Geçersiz değer sayısı
     }
     
-    for (uint i = 0; i < count; i++, startIdx++) {
-        uint value = packet.values[i];
+    ShadowRegisters shadow;
+    _shadow->read(shadow);
+    _readRegisterList(shadow, packet.indices, packet.count, values);
+    
+    _commProtocol->sendListResponse(packet.count, values, packet.seq);
+}
+
+void PirobotServo2040::_processWriteListCommand(const CommProtocol::CommandPacket& packet) {
+    // Paket doğrulama
+    if (packet.count == 0 || packet.count > CommProtocol::MAX_VALUES) {
+        return;  // Geçersiz değer sayısı
+    }
+    
+    _writeRegisterList(packet.indices, packet.count, packet.values);
+}
+
+void PirobotServo2040::_processDeltaCommand(const CommProtocol::CommandPacket& packet) {
+    bool key = (packet.mask & CommProtocol::DELTA_KEY_FLAG) != 0;
+    uint32_t errors = _frameErrorCount();
+    
+    // Son kareden bu yana bir v2 çerçevesi bozulduysa veya sıra numarası atladıysa host'un
+    // modeli artık cihazla aynı değil. Eski protokolde kayıp algılanamaz, zinciri yalnızca
+    // host'un periyodik anahtar kareleri düzeltir
+    if (!key && (!_delta.synced || errors != _delta.errorMark)) {
+        _delta.synced = false;
+        _delta.rejected++;
+        return;
+    }
+    _delta.synced = true;
+    _delta.errorMark = errors;
+    
+    if (key) {
+        _delta.keyFrames++;
+    } else {
+        _delta.deltaFrames++;
+    }
+    
+    // Anahtar karede tüm değerler mutlak
+    ControlCommand cmd;
+    cmd.kind = ControlCommand::Kind::DELTA_SERVOS;
+    cmd.mask = packet.mask & CommProtocol::DELTA_SERVO_MASK;
+    cmd.absoluteMask = key ? cmd.mask : 0;
+    
+    // Değerler maske sırasıyla gelir, komutta servo indeksine yerleşir
+    uint valueIdx = 0;
+    for (uint servoIdx = 0; servoIdx < TrajectoryPlanner::NUM_SERVOS; servoIdx++) {
+        if (cmd.mask & (1u << servoIdx)) {
+            cmd.values[servoIdx] = packet.values[valueIdx++];
+        }
+    }
+    
+    // Kuyruk dolu: kare bekleyen kareyle birleşir, sıradaki turda gönderilir
+    if (!_flushPendingFrame() || !_pushCommand(cmd)) {
+        _mergePendingFrame(cmd);
+    }
+}
+
+void PirobotServo2040::_mergePendingFrame(const ControlCommand& cmd) {
+    ControlCommand& pending = _delta.pendingCmd;
+    if (!_delta.pending) {
+        pending = cmd;
+        _delta.pending = true;
+        return;
+    }
+    
+    for (uint servoIdx = 0; servoIdx < TrajectoryPlanner::NUM_SERVOS; servoIdx++) {
+        uint32_t bit = 1u << servoIdx;
+        if (!(cmd.mask & bit)) {
+            continue;
+        }
+        if ((cmd.absoluteMask & bit) || !(pending.mask & bit)) {
+            pending.values[servoIdx] = cmd.values[servoIdx];
+            pending.absoluteMask = (pending.absoluteMask & ~bit) | (cmd.absoluteMask & bit);
+        } else {
+            // Fark, bekleyen mutlak değere veya farka eklenir
+            pending.values[servoIdx] += cmd.values[servoIdx];
+        }
+        pending.mask |= bit;
+    }
+    _delta.merged++;
+}
+
+bool PirobotServo2040::_flushPendingFrame() {
+    if (!_delta.pending) {
+        return true;
+    }
+    
+    if (!_pushCommand(_delta.pendingCmd)) {
+        return false;
+    }
+    _delta.pending = false;
+    return true;
+}
+
+bool PirobotServo2040::_pushCommand(const ControlCommand& cmd) {
+    // İşlenen paketin alım zamanı, core1 PWM'e yükleyince gecikmeyi hesaplar
+    ControlCommand stamped = cmd;
+    stamped.rx_us = _packetRx_us;
+    if (!_commandQueue->push(stamped)) {
+        return false;
+    }
+    _core1Tasks->signal(TASK_COMMANDS);
+    return true;
+}
+
+uint32_t PirobotServo2040::_frameErrorCount() const {
+    const FrameParser::Stats& stats = _commProtocol->getFrameStats();
+    return stats.crcErrors + stats.lengthErrors + stats.encodingErrors + stats.overflowErrors +
+           stats.sequenceGaps + _commProtocol->getRejectedFrames();
+}
+
+void PirobotServo2040::_processTimeSyncCommand(const CommProtocol::CommandPacket& packet) {
+    // Alım zamanı isteği içeren USB okumasının zamanıdır; yanıt grup sonunu
+    // beklemeden gönderilir, aksi halde bekleme süresi saat farkı ölçümüne girerdi
+    _commProtocol->sendTimeSync(_rxTimestamp_us, packet.seq);
+    _commProtocol->getResponseWriter().endBatch();
+}
+
+void PirobotServo2040::_processScheduleCommand(const CommProtocol::CommandPacket& packet) {
+    // Paket doğrulama
+    if (packet.count == 0 || packet.count > CommProtocol::MAX_VALUES) {
+        return;  // Geçersiz değer sayısı
+    }
+    
+    ControlCommand cmd;
+    cmd.kind = ControlCommand::Kind::SCHEDULE_SERVOS;
+    cmd.mask = 0;
+    cmd.applyAt_us = packet.applyAt_us;
+    
+    for (uint i = 0; i < packet.count; i++) {
+        const RegisterMap::Entry& reg = RegisterMap::lookup(packet.startIdx + i);
+        if (reg.kind == RegisterMap::Kind::SERVO) {
+            cmd.values[reg.sub] = packet.values[i];
+            cmd.mask |= 1u << reg.sub;
+        }
+    }
+    
+    if (cmd.mask != 0) {
+        _sendControlCommand(cmd);
+    }
+}
+
+void PirobotServo2040::_processPoseCommand(const CommProtocol::CommandPacket& packet) {
+    // Değerler işaretli: gövde x, y, z, roll, pitch, yaw, ardından ayak başına x, y, z
+    const int16_t* values = reinterpret_cast<const int16_t*>(packet.values);
+    
+    HexapodIK::BodyPose pose;
+    pose.position = {values[0], values[1], values[2]};
+    pose.roll = values[3];
+    pose.pitch = values[4];
+    pose.yaw = values[5];
+    
+    HexapodIK::Vec3 feet[HexapodIK::NUM_LEGS];
+    for (uint leg = 0; leg < HexapodIK::NUM_LEGS; leg++) {
+        const int16_t* foot = &values[6 + 3 * leg];
+        feet[leg] = {foot[0], foot[1], foot[2]};
+    }
+    
+    uint32_t start = time_us_32();
+    int32_t angles[HexapodIK::NUM_JOINTS];
+    _ikStats.unreachable += _ik->solve(pose, feet, angles);
+    
+    // Açılar core1'de servo kalibrasyonuyla darbeye çevrilir
+    ControlCommand cmd;
+    cmd.kind = ControlCommand::Kind::SET_ANGLES;
+    cmd.mask = (1u << HexapodIK::NUM_JOINTS) - 1;
+    for (uint i = 0; i < HexapodIK::NUM_JOINTS; i++) {
+        int32_t angle = (angles[i] < -ANGLE_LIMIT) ? -ANGLE_LIMIT : (angles[i] > ANGLE_LIMIT) ? ANGLE_LIMIT : angles[i];
+        cmd.values[i] = (uint16_t)(int16_t)angle;
+    }
+    
+    uint32_t elapsed = time_us_32() - start;
+    _ikStats.solves++;
+    _ikStats.lastUs = elapsed;
+    if (elapsed > _ikStats.maxUs) {
+        _ikStats.maxUs = elapsed;
+    }
+    
+    _sendControlCommand(cmd);
+}
+
+void PirobotServo2040::_processGaitCommand(const CommProtocol::CommandPacket& packet) {
+    // Değerler işaretli: desen, ileri hız, yana hız, dönüş hızı, adım yüksekliği, döngü süresi
+    const int16_t* values = reinterpret_cast<const int16_t*>(packet.values);
+    
+    ControlCommand cmd;
+    cmd.kind = ControlCommand::Kind::GAIT;
+    cmd.gait.pattern = static_cast<GaitGenerator::Pattern>(values[0] & 0xFF);
+    cmd.gait.vx = values[1];
+    cmd.gait.vy = values[2];
+    cmd.gait.turnRate = values[3];
+    cmd.gait.stepHeight = values[4];
+    cmd.gait.periodMs = (values[5] < 0) ? 0 : (uint16_t)values[5];
+    
+    _sendControlCommand(cmd);
+}
+
+void PirobotServo2040::_processAngleCommand(const CommProtocol::CommandPacket& packet) {
+    // Paket doğrulama
+    if (packet.count == 0 || packet.startIdx >= ServoCalibration::NUM_SERVOS) {
+        return;  // Geçersiz değer sayısı veya indeks
+    }
+    
+    // Değerler işaretli 0.1°, core1'e 0.01° olarak gider
+    const int16_t* values = reinterpret_cast<const int16_t*>(packet.values);
+    ControlCommand cmd;
+    cmd.kind = ControlCommand::Kind::SET_ANGLES;
+    cmd.mask = 0;
+    for (uint i = 0; i < packet.count && packet.startIdx + i < ServoCalibration::NUM_SERVOS; i++) {
+        int32_t angle = values[i] * 10;
+        angle = (angle < -ANGLE_LIMIT) ? -ANGLE_LIMIT : (angle > ANGLE_LIMIT) ? ANGLE_LIMIT : angle;
+        cmd.values[packet.startIdx + i] = (uint16_t)(int16_t)angle;
+        cmd.mask |= 1u << (packet.startIdx + i);
+    }
+    
+    _sendControlCommand(cmd);
+}
+
+void PirobotServo2040::_processCalibrateCommand(const CommProtocol::CommandPacket& packet) {
+    uint8_t servo = packet.startIdx;
+    if (servo >= ServoCalibration::NUM_SERVOS) {
+        return;  // Geçersiz servo
+    }
+    
+    // Değerler işaretli: min, mid, max, yön, ofset (0.1°), nokta başına açı (0.1°) ve darbe
+    const int16_t* values = reinterpret_cast<const int16_t*>(packet.values);
+    uint numPoints = (packet.count - CommProtocol::CALIBRATE_BASE_VALUES) / 2;
+    if (packet.count >= CommProtocol::CALIBRATE_BASE_VALUES &&
+        (packet.count - CommProtocol::CALIBRATE_BASE_VALUES) % 2 == 0 && numPoints <= ServoCalibration::MAX_POINTS) {
+        ServoCalibration::Entry entry = {};
+        bool valid = values[0] >= 0 && values[1] >= 0 && values[2] >= 0 &&
+                     values[4] >= -ANGLE_LIMIT / 10 && values[4] <= ANGLE_LIMIT / 10;
+        entry.minPulse = (uint16_t)values[0];
+        entry.midPulse = (uint16_t)values[1];
+        entry.maxPulse = (uint16_t)values[2];
+        entry.direction = (int8_t)values[3];
+        entry.offset = (int16_t)(values[4] * 10);
+        entry.numPoints = (uint8_t)numPoints;
+        for (uint i = 0; i < numPoints; i++) {
+            int16_t angle = values[CommProtocol::CALIBRATE_BASE_VALUES + 2 * i];
+            int16_t pulse = values[CommProtocol::CALIBRATE_BASE_VALUES + 2 * i + 1];
+            valid = valid && angle >= -ANGLE_LIMIT / 10 && angle <= ANGLE_LIMIT / 10 && pulse >= 0;
+            entry.points[i].angle = (int16_t)(angle * 10);
+            entry.points[i].pulse = (uint16_t)pulse;
+        }
+        
+        // Kayıt core0 kopyasında doğrulanır, sadece geçerli kayıt core1'e gider;
+        // kuyruk doluysa kopya eski kayda döner, iki çekirdek ayrışmaz
+        ServoCalibration::Entry previous = _calibrationView->get(servo);
+        if (valid && _calibrationView->set(servo, entry)) {
+            ControlCommand cmd;
+            cmd.kind = ControlCommand::Kind::CALIBRATE;
+            cmd.startIdx = servo;
+            cmd.calibration = entry;
+            if (!_sendControlCommand(cmd)) {
+                _calibrationView->set(servo, previous);
+            }
+        }
+    }
+    
+    // Yanıt servonun geçerli kaydı; reddedilen istekte eski kayıt döner
+    const ServoCalibration::Entry& current = _calibrationView->get(servo);
+    uint16_t reply[CommProtocol::CALIBRATE_BASE_VALUES + 2 * ServoCalibration::MAX_POINTS];
+    reply[0] = current.minPulse;
+    reply[1] = current.midPulse;
+    reply[2] = current.maxPulse;
+    reply[3] = (uint16_t)(int16_t)current.direction;
+    reply[4] = (uint16_t)(int16_t)(current.offset / 10);
+    for (uint i = 0; i < current.numPoints; i++) {
+        reply[CommProtocol::CALIBRATE_BASE_VALUES + 2 * i] = (uint16_t)(int16_t)(current.points[i].angle / 10);
+        reply[CommProtocol::CALIBRATE_BASE_VALUES + 2 * i + 1] = current.points[i].pulse;
+    }
+    _commProtocol->sendCalibration(servo, CommProtocol::CALIBRATE_BASE_VALUES + 2 * current.numPoints, reply,
+                                   packet.seq);
+}
+
+void PirobotServo2040::_startCalibrationBenchmark() {
+    // Süren ölçüm varsa baştan başlar
+    _calBench = {};
+    _core0Tasks->signal(TASK_CAL_BENCH);
+}
+
+void PirobotServo2040::_benchmarkCalibration() {
+    // Aynı açı seti iki yoldan CAL_BENCH_BATCHES kez çevrilir, her çalışmada CAL_BENCH_CHUNK kez
+    int32_t angles[ServoCalibration::NUM_SERVOS];
+    float degrees[ServoCalibration::NUM_SERVOS];
+    uint16_t pulses[ServoCalibration::NUM_SERVOS];
+    for (uint i = 0; i < ServoCalibration::NUM_SERVOS; i++) {
+        angles[i] = (int32_t)(i * 1000) - 8500;
+        degrees[i] = angles[i] / 100.0f;
+    }
+    
+    // Sonuçlar volatile toplamda tutulur, derleyici döngüleri atamaz
+    volatile uint32_t sink = 0;
+    
+    uint32_t start = time_us_32();
+    if (_calBench.step < CAL_BENCH_BATCHES) {
+        for (uint batch = 0; batch < CAL_BENCH_CHUNK; batch++) {
+            _calibrationView->toPulses(angles, ServoCalibration::ALL_SERVOS, pulses);
+            sink = sink + pulses[batch % ServoCalibration::NUM_SERVOS];
+        }
+        _calBench.fixedSumUs += time_us_32() - start;
+    } else {
+        for (uint batch = 0; batch < CAL_BENCH_CHUNK; batch++) {
+            for (uint i = 0; i < ServoCalibration::NUM_SERVOS; i++) {
+                pulses[i] = (uint16_t)_servoDriver->angleToPulseWidth(degrees[i]);
+            }
+            sink = sink + pulses[batch % ServoCalibration::NUM_SERVOS];
+        }
+        _calBench.floatSumUs += time_us_32() - start;
+    }
+    _calBench.step += CAL_BENCH_CHUNK;
+    
+    if (_calBench.step < 2 * CAL_BENCH_BATCHES) {
+        _core0Tasks->signal(TASK_CAL_BENCH);
+        return;
+    }
+    _calBench.fixedUs = _calBench.fixedSumUs;
+    _calBench.floatUs = _calBench.floatSumUs;
+}
+
+void PirobotServo2040::_processSnapshotCommand(const CommProtocol::CommandPacket& packet) {
+    uint16_t values[RegisterMap::NUM_MAPPED];
+    
+    // Tüm register'lar tek gölge kopyadan; zaman damgası core1 yayınının zamanı
+    ShadowRegisters shadow;
+    _shadow->read(shadow);
+    _readRegisters(shadow, 0, RegisterMap::NUM_MAPPED, values);
+    
+    _commProtocol->sendSnapshot(shadow.timestamp_us, RegisterMap::NUM_MAPPED, values, packet.seq);
+}
+
+void PirobotServo2040::_writeRegisters(uint startIdx, uint count, const uint16_t* values) {
+    ControlCommand servoCmd;
+    servoCmd.kind = ControlCommand::Kind::SET_SERVOS;
+    servoCmd.mask = 0;
+    
+    uint i = 0;
+    while (i < count) {
+        const RegisterMap::Entry& reg = RegisterMap::lookup(startIdx + i);
+        uint run = (reg.remaining < count - i) ? reg.remaining : count - i;
+        _writeRun(reg, run, &values[i], servoCmd);
+        i += run;
+    }
+    
+    // Paketteki servo hedefleri birlikte uygulanır
+    if (servoCmd.mask != 0) {
+        _sendControlCommand(servoCmd);
+    }
+}
+
+void PirobotServo2040::_writeRegisterList(const uint8_t* indices, uint count, const uint16_t* values) {
+    ControlCommand servoCmd;
+    servoCmd.kind = ControlCommand::Kind::SET_SERVOS;
+    servoCmd.mask = 0;
+    
+    for (uint i = 0; i < count; i++) {
+        _writeRun(RegisterMap::lookup(indices[i]), 1, &values[i], servoCmd);
+    }
+    
+    // Listedeki servo hedefleri birlikte uygulanır
+    if (servoCmd.mask != 0) {
+        _sendControlCommand(servoCmd);
+    }
+}
+
+void PirobotServo2040::_writeRun(const RegisterMap::Entry& reg, uint run, const uint16_t* in,
+                                 ControlCommand& servoCmd) {
+    if (!(reg.access & RegisterMap::WRITE)) {
+        return;  // Tanımsız veya salt okunur
+    }
+    
+    switch (reg.kind) {
+        case RegisterMap::Kind::SERVO:
+            // Servo hedefleri toplanır, çağıran tek komutla core1'e gönderir
+            for (uint j = 0; j < run; j++) {
+                servoCmd.values[reg.sub + j] = in[j];
+                servoCmd.mask |= 1u << (reg.sub + j);
+            }
+            break;
+        
+        case RegisterMap::Kind::GPIO: {
+            // A0 (RELAY), A1, A2: tek SET'teki pinler aynı anda değişir
+            uint8_t mask = 0;
+            uint8_t levels = 0;
+            for (uint j = 0; j < run; j++) {
+                uint pin = reg.sub + j;
+                mask |= 1u << pin;
+                levels |= (in[j] ? 1u : 0u) << pin;
+            }
+            _gpioManager->writeBank(mask, levels);
+            break;
+        }
+        
+        case RegisterMap::Kind::DIAG:
+            // Maskedeki sayfalar sıfırlanır; zamanlayıcılar ve histogramlar isteği kendi çekirdeklerinde uygular
+            if (in[0] & (1u << DIAG_PAGE_TASKS)) {
+                _core0Tasks->requestReset();
+                _core1Tasks->requestReset();
+            }
+            for (uint probe = 0; probe < NUM_LATENCY_PROBES; probe++) {
+                if (in[0] & (1u << (DIAG_PAGE_LATENCY + probe))) {
+                    _latency[probe].requestReset();
+                }
+            }
+            break;
+        
+        case RegisterMap::Kind::GPIO_BANK:
+            for (uint j = 0; j < run; j++) {
+                uint16_t value = in[j];
+                if (reg.sub + j == 0) {
+                    // Düşük 7 bit seviyeler, yüksek 7 bit yazma maskesi
+                    _gpioManager->writeBank((value >> 7) & GPIOManager::BANK_BITS, value & GPIOManager::BANK_BITS);
+                    continue;
+                }
+                
+                // Pin başına 4 bit: mod (bit 0-1), pull (bit 2-3); geçersiz ayarlı pin değişmez
+                for (uint pin = 0; pin < GPIOManager::NUM_PINS; pin++) {
+                    uint16_t config = (value >> (GPIO_MODE_BITS * pin)) & 0x0F;
+                    _gpioManager->setMode(pin, (GPIOManager::Mode)(config & 0x03),
+                                          (GPIOManager::Pull)(config >> 2));
+                }
+                _gpioEdgePush = (value & GPIO_EDGE_PUSH) != 0;
+            }
+            break;
+        
+        case RegisterMap::Kind::LED:
+            for (uint j = 0; j < run; j++) {
+                uint16_t value = in[j];
+                
+                // 14-bit değeri renk bileşenlerine ayır
+                // RGB - 4-bit per channel
+                uint8_t r = ((value >> 8) & 0x0F) << 4;  // 4-bit -> 8-bit
+                uint8_t g = ((value >> 4) & 0x0F) << 4;  // 4-bit -> 8-bit
+                uint8_t b = (value & 0x0F) << 4;         // 4-bit -> 8-bit
+                
+                // LED'i ayarla
+                _ledManager->setLed(reg.sub + j, r, g, b);
+            }
+            break;
+        
+        case RegisterMap::Kind::LED_EFFECT:
+            // Önce seçim maskesi, sonra efekt ayarları; gösterge aralığı alt ve üst uç 7'şer bit
+            for (uint j = 0; j < run; j++) {
+                uint sub = reg.sub + j;
+                if (sub == 0) {
+                    _ledSelect = in[j] & ((1u << LedManager::NUM_LEDS) - 1);
+                    continue;
+                }
+                for (uint led = 0; led < LedManager::NUM_LEDS; led++) {
+                    if (!(_ledSelect & (1u << led))) {
+                        continue;
+                    }
+                    uint8_t source = _ledManager->getMeterSource(led);
+                    uint16_t low = _ledManager->getMeterLow(led);
+                    uint16_t high = _ledManager->getMeterHigh(led);
+                    if (sub == 1) {
+                        _ledManager->setEffect(led, (LedManager::Effect)(in[j] & 0x7F));
+                        source = in[j] >> 7;
+                    } else if (sub == 2) {
+                        _ledManager->setEffect(led, _ledManager->getEffect(led), in[j]);
+                    } else {
+                        low = (in[j] & 0x7F) * LED_METER_UNIT;
+                        high = (in[j] >> 7) * LED_METER_UNIT;
+                    }
+                    _ledManager->setMeter(led, source, low, high);
+                }
+            }
+            break;
+        
+        case RegisterMap::Kind::TX_DEADLINE:
+            // Yanıt gönderim son tarihi (μs)
+            _commProtocol->getResponseWriter().setDeadline(in[run - 1]);
+            break;
+        
+        case RegisterMap::Kind::CAL_STATS:
+            // Herhangi bir değer ölçümü yeniden başlatır, ölçüm arka planda ilerler
+            _startCalibrationBenchmark();
+            break;
+        
+        case RegisterMap::Kind::SLEW_CONFIG:
+            // Önce seçim maskesi, sonra sınırlar: tek SET ile seçilip ayarlanabilir
+            for (uint j = 0; j < run; j++) {
+                uint sub = reg.sub + j;
+                if (sub == 0) {
+                    _slewSelect = (_slewSelect & ~0x3FFFu) | (in[j] & 0x3FFFu);
+                } else if (sub == 1) {
+                    _slewSelect = (_slewSelect & 0x3FFFu) | ((uint32_t)(in[j] & 0xF) << 14);
+                } else if (_slewSelect != 0) {
+                    ControlCommand cmd;
+                    cmd.kind = (sub == 2) ? ControlCommand::Kind::SLEW_VELOCITY : ControlCommand::Kind::SLEW_ACCEL;
+                    cmd.mask = _slewSelect;
+                    cmd.values[0] = in[j];
+                    if (!_sendControlCommand(cmd)) {
+                        continue;  // Kuyruk dolu, core0 kopyası da değişmez
+                    }
+                    for (uint servo = 0; servo < SlewLimiter::NUM_SERVOS; servo++) {
+                        if (_slewSelect & (1u << servo)) {
+                            uint16_t& field = (sub == 2) ? _slewConfig[servo].velocity : _slewConfig[servo].accel;
+                            field = in[j];
+                        }
+                    }
+                }
+            }
+            break;
+        
+        case RegisterMap::Kind::CURRENT_GOVERNOR:
+            // Bütçe ayarlanır, tepe akıma yazılan herhangi bir değer onu sıfırlar; sayaçlar salt okunur
+            for (uint j = 0; j < run; j++) {
+                uint sub = reg.sub + j;
+                if (sub != 0 && sub != 2) {
+                    continue;
+                }
+                ControlCommand cmd;
+                cmd.kind = (sub == 0) ? ControlCommand::Kind::CURRENT_BUDGET : ControlCommand::Kind::CURRENT_PEAK_RESET;
+                cmd.values[0] = in[j];
+                if (_sendControlCommand(cmd) && sub == 0) {
+                    _currentBudget = in[j];
+                }
+            }
+            break;
+        
+        default:
+            break;
+    }
+}
+
+void PirobotServo2040::_readRegisters(const ShadowRegisters& shadow, uint startIdx, uint count, uint16_t* values) {
+    uint i = 0;
+    while (i < count) {
+        const RegisterMap::Entry& reg = RegisterMap::lookup(startIdx + i);
+        uint run = (reg.remaining < count - i) ? reg.remaining : count - i;
+        _readRun(shadow, reg, run, &values[i]);
+        i += run;
+    }
+}
+
+void PirobotServo2040::_readRegisterList(const ShadowRegisters& shadow, const uint8_t* indices, uint count,
+                                         uint16_t* values) {
+    for (uint i = 0; i < count; i++) {
+        _readRun(shadow, RegisterMap::lookup(indices[i]), 1, &values[i]);
+    }
+}
+
+void PirobotServo2040::_readRun(const ShadowRegisters& shadow, const RegisterMap::Entry& reg, uint run,
+                                uint16_t* out) {
+    if (!(reg.access & RegisterMap::READ)) {
+        // Tanımsız veya salt yazılır, 0 döndür
+        for (uint j = 0; j < run; j++) {
+            out[j] = 0;
+        }
+        return;
+    }
+    
+    switch (reg.kind) {
+        case RegisterMap::Kind::SERVO:
+            // Servo pozisyonları core1'in son yayınından
+            for (uint j = 0; j < run; j++) {
+                out[j] = shadow.pulses[reg.sub + j];
+            }
+            break;
         
-        // Servo pozisyonu ayarla
-        if (startIdx <= SERVO_IDX_MAX) {
-            _servoDriver->moveServo(startIdx, value, false);
+        case RegisterMap::Kind::GPIO: {
+            uint8_t levels = _gpioManager->readBank();
+            for (uint j = 0; j < run; j++) {
+                out[j] = (levels >> (reg.sub + j)) & 1u;
+            }
+            break;
         }
-        // RELAY pini - A0_IDX değerinde olmalı
-        else if (startIdx == A0_IDX) {  // RELAY (A0)
-            // GPIOManager ile A0 (RELAY) pini kontrolü
-            bool state = value ? true : false;
-            _gpioManager->setA0(state);
+        
+        case RegisterMap::Kind::DIAG: {
+            uint32_t load = _core0Tasks->getLoadPermille();
+            out[0] = (load > VALUE_MAX) ? VALUE_MAX : (uint16_t)load;
+            break;
         }
-        // A1 pini - A1_IDX değerinde olmalı
-        else if (startIdx == A1_IDX) {  // A1
-            bool state = value ? true : false;
-            _gpioManager->setA1(state);
+        
+        case RegisterMap::Kind::GPIO_BANK:
+            for (uint j = 0; j < run; j++) {
+                if (reg.sub + j == 0) {
+                    // Seviyeler ve bekleyen kenar sayısı (127'de doyar)
+                    size_t pending = _gpioManager->pendingEdges();
+                    out[j] = _gpioManager->readBank() | ((pending > 0x7F) ? 0x7F : pending) << 7;
+                    continue;
+                }
+                
+                uint16_t config = _gpioEdgePush ? GPIO_EDGE_PUSH : 0;
+                for (uint pin = 0; pin < GPIOManager::NUM_PINS; pin++) {
+                    config |= ((uint16_t)_gpioManager->getMode(pin) |
+                               ((uint16_t)_gpioManager->getPull(pin) << 2)) << (GPIO_MODE_BITS * pin);
+                }
+                out[j] = config;
+            }
+            break;
+        
+        case RegisterMap::Kind::TOUCH:
+            for (uint j = 0; j < run; j++) {
+                out[j] = shadow.touch[reg.sub + j];
+            }
+            break;
+        
+        case RegisterMap::Kind::CURRENT:
+            out[0] = shadow.current;
+            break;
+        
+        case RegisterMap::Kind::VOLTAGE:
+            out[0] = shadow.voltage;
+            break;
+        
+        case RegisterMap::Kind::ADC_AGE:
+        case RegisterMap::Kind::ADC_RATE:
+            // ADC tarama tanılama değerleri (örnek yaşı ve örnekleme hızı), gölgeden
+            for (uint j = 0; j < run; j++) {
+                uint channel = reg.sub + j;
+                uint32_t stat;
+                if (reg.kind == RegisterMap::Kind::ADC_RATE) {
+                    stat = shadow.adcRate[channel];
+                } else if (shadow.adcSampled & (1u << channel)) {
+                    stat = time_us_32() - shadow.adcSample_us[channel];
+                } else {
+                    stat = UINT32_MAX;
+                }
+                out[j] = (stat > VALUE_MAX) ? VALUE_MAX : (uint16_t)stat;
+            }
+            break;
+        
+        case RegisterMap::Kind::CONTROL_STATS: {
+            // Servo kare sayaçları, komut kuyruğu kayıpları ve tekrarlanan gölge okumaları (14-bit'te sarar)
+            const uint32_t counters[RegisterMap::NUM_CONTROL_STATS] = {
+                shadow.framesCommitted, shadow.framesCoalesced,
+                _commandsDropped, _shadow->retries()
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = counters[reg.sub + j] & VALUE_MAX;
+            }
+            break;
         }
-        // A2 pini - A2_IDX değerinde olmalı
-        else if (startIdx == A2_IDX) {  // A2
-            bool state = value ? true : false;
-            _gpioManager->setA2(state);
+        
+        case RegisterMap::Kind::PROTO_STATS: {
+            // v2 çerçeve sayaçları (14-bit'te sarar)
+            const FrameParser::Stats& stats = _commProtocol->getFrameStats();
+            const uint32_t counters[RegisterMap::NUM_PROTO_STATS] = {
+                stats.framesOk, stats.crcErrors, stats.lengthErrors, stats.encodingErrors,
+                stats.overflowErrors, stats.sequenceGaps, _commProtocol->getRejectedFrames()
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = counters[reg.sub + j] & VALUE_MAX;
+            }
+            break;
         }
-        // LED komutları - LED_IDX_BASE ile LED_IDX_MAX arası
-        else if (startIdx >= LED_IDX_BASE && startIdx <= LED_IDX_MAX) {
-            uint ledIdx = startIdx - LED_IDX_BASE;
-            
-            // 14-bit değeri renk bileşenlerine ayır
-            // RGB - 4-bit per channel
-            uint8_t r = ((value >> 8) & 0x0F) << 4;  // 4-bit -> 8-bit
-            uint8_t g = ((value >> 4) & 0x0F) << 4;  // 4-bit -> 8-bit
-            uint8_t b = (value & 0x0F) << 4;         // 4-bit -> 8-bit
-            
-            // LED'i ayarla
-            _ledManager->setLed(ledIdx, r, g, b);
+        
+        case RegisterMap::Kind::RX_STATS: {
+            // USB alım yolu sayaçları (tepe değerler 14-bit'te sınırlanır)
+            const uint32_t counters[RegisterMap::NUM_RX_STATS] = {
+                _rxStats.fifoHighWater, _rxStats.maxBytesPerLoop, _rxStats.budgetExhausted & VALUE_MAX
+            };
+            for (uint j = 0; j < run; j++) {
+                uint32_t stat = counters[reg.sub + j];
+                out[j] = (stat > VALUE_MAX) ? VALUE_MAX : (uint16_t)stat;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::TX_STATS: {
+            // Yanıt gönderim sayaçları (14-bit'te sarar, ortalama hariç)
+            const ResponseWriter::Stats& stats = _commProtocol->getResponseWriter().stats();
+            const uint32_t counters[RegisterMap::NUM_TX_STATS] = {
+                stats.packetsSent,
+                (stats.packetsSent == 0) ? 0 : stats.bytesSent / stats.packetsSent,
+                stats.flushes[(uint)ResponseWriter::FlushReason::PACKET_FULL],
+                stats.flushes[(uint)ResponseWriter::FlushReason::BATCH_END],
+                stats.flushes[(uint)ResponseWriter::FlushReason::DEADLINE],
+                stats.droppedReplies
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = counters[reg.sub + j] & VALUE_MAX;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::TX_DEADLINE: {
+            uint32_t deadline = _commProtocol->getResponseWriter().getDeadline();
+            out[0] = (deadline > VALUE_MAX) ? VALUE_MAX : (uint16_t)deadline;
+            break;
+        }
+        
+        case RegisterMap::Kind::SUBSCRIPTION_STATS: {
+            // Telemetri push sayaçları (14-bit'te sarar)
+            const uint32_t counters[RegisterMap::NUM_SUBSCRIPTION_STATS] = {
+                _subscriptionFramesSent, _subscriptionFramesDropped
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = counters[reg.sub + j] & VALUE_MAX;
+            }
+            break;
         }
+        
+        case RegisterMap::Kind::SCHEDULE_STATS: {
+            // Zamanlanmış kare sayaçları core1'in son yayınından (14-bit'te sarar)
+            const uint32_t counters[RegisterMap::NUM_SCHEDULE_STATS] = {
+                shadow.schedulePending, shadow.scheduleApplied, shadow.scheduleLate, shadow.scheduleOverflow
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = counters[reg.sub + j] & VALUE_MAX;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::IK_STATS: {
+            // Ters kinematik sayaçları (14-bit'te sarar) ve çözüm süreleri (14-bit'te sınırlanır)
+            const uint32_t counters[RegisterMap::NUM_IK_STATS] = {
+                _ikStats.solves & VALUE_MAX, _ikStats.unreachable & VALUE_MAX, _ikStats.lastUs, _ikStats.maxUs
+            };
+            for (uint j = 0; j < run; j++) {
+                uint32_t stat = counters[reg.sub + j];
+                out[j] = (stat > VALUE_MAX) ? VALUE_MAX : (uint16_t)stat;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::GAIT_STATS: {
+            // Yürüyüş durumu core1'in son yayınından; faz 14-bit'e ölçeklenir, sayaçlar 14-bit'te sarar
+            const uint32_t counters[RegisterMap::NUM_GAIT_STATS] = {
+                shadow.gaitPattern, (uint32_t)shadow.gaitPhase >> 2, shadow.gaitCycles & VALUE_MAX,
+                shadow.gaitUnreachable & VALUE_MAX, shadow.gaitUpdateUs
+            };
+            for (uint j = 0; j < run; j++) {
+                uint32_t stat = counters[reg.sub + j];
+                out[j] = (stat > VALUE_MAX) ? VALUE_MAX : (uint16_t)stat;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::CAL_STATS: {
+            // Ölçüm süreleri (14-bit'te sınırlanır) ve core1'in açı sayaçları (14-bit'te sarar)
+            const uint32_t counters[RegisterMap::NUM_CAL_STATS] = {
+                _calBench.fixedUs, _calBench.floatUs, shadow.angleFrames & VALUE_MAX, shadow.angleClamped & VALUE_MAX
+            };
+            for (uint j = 0; j < run; j++) {
+                uint32_t stat = counters[reg.sub + j];
+                out[j] = (stat > VALUE_MAX) ? VALUE_MAX : (uint16_t)stat;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::SLEW_CONFIG: {
+            // Sınırlar seçili ilk servonunkidir
+            uint first = 0;
+            while (first < SlewLimiter::NUM_SERVOS - 1 && !(_slewSelect & (1u << first))) {
+                first++;
+            }
+            const uint32_t config[RegisterMap::NUM_SLEW_CONFIG] = {
+                _slewSelect & 0x3FFFu, _slewSelect >> 14, _slewConfig[first].velocity, _slewConfig[first].accel
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = config[reg.sub + j] & VALUE_MAX;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::SLEW_STATUS: {
+            // Hedefe ulaşma bitleri ve sınırlanan adımlar core1'in son yayınından (sayaç 14-bit'te sarar)
+            const uint32_t status[RegisterMap::NUM_SLEW_STATUS] = {
+                shadow.slewReached & 0x3FFFu, shadow.slewReached >> 14, shadow.slewLimitedSteps
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = status[reg.sub + j] & VALUE_MAX;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::CURRENT_GOVERNOR: {
+            // Akımlar mA (14-bit'te sınırlanır), kısılmış süre 10 ms biriminde ve olaylar 14-bit'te sarar
+            const uint32_t values[RegisterMap::NUM_CURRENT_GOVERNOR] = {
+                _currentBudget,
+                (shadow.currentEstimate > VALUE_MAX) ? VALUE_MAX : shadow.currentEstimate,
+                (shadow.currentPeak > VALUE_MAX) ? VALUE_MAX : shadow.currentPeak,
+                (shadow.throttledMs / 10) & VALUE_MAX,
+                shadow.throttleEvents & VALUE_MAX,
+                shadow.governorScale
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = (uint16_t)values[reg.sub + j];
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::PWM_CONFIG: {
+            // Frekans ve faz ayarı açılıştan sonra değişmez, etkin servo sayısı core1'den;
+            // 50 Hz'in 20000 μs'lik adımı 14 bit'e sığmadığı için adım 10 μs biriminde
+            const uint32_t values[RegisterMap::NUM_PWM_CONFIG] = {
+                (uint32_t)(_servoDriver->getFrequency() + 0.5f), (_controlTickUs + 5) / 10,
+                _servoDriver->isAutoPhase() ? 1u : 0u, shadow.servosEnabled
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = values[reg.sub + j] & VALUE_MAX;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::BOOT_STATS: {
+            // Açılış süresi 10 μs, ilk komut ms biriminde; 14-bit'e sığmayan süreler sınırlanır
+            const uint32_t values[RegisterMap::NUM_BOOT_STATS] = {
+                (_bootReady_us + 5) / 10, (_firstCommand_us + 500) / 1000
+            };
+            for (uint j = 0; j < run; j++) {
+                uint32_t value = values[reg.sub + j];
+                out[j] = (value > VALUE_MAX) ? VALUE_MAX : (uint16_t)value;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::LED_EFFECT: {
+            // Ayarlar seçili ilk LED'inkidir
+            uint first = 0;
+            while (first < LedManager::NUM_LEDS - 1 && !(_ledSelect & (1u << first))) {
+                first++;
+            }
+            const uint32_t values[RegisterMap::NUM_LED_EFFECT] = {
+                _ledSelect,
+                (uint32_t)_ledManager->getEffect(first) | ((uint32_t)_ledManager->getMeterSource(first) << 7),
+                _ledManager->getPeriodMs(first),
+                (uint32_t)(_ledManager->getMeterLow(first) / LED_METER_UNIT) |
+                    ((uint32_t)(_ledManager->getMeterHigh(first) / LED_METER_UNIT) << 7)
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = values[reg.sub + j] & VALUE_MAX;
+            }
+            break;
+        }
+        
+        case RegisterMap::Kind::DELTA_STATS: {
+            // Fark karesi sayaçları (14-bit'te sarar) ve zincir durumu
+            const uint32_t counters[RegisterMap::NUM_DELTA_STATS] = {
+                _delta.keyFrames, _delta.deltaFrames, _delta.rejected, _delta.merged, _delta.synced ? 1u : 0u
+            };
+            for (uint j = 0; j < run; j++) {
+                out[j] = counters[reg.sub + j] & VALUE_MAX;
+            }
+            break;
+        }
+        
+        default:
+            for (uint j = 0; j < run; j++) {
+                out[j] = 0;
+            }
+            break;
     }
 }
 
-void PirobotServo2040::_processGetCommand(const CommProtocol::CommandPacket& packet) {
-    uint startIdx = packet.startIdx;
-    uint count = packet.count;
-    uint16_t values[CommProtocol::MAX_VALUES] = {0}; // Yanıt değerleri için geçici dizi
+void PirobotServo2040::_processSubscribeCommand(const CommProtocol::CommandPacket& packet) {
+    if (packet.slot >= MAX_SUBSCRIPTIONS) {
+        return;  // Geçersiz yuva
+    }
+    
+    Subscription& sub = _subscriptions[packet.slot];
+    
+    // Periyot 0 aboneliği iptal eder
+    if (packet.periodMs == 0) {
+        sub.active = false;
+        return;
+    }
     
     // Paket doğrulama
-    if (count == 0 || count > CommProtocol::MAX_VALUES) {
+    if (packet.count == 0 || packet.count > CommProtocol::MAX_VALUES) {
         return;  // Geçersiz değer sayısı
     }
     
-    for (uint i = 0; i < count; i++, startIdx++) {
-        // Servo pozisyonu oku
-        if (startIdx <= SERVO_IDX_MAX) {
-            values[i] = _servoDriver->getServoPosition(startIdx);
+    sub.startIdx = packet.startIdx;
+    sub.count = packet.count;
+    sub.seq = 0;
+    sub.periodUs = (uint32_t)packet.periodMs * 1000;
+    sub.nextUs = time_us_32();  // İlk çerçeve hemen gider
+    sub.active = true;
+}
+
+void PirobotServo2040::_serviceSubscriptions() {
+    if (!tud_cdc_connected()) {
+        return;
+    }
+    
+    for (uint slot = 0; slot < MAX_SUBSCRIPTIONS; slot++) {
+        Subscription& sub = _subscriptions[slot];
+        if (!sub.active) {
+            continue;
         }
-        // A0 durumunu oku
-        else if (startIdx == A0_IDX) {  // A0/
-            values[i] = _gpioManager->getA0() ? 1 : 0;
+        
+        uint32_t now = time_us_32();
+        if (!_isDue(now, sub.nextUs, sub.periodUs)) {
+            continue;
         }
-        // A1 durumunu oku
-        else if (startIdx == A1_IDX) {  // A1
-            values[i] = _gpioManager->getA1() ? 1 : 0;
+        
+        uint16_t values[CommProtocol::MAX_VALUES];
+        ShadowRegisters shadow;
+        _shadow->read(shadow);
+        _readRegisters(shadow, sub.startIdx, sub.count, values);
+        
+        // Sıra numarası atılan çerçevelerde de ilerler, host kaybı buradan görür
+        if (_commProtocol->sendTelemetry(slot, sub.seq++, sub.startIdx, sub.count, now, values)) {
+            _subscriptionFramesSent++;
+        } else {
+            _subscriptionFramesDropped++;
         }
-        // A2 durumunu oku
-        else if (startIdx == A2_IDX) {  // A2
-            values[i] = _gpioManager->getA2() ? 1 : 0;
+    }
+}
+
+void PirobotServo2040::_serviceLeds() {
+    uint32_t now = time_us_32();
+    if (!_ledManager->isFrameDue(now)) {
+        return;
+    }
+    
+    // Gösterge kaynakları tek tutarlı gölge okumasından
+    bool shadowRead = false;
+    ShadowRegisters shadow;
+    for (uint led = 0; led < LedManager::NUM_LEDS; led++) {
+        if (_ledManager->getEffect(led) != LedManager::Effect::METER) {
+            continue;
         }
-        // Dokunmatik sensör değeri oku
-        else if (startIdx >= TOUCH_START_IDX && startIdx <= TOUCH_END_IDX) {  // TS1-TS6
-            uint sensorIdx = startIdx - TOUCH_START_IDX;
-            float sensor_voltage = _sensorManager->readTouchSensor(sensorIdx);
-            // Voltajı 10-bit değere dönüştür (0-1023 arası)
-            values[i] = (uint16_t)(sensor_voltage * 310.303f);
+        if (!shadowRead) {
+            _shadow->read(shadow);
+            shadowRead = true;
         }
-        // Akım değeri oku
-        else if (startIdx == CURRENT_IDX) {  // CURR
-            float current = _sensorManager->readCurrent();
-            // Akımı 10-bit değere dönüştür (0-1023 arası, orta değer = 512 -> 0A)
-            values[i] = (uint16_t)(current / 0.0814f) + 512;
+        uint8_t source = _ledManager->getMeterSource(led);
+        uint16_t value;
+        _readRegisterList(shadow, &source, 1, &value);
+        _ledManager->setMeterValue(led, value);
+    }
+    
+    _ledManager->render(now);
+}
+
+void PirobotServo2040::_serviceGpioEdges() {
+    if (!_gpioEdgePush || _gpioManager->pendingEdges() == 0 || !tud_cdc_connected()) {
+        return;
+    }
+    
+    // Sıra numarası her push'ta ilerler, host kayıp çerçeveyi buradan görür
+    _sendGpioEdges(CommProtocol::GPIO_EDGES_MAX, _gpioEdgeSeq++);
+}
+
+bool PirobotServo2040::_sendGpioEdges(uint8_t maxEdges, uint8_t seq) {
+    if (maxEdges == 0 || maxEdges > CommProtocol::GPIO_EDGES_MAX) {
+        maxEdges = CommProtocol::GPIO_EDGES_MAX;
+    }
+    
+    uint8_t codes[CommProtocol::GPIO_EDGES_MAX];
+    uint32_t times[CommProtocol::GPIO_EDGES_MAX];
+    uint8_t count = 0;
+    GPIOManager::Edge edge;
+    while (count < maxEdges && _gpioManager->popEdge(edge)) {
+        codes[count] = edge.pin | (edge.level ? CommProtocol::GPIO_EDGE_LEVEL : 0);
+        times[count] = edge.time_us;
+        count++;
+    }
+    
+    size_t remaining = _gpioManager->pendingEdges();
+    uint32_t dropped = _gpioManager->getDroppedEdges();
+    return _commProtocol->sendGpioEdges(count, (remaining > 0xFF) ? 0xFF : (uint8_t)remaining,
+                                        (dropped > 0xFFFF) ? 0xFFFF : (uint16_t)dropped, codes, times, seq);
+}
+
+void PirobotServo2040::_processDiagCommand(const CommProtocol::CommandPacket& packet) {
+    uint8_t count = (packet.count > CommProtocol::MAX_VALUES) ? CommProtocol::MAX_VALUES : packet.count;
+    uint16_t values[CommProtocol::MAX_VALUES];
+    for (uint i = 0; i < count; i++) {
+        values[i] = _readDiagnostic(packet.slot, packet.startIdx + i);
+    }
+    _commProtocol->sendDiagnostics(packet.slot, packet.startIdx, count, values, packet.seq);
+}
+
+uint16_t PirobotServo2040::_readDiagnostic(uint page, uint index) const {
+    if (page >= DIAG_PAGE_LATENCY && page < DIAG_PAGE_LATENCY + NUM_LATENCY_PROBES) {
+        if (index >= DIAG_LATENCY_FIELDS) {
+            return 0;
         }
-        // Voltaj değeri oku
-        else if (startIdx == VOLTAGE_IDX) {  // VOLT
-            float voltage = _sensorManager->readVoltage();
-            // Voltajı 10-bit değere dönüştür (0-1023 arası)
-            values[i] = (uint16_t)(voltage * 310.303f);
+        
+        // Sayı ve kovalar iki protokolde de taşınsın diye düşük ve yüksek 14 bit olarak
+        const LatencyHistogram& histogram = _latency[page - DIAG_PAGE_LATENCY];
+        uint32_t value;
+        uint half;
+        if (index < 2) {
+            value = histogram.getCount();
+            half = index;
+        } else if (index < 5) {
+            const uint32_t times[3] = {histogram.getMin(), histogram.getAvg(), histogram.getMax()};
+            value = times[index - 2];
+            return (value > 0xFFFF) ? 0xFFFF : (uint16_t)value;
+        } else {
+            value = histogram.getBucket((index - 5) / 2);
+            half = (index - 5) % 2;
         }
-        else {
-            values[i] = 0;  // Geçersiz indeks, 0 döndür
+        value = (half == 0) ? (value & VALUE_MAX) : (value >> 14);
+        return (value > VALUE_MAX) ? VALUE_MAX : (uint16_t)value;
+    }
+    
+    if (page != DIAG_PAGE_TASKS) {
+        return 0;
+    }
+    
+    uint32_t value = 0;
+    if (index < DIAG_TASK_HEADER) {
+        const uint32_t header[DIAG_TASK_HEADER] = {
+            NUM_CORE0_TASKS + NUM_CORE1_TASKS, DIAG_TASK_FIELDS,
+            _core0Tasks->getLoadPermille(), _core1Tasks->getLoadPermille()
+        };
+        value = header[index];
+    } else {
+        uint record = (index - DIAG_TASK_HEADER) / DIAG_TASK_FIELDS;
+        uint field = (index - DIAG_TASK_HEADER) % DIAG_TASK_FIELDS;
+        if (record >= NUM_CORE0_TASKS + NUM_CORE1_TASKS) {
+            return 0;
         }
+        
+        const TaskScheduler& tasks = (record < NUM_CORE0_TASKS) ? *_core0Tasks : *_core1Tasks;
+        uint id = (record < NUM_CORE0_TASKS) ? record : record - NUM_CORE0_TASKS;
+        const TaskScheduler::Config& config = tasks.getConfig(id);
+        const TaskScheduler::Stats& stats = tasks.getStats(id);
+        
+        // Periyot ve bütçe 10 μs biriminde: 20000 μs'lik periyot eski protokolün 14 bit'ine sığar.
+        // Kayıtlar 7-bit ilk değer indeksine (< 128) sığmalı, bu yüzden alanlar ikiye bölünmez
+        const uint32_t fields[DIAG_TASK_FIELDS] = {
+            (config.period_us + DIAG_TASK_CONFIG_UNIT_US / 2) / DIAG_TASK_CONFIG_UNIT_US,
+            (config.budget_us + DIAG_TASK_CONFIG_UNIT_US / 2) / DIAG_TASK_CONFIG_UNIT_US,
+            config.priority | (config.event ? DIAG_TASK_EVENT : 0u),
+            stats.wcet_us, stats.avg_us, stats.maxLatency_us, stats.loadPermille,
+            stats.deadlineMisses, stats.overruns
+        };
+        value = fields[field];
+    }
+    return (value > 0xFFFF) ? 0xFFFF : (uint16_t)value;
+}
+
+void PirobotServo2040::_processKeyframeCommand(const CommProtocol::CommandPacket& packet) {
+    // Paket doğrulama
+    if (packet.count == 0 || packet.count > CommProtocol::MAX_VALUES ||
+        packet.startIdx >= TrajectoryPlanner::NUM_SERVOS) {
+        return;  // Geçersiz değer sayısı veya indeks
     }
     
-    // Yanıtı gönder
-    _commProtocol->sendGetResponse(packet.startIdx, packet.count, values);
+    ControlCommand cmd;
+    cmd.kind = ControlCommand::Kind::KEYFRAME;
+    cmd.startIdx = packet.startIdx;
+    cmd.count = 0;
+    cmd.interpolation = packet.interpolation;
+    cmd.durationMs = packet.durationMs;
+    
+    for (uint i = 0; i < packet.count && cmd.startIdx + i < TrajectoryPlanner::NUM_SERVOS; i++) {
+        cmd.values[cmd.count++] = packet.values[i];
+    }
+    
+    _sendControlCommand(cmd);
 }
 
-void PirobotServo2040::_waitForVCPConnection() {
-    // TinyUSB bağlantı animasyonu başlat
-    while (!tud_cdc_connected()) {
-        _ledManager->pendingConnectionAnimation();
-        
-        // TinyUSB task'ı işle
-        tud_task();
+void PirobotServo2040::_processLedFrameCommand(const CommProtocol::CommandPacket& packet) {
+    for (uint i = 0; i < CommProtocol::LED_FRAME_LEDS; i++) {
+        uint32_t color = packet.values[2 * i] | ((uint32_t)packet.values[2 * i + 1] << 16);
+        _ledManager->setLed(i, (color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+    }
+}
+
+void PirobotServo2040::_submitFrame(const ControlCommand& cmd) {
+    _servoDriver->submitFrame();
+    if (cmd.rx_us != 0) {
+        _submittedRx_us = cmd.rx_us;
+    }
+}
+
+uint32_t PirobotServo2040::_nextTickRelease(uint32_t now_us) const {
+    uint32_t lead = _controlTickUs / 2;
+    return _servoDriver->getNextWrap(now_us + lead) - lead;
+}
+
+void PirobotServo2040::_controlTick(uint32_t now_us) {
+    uint16_t pulses[TrajectoryPlanner::NUM_SERVOS];
+    uint32_t mask = _trajectory->update(now_us, pulses);
+    
+    for (uint i = 0; mask != 0; i++, mask >>= 1) {
+        if (mask & 1) {
+            _stageTarget(i, pulses[i]);
+        }
+    }
+    
+    // Yürüyüş faz ilerlemesi ve ayak yörüngeleri, yörünge çıktısının üzerine
+    uint32_t start = time_us_32();
+    int32_t angles[HexapodIK::NUM_JOINTS];
+    if (_gait->update(now_us, angles)) {
+        uint16_t gaitPulses[ServoCalibration::NUM_SERVOS];
+        _angleStats.clamped += _calibration->toPulses(angles, ServoCalibration::ALL_SERVOS, gaitPulses);
+        _angleStats.frames++;
+        for (uint i = 0; i < HexapodIK::NUM_JOINTS; i++) {
+            if (_stageTarget(i, gaitPulses[i])) {
+                _trajectory->cancel(i, _slew->getTarget(i));
+            }
+        }
+        _gaitUpdateUs = time_us_32() - start;
     }
     
-    // Bağlantı kuruldu, bağlantı durumunu göster
-    _ledManager->setConnectedStatus(true);
-    sleep_ms(1000);  // Kısa bir süre göster
+    // Zamanı gelen kareler aynı karede, zaman sırasıyla yörünge çıktısının üzerine yazılır
+    ControlCommand cmd;
+    while (_schedule->popDue(now_us, cmd)) {
+        uint32_t servos = cmd.mask;
+        for (uint servoIdx = 0; servos != 0; servoIdx++, servos >>= 1) {
+            if ((servos & 1) && _stageTarget(servoIdx, cmd.values[servoIdx])) {
+                _trajectory->cancel(servoIdx, _slew->getTarget(servoIdx));
+            }
+        }
+        _scheduleStats.applied++;
+    }
     
-    // LEDleri temizle
-    _ledManager->clearAllLeds();
-}
\ No newline at end of file
+    // Hız sınırlı servoların çıkışı bu karenin hedeflerine doğru bir adım ilerler;
+    // akım bütçeye yaklaştıysa sınırlar ölçeklenir ve sınırsız servolar sıraya girer
+    uint32_t dt_us = (_lastTick_us == 0) ? 0 : now_us - _lastTick_us;
+    _lastTick_us = (now_us == 0) ? 1 : now_us;
+    _slew->setScale(_governor->update(dt_us));
+    uint32_t moved = _slew->update(dt_us, pulses);
+    for (uint i = 0; moved != 0; i++, moved >>= 1) {
+        if (moved & 1) {
+            _servoDriver->stageServo(i, pulses[i]);
+        }
+    }
+    
+    // Periyot başına tek yükleme; araya giren host karelerinin sonuncusu bununla çıkar
+    if (_servoDriver->commitFrame() && _submittedRx_us != 0) {
+        _latency[LATENCY_RX_COMMIT].record(time_us_64() - _submittedRx_us);
+    }
+    _submittedRx_us = 0;
+}
+
+void PirobotServo2040::_sampleCurrent() {
+    uint32_t count = _sensorManager->getSample(servo_defs::CURRENT_SENSE_ADDR).count;
+    if (count == _currentSampleCount) {
+        return;
+    }
+    _currentSampleCount = count;
+    _governor->sample((int32_t)(_sensorManager->readCurrent() * 1000.0f));
+}
+
+void PirobotServo2040::_serviceLink() {
+    bool connected = tud_cdc_connected();
+    if (connected == _linkUp) {
+        return;
+    }
+    _linkUp = connected;
+    
+    // Protokol durumu alım görevinde (_processCdcData) sıfırlanır, burada sadece LED durumu değişir
+    _core0Tasks->signal(TASK_USB_RX);
+    
+    if (connected) {
+        _ledManager->setConnectedStatus(true);
+    } else {
+        _ledManager->pendingConnectionAnimation();
+    }
+}
@@ -11,6 +11,18 @@
 #include "led_manager.hpp"
 #include "gpio_manager.hpp"
 #include "comm_protocol.hpp"
+#include "trajectory_planner.hpp"
+#include "hexapod_ik.hpp"
+#include "gait_generator.hpp"
+#include "servo_calibration.hpp"
+#include "slew_limiter.hpp"
+#include "current_governor.hpp"
+#include "spsc_queue.hpp"
+#include "seqlock.hpp"
+#include "schedule_queue.hpp"
+#include "register_map.hpp"
+#include "task_scheduler.hpp"
+#include "latency_histogram.hpp"
 
 // Forward declaration for callback
 class PirobotServo2040;
@@ -18,6 +30,12 @@ extern PirobotServo2040* g_servo2040_instance;
 
 /**
  * @brief Ana uygulama sınıfı - Servo2040 için servo kontrolü, sensör okuma ve iletişim
+ * 
+ * İş iki çekirdeğe bölünür: core0 TinyUSB, CommProtocol, LED ve GPIO'yu
+ * yürütür; core1 servo commit, sensör taraması ve yörünge enterpolasyonunu
+ * içeren deterministik kontrol döngüsünü yürütür. Çekirdekler arasında
+ * sadece kilitsiz SPSC komut kuyruğu ve seqlock korumalı gölge register'lar
+ * paylaşılır.
  */
 class PirobotServo2040 {
 public:
@@ -27,7 +45,7 @@ public:
     PirobotServo2040();
     
     /**
-     * @brief Sistemi başlatır
+     * @brief Sistemi başlatır, hiçbir adımda beklemez (host bağlantısı run() içinde izlenir)
      */
     void init();
     
@@ -40,49 +58,370 @@ public:
      * @brief USB CDC veri alındığında çağrılan callback
      */
     void usbCdcRxCallback();
-    
+
 private:
+    /**
+     * @brief core0'dan core1'e giden kontrol komutu
+     */
+    struct ControlCommand {
+        enum class Kind : uint8_t {
+            SET_SERVOS,   // Maskedeki servo hedeflerini doğrudan uygula
+            SCHEDULE_SERVOS, // Maskedeki servo hedeflerini applyAt_us'den sonraki ilk kontrol adımında uygula
+            DELTA_SERVOS, // Maskedeki servolara son uygulanan kareye göre fark (absoluteMask'takilere mutlak değer) uygula
+            KEYFRAME,     // Yörünge kuyruğuna anahtar kare ekle
+            GAIT,         // Yürüyüş üretecinin komutunu değiştir
+            SET_ANGLES,   // Maskedeki servo açılarını kalibrasyonla darbeye çevirip uygula
+            CALIBRATE,    // Servonun kalibrasyon kaydını değiştir
+            SLEW_VELOCITY, // Maskedeki servoların hız sınırını values[0] yap (μs/s)
+            SLEW_ACCEL,   // Maskedeki servoların ivme sınırını values[0] yap (SLEW_ACCEL_UNIT)
+            CURRENT_BUDGET, // Akım bütçesini values[0] yap (mA, 0 = kapalı)
+            CURRENT_PEAK_RESET // Tepe akımı sıfırla
+        };
+        
+        Kind kind;                                        // Komut türü
+        uint8_t startIdx;                                 // İlk servo indeksi (KEYFRAME)
+        uint8_t count;                                    // Servo sayısı (KEYFRAME)
+        uint32_t mask;                                    // Uygulanacak servolar, values servo indeksiyle (SET_SERVOS, DELTA_SERVOS)
+        uint32_t absoluteMask;                            // Mutlak değer taşıyan servolar (DELTA_SERVOS)
+        uint8_t interpolation;                            // Enterpolasyon türü (KEYFRAME)
+        uint16_t durationMs;                              // Anahtar kare süresi (KEYFRAME)
+        uint32_t applyAt_us;                              // Uygulama zamanı, cihaz saatiyle (SCHEDULE_SERVOS)
+        GaitGenerator::Command gait;                      // Yürüyüş komutu (GAIT)
+        ServoCalibration::Entry calibration;              // Kalibrasyon kaydı, servo startIdx'te (CALIBRATE)
+        uint16_t values[TrajectoryPlanner::NUM_SERVOS];   // Darbe genişlikleri (DELTA_SERVOS'ta i16 farklar, SET_ANGLES'ta i16 açılar, 0.01°)
+        uint64_t rx_us;                                   // İsteğin USB alım zamanı (time_us_64), 0 = ölçülmez
+    };
+    
+    /**
+     * @brief core1'in yayınladığı gölge register'lar
+     * 
+     * Servo ve sensör değerleri core1'de register biçimine çevrilip tek
+     * seqlock yayınıyla core0'a aktarılır; GET, abonelik ve SNAPSHOT yanıtları
+     * aynı anda alınmış tutarlı bir kopyadan üretilir.
+     */
+    struct ShadowRegisters {
+        uint32_t timestamp_us;                            // Durumun üretildiği zaman
+        uint16_t pulses[TrajectoryPlanner::NUM_SERVOS];   // Uygulanan darbe genişlikleri
+        uint16_t touch[RegisterMap::NUM_TOUCH];           // Dokunmatik sensörler (10-bit)
+        uint16_t current;                                 // Akım (10-bit, 512 = 0 A)
+        uint16_t voltage;                                 // Besleme gerilimi (10-bit)
+        uint32_t adcSample_us[RegisterMap::NUM_ADC_CHANNELS];  // Kanalın son örnek zamanı (yaş okurken hesaplanır)
+        uint16_t adcRate[RegisterMap::NUM_ADC_CHANNELS];       // Kanalın örnekleme hızı (Hz)
+        uint8_t adcSampled;                               // Örneği olan kanalların maskesi
+        uint32_t framesCommitted;                         // Uygulanan servo kare sayısı
+        uint32_t framesCoalesced;                         // Ezilen servo kare sayısı
+        uint32_t schedulePending;                         // Zamanı bekleyen servo kareleri
+        uint32_t scheduleApplied;                         // Zamanında uygulanan servo kareleri
+        uint32_t scheduleLate;                            // core1'e uygulama zamanından sonra ulaşan kareler
+        uint32_t scheduleOverflow;                        // Zaman kuyruğu dolu olduğu için atılan kareler
+        uint16_t gaitPattern;                             // Etkin yürüyüş deseni (0 = duruyor)
+        uint16_t gaitPhase;                               // Döngü fazı (65536 = tam döngü)
+        uint32_t gaitCycles;                              // Tamamlanan yürüyüş döngüleri
+        uint32_t gaitUnreachable;                         // Yürürken erişim dışında kalan bacaklar
+        uint32_t gaitUpdateUs;                            // Son yürüyüş adımının süresi (IK dahil)
+        uint32_t angleFrames;                             // Kalibrasyonla çevrilen açı kareleri (ANGLE, POSE, yürüyüş)
+        uint32_t angleClamped;                            // Kalibrasyon aralığı dışında kalıp sınırlanan açılar
+        uint32_t slewReached;                             // Çıkışı hedefine ulaşmış servoların maskesi
+        uint32_t slewLimitedSteps;                        // Sınırlayıcının hedeften geride tuttuğu servo adımları
+        uint32_t currentEstimate;                         // Kısıcının filtrelenmiş akımı (mA)
+        uint32_t currentPeak;                             // Tepe filtrelenmiş akım (mA)
+        uint32_t throttledMs;                             // Kısılmış geçen toplam süre (ms)
+        uint32_t throttleEvents;                          // Tam hızdan kısmaya geçişler
+        uint16_t governorScale;                           // Hareket ölçeği (Q8, 256 = tam hız)
+        uint16_t servosEnabled;                           // Kademeli açılışta etkinleşmiş servolar
+    };
+    
+    /**
+     * @brief Periyodik telemetri aboneliği (core0)
+     */
+    struct Subscription {
+        bool active;          // Yuva kullanımda
+        uint8_t startIdx;     // İlk register
+        uint8_t count;        // Register sayısı
+        uint8_t seq;          // Push sıra numarası (v2 çerçeve sıra no)
+        uint32_t periodUs;    // Push periyodu
+        uint32_t nextUs;      // Sonraki push zamanı
+    };
+    
+    static constexpr uint MAX_SUBSCRIPTIONS = 4;         // Eşzamanlı abonelik sayısı
+    
+    static constexpr size_t COMMAND_QUEUE_DEPTH = 16;    // core0 -> core1
+    using CommandQueue = SpscQueue<ControlCommand, COMMAND_QUEUE_DEPTH>;
+    using ShadowLock = Seqlock<ShadowRegisters>;
+    
+    static constexpr size_t SCHEDULE_DEPTH = 16;         // Zamanı bekleyen servo kareleri (core1)
+    using Schedule = ScheduleQueue<ControlCommand, SCHEDULE_DEPTH>;
+    
+    static constexpr uint SHADOW_PUBLISH_US = 1000;      // Sensör değerleri için gölge yayın periyodu
+    
+    /**
+     * @brief core0 görevleri (numara = tanılama kaydı sırası)
+     */
+    enum Core0Task : uint32_t {
+        TASK_USB = 0,         // tud_task ve bağlantı durumu, her uyanışta
+        TASK_USB_RX,          // CDC verisini ayrıştırıp komutları işler, tud_cdc_rx_cb ile
+        TASK_TX_FLUSH,        // Bekleyen fark karesi ve son tarihi dolan yanıtlar
+        TASK_TELEMETRY,       // Telemetri abonelikleri
+        TASK_GPIO_EDGES,      // Kesmeden gelen GPIO kenarları, her uyanışta
+        TASK_LEDS,            // LED efekt karesi
+        TASK_CAL_BENCH,       // Açı dönüşümü ölçümünün adımı, açılışta ve CAL_STATS yazılınca
+        NUM_CORE0_TASKS
+    };
+    
+    /**
+     * @brief core1 görevleri (tanılama kayıtları core0 görevlerinden sonra)
+     */
+    enum Core1Task : uint32_t {
+        TASK_COMMANDS = 0,    // core0 kuyruğundaki komutlar, kuyruğa ekleyen core0 sinyal verir
+        TASK_CONTROL_TICK,    // Sabit periyotlu kontrol adımı (PWM periyodu)
+        TASK_ADC_SCAN,        // Sensör tarama adımı ve akım örneği
+        TASK_SERVO_ENABLE,    // Açılışta kademeli servo etkinleştirme
+        TASK_PUBLISH,         // Sensörler için periyodik gölge yayını
+        NUM_CORE1_TASKS
+    };
+    
+    static constexpr uint32_t TELEMETRY_TASK_US = 1000;  // Abonelik kontrolü (en kısa abonelik periyodu)
+    static constexpr uint32_t TX_FLUSH_TASK_US = 250;    // Yanıt yazıcısının son tarih kontrolü
+    static constexpr uint32_t ENABLE_TASK_US = 1000;     // Kademeli açılış adımının çözünürlüğü
+    
+    // Tanılama sayfaları (DIAG komutu); DIAG register'ına yazılan maskenin biti sayfa numarasıdır
+    static constexpr uint DIAG_PAGE_TASKS = 0;           // [görev sayısı, kayıt boyu, core0 ‰, core1 ‰], ardından görev kayıtları
+    static constexpr uint DIAG_TASK_HEADER = 4;
+    static constexpr uint DIAG_TASK_FIELDS = 9;          // Periyot, bütçe (10 μs), öncelik (+ olay << 7), WCET, ortalama, gecikme, ‰, kaçırma, aşım
+    static constexpr uint DIAG_TASK_CONFIG_UNIT_US = 10; // Periyot ve bütçe alanlarının birimi (PWM periyodu register'ıyla aynı)
+    static constexpr uint DIAG_TASK_EVENT = 1u << 7;     // Öncelik alanında olay güdümlü görev biti
+    static constexpr uint DIAG_PAGE_LATENCY = 1;         // Gecikme histogramları, ölçüm noktası başına bir sayfa
+    static constexpr uint DIAG_LATENCY_FIELDS = 5 + 2 * LatencyHistogram::NUM_BUCKETS;  // Sayı (2 x 14-bit), min, ort, max, kovalar (2 x 14-bit)
+    
+    /**
+     * @brief Gecikme ölçümleri (tanılama sayfası DIAG_PAGE_LATENCY + numara)
+     */
+    enum LatencyProbe : uint32_t {
+        LATENCY_RX_PARSE = 0, // tud_cdc_rx_cb -> paket ayrıştırıldı
+        LATENCY_DISPATCH,     // Paket ayrıştırıldı -> işleyici bitti (tüm komutlar)
+        LATENCY_GET,          // Paket ayrıştırıldı -> GET işleyicisi bitti (yanıt kodlaması dahil)
+        LATENCY_RX_COMMIT,    // tud_cdc_rx_cb -> servo karesi PWM'e yüklendi (core1)
+        LATENCY_RX_FLUSH,     // tud_cdc_rx_cb -> yanıt TinyUSB'ye aktarıldı
+        NUM_LATENCY_PROBES
+    };
+    
     // Alt sistemler
     std::unique_ptr<ServoDriver> _servoDriver;       // Servo kontrolü
     std::unique_ptr<SensorManager> _sensorManager;   // Sensör yönetimi
     std::unique_ptr<LedManager> _ledManager;         // LED yönetimi
     std::unique_ptr<GPIOManager> _gpioManager;       // GPIO yönetimi
     std::unique_ptr<CommProtocol> _commProtocol;     // İletişim protokolü
+    std::unique_ptr<TrajectoryPlanner> _trajectory;  // Servo yörünge motoru (core1)
+    std::unique_ptr<HexapodIK> _ik;                  // Ters kinematik (core0, POSE komutları)
+    std::unique_ptr<GaitGenerator> _gait;            // Yürüyüş üreteci (core1)
+    std::unique_ptr<ServoCalibration> _calibration;  // Açı -> darbe kalibrasyonu (core1)
+    std::unique_ptr<ServoCalibration> _calibrationView;  // Kalibrasyonun core0 kopyası (sorgu ve ölçüm)
+    std::unique_ptr<SlewLimiter> _slew;              // Hız/ivme sınırlayıcı (core1)
+    std::unique_ptr<CurrentGovernor> _governor;      // Akım bütçesi kısıcısı (core1)
+    std::unique_ptr<TaskScheduler> _core0Tasks;      // USB, protokol, telemetri, LED ve GPIO görevleri
+    std::unique_ptr<TaskScheduler> _core1Tasks;      // Kontrol adımı, komut ve sensör görevleri
+    
+    // Çekirdekler arası paylaşılan yapılar (core0 yığını küçük olduğu için heap'te)
+    std::unique_ptr<CommandQueue> _commandQueue;
+    std::unique_ptr<ShadowLock> _shadow;   // core1 yazar, core0 okur
     
-    // USB CDC veri tamponu
-    static const uint CDC_RX_BUFFER_SIZE = 256;
+    /**
+     * @brief Zamanlanmış servo kareleri (core1)
+     * 
+     * SCHEDULE komutları uygulama zamanına göre sıralanır ve zamanı gelen her
+     * kare kontrol adımının karesine, yörünge çıktısının üzerine yazılır.
+     * Böylece bir kare, USB'nin komutu ne zaman teslim ettiğinden bağımsız
+     * olarak uygulama zamanını izleyen ilk kontrol adımında PWM'e yüklenir.
+     */
+    struct ScheduleState {
+        uint32_t applied;             // Uygulanan kareler
+        uint32_t late;                // Uygulama zamanı geçmiş olarak gelen kareler (bir sonraki adımda uygulanır)
+        uint32_t overflow;            // Kuyruk dolu olduğu için atılan kareler
+    };
+    
+    std::unique_ptr<Schedule> _schedule;   // Zaman sıralı bekleyen kareler (core1)
+    ScheduleState _scheduleStats;          // Zamanlama sayaçları (core1, gölge register'larla yayınlanır)
+    uint32_t _rxTimestamp_us;              // Son USB okumasının zamanı, TIME_SYNC alım zamanı (core0)
+    
+    uint32_t _commandsDropped;        // Kuyruk dolu olduğu için atılan komutlar (core0)
+    
+    Subscription _subscriptions[MAX_SUBSCRIPTIONS];   // Telemetri abonelikleri (core0)
+    uint32_t _subscriptionFramesSent;                 // Gönderim tamponuna eklenen push çerçeveleri
+    uint32_t _subscriptionFramesDropped;              // Gönderim tamponu dolu olduğu için atılan push çerçeveleri
+    
+    // USB CDC veri tamponu: TinyUSB FIFO'su ile aynı boyutta, tek okuma FIFO'yu boşaltır
+    static const uint CDC_RX_BUFFER_SIZE = CFG_TUD_CDC_RX_BUFSIZE;
     uint8_t _cdcRxBuffer[CDC_RX_BUFFER_SIZE];
     
+    // Döngü başına işlenecek en fazla byte; aşılırsa kalan veri bir sonraki
+    // turda işlenir ve tud_task/telemetri aç kalmaz
+    static const uint CDC_RX_BUDGET = 2 * CDC_RX_BUFFER_SIZE;
+    
+    /**
+     * @brief USB alım yolu sayaçları
+     */
+    struct RxStats {
+        uint32_t fifoHighWater;       // TinyUSB RX FIFO'sunda görülen en fazla byte
+        uint32_t maxBytesPerLoop;     // Bir döngüde işlenen en fazla byte
+        uint32_t budgetExhausted;     // Bütçe dolduğu için FIFO'da veri bırakılan döngüler
+    };
+    
+    RxStats _rxStats;                 // Alım yolu sayaçları (core0)
+    
+    /**
+     * @brief Servo fark karesi durumu (core0)
+     * 
+     * Fark kareleri sadece bir anahtar kareden sonra, arada kayıp olmadıkça
+     * kabul edilir; bozuk v2 çerçevesi veya bağlantı kopması zinciri bozar ve
+     * host yeni bir anahtar kare gönderene kadar farklar reddedilir. Komut
+     * kuyruğu doluysa fark ve SET kareleri atılmaz, core0'da tek bir bekleyen
+     * karede toplanır (farklar toplanabilir, SET'te son değer geçerli olduğu
+     * için sonuç aynıdır).
+     */
+    struct DeltaState {
+        bool synced;                  // Fark zinciri geçerli
+        bool pending;                 // pendingCmd kuyruğa eklenmeyi bekliyor
+        ControlCommand pendingCmd;    // Kuyruk dolduğunda biriken servo karesi
+        uint32_t errorMark;           // Son anahtar/fark karesindeki v2 hata sayısı
+        uint32_t keyFrames;           // Kabul edilen anahtar kareler
+        uint32_t deltaFrames;         // Uygulanan fark kareleri
+        uint32_t rejected;            // Zincir bozuk olduğu için reddedilen fark kareleri
+        uint32_t merged;              // Kuyruk dolu olduğu için bekleyen kareyle birleştirilen fark ve SET kareleri
+    };
+    
+    DeltaState _delta;                // Fark karesi durumu (core0)
+    
+    /**
+     * @brief Ters kinematik sayaçları (core0)
+     */
+    struct IkStats {
+        uint32_t solves;              // Çözülen POSE komutları
+        uint32_t unreachable;         // Hedefi erişim dışında kalan bacaklar
+        uint32_t lastUs;              // Son çözüm süresi (6 bacak)
+        uint32_t maxUs;               // En uzun çözüm süresi
+    };
+    
+    IkStats _ikStats;                 // Ters kinematik sayaçları (core0)
+    uint32_t _gaitUpdateUs;           // Son yürüyüş adımının süresi (core1)
+    
+    /**
+     * @brief Açı çevirme sayaçları (core1, gölge register'larla yayınlanır)
+     */
+    struct AngleStats {
+        uint32_t frames;              // Kalibrasyonla çevrilen açı kareleri
+        uint32_t clamped;             // Sınırlanan açılar
+    };
+    
+    AngleStats _angleStats;           // Açı çevirme sayaçları (core1)
+    
+    static constexpr uint CAL_BENCH_BATCHES = 100;   // Ölçümde tekrarlanan 18 servoluk toplu dönüşüm sayısı
+    static constexpr uint CAL_BENCH_CHUNK = 10;      // Görevin bir çalışmasındaki toplu dönüşüm sayısı
+    static_assert(CAL_BENCH_BATCHES % CAL_BENCH_CHUNK == 0, "Ölçüm tam adımlara bölünmeli");
+    
+    /**
+     * @brief Toplu dönüşüm ölçümü (core0)
+     */
+    struct CalibrationBench {
+        uint32_t fixedUs;             // CAL_BENCH_BATCHES sabit noktalı toplu dönüşümün süresi, ölçüm sürerken 0
+        uint32_t floatUs;             // CAL_BENCH_BATCHES ServoDriver::angleToPulseWidth toplu dönüşümünün süresi, ölçüm sürerken 0
+        uint32_t step;                // Yapılan toplu dönüşümler; önce sabit noktalı, sonra float yol
+        uint32_t fixedSumUs;          // Süren ölçümde sabit noktalı adımların toplamı
+        uint32_t floatSumUs;          // Süren ölçümde float adımların toplamı
+    };
+    
+    CalibrationBench _calBench;       // Son ölçüm ve süren ölçümün durumu (core0)
+    
+    static constexpr uint32_t SLEW_ACCEL_UNIT = 10;  // İvme register'ının birimi (μs/s²)
+    
+    /**
+     * @brief Servonun sınırlayıcı ayarı (core0 kopyası, register okuması için)
+     */
+    struct SlewConfig {
+        uint16_t velocity;            // En yüksek hız (μs/s), 0 = sınırsız
+        uint16_t accel;               // En yüksek ivme (SLEW_ACCEL_UNIT), 0 = sınırsız
+    };
+    
+    uint32_t _slewSelect;                             // Ayar register'larının uygulandığı servolar (core0)
+    SlewConfig _slewConfig[SlewLimiter::NUM_SERVOS];  // Servo başına sınırlayıcı ayarı (core0)
+    uint32_t _lastTick_us;                            // Önceki kontrol adımının zamanı (core1)
+    uint64_t _submittedRx_us;                         // Commit bekleyen host karesinin alım zamanı, 0 = yok (core1)
+    
+    uint32_t _currentBudget;          // Akım bütçesi, register okuması için (core0, mA)
+    uint32_t _currentSampleCount;     // Kısıcıya işlenen son akım örneği (core1)
+    uint _controlTickUs;              // Kontrol adımı periyodu, PWM periyoduna eşit (init'te sabitlenir)
+    
+    static constexpr uint16_t LED_METER_UNIT = 8;  // Gösterge aralığı register'ının birimi (10-bit sensör değeri)
+    uint8_t _ledSelect;               // LED_EFFECT register'larının uygulandığı LED'ler (core0)
+    bool _linkUp;                     // CDC bağlantısının son görülen durumu (core0)
+    uint32_t _bootReady_us;           // init() bitişi, açılıştan itibaren (μs)
+    uint32_t _firstCommand_us;        // İlk kabul edilen komutun alım zamanı, açılıştan itibaren (μs), 0 = henüz yok
+    
+    static constexpr uint GPIO_MODE_BITS = 4;             // GPIO_BANK mod register'ında pin başına bit
+    static constexpr uint16_t GPIO_EDGE_PUSH = 1u << 12;  // GPIO_BANK mod register'ı: kenarlar beklemeden gönderilir
+    bool _gpioEdgePush;               // Kenarlar gelir gelmez 'E' çerçevesiyle gönderilir (core0)
+    uint8_t _gpioEdgeSeq;             // Kenar push sıra numarası
+    
+    LatencyHistogram _latency[NUM_LATENCY_PROBES];  // RX_COMMIT'i core1, diğerlerini core0 yazar
+    uint64_t _rxCallback_us;          // İşlenmemiş verinin ilk tud_cdc_rx_cb zamanı (core0)
+    uint64_t _packetRx_us;            // İşlenen paketin alım zamanı, paket dışında 0 (core0)
+    
     // Veri tamponu durumu
     bool _hasNewData;
     
+    
     // Komut sabitleri
-    static constexpr uint SERVO_IDX_MAX = 18;       // Servo indeksi üst sınırı
     static constexpr uint TOUCH_SENSOR_IDX_MAX = 6; // Dokunmatik sensör indeksi üst sınırı
     static constexpr uint GETC_TIMEOUT_US = 100;    // getchar_timeout_us için zaman aşımı
     
-    // Komut indeks sabitleri
-    static constexpr uint A0_IDX = 19;              // A0 komutu indeksi
-    static constexpr uint A1_IDX = 20;              // A1 komutu indeksi
-    static constexpr uint A2_IDX = 21;              // A2 komutu indeksi
-    static constexpr uint TOUCH_START_IDX = 22;     // Dokunmatik sensör başlangıç indeksi
-    static constexpr uint TOUCH_END_IDX = 27;       // Dokunmatik sensör bitiş indeksi
-    static constexpr uint CURRENT_IDX = 28;         // Akım ölçüm indeksi
-    static constexpr uint VOLTAGE_IDX = 29;         // Voltaj ölçüm indeksi
-    static constexpr uint LED_IDX_BASE = 32;        // LED komutları başlangıç indeksi
-    static constexpr uint LED_IDX_MAX = 37;         // LED komutları bitiş indeksi (dahil)
-    static constexpr uint NUM_LEDS = 6;             // LED sayısı
+    static constexpr uint16_t VALUE_MAX = 0x3FFF;   // 14-bit değer üst sınırı
+    static constexpr int32_t ANGLE_LIMIT = 18000;   // Açı komutlarının sınırı (0.01°)
     
     /**
-     * @brief USB CDC veri alımını ve komut çözümlemesini işler
+     * @brief DIAG komutunu işler: istenen sayfa aralığını tek yanıtla gönderir
+     * 
+     * @param packet Komut paketi (slot: sayfa, startIdx: ilk değer, count: sayı)
      */
-    void _parseAndProcessCommands();
+    void _processDiagCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Tanılama sayfasındaki bir değeri okur (core0)
+     * 
+     * Görev sayfasında core0 görevleri önce, core1 görevleri sonra gelir;
+     * core1 istatistikleri 32-bit alanlar olarak okunur. Gecikme
+     * sayfalarında 32-bit sayaçlar düşük ve yüksek 14 bit olarak iki değere
+     * bölünür. Sayfa dışı indeksler 0 döndürür.
+     * 
+     * @param page Sayfa numarası
+     * @param index Sayfadaki değer indeksi
+     * @return uint16_t Değer (16-bit'te doyar)
+     */
+    uint16_t _readDiagnostic(uint page, uint index) const;
     
     /**
      * @brief TinyUSB CDC verilerini işler (non-blocking)
+     * 
+     * FIFO boşalana veya CDC_RX_BUDGET byte işlenene kadar okur; her okuma
+     * tamponda yerinde ayrıştırılır.
      */
     void _processCdcData();
     
+    /**
+     * @brief Ayrıştırılan bir komut paketini türüne göre işler
+     * 
+     * @param packet Komut paketi
+     */
+    void _dispatchPacket(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Paketi işler ve alım, ayrıştırma ve işleyici gecikmelerini kaydeder
+     * 
+     * İşleyicinin core1'e gönderdiği komutlar ve yazdığı yanıtlar paketin
+     * alım zamanını taşır.
+     * 
+     * @param packet Ayrıştırılan komut paketi
+     */
+    void _dispatchMeasured(const CommProtocol::CommandPacket& packet);
+    
     /**
      * @brief Alınan SET komutunu işler
      * 
@@ -98,7 +437,403 @@ private:
     void _processGetCommand(const CommProtocol::CommandPacket& packet);
     
     /**
-     * @brief VCP bağlantı kurulana kadar bekler
+     * @brief Alınan READ_LIST komutunu işler (listedeki register'lar tek yanıtla)
+     * 
+     * @param packet Komut paketi
+     */
+    void _processReadListCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Alınan WRITE_LIST komutunu işler (listedeki servolar tek karede uygulanır)
+     * 
+     * @param packet Komut paketi
+     */
+    void _processWriteListCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Alınan DELTA komutunu işler (anahtar kare veya fark karesi)
+     * 
+     * @param packet Komut paketi
+     */
+    void _processDeltaCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Bekleyen servo karesini kuyruğa eklemeyi dener (core0)
+     * 
+     * @return true Bekleyen kare yok veya kuyruğa eklendi
+     */
+    bool _flushPendingFrame();
+    
+    /**
+     * @brief Kuyruğa sığmayan servo karesini bekleyen kareyle birleştirir (core0)
+     * 
+     * Mutlak değerler bekleyen değerin yerine geçer, farklar bekleyen değere eklenir.
+     * 
+     * @param cmd DELTA_SERVOS biçiminde kare (SET için absoluteMask = mask)
+     */
+    void _mergePendingFrame(const ControlCommand& cmd);
+    
+    /**
+     * @brief Bozuk v2 çerçevesi ve sıra atlaması sayısını döndürür (fark zinciri kaybını algılamak için)
+     */
+    uint32_t _frameErrorCount() const;
+    
+    /**
+     * @brief Alınan TIME_SYNC komutunu işler (alım ve gönderim zamanını hemen yanıtlar)
+     * 
+     * @param packet Komut paketi
+     */
+    void _processTimeSyncCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Alınan SCHEDULE komutunu işler (servo hedeflerini core1 zaman kuyruğuna gönderir)
+     * 
+     * Sadece servo register'ları zamanlanır; aralıktaki diğer register'lar yok sayılır.
+     * 
+     * @param packet Komut paketi
+     */
+    void _processScheduleCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Alınan POSE komutunu işler
+     * 
+     * Eklem açıları HexapodIK ile hesaplanır ve 18 servo tek SET karesi olarak
+     * core1'e gönderilir.
+     * 
+     * @param packet Komut paketi
+     */
+    void _processPoseCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Alınan GAIT komutunu işler (yürüyüş üretecinin komutunu core1'e gönderir)
+     * 
+     * @param packet Komut paketi
+     */
+    void _processGaitCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Alınan ANGLE komutunu işler (açılar core1'de kalibrasyonla darbeye çevrilir)
+     * 
+     * @param packet Komut paketi
+     */
+    void _processAngleCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Alınan CALIBRATE komutunu işler
+     * 
+     * Geçerli kayıt core1'e gönderilir ve servonun darbe sınırları da
+     * değişir; her durumda servonun geçerli kaydı yanıtlanır, host kaydın
+     * kabul edilip edilmediğini yanıttan görür.
+     * 
+     * @param packet Komut paketi
+     */
+    void _processCalibrateCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Alınan LED_FRAME komutunu işler (6 LED'in 24-bit rengi)
+     * 
+     * Renkler LED'lerin sabit renk ve nabız rengi olur; gökkuşağı ve gösterge
+     * efektindeki LED'ler efekt değişene kadar çizmeye devam eder.
+     * 
+     * @param packet Komut paketi
+     */
+    void _processLedFrameCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Açı dönüşümü ölçümünü baştan başlatır (core0)
+     * 
+     * Açılıştan sonra ve CAL_STATS aralığına yazıldığında çağrılır; ölçüm
+     * en düşük öncelikli TASK_CAL_BENCH görevinde adım adım ilerler, sonuç
+     * bitince CAL_STATS register'larından okunur.
+     */
+    void _startCalibrationBenchmark();
+    
+    /**
+     * @brief Sabit noktalı ve float toplu açı dönüşümü ölçümünün bir adımı (core0)
+     * 
+     * CAL_BENCH_CHUNK toplu dönüşüm yapar ve ölçüm bitene kadar görevi
+     * yeniden sinyaller; aradaki USB ve komut görevleri beklemez.
+     */
+    void _benchmarkCalibration();
+    
+    /**
+     * @brief Alınan SNAPSHOT komutunu işler (tüm register'lar ve zaman damgası)
+     * 
+     * @param packet Komut paketi
+     */
+    void _processSnapshotCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Register değerlerini okur (GET, SNAPSHOT ve telemetri push'ları için)
+     * 
+     * Servo ve sensör değerleri gölge register kopyasından, core0'a ait
+     * değerler (GPIO, protokol sayaçları) doğrudan okunur; ADC beklenmez.
+     * Register türü RegisterMap tablosundan bulunur ve ardışık register'lar
+     * aralık başına bir kez işlenir.
+     * 
+     * @param shadow Gölge register kopyası
+     * @param startIdx İlk register
+     * @param count Register sayısı
+     * @param values Değerlerin yazılacağı dizi
+     */
+    void _readRegisters(const ShadowRegisters& shadow, uint startIdx, uint count, uint16_t* values);
+    
+    /**
+     * @brief Ardışık olmayan register listesini okur (READ_LIST için)
+     * 
+     * @param shadow Gölge register kopyası
+     * @param indices Register indeksleri
+     * @param count İndeks sayısı
+     * @param values Değerlerin indeks sırasıyla yazılacağı dizi
+     */
+    void _readRegisterList(const ShadowRegisters& shadow, const uint8_t* indices, uint count, uint16_t* values);
+    
+    /**
+     * @brief Aynı aralıktaki ardışık register'ları okur
+     * 
+     * @param shadow Gölge register kopyası
+     * @param reg İlk register'ın tablo girişi
+     * @param run Register sayısı (en fazla reg.remaining)
+     * @param out Değerlerin yazılacağı dizi
+     */
+    void _readRun(const ShadowRegisters& shadow, const RegisterMap::Entry& reg, uint run, uint16_t* out);
+    
+    /**
+     * @brief Register değerlerini yazar (SET komutu için)
+     * 
+     * Servo aralığı tek bir core1 komutu olarak gönderilir; okunabilir fakat
+     * yazılamaz register'lar yok sayılır.
+     * 
+     * @param startIdx İlk register
+     * @param count Register sayısı (en fazla CommProtocol::MAX_VALUES)
+     * @param values Yazılacak değerler
+     */
+    void _writeRegisters(uint startIdx, uint count, const uint16_t* values);
+    
+    /**
+     * @brief Ardışık olmayan register listesine yazar (WRITE_LIST için)
+     * 
+     * @param indices Register indeksleri
+     * @param count İndeks sayısı
+     * @param values Yazılacak değerler
+     */
+    void _writeRegisterList(const uint8_t* indices, uint count, const uint16_t* values);
+    
+    /**
+     * @brief Aynı aralıktaki ardışık register'lara yazar
+     * 
+     * Servo hedefleri hemen gönderilmez, çağıranın tek core1 komutunda toplanır.
+     * 
+     * @param reg İlk register'ın tablo girişi
+     * @param run Register sayısı (en fazla reg.remaining)
+     * @param in Yazılacak değerler
+     * @param servoCmd Servo hedeflerinin toplandığı komut
+     */
+    void _writeRun(const RegisterMap::Entry& reg, uint run, const uint16_t* in, ControlCommand& servoCmd);
+    
+    /**
+     * @brief Alınan SUBSCRIBE komutunu işler (yuvayı kurar veya periyot 0 ise iptal eder)
+     * 
+     * @param packet Komut paketi
+     */
+    void _processSubscribeCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief Zamanı gelen abonelikler için telemetri çerçevesi gönderir (core0)
+     */
+    void _serviceSubscriptions();
+    
+    /**
+     * @brief Zamanı gelen LED karesini çizer (core0)
+     * 
+     * Gösterge LED'lerinin kaynak register'ları sadece kare zamanında,
+     * tek bir gölge okumasıyla alınır; döngünün diğer turlarında maliyet
+     * tek bir zaman karşılaştırmasıdır.
+     */
+    void _serviceLeds();
+    
+    /**
+     * @brief Push açıksa bekleyen GPIO kenarlarını gönderir (core0)
+     * 
+     * Kenarlar kesmede zaman damgalandığı için gönderim gecikmesi zaman
+     * bilgisini etkilemez; bir turda en fazla GPIO_EDGES_MAX kenar gider.
+     */
+    void _serviceGpioEdges();
+    
+    /**
+     * @brief GPIO kenar halkasından en fazla maxEdges kenarı alıp gönderir
+     * 
+     * GPIO_EDGES isteğinin yanıtı ve push için ortaktır; halka boşsa da
+     * gönderilir (count = 0), host kayıp sayacını her yanıtta görür.
+     * 
+     * @param maxEdges En fazla kenar, 0 = GPIO_EDGES_MAX
+     * @param seq İsteğin sıra numarası veya push sayacı (v2)
+     * @return true Gönderim tamponuna eklendi
+     */
+    bool _sendGpioEdges(uint8_t maxEdges, uint8_t seq);
+    
+    /**
+     * @brief Alınan KEYFRAME komutunu işler (hedefleri yörünge kuyruğuna ekler)
+     * 
+     * @param packet Komut paketi
+     */
+    void _processKeyframeCommand(const CommProtocol::CommandPacket& packet);
+    
+    /**
+     * @brief core1 giriş noktası
+     */
+    static void _core1Entry();
+    
+    /**
+     * @brief core1 kontrol döngüsü: komutlar, sensör taraması ve kontrol adımı
+     * 
+     * Görevler _core1Tasks ile sırayla çalışır; hazır görev yoksa çekirdek
+     * sonraki sürüme veya core0'ın komut sinyaline kadar uyur.
+     */
+    void _core1Main();
+    
+    /**
+     * @brief İki çekirdeğin görevlerini kaydeder (init'te, core1 başlamadan önce)
+     */
+    void _registerTasks();
+    
+    /**
+     * @brief core1 kuyruğundaki komutları uygular, değişiklik varsa gölgeyi yayınlar (core1)
+     */
+    void _runCommands();
+    
+    /**
+     * @brief Kontrol adımını çalıştırır ve gölgeyi yayınlar (core1)
+     */
+    void _runControlTick();
+    
+    /**
+     * @brief USB yığınını çalıştırır, bağlantı değiştiyse alım görevine haber verir (core0)
+     */
+    void _runUsb();
+    
+    /**
+     * @brief CDC verisini işler; FIFO'da veri kaldıysa kendini yeniden hazırlar (core0)
+     */
+    void _runUsbRx();
+    
+    /**
+     * @brief Komutu core1 kuyruğuna ekler ve core1'in komut görevine sinyal verir (core0)
+     * 
+     * @param cmd Kontrol komutu
+     * @return true Kuyruğa eklendi
+     * @return false Kuyruk dolu
+     */
+    bool _pushCommand(const ControlCommand& cmd);
+    
+    /**
+     * @brief core1'de bir kontrol komutunu uygular
+     * 
+     * @param cmd Kontrol komutu
+     */
+    void _applyControlCommand(const ControlCommand& cmd);
+    
+    /**
+     * @brief Servo hedefini hazırlar (core1)
+     * 
+     * Hedef servonun darbe sınırlarına çekilir. Sınırsız servoda doğrudan
+     * servo karesine yazılır; hız sınırlı servoda sınırlayıcının hedefi olur
+     * ve çıkış kontrol adımlarında hedefe yaklaşır.
+     * 
+     * @param servo Servo indeksi
+     * @param pulse Darbe genişliği (μs)
+     * @return true Hedef kabul edildi
+     */
+    bool _stageTarget(uint servo, uint pulse);
+    
+    /**
+     * @brief Servo hedefini farkla hazırlar (core1)
+     * 
+     * Fark sınırsız servoda son commit edilen darbeye, hız sınırlı servoda
+     * sınırlayıcının hedefine eklenir; host'un modeli çıkışın gecikmesinden
+     * etkilenmez.
+     * 
+     * @param servo Servo indeksi
+     * @param delta Darbe genişliği farkı (μs)
+     * @return true Hedef kabul edildi
+     */
+    bool _stageTargetDelta(uint servo, int delta);
+    
+    /**
+     * @brief Komutun servo karesini sonraki kontrol adımının commit'ine bırakır (core1)
+     * 
+     * Alım zamanı varsa, kare commit edildiğinde gecikme olarak kaydedilir.
+     * 
+     * @param cmd Kareyi oluşturan komut
+     */
+    void _submitFrame(const ControlCommand& cmd);
+    
+    /**
+     * @brief Kontrol adımının sonraki sürüm zamanını hesaplar (core1)
+     * 
+     * Adım PWM wrap'inden yarım periyot (bütçesi) önce başlar; bütçe içinde
+     * biten adımın commit'i her periyotta aynı wrap'e yetişir.
+     * 
+     * @param now_us Şu anki zaman (μs)
+     * @return uint32_t Sonraki sürüm zamanı (μs)
+     */
+    uint32_t _nextTickRelease(uint32_t now_us) const;
+    
+    /**
+     * @brief Sabit periyotlu kontrol adımı: yörüngeleri ve yürüyüşü ilerletip
+     * zamanı gelen zamanlanmış karelerle birlikte servolara yazar (core1)
+     * 
+     * Yürüyüş üreteci çalışırken 18 servonun hepsini her adımda yazar;
+     * yörüngeler ve doğrudan SET'ler bir sonraki adımda ezilir, zamanlanmış
+     * kareler ise yürüyüşün üzerine uygulanır. Hız sınırlı servoların
+     * çıkışı en son, sınırlayıcıyla hedeflerine yaklaştırılır; akım
+     * kısıcısının ölçeği bu adımın sınırlarını ve sıçramalarını belirler.
+     * 
+     * @param now_us Şu anki zaman (μs)
+     */
+    void _controlTick(uint32_t now_us);
+    
+    /**
+     * @brief Yeni akım örneği varsa akım kısıcısına işler (core1, tarama adımından sonra)
+     */
+    void _sampleCurrent();
+    
+    /**
+     * @brief Servo ve sensör durumunu gölge register'lara yayınlar (core1)
+     * 
+     * @param now_us Şu anki zaman (μs)
+     */
+    void _publishShadow(uint32_t now_us);
+    
+    /**
+     * @brief Komutu core1 kuyruğuna ekler (core0)
+     * 
+     * @param cmd Kontrol komutu
+     * @return true Kuyruğa eklendi
+     * @return false Kuyruk dolu, komut atıldı
+     */
+    bool _sendControlCommand(const ControlCommand& cmd);
+    
+    /**
+     * @brief Periyodik bir işin zamanının gelip gelmediğini kontrol eder
+     * 
+     * Zamanı geldiyse bir sonraki son tarihi periyot kadar ilerletir; bir
+     * periyottan fazla geride kalındıysa kaçırılan adımlar telafi edilmez,
+     * son tarih şimdiden yeniden başlatılır.
+     * 
+     * @param now_us Şu anki zaman (μs)
+     * @param deadline_us Son tarih (güncellenir)
+     * @param period_us Periyot (μs)
+     * @return true İş çalıştırılmalı
+     */
+    static bool _isDue(uint32_t now_us, uint32_t& deadline_us, uint32_t period_us);
+    
+    /**
+     * @brief CDC bağlantısının kurulmasını ve kopmasını izler (core0, beklemez)
+     * 
+     * Bağlantı beklenirken LED'ler gökkuşağı, kurulduğunda kısa bir süre yeşil
+     * gösterir. Yeniden bağlantıda init tekrar çalışmaz; protokol durumu
+     * _processCdcData'da sıfırlanır.
      */
-    void _waitForVCPConnection();
+    void _serviceLink();
 }; 
\ No newline at end of file
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief SET/GET register haritası
+ * 
+ * Her register aralığı bir işleyici türüne (Kind) ve erişim bayraklarına
+ * bağlanır. Derleme zamanında 128 girişlik bir tablo üretilir; her indeks
+ * için tür, aralık içindeki alt indeks ve aralığın kalan uzunluğu tek
+ * okumayla bulunur. Böylece komut işleme register başına sabit zamanlıdır
+ * ve ardışık register'lar (ör. 18 servo) tek seferde işlenir.
+ * 
+ * Aynı tablo DISCOVER yanıtı olarak host'a gönderilir; yeni bir register
+ * eklemek için RANGES'e bir satır ve türün işleyicisi yeterlidir. Tür
+ * numaraları host araçları tarafından kullanıldığı için değiştirilmemelidir.
+ */
+class RegisterMap {
+public:
+    static constexpr uint8_t VERSION = 1;           // Harita biçim sürümü (DISCOVER yanıtında)
+    static constexpr size_t NUM_REGISTERS = 128;    // 7-bit indeks alanı
+    
+    /**
+     * @brief Register işleyici türleri (DISCOVER yanıtındaki sabit numaralar)
+     */
+    enum class Kind : uint8_t {
+        NONE = 0,                 // Tanımsız indeks: GET 0 döndürür, SET yok sayılır
+        SERVO = 1,                // Servo darbe genişliği (μs)
+        GPIO = 2,                 // A0-A2 çıkışları
+        TOUCH = 3,                // Dokunmatik sensör gerilimi (10-bit)
+        CURRENT = 4,              // Akım (10-bit, 512 = 0 A)
+        VOLTAGE = 5,              // Besleme gerilimi (10-bit)
+        LED = 6,                  // LED rengi (4-bit RGB)
+        ADC_AGE = 7,              // ADC kanal örnek yaşı (μs)
+        ADC_RATE = 8,             // ADC kanal örnekleme hızı (Hz)
+        CONTROL_STATS = 9,        // Servo kare ve çekirdekler arası kuyruk sayaçları
+        PROTO_STATS = 10,         // v2 çerçeve sayaçları
+        RX_STATS = 11,            // USB alım yolu sayaçları
+        TX_STATS = 12,            // USB gönderim yolu sayaçları
+        TX_DEADLINE = 13,         // Yanıt gönderim son tarihi (μs)
+        SUBSCRIPTION_STATS = 14,  // Telemetri push sayaçları
+        DELTA_STATS = 15,         // Servo fark karesi sayaçları
+        SCHEDULE_STATS = 16,      // Zamanlanmış komut sayaçları
+        IK_STATS = 17,            // Ters kinematik sayaçları
+        GAIT_STATS = 18,          // Yürüyüş üreteci durumu
+        CAL_STATS = 19,           // Kalibrasyonlu açı dönüşümü ölçümü ve sayaçları
+        SLEW_CONFIG = 20,         // Hız/ivme sınırlayıcı ayarı (seçili servolar)
+        SLEW_STATUS = 21,         // Hedefe ulaşan servolar ve sınırlanan adımlar
+        CURRENT_GOVERNOR = 22,    // Akım bütçesi ve kısıcı sayaçları
+        PWM_CONFIG = 23,          // Servo PWM frekansı, kontrol adımı ve açılış durumu
+        LED_EFFECT = 24,          // LED efekt ayarı (seçili LED'ler)
+        BOOT_STATS = 25,          // Açılıştan hazır olmaya ve ilk komuta kadar geçen süre
+        GPIO_BANK = 26,           // A0-A2 tek işlemli maskeli yazma/okuma ve pin modları
+        DIAG = 27                 // Tanılama sayfalarını sıfırlama; DIAG komutuyla okunan sayfaların özeti
+    };
+    
+    // Erişim bayrakları
+    static constexpr uint8_t READ = 0x01;
+    static constexpr uint8_t WRITE = 0x02;
+    
+    /**
+     * @brief Ardışık register aralığı
+     */
+    struct Range {
+        uint8_t base;     // İlk indeks
+        uint8_t length;   // Register sayısı
+        Kind kind;        // İşleyici türü
+        uint8_t access;   // READ / WRITE bayrakları
+    };
+    
+    /**
+     * @brief Bir indeksin tablo girişi
+     */
+    struct Entry {
+        Kind kind;          // İşleyici türü
+        uint8_t sub;        // Aralık içindeki alt indeks (ör. servo numarası)
+        uint8_t remaining;  // Bu indeks dahil aralıkta kalan register sayısı
+        uint8_t access;     // READ / WRITE bayrakları
+    };
+    
+    // Register indeksleri
+    static constexpr uint8_t SERVO_BASE = 0;                // Servo 0-17
+    static constexpr uint8_t NUM_SERVOS = 18;
+    static constexpr uint8_t DIAG_IDX = 18;                 // Okuma: core0 yükü (‰), yazma: sıfırlanacak tanılama sayfaları (bit maskesi)
+    static constexpr uint8_t GPIO_BASE = 19;                // A0 (RELAY), A1, A2
+    static constexpr uint8_t NUM_GPIOS = 3;
+    static constexpr uint8_t TOUCH_BASE = 22;               // TS1-TS6
+    static constexpr uint8_t NUM_TOUCH = 6;
+    static constexpr uint8_t CURRENT_IDX = 28;              // CURR
+    static constexpr uint8_t VOLTAGE_IDX = 29;              // VOLT
+    static constexpr uint8_t BOOT_STATS_BASE = 30;          // Hazır olma zamanı (10 μs), ilk kabul edilen komut zamanı (ms), açılıştan itibaren
+    static constexpr uint8_t NUM_BOOT_STATS = 2;
+    static constexpr uint8_t LED_BASE = 32;                 // LED 0-5
+    static constexpr uint8_t NUM_LEDS = 6;
+    static constexpr uint8_t GPIO_BANK_BASE = 38;           // Seviyeler (+ yazma maskesi << 7), pin modları (pin başına 4 bit, + kenar push << 12)
+    static constexpr uint8_t NUM_GPIO_BANK = 2;
+    static constexpr uint8_t ADC_AGE_BASE = 40;             // Mux adres sırasıyla 8 kanal
+    static constexpr uint8_t ADC_RATE_BASE = 48;            // Mux adres sırasıyla 8 kanal
+    static constexpr uint8_t NUM_ADC_CHANNELS = 8;
+    static constexpr uint8_t CONTROL_STATS_BASE = 56;       // Uygulanan kare, ezilen kare, atılan komut, atılan telemetri
+    static constexpr uint8_t NUM_CONTROL_STATS = 4;
+    static constexpr uint8_t PROTO_STATS_BASE = 60;         // Kabul, CRC, uzunluk, COBS, taşma, sıra atlama, geçersiz içerik
+    static constexpr uint8_t NUM_PROTO_STATS = 7;
+    static constexpr uint8_t RX_STATS_BASE = 67;            // FIFO tepe seviyesi, döngü başına en fazla byte, bütçe aşımı
+    static constexpr uint8_t NUM_RX_STATS = 3;
+    static constexpr uint8_t TX_STATS_BASE = 70;            // Paket, paket başına byte, tam paket/grup sonu/son tarih, atılan yanıt
+    static constexpr uint8_t NUM_TX_STATS = 6;
+    static constexpr uint8_t TX_DEADLINE_IDX = 76;          // Yanıt gönderim son tarihi (μs)
+    static constexpr uint8_t SUBSCRIPTION_STATS_BASE = 77;  // Gönderilen ve atılan push çerçeveleri
+    static constexpr uint8_t NUM_SUBSCRIPTION_STATS = 2;
+    static constexpr uint8_t DELTA_STATS_BASE = 79;         // Anahtar kare, uygulanan fark, reddedilen fark, birleştirilen, eşzamanlı
+    static constexpr uint8_t NUM_DELTA_STATS = 5;
+    static constexpr uint8_t SCHEDULE_STATS_BASE = 84;      // Bekleyen, uygulanan, geç gelen, kuyruk dolu olduğu için atılan
+    static constexpr uint8_t NUM_SCHEDULE_STATS = 4;
+    static constexpr uint8_t IK_STATS_BASE = 88;            // Çözüm, erişilemeyen bacak, son ve en uzun çözüm süresi (μs)
+    static constexpr uint8_t NUM_IK_STATS = 4;
+    static constexpr uint8_t GAIT_STATS_BASE = 92;          // Desen, faz, döngü, erişilemeyen bacak, son adım süresi (μs)
+    static constexpr uint8_t NUM_GAIT_STATS = 5;
+    static constexpr uint8_t CAL_STATS_BASE = 97;           // Sabit noktalı ve float toplu dönüşüm süresi (100 x 18 servo, μs), açı karesi, sınırlanan açı
+    static constexpr uint8_t NUM_CAL_STATS = 4;
+    static constexpr uint8_t SLEW_CONFIG_BASE = 101;        // Seçim maskesi (servo 0-13, 14-17), en yüksek hız (μs/s), en yüksek ivme (10 μs/s²)
+    static constexpr uint8_t NUM_SLEW_CONFIG = 4;
+    static constexpr uint8_t SLEW_STATUS_BASE = 105;        // Hedefe ulaşan servo maskesi (servo 0-13, 14-17), sınırlanan servo adımı
+    static constexpr uint8_t NUM_SLEW_STATUS = 3;
+    static constexpr uint8_t CURRENT_GOVERNOR_BASE = 108;   // Bütçe (mA), filtrelenmiş akım (mA), tepe akım (mA), kısılmış süre (10 ms), kısma olayı, ölçek (Q8)
+    static constexpr uint8_t NUM_CURRENT_GOVERNOR = 6;
+    static constexpr uint8_t PWM_CONFIG_BASE = 114;         // PWM frekansı (Hz), kontrol adımı (10 μs), faz yayma (0/1), etkin servo sayısı
+    static constexpr uint8_t NUM_PWM_CONFIG = 4;
+    static constexpr uint8_t LED_EFFECT_BASE = 118;         // Seçim maskesi, efekt (+ gösterge kaynağı << 7), periyot (ms), gösterge aralığı (2 x 7-bit, 8'lik adım)
+    static constexpr uint8_t NUM_LED_EFFECT = 4;
+    
+    /**
+     * @brief Register aralıkları, artan indeks sırasıyla
+     */
+    static constexpr Range RANGES[] = {
+        {SERVO_BASE, NUM_SERVOS, Kind::SERVO, READ | WRITE},
+        {DIAG_IDX, 1, Kind::DIAG, READ | WRITE},
+        {GPIO_BASE, NUM_GPIOS, Kind::GPIO, READ | WRITE},
+        {TOUCH_BASE, NUM_TOUCH, Kind::TOUCH, READ},
+        {CURRENT_IDX, 1, Kind::CURRENT, READ},
+        {VOLTAGE_IDX, 1, Kind::VOLTAGE, READ},
+        {BOOT_STATS_BASE, NUM_BOOT_STATS, Kind::BOOT_STATS, READ},
+        {LED_BASE, NUM_LEDS, Kind::LED, WRITE},
+        {GPIO_BANK_BASE, NUM_GPIO_BANK, Kind::GPIO_BANK, READ | WRITE},
+        {ADC_AGE_BASE, NUM_ADC_CHANNELS, Kind::ADC_AGE, READ},
+        {ADC_RATE_BASE, NUM_ADC_CHANNELS, Kind::ADC_RATE, READ},
+        {CONTROL_STATS_BASE, NUM_CONTROL_STATS, Kind::CONTROL_STATS, READ},
+        {PROTO_STATS_BASE, NUM_PROTO_STATS, Kind::PROTO_STATS, READ},
+        {RX_STATS_BASE, NUM_RX_STATS, Kind::RX_STATS, READ},
+        {TX_STATS_BASE, NUM_TX_STATS, Kind::TX_STATS, READ},
+        {TX_DEADLINE_IDX, 1, Kind::TX_DEADLINE, READ | WRITE},
+        {SUBSCRIPTION_STATS_BASE, NUM_SUBSCRIPTION_STATS, Kind::SUBSCRIPTION_STATS, READ},
+        {DELTA_STATS_BASE, NUM_DELTA_STATS, Kind::DELTA_STATS, READ},
+        {SCHEDULE_STATS_BASE, NUM_SCHEDULE_STATS, Kind::SCHEDULE_STATS, READ},
+        {IK_STATS_BASE, NUM_IK_STATS, Kind::IK_STATS, READ},
+        {GAIT_STATS_BASE, NUM_GAIT_STATS, Kind::GAIT_STATS, READ},
+        {CAL_STATS_BASE, NUM_CAL_STATS, Kind::CAL_STATS, READ | WRITE},
+        {SLEW_CONFIG_BASE, NUM_SLEW_CONFIG, Kind::SLEW_CONFIG, READ | WRITE},
+        {SLEW_STATUS_BASE, NUM_SLEW_STATUS, Kind::SLEW_STATUS, READ},
+        {CURRENT_GOVERNOR_BASE, NUM_CURRENT_GOVERNOR, Kind::CURRENT_GOVERNOR, READ | WRITE},
+        {PWM_CONFIG_BASE, NUM_PWM_CONFIG, Kind::PWM_CONFIG, READ},
+        {LED_EFFECT_BASE, NUM_LED_EFFECT, Kind::LED_EFFECT, READ | WRITE},
+    };
+    static constexpr size_t NUM_RANGES = sizeof(RANGES) / sizeof(RANGES[0]);
+    
+    // 0'dan son tanımlı register'a kadar indeks sayısı (SNAPSHOT yanıt boyutu)
+    static constexpr uint8_t NUM_MAPPED = RANGES[NUM_RANGES - 1].base + RANGES[NUM_RANGES - 1].length;
+    
+    /**
+     * @brief İndeksin tablo girişini döndürür
+     * 
+     * @param index Register indeksi
+     * @return const Entry& Giriş; tanımsız indekslerde Kind::NONE, remaining = 1
+     */
+    static const Entry& lookup(uint32_t index) {
+        return _table[(index < NUM_REGISTERS) ? index : NUM_REGISTERS - 1];
+    }
+    
+    /**
+     * @brief Aralıkların sıralı, çakışmasız ve 7-bit alanda olduğunu doğrular
+     */
+    static constexpr bool rangesValid();
+
+private:
+    /**
+     * @brief Aralıklardan indeks tablosunu üretir
+     */
+    static constexpr std::array<Entry, NUM_REGISTERS> _buildTable();
+    
+    static const std::array<Entry, NUM_REGISTERS> _table;
+};
+
+constexpr bool RegisterMap::rangesValid() {
+    uint32_t next = 0;
+    for (const Range& range : RANGES) {
+        if (range.base < next || range.length == 0 || range.base + range.length > NUM_REGISTERS - 1) {
+            return false;
+        }
+        next = range.base + range.length;
+    }
+    return true;
+}
+
+constexpr std::array<RegisterMap::Entry, RegisterMap::NUM_REGISTERS> RegisterMap::_buildTable() {
+    std::array<Entry, NUM_REGISTERS> table{};
+    for (Entry& entry : table) {
+        entry = {Kind::NONE, 0, 1, 0};
+    }
+    for (const Range& range : RANGES) {
+        for (uint8_t i = 0; i < range.length; i++) {
+            table[range.base + i] = {range.kind, i, (uint8_t)(range.length - i), range.access};
+        }
+    }
+    return table;
+}
+
+inline constexpr std::array<RegisterMap::Entry, RegisterMap::NUM_REGISTERS> RegisterMap::_table =
+    RegisterMap::_buildTable();
+
+// Son indeks her zaman tanımsız kalır, lookup() aralık dışını oraya yönlendirir
+static_assert(RegisterMap::rangesValid(), "Register aralıkları sıralı, çakışmasız ve 127'nin altında olmalı");
@@ -0,0 +1,124 @@
+#include "response_writer.hpp"
+#include "tusb.h"
+#include <cstring>
+
+ResponseWriter::ResponseWriter() :
+    _head(0),
+    _count(0),
+    _oldestUs(0),
+    _deadlineUs(DEFAULT_DEADLINE_US),
+    _stats(),
+    _flushProbe(nullptr),
+    _origin_us(0),
+    _pendingOrigin_us(0),
+    _lastOrigin_us(0) {
+}
+
+void ResponseWriter::reset() {
+    _head = 0;
+    _count = 0;
+    _pendingOrigin_us = 0;
+}
+
+bool ResponseWriter::write(const uint8_t* data, size_t len) {
+    // Yer yoksa önce tam paketleri göndererek yer açmayı dene
+    if (len > BUFFER_SIZE - _count) {
+        _transmit(true, FlushReason::PACKET_FULL);
+        if (len > BUFFER_SIZE - _count) {
+            _stats.droppedReplies++;
+            return false;
+        }
+    }
+    
+    if (_count == 0) {
+        _oldestUs = time_us_32();
+    }
+    
+    // Halka sonunda iki parça halinde kopyala
+    size_t tail = (_head + _count) % BUFFER_SIZE;
+    size_t first = BUFFER_SIZE - tail;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(&_buffer[tail], data, first);
+    memcpy(&_buffer[0], data + first, len - first);
+    _count += len;
+    
+    if (_origin_us != 0) {
+        if (_pendingOrigin_us == 0) {
+            _pendingOrigin_us = _origin_us;
+        }
+        _lastOrigin_us = _origin_us;
+    }
+    
+    if (_deadlineUs == 0) {
+        _transmit(false, FlushReason::DEADLINE);
+    } else if (_count >= PACKET_SIZE) {
+        _transmit(true, FlushReason::PACKET_FULL);
+    }
+    return true;
+}
+
+void ResponseWriter::endBatch() {
+    if (_count > 0) {
+        _transmit(false, FlushReason::BATCH_END);
+    }
+}
+
+void ResponseWriter::poll() {
+    if (_count == 0) {
+        return;
+    }
+    
+    if (time_us_32() - _oldestUs >= _deadlineUs) {
+        _transmit(false, FlushReason::DEADLINE);
+    } else if (_count >= PACKET_SIZE) {
+        // TinyUSB FIFO'su daha önce doluydu, tam paketleri tekrar dene
+        _transmit(true, FlushReason::PACKET_FULL);
+    }
+}
+
+void ResponseWriter::setDeadline(uint32_t deadline_us) {
+    _deadlineUs = deadline_us;
+}
+
+void ResponseWriter::_transmit(bool fullPacketsOnly, FlushReason reason) {
+    size_t length = fullPacketsOnly ? (_count / PACKET_SIZE) * PACKET_SIZE : _count;
+    size_t space = tud_cdc_write_available();
+    if (length > space) {
+        length = space;
+    }
+    if (length == 0) {
+        return;
+    }
+    
+    // Halka sonundaki ve başındaki parçaları sırayla FIFO'ya yaz
+    size_t first = BUFFER_SIZE - _head;
+    if (first > length) {
+        first = length;
+    }
+    tud_cdc_write(&_buffer[_head], first);
+    if (length > first) {
+        tud_cdc_write(&_buffer[0], length - first);
+    }
+    tud_cdc_write_flush();
+    
+    _head = (_head + length) % BUFFER_SIZE;
+    _count -= length;
+    if (_count > 0) {
+        // Kalan byte'lar için son tarih yeniden başlar
+        _oldestUs = time_us_32();
+    }
+    
+    // En eski yanıtın alımından buraya kadar; kalan byte'lar en yeni yanıttan sayılır
+    if (_pendingOrigin_us != 0) {
+        if (_flushProbe) {
+            _flushProbe->record(time_us_64() - _pendingOrigin_us);
+        }
+        _pendingOrigin_us = (_count > 0) ? _lastOrigin_us : 0;
+    }
+    
+    _stats.packetsSent += (length + PACKET_SIZE - 1) / PACKET_SIZE;
+    _stats.bytesSent += length;
+    _stats.flushes[(size_t)reason]++;
+}
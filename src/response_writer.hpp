@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "pico/stdlib.h"
+#include "tusb_config.h"
+#include "latency_histogram.hpp"
+
+/**
+ * @brief Kodlanmış yanıtları biriktirip USB CDC'ye dolu paketler halinde gönderen yazıcı
+ * 
+ * Yanıtlar bir halka tampona eklenir ve TinyUSB'ye üç durumda aktarılır:
+ *   - tamponda tam bir uç nokta paketi (64 byte) biriktiğinde
+ *   - bir RX grubu işlendikten sonra (endBatch)
+ *   - en eski bekleyen byte son tarihini aştığında (poll)
+ * 
+ * Böylece art arda gelen GET istekleri yanıt başına kısa bir paket yerine
+ * dolu paketlerle cevaplanır. Yanıtlar bölünmeden eklenir; sığmayan yanıt
+ * atılır ve sayılır. Sadece core0'dan kullanılır.
+ * 
+ * Bir isteğin yanıtları yazılırken setOrigin() ile isteğin alım zamanı
+ * verilirse, her gönderimde en eski bekleyen yanıtın alımından TinyUSB'ye
+ * aktarılmasına kadar geçen süre ölçüm histogramına eklenir.
+ */
+class ResponseWriter {
+public:
+    static constexpr size_t BUFFER_SIZE = 1024;                   // Halka tampon boyutu
+    static constexpr size_t PACKET_SIZE = CFG_TUD_CDC_EP_BUFSIZE; // USB tam hız bulk paket boyutu
+    static constexpr uint32_t DEFAULT_DEADLINE_US = 1000;         // Varsayılan gönderim son tarihi (1 USB karesi)
+    
+    /**
+     * @brief Gönderim nedenleri
+     */
+    enum class FlushReason : uint8_t {
+        PACKET_FULL,   // Tam paket birikti
+        BATCH_END,     // RX grubu bitti
+        DEADLINE,      // Son tarih doldu (veya son tarih 0)
+        COUNT
+    };
+    
+    /**
+     * @brief Gönderim sayaçları
+     */
+    struct Stats {
+        uint32_t packetsSent;                              // Gönderilen USB paketleri (tahmini)
+        uint32_t bytesSent;                                // TinyUSB'ye aktarılan byte
+        uint32_t flushes[(size_t)FlushReason::COUNT];      // Nedene göre gönderimler
+        uint32_t droppedReplies;                           // Tampona sığmadığı için atılan yanıtlar
+    };
+    
+    /**
+     * @brief Yapılandırıcı
+     */
+    ResponseWriter();
+    
+    /**
+     * @brief Bekleyen veriyi atar (bağlantı koptuğunda)
+     */
+    void reset();
+    
+    /**
+     * @brief Tam bir yanıtı tampona ekler
+     * 
+     * @param data Kodlanmış yanıt
+     * @param len Yanıt uzunluğu
+     * @return true Yanıt eklendi
+     * @return false Tampon dolu, yanıt atıldı
+     */
+    bool write(const uint8_t* data, size_t len);
+    
+    /**
+     * @brief RX grubu bittiğinde bekleyen tüm veriyi gönderir
+     */
+    void endBatch();
+    
+    /**
+     * @brief Son tarihi dolan veriyi gönderir, ana döngüden sürekli çağrılır
+     */
+    void poll();
+    
+    /**
+     * @brief Gönderim son tarihini ayarlar
+     * 
+     * @param deadline_us Son tarih (μs), 0 ise her yanıt hemen gönderilir
+     */
+    void setDeadline(uint32_t deadline_us);
+    
+    /**
+     * @brief Gönderim son tarihini döndürür (μs)
+     */
+    uint32_t getDeadline() const { return _deadlineUs; }
+    
+    /**
+     * @brief Alım → gönderim süresinin ekleneceği histogramı bağlar
+     * 
+     * @param probe Histogram, nullptr ölçümü kapatır
+     */
+    void setFlushProbe(LatencyHistogram* probe) { _flushProbe = probe; }
+    
+    /**
+     * @brief Bundan sonra yazılan yanıtların isteğinin alım zamanını verir
+     * 
+     * @param origin_us Alım zamanı (time_us_64), 0 = ölçülmeyen yanıtlar (ör. push)
+     */
+    void setOrigin(uint64_t origin_us) { _origin_us = origin_us; }
+    
+    /**
+     * @brief Bekleyen byte sayısını döndürür
+     */
+    size_t pending() const { return _count; }
+    
+    /**
+     * @brief Gönderim sayaçlarını döndürür
+     */
+    const Stats& stats() const { return _stats; }
+    
+private:
+    uint8_t _buffer[BUFFER_SIZE];   // Halka tampon
+    size_t _head;                   // Gönderilecek ilk byte
+    size_t _count;                  // Bekleyen byte sayısı
+    uint32_t _oldestUs;             // En eski bekleyen byte'ın eklenme zamanı
+    uint32_t _deadlineUs;           // Gönderim son tarihi
+    Stats _stats;                   // Sayaçlar
+    LatencyHistogram* _flushProbe;  // Alım → gönderim süresi
+    uint64_t _origin_us;            // Yazılan yanıtların alım zamanı
+    uint64_t _pendingOrigin_us;     // Alım zamanı bilinen en eski bekleyen yanıtın alımı, 0 = yok
+    uint64_t _lastOrigin_us;        // Alım zamanı bilinen en yeni bekleyen yanıtın alımı
+    
+    /**
+     * @brief Bekleyen veriyi TinyUSB FIFO'suna aktarır ve gönderimi başlatır
+     * 
+     * @param fullPacketsOnly Sadece tam paketleri gönder, artığı tamponda bırak
+     * @param reason Gönderim nedeni
+     */
+    void _transmit(bool fullPacketsOnly, FlushReason reason);
+};
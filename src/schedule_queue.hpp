@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Zaman sıralı sabit kapasiteli bekleyen iş kuyruğu
+ * 
+ * Elemanlar uygulama zamanına göre sıralı tutulur; ekleme sıralı yerleştirme,
+ * alma baştan yapılır. Zaman karşılaştırmaları 32-bit μs sayacının taşmasına
+ * dayanıklıdır (zamanlar birbirinden en fazla ~35 dakika uzakta olmalı). Aynı
+ * zamana sahip elemanlar ekleme sırasıyla alınır. Tek bir çekirdek tarafından
+ * kullanılır, kilit içermez.
+ * 
+ * @tparam T Eleman tipi (kopyalanabilir olmalı)
+ * @tparam N Kapasite
+ */
+template <typename T, size_t N>
+class ScheduleQueue {
+public:
+    ScheduleQueue() : _count(0) {}
+    
+    /**
+     * @brief Elemanı zaman sırasına yerleştirir
+     * 
+     * @param time_us Uygulama zamanı (μs)
+     * @param item Eklenecek eleman
+     * @return true Eklendi
+     * @return false Kuyruk dolu
+     */
+    bool push(uint32_t time_us, const T& item) {
+        if (_count >= N) {
+            return false;
+        }
+        
+        // Sondan başlayarak daha geç zamanlı elemanları bir kaydır
+        size_t pos = _count;
+        while (pos > 0 && _before(time_us, _slots[pos - 1].time_us)) {
+            _slots[pos] = _slots[pos - 1];
+            pos--;
+        }
+        _slots[pos].time_us = time_us;
+        _slots[pos].item = item;
+        _count++;
+        return true;
+    }
+    
+    /**
+     * @brief Zamanı gelmiş en erken elemanı alır
+     * 
+     * @param now_us Şu anki zaman (μs)
+     * @param item Alınan eleman
+     * @return true Eleman alındı
+     * @return false Zamanı gelmiş eleman yok
+     */
+    bool popDue(uint32_t now_us, T& item) {
+        if (_count == 0 || _before(now_us, _slots[0].time_us)) {
+            return false;
+        }
+        
+        item = _slots[0].item;
+        _count--;
+        for (size_t i = 0; i < _count; i++) {
+            _slots[i] = _slots[i + 1];
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Kuyruktaki eleman sayısını döndürür
+     */
+    size_t size() const {
+        return _count;
+    }
+    
+    /**
+     * @brief Kuyruk boş mu
+     */
+    bool empty() const {
+        return _count == 0;
+    }
+    
+    /**
+     * @brief Tüm elemanları atar
+     */
+    void clear() {
+        _count = 0;
+    }
+    
+private:
+    /**
+     * @brief Kuyruk yuvası
+     */
+    struct Slot {
+        uint32_t time_us;   // Uygulama zamanı
+        T item;             // Eleman
+    };
+    
+    /**
+     * @brief a zamanı b'den önce mi (taşmaya dayanıklı)
+     */
+    static bool _before(uint32_t a, uint32_t b) {
+        return (int32_t)(a - b) < 0;
+    }
+    
+    Slot _slots[N];     // Zaman sıralı elemanlar
+    size_t _count;      // Eleman sayısı
+};
@@ -1,6 +1,9 @@
 #include "sensor_manager.hpp"
 #include "servo2040.hpp"
 #include "common/pimoroni_common.hpp"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
 
 using namespace servo::servo2040;
 
@@ -9,17 +12,34 @@ namespace {
     constexpr float CURRENT_GAIN = servo::servo2040::CURRENT_GAIN;
     constexpr float VOLTAGE_GAIN = servo::servo2040::VOLTAGE_GAIN;
     constexpr float CURRENT_OFFSET = servo::servo2040::CURRENT_OFFSET;
+    
+    // 12-bit ADC, 3.3V referans
+    constexpr float ADC_REF_VOLTAGE = 3.3f;
+    constexpr float ADC_MAX_COUNT = (float)(1 << 12);
+    
+    // Filtre durumu 4 bit kesirli kısım taşır
+    constexpr uint FILTER_FRAC_BITS = 4;
 }
 
 SensorManager::SensorManager() :
-    _sensor_adc(SHARED_ADC),
-    _voltage_adc(SHARED_ADC, VOLTAGE_GAIN),
-    _current_adc(SHARED_ADC, CURRENT_GAIN, SHUNT_RESISTOR, CURRENT_OFFSET),
     _mux(ADC_ADDR_0, 
          ADC_ADDR_1, 
          ADC_ADDR_2,
          pimoroni::PIN_UNUSED, 
-         SHARED_ADC) {
+         SHARED_ADC),
+    _frontTable(0),
+    _dmaChannel(-1),
+    _scanChannel(0),
+    _scanPhase(ScanPhase::SETTLE) {
+    
+    for (uint t = 0; t < 2; t++) {
+        for (uint i = 0; i < NUM_CHANNELS; i++) {
+            _tables[t][i] = {0, 0, 0, 0};
+        }
+    }
+    for (uint i = 0; i < NUM_CHANNELS; i++) {
+        _filterState[i] = 0;
+    }
 }
 
 void SensorManager::init() {
@@ -27,42 +47,116 @@ void SensorManager::init() {
     for (uint i = 0; i < NUM_SENSORS; i++) {
         _mux.configure_pulls(SENSOR_1_ADDR + i, false, true);
     }
+    
+    // Paylaşılan ADC pinini hazırla
+    adc_init();
+    adc_gpio_init(SHARED_ADC);
+    adc_select_input(SHARED_ADC - ADC0);
+    
+    // FIFO: etkin, her örnekte DREQ, hata biti ve byte kaydırma yok
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(0);  // Serbest çalışmada en yüksek hız (~2 μs/örnek)
+    
+    // ADC FIFO -> bellek DMA kanalı
+    _dmaChannel = dma_claim_unused_channel(true);
+    
+    // İlk kanalı seç, ilk adımda yerleşmiş olacak
+    _scanChannel = 0;
+    _scanPhase = ScanPhase::SETTLE;
+    _mux.select(_scanChannel);
 }
 
-float SensorManager::readVoltage() {
-    _mux.select(VOLTAGE_SENSE_ADDR);
+void SensorManager::scanStep() {
+    if (_dmaChannel < 0) {
+        return;  // init() çağrılmamış
+    }
     
-    // ADC stabilizasyonu için bekleme
-    sleep_us(100);
+    if (_scanPhase == ScanPhase::SETTLE) {
+        // Mux bir adım önce seçildi, sinyal yerleşti
+        _startCapture();
+        _scanPhase = ScanPhase::CAPTURE;
+        return;
+    }
     
-    // Birkaç örnek alıp ortalamasını hesapla
-    const int NUM_SAMPLES = 4;
-    float total = 0.0f;
+    // Yakalama henüz bitmediyse bir sonraki adımda tekrar dene
+    if (dma_channel_is_busy(_dmaChannel)) {
+        return;
+    }
+    
+    _finishCapture();
     
-    for (int i = 0; i < NUM_SAMPLES; i++) {
-        total += _voltage_adc.read_voltage();
-        sleep_us(50);  // Örnekler arası kısa bekleme
+    // Sonraki kanala geç; tam tur tamamlandıysa tabloları değiştir.
+    // Bariyer, diğer çekirdek yeni ön tabloyu görmeden önce içeriğinin yazılmış olmasını sağlar.
+    _scanChannel++;
+    if (_scanChannel >= NUM_CHANNELS) {
+        _scanChannel = 0;
+        __dmb();
+        _frontTable ^= 1;
     }
     
-    return total / NUM_SAMPLES;
+    _mux.select(_scanChannel);
+    _scanPhase = ScanPhase::SETTLE;
 }
 
-float SensorManager::readCurrent() {
-    _mux.select(CURRENT_SENSE_ADDR);
+void SensorManager::_startCapture() {
+    adc_run(false);
+    adc_fifo_drain();
     
-    // ADC stabilizasyonu için bekleme
-    sleep_us(100);
+    dma_channel_config cfg = dma_channel_get_default_config(_dmaChannel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
     
-    // Birkaç örnek alıp ortalamasını hesapla
-    const int NUM_SAMPLES = 4;
-    float total = 0.0f;
+    dma_channel_configure(_dmaChannel, &cfg, _dmaBuffer, &adc_hw->fifo, SAMPLES_PER_CHANNEL, true);
+    adc_run(true);
+}
+
+void SensorManager::_finishCapture() {
+    adc_run(false);
+    adc_fifo_drain();
     
-    for (int i = 0; i < NUM_SAMPLES; i++) {
-        total += _current_adc.read_current();
-        sleep_us(50);  // Örnekler arası kısa bekleme
+    // Örneklerin ortalaması (Q4)
+    uint32_t total = 0;
+    for (uint i = 0; i < SAMPLES_PER_CHANNEL; i++) {
+        total += _dmaBuffer[i] & 0x0FFF;
     }
+    uint32_t average = (total << FILTER_FRAC_BITS) / SAMPLES_PER_CHANNEL;
+    
+    // Üstel hareketli ortalama; ilk örnek filtreyi doğrudan başlatır
+    uint ch = _scanChannel;
+    ChannelSample& front = _tables[_frontTable][ch];
+    ChannelSample& back = _tables[_frontTable ^ 1][ch];
     
-    return total / NUM_SAMPLES;
+    if (front.count == 0) {
+        _filterState[ch] = average;
+    } else {
+        _filterState[ch] = _filterState[ch] + ((int32_t)(average - _filterState[ch]) >> FILTER_SHIFT);
+    }
+    
+    uint32_t now = time_us_32();
+    back.filtered = (uint16_t)_filterState[ch];
+    back.period_us = (front.count == 0) ? 0 : now - front.timestamp_us;
+    back.timestamp_us = now;
+    back.count = front.count + 1;
+    
+    // Tur bitmeden okuyanlar da güncel değeri görsün
+    if (front.count == 0) {
+        front = back;
+    }
+}
+
+float SensorManager::_channelVoltage(uint channel) {
+    const ChannelSample& sample = _tables[_frontTable][channel];
+    return ((float)sample.filtered * ADC_REF_VOLTAGE) / (ADC_MAX_COUNT * (1 << FILTER_FRAC_BITS));
+}
+
+float SensorManager::readVoltage() {
+    return _channelVoltage(VOLTAGE_SENSE_ADDR) / VOLTAGE_GAIN;
+}
+
+float SensorManager::readCurrent() {
+    return (_channelVoltage(CURRENT_SENSE_ADDR) / CURRENT_GAIN) / SHUNT_RESISTOR + CURRENT_OFFSET;
 }
 
 float SensorManager::readTouchSensor(uint sensor_idx) {
@@ -70,27 +164,45 @@ float SensorManager::readTouchSensor(uint sensor_idx) {
         return 0.0f;
     }
     
-    uint address = SENSOR_1_ADDR + sensor_idx;
-    _mux.select(address);
+    return _channelVoltage(SENSOR_1_ADDR + sensor_idx);
+}
+
+float SensorManager::readAnalogPin(uint analog_pin) {
+    if (analog_pin >= NUM_CHANNELS) {
+        return 0.0f;
+    }
     
-    // ADC stabilizasyonu için bekleme
-    sleep_us(100);
+    return _channelVoltage(analog_pin);
+}
+
+uint SensorManager::getSampleRate(uint channel) {
+    if (channel >= NUM_CHANNELS) {
+        return 0;
+    }
     
-    // Birkaç örnek alıp ortalamasını hesapla
-    const int NUM_SAMPLES = 4;
-    float total = 0.0f;
+    uint32_t period = _tables[_frontTable][channel].period_us;
+    return (period == 0) ? 0 : 1000000u / period;
+}
+
+uint32_t SensorManager::getSampleAge(uint channel) {
+    if (channel >= NUM_CHANNELS) {
+        return UINT32_MAX;
+    }
     
-    for (int i = 0; i < NUM_SAMPLES; i++) {
-        total += _sensor_adc.read_voltage();
-        sleep_us(50);  // Örnekler arası kısa bekleme
+    const ChannelSample& sample = _tables[_frontTable][channel];
+    if (sample.count == 0) {
+        return UINT32_MAX;
     }
     
-    return total / NUM_SAMPLES;
+    return time_us_32() - sample.timestamp_us;
 }
 
-float SensorManager::readAnalogPin(uint analog_pin) {
-    _mux.select(analog_pin);
-    return _sensor_adc.read_voltage();
+SensorManager::ChannelSample SensorManager::getSample(uint channel) {
+    if (channel >= NUM_CHANNELS) {
+        return {0, 0, 0, 0};
+    }
+    
+    return _tables[_frontTable][channel];
 }
 
 void SensorManager::encodeValue(uint value, uint8_t &low_byte, uint8_t &high_byte) {
@@ -104,4 +216,4 @@ uint SensorManager::decodeValue(uint8_t low_byte, uint8_t high_byte) {
 
 bool SensorManager::_isValidSensorIdx(uint sensor_idx) {
     return (sensor_idx < NUM_SENSORS);
-} 
\ No newline at end of file
+}
@@ -3,39 +3,69 @@
 #include "pico/stdlib.h"
 #include "servo2040_defs.hpp"
 #include "analogmux.hpp"
-#include "analog.hpp"
 
 /**
  * @brief Voltaj, akım ve dokunmatik sensörlerin yönetimini yapan sınıf
+ * 
+ * AnalogMux adresleri (SENSOR_1..6, VOLTAGE_SENSE, CURRENT_SENSE) arka planda
+ * kontrol döngüsünün SCAN_STEP_US periyotlu scanStep() çağrılarıyla sırayla taranır. Paylaşılan ADC, FIFO ve DMA üzerinden
+ * okunur ve sonuçlar çift tamponlu bir örnek tablosuna yazılır. Okuma
+ * fonksiyonları beklemeden tablodaki son filtrelenmiş değeri döndürür.
  */
 class SensorManager {
 public:
+    // Taranan kanal sayısı (mux adres sayısı)
+    static constexpr uint NUM_CHANNELS = 8;
+    
+    // Tarama zamanlaması
+    static constexpr uint SCAN_STEP_US = 100;         // Tarama adımı periyodu (mux yerleşme süresi)
+    static constexpr uint SAMPLES_PER_CHANNEL = 4;    // Kanal başına DMA ile alınan örnek sayısı
+    
+    /**
+     * @brief Tek bir kanalın son örnek bilgisi
+     */
+    struct ChannelSample {
+        uint16_t filtered;      // Filtrelenmiş ham ADC değeri (12-bit, Q4 formatında)
+        uint32_t timestamp_us;  // Son örneğin alındığı zaman (μs)
+        uint32_t period_us;     // Son iki örnek arasındaki süre (μs)
+        uint32_t count;         // Toplam örnek sayısı
+    };
+    
     /**
-     * @brief Yapılandırıcı, analog ve çoklayıcı başlatır
+     * @brief Yapılandırıcı, analog çoklayıcıyı hazırlar
      */
     SensorManager();
     
     /**
-     * @brief Sistemi başlatır
+     * @brief Sistemi başlatır (ADC, FIFO ve DMA kanalını yapılandırır)
      */
     void init();
     
     /**
-     * @brief Sistemin voltajını ölçer
+     * @brief Tarama durum makinesini bir adım ilerletir
+     * 
+     * Her çağrıda ya seçili kanal için DMA yakalamasını başlatır ya da
+     * tamamlanan yakalamayı tabloya işleyip sonraki mux adresini seçer.
+     * SCAN_STEP_US periyoduyla, her zaman aynı çekirdekten çağrılmalıdır.
+     */
+    void scanStep();
+    
+    /**
+     * @brief Sistemin voltajını döndürür (son filtrelenmiş örnek)
      * 
      * @return float Voltaj değeri (Volt)
      */
     float readVoltage();
     
     /**
-     * @brief Sistemin çektiği akımı ölçer
+     * @brief Sistemin çektiği akımı döndürür (son filtrelenmiş örnek)
      * 
      * @return float Akım değeri (Amper)
      */
     float readCurrent();
     
     /**
-     * @brief Belirtilen dokunmatik sensörün değerini okur
+     * @brief Belirtilen dokunmatik sensörün değerini döndürür (son filtrelenmiş örnek)
      * 
      * @param sensor_idx Sensör indeksi (0-5)
      * @return float Sensör değeri (Volt)
@@ -43,13 +73,37 @@ public:
     float readTouchSensor(uint sensor_idx);
     
     /**
-     * @brief Belirtilen analog pinin değerini okur
+     * @brief Belirtilen mux adresinin değerini döndürür (son filtrelenmiş örnek)
      * 
-     * @param analog_pin Analog pin numarası
+     * @param analog_pin Mux adresi (0-7)
      * @return float Analog değeri (Volt)
      */
     float readAnalogPin(uint analog_pin);
     
+    /**
+     * @brief Kanalın örnekleme hızını döndürür
+     * 
+     * @param channel Mux adresi (0-7)
+     * @return uint Örnekleme hızı (Hz), henüz örnek yoksa 0
+     */
+    uint getSampleRate(uint channel);
+    
+    /**
+     * @brief Kanalın son örneğinin yaşını döndürür
+     * 
+     * @param channel Mux adresi (0-7)
+     * @return uint32_t Son örnekten bu yana geçen süre (μs), henüz örnek yoksa UINT32_MAX
+     */
+    uint32_t getSampleAge(uint channel);
+    
+    /**
+     * @brief Kanalın son örnek kaydını döndürür
+     * 
+     * @param channel Mux adresi (0-7)
+     * @return ChannelSample Örnek kaydının kopyası
+     */
+    ChannelSample getSample(uint channel);
+    
     /**
      * @brief 14-bit değeri iki 7-bit byte'a kodlar 
      * (USB CDC iletişimi için gerekli)
@@ -70,9 +124,6 @@ public:
     uint decodeValue(uint8_t low_byte, uint8_t high_byte);
     
 private:
-    pimoroni::Analog _sensor_adc;        // Sensör analog-dijital dönüştürücüsü
-    pimoroni::Analog _voltage_adc;       // Voltaj ölçümü ADC
-    pimoroni::Analog _current_adc;       // Akım ölçümü ADC
     pimoroni::AnalogMux _mux;            // Analog çoklayıcı
     
     static constexpr float SHUNT_RESISTOR = servo_defs::SHUNT_RESISTOR;
@@ -80,6 +131,45 @@ private:
     static constexpr float VOLTAGE_GAIN = servo_defs::VOLTAGE_GAIN;
     static constexpr float CURRENT_OFFSET = servo_defs::CURRENT_OFFSET;
     
+    // Filtre katsayısı: yeni = eski + (örnek - eski) >> FILTER_SHIFT
+    static constexpr uint FILTER_SHIFT = 2;
+    
+    /**
+     * @brief Tarama durumları
+     */
+    enum class ScanPhase {
+        SETTLE,   // Mux seçildi, sinyalin yerleşmesi bekleniyor
+        CAPTURE   // DMA ile örnekler alınıyor
+    };
+    
+    // Çift tamponlu örnek tablosu: tarama arka tabloya yazar, okuyucular ön tablodan okur
+    ChannelSample _tables[2][NUM_CHANNELS];
+    volatile uint8_t _frontTable;
+    
+    uint32_t _filterState[NUM_CHANNELS];              // Kanal başına filtre durumu (Q4)
+    uint16_t _dmaBuffer[SAMPLES_PER_CHANNEL];         // DMA hedef tamponu
+    int _dmaChannel;                                  // Kullanılan DMA kanalı
+    uint _scanChannel;                                // Şu an taranan kanal
+    ScanPhase _scanPhase;                             // Tarama durumu
+    
+    /**
+     * @brief Seçili kanal için DMA yakalamasını başlatır
+     */
+    void _startCapture();
+    
+    /**
+     * @brief Tamamlanan yakalamayı filtreleyip arka tabloya yazar
+     */
+    void _finishCapture();
+    
+    /**
+     * @brief Kanalın filtrelenmiş değerini ADC giriş voltajına dönüştürür
+     * 
+     * @param channel Mux adresi
+     * @return float ADC girişindeki voltaj (Volt)
+     */
+    float _channelVoltage(uint channel);
+    
     /**
      * @brief Sensör indeksinin geçerli olup olmadığını kontrol eder
      * 
@@ -88,4 +178,4 @@ private:
      * @return false Geçersiz
      */
     bool _isValidSensorIdx(uint sensor_idx);
-}; 
\ No newline at end of file
+}; 
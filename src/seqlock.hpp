@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Tek yazıcılı sıra kilidi (seqlock)
+ * 
+ * core1'in ürettiği son durumun core0 tarafından tutarlı bir kopya olarak
+ * okunması için kullanılır. Yazıcı hiç beklemez; yazma sırasında sıra sayacı
+ * tektir ve okuyucu sayaç okuma öncesi ve sonrasında aynı çift değeri
+ * görene kadar kopyayı tekrarlar. Veri 32-bit atomik kelimeler halinde
+ * saklanır, böylece kopya hiçbir zaman yarım yazılmış bir değer içermez.
+ * 
+ * @tparam T Saklanan durum tipi (trivially copyable olmalı)
+ */
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock tipi trivially copyable olmalı");
+    
+public:
+    Seqlock() : _seq(0), _retries(0) {
+        for (std::atomic<uint32_t>& word : _words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+    
+    /**
+     * @brief Yeni durumu yayınlar (sadece yazıcı çağırır)
+     * 
+     * @param value Yayınlanacak durum
+     */
+    void write(const T& value) {
+        uint32_t words[NUM_WORDS] = {0};
+        std::memcpy(words, &value, sizeof(T));
+        
+        uint32_t seq = _seq.load(std::memory_order_relaxed);
+        _seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < NUM_WORDS; i++) {
+            _words[i].store(words[i], std::memory_order_relaxed);
+        }
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Son yayınlanan durumun tutarlı kopyasını alır
+     * 
+     * Yazıcı kopyalama sırasında yeni bir durum yayınlarsa kopya tekrarlanır.
+     * 
+     * @param value Kopyanın yazılacağı durum
+     * @return uint32_t Kopyalanan durumun yayın numarası (0 = henüz yayın yok)
+     */
+    uint32_t read(T& value) {
+        uint32_t words[NUM_WORDS];
+        while (true) {
+            uint32_t before = _seq.load(std::memory_order_acquire);
+            if (!(before & 1)) {
+                for (size_t i = 0; i < NUM_WORDS; i++) {
+                    words[i] = _words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (_seq.load(std::memory_order_relaxed) == before) {
+                    std::memcpy(&value, words, sizeof(T));
+                    return before / 2;
+                }
+            }
+            _retries++;
+        }
+    }
+    
+    /**
+     * @brief Yazma ile çakıştığı için tekrarlanan okuma sayısı (okuyucu sayacı)
+     */
+    uint32_t retries() const {
+        return _retries;
+    }
+    
+private:
+    static constexpr size_t NUM_WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    
+    std::atomic<uint32_t> _seq;               // Yazma sırasında tek, aksi halde çift
+    std::atomic<uint32_t> _words[NUM_WORDS];  // Durum verisi
+    uint32_t _retries;                        // Tekrarlanan okumalar (sadece okuyucu yazar)
+};
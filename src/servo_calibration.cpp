@@ -0,0 +1,125 @@
+#include "servo_calibration.hpp"
+
+ServoCalibration::ServoCalibration() {
+    for (size_t servo = 0; servo < NUM_SERVOS; servo++) {
+        reset(servo);
+    }
+}
+
+bool ServoCalibration::set(size_t servo, const Entry& entry) {
+    if (servo >= NUM_SERVOS) {
+        return false;
+    }
+    
+    // Sınırlar sıralı ve kabul edilen aralıkta olmalı
+    if (entry.minPulse < PULSE_LIMIT_MIN || entry.maxPulse > PULSE_LIMIT_MAX ||
+        entry.minPulse > entry.midPulse || entry.midPulse > entry.maxPulse) {
+        return false;
+    }
+    if (entry.direction != 1 && entry.direction != -1) {
+        return false;
+    }
+    
+    // Eğri noktaları artan açı sırasıyla, tek nokta eğri tanımlamaz
+    if (entry.numPoints == 1 || entry.numPoints > MAX_POINTS) {
+        return false;
+    }
+    for (size_t i = 1; i < entry.numPoints; i++) {
+        if (entry.points[i].angle <= entry.points[i - 1].angle) {
+            return false;
+        }
+    }
+    
+    _entries[servo] = entry;
+    _compile(servo);
+    return true;
+}
+
+void ServoCalibration::reset(size_t servo) {
+    if (servo >= NUM_SERVOS) {
+        return;
+    }
+    
+    Entry& entry = _entries[servo];
+    entry = Entry();
+    entry.minPulse = DEFAULT_MIN_PULSE;
+    entry.midPulse = DEFAULT_MID_PULSE;
+    entry.maxPulse = DEFAULT_MAX_PULSE;
+    entry.direction = 1;
+    entry.offset = 0;
+    entry.numPoints = 0;
+    _compile(servo);
+}
+
+uint16_t ServoCalibration::toPulse(size_t servo, int32_t angle, bool& clamped) const {
+    const Entry& entry = _entries[servo];
+    const Curve& curve = _curves[servo];
+    
+    int32_t a = entry.direction * angle + entry.offset;
+    if (a < curve.firstAngle) {
+        a = curve.firstAngle;
+        clamped = true;
+    } else if (a > curve.lastAngle) {
+        a = curve.lastAngle;
+        clamped = true;
+    }
+    
+    // Parça sayısı en fazla 6, doğrusal arama yeterli
+    const Segment* segment = &curve.segments[0];
+    for (size_t i = 1; i < curve.numSegments; i++) {
+        if (a < curve.segments[i].angle) {
+            break;
+        }
+        segment = &curve.segments[i];
+    }
+    
+    // (a - başlangıç) parça genişliğini aşmaz, çarpım darbe farkı << 16 ile sınırlı
+    int32_t pulse = segment->pulse + (((a - segment->angle) * segment->slope + (1 << 15)) >> 16);
+    if (pulse < entry.minPulse) {
+        pulse = entry.minPulse;
+        clamped = true;
+    } else if (pulse > entry.maxPulse) {
+        pulse = entry.maxPulse;
+        clamped = true;
+    }
+    return (uint16_t)pulse;
+}
+
+uint32_t ServoCalibration::toPulses(const int32_t* angles, uint32_t mask, uint16_t* pulses) const {
+    uint32_t clampedCount = 0;
+    mask &= ALL_SERVOS;
+    for (size_t servo = 0; mask != 0; servo++, mask >>= 1) {
+        if (mask & 1) {
+            bool clamped = false;
+            pulses[servo] = toPulse(servo, angles[servo], clamped);
+            clampedCount += clamped ? 1 : 0;
+        }
+    }
+    return clampedCount;
+}
+
+void ServoCalibration::_compile(size_t servo) {
+    const Entry& entry = _entries[servo];
+    Curve& curve = _curves[servo];
+    
+    // Eğri yoksa -90°, 0°, +90° -> min, mid, max
+    Point defaults[3] = {
+        {(int16_t)-DEFAULT_RANGE, entry.minPulse},
+        {0, entry.midPulse},
+        {(int16_t)DEFAULT_RANGE, entry.maxPulse}
+    };
+    const Point* points = (entry.numPoints == 0) ? defaults : entry.points;
+    size_t numPoints = (entry.numPoints == 0) ? 3 : entry.numPoints;
+    
+    curve.numSegments = (uint8_t)(numPoints - 1);
+    curve.firstAngle = points[0].angle;
+    curve.lastAngle = points[numPoints - 1].angle;
+    for (size_t i = 0; i + 1 < numPoints; i++) {
+        Segment& segment = curve.segments[i];
+        int32_t width = points[i + 1].angle - points[i].angle;
+        int32_t rise = (int32_t)points[i + 1].pulse - points[i].pulse;
+        segment.angle = points[i].angle;
+        segment.pulse = points[i].pulse;
+        segment.slope = rise * 65536 / width;
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Servo başına açı -> darbe genişliği kalibrasyonu (sabit noktalı)
+ * 
+ * Her servo için alt/orta/üst darbe sınırı, dönüş yönü, açı ofseti ve
+ * isteğe bağlı çok noktalı parçalı doğrusal eğri tutulur. Eğri verilmezse
+ * -90°, 0° ve +90° sırasıyla alt, orta ve üst darbeye eşlenir.
+ * 
+ * Kalibrasyon değiştiğinde her parçanın eğimi Q16 olarak bir kez hesaplanır;
+ * dönüşüm bölme veya float içermez, servo başına bir çarpma ve kaydırmadır.
+ * RP2040'ta float bölme yazılımla (ROM rutinleri) yapıldığı için 18 servoluk
+ * toplu dönüşüm ServoDriver::angleToPulseWidth'e göre belirgin şekilde kısadır.
+ * Donanımdan bağımsızdır, host üzerinde de derlenebilir.
+ */
+class ServoCalibration {
+public:
+    static constexpr size_t NUM_SERVOS = 18;
+    static constexpr size_t MAX_POINTS = 7;           // Eğri başına en fazla nokta
+    static constexpr uint32_t ALL_SERVOS = (1u << NUM_SERVOS) - 1;
+    
+    // Varsayılan eşleme: ±90° -> 500-2500 μs
+    static constexpr uint16_t DEFAULT_MIN_PULSE = 500;
+    static constexpr uint16_t DEFAULT_MID_PULSE = 1500;
+    static constexpr uint16_t DEFAULT_MAX_PULSE = 2500;
+    static constexpr int32_t DEFAULT_RANGE = 9000;    // 0.01°
+    
+    // Kabul edilen darbe aralığı (μs)
+    static constexpr uint16_t PULSE_LIMIT_MIN = 400;
+    static constexpr uint16_t PULSE_LIMIT_MAX = 2600;
+    
+    /**
+     * @brief Eğri noktası
+     */
+    struct Point {
+        int16_t angle;      // Açı (0.01°), noktalar artan açı sırasıyla
+        uint16_t pulse;     // Darbe genişliği (μs)
+    };
+    
+    /**
+     * @brief Servonun kalibrasyon kaydı
+     */
+    struct Entry {
+        uint16_t minPulse;              // Alt darbe sınırı (μs)
+        uint16_t midPulse;              // 0°'deki darbe (eğri yoksa)
+        uint16_t maxPulse;              // Üst darbe sınırı (μs)
+        int8_t direction;               // 1 veya -1, açıya ofsetten önce uygulanır
+        int16_t offset;                 // Açı ofseti (0.01°)
+        uint8_t numPoints;              // 0 = min/mid/max ile doğrusal, aksi halde 2..MAX_POINTS
+        Point points[MAX_POINTS];       // Parçalı doğrusal eğri
+    };
+    
+    /**
+     * @brief Yapılandırıcı, tüm servolar varsayılan eşlemeyle başlar
+     */
+    ServoCalibration();
+    
+    /**
+     * @brief Servonun kalibrasyonunu değiştirir
+     * 
+     * @param servo Servo indeksi
+     * @param entry Yeni kayıt
+     * @return true Kayıt geçerli ve uygulandı
+     * @return false Geçersiz servo, sınırlar sırasız veya aralık dışı, yön ±1 değil,
+     * nokta sayısı geçersiz ya da açılar artan sırada değil
+     */
+    bool set(size_t servo, const Entry& entry);
+    
+    /**
+     * @brief Servonun kalibrasyon kaydını döndürür
+     */
+    const Entry& get(size_t servo) const {
+        return _entries[(servo < NUM_SERVOS) ? servo : 0];
+    }
+    
+    /**
+     * @brief Servoyu varsayılan eşlemeye döndürür
+     */
+    void reset(size_t servo);
+    
+    /**
+     * @brief Tek servonun açısını darbe genişliğine çevirir
+     * 
+     * @param servo Servo indeksi
+     * @param angle Açı (0.01°)
+     * @param clamped Açı eğri dışında kaldıysa veya darbe sınırlandıysa true yapılır
+     * @return uint16_t Darbe genişliği (μs)
+     */
+    uint16_t toPulse(size_t servo, int32_t angle, bool& clamped) const;
+    
+    /**
+     * @brief Maskedeki servoların açılarını toplu çevirir
+     * 
+     * @param angles NUM_SERVOS açı (0.01°), servo indeksiyle
+     * @param mask Çevrilecek servolar
+     * @param pulses NUM_SERVOS darbe genişliği; sadece maskedekiler yazılır
+     * @return uint32_t Sınırlanan servo sayısı
+     */
+    uint32_t toPulses(const int32_t* angles, uint32_t mask, uint16_t* pulses) const;
+    
+private:
+    /**
+     * @brief Eğri parçası: başlangıç açısı ve darbesi, eğim Q16 (μs / 0.01°)
+     */
+    struct Segment {
+        int32_t angle;
+        int32_t pulse;
+        int32_t slope;
+    };
+    
+    /**
+     * @brief Servonun derlenmiş eğrisi
+     */
+    struct Curve {
+        uint8_t numSegments;
+        int32_t firstAngle;
+        int32_t lastAngle;
+        Segment segments[MAX_POINTS - 1];
+    };
+    
+    Entry _entries[NUM_SERVOS];   // Host'un verdiği kayıtlar
+    Curve _curves[NUM_SERVOS];    // Dönüşümde kullanılan parçalar
+    
+    /**
+     * @brief Kaydın noktalarından parçaları ve eğimleri hesaplar
+     * 
+     * @param servo Servo indeksi
+     */
+    void _compile(size_t servo);
+};
@@ -1,31 +1,199 @@
 #include "servo_driver.hpp"
 #include <cmath>
 
-ServoDriver::ServoDriver(uint start_pin, uint end_pin) :
-    _servos(pio0, 0, start_pin, (end_pin - start_pin) + 1),
+ServoDriver::Config ServoDriver::boardConfig() {
+    Config config;
+    config.frequency = (float)SERVO2040_PWM_FREQUENCY;
+    config.autoPhase = (SERVO2040_PWM_AUTO_PHASE != 0);
+    config.enableStaggerUs = SERVO2040_ENABLE_STAGGER_US;
+    return config;
+}
+
+ServoDriver::Config ServoDriver::_sanitize(const Config& config) {
+    Config result = config;
+    result.frequency = (config.frequency < MIN_FREQUENCY) ? MIN_FREQUENCY :
+                       (config.frequency > MAX_FREQUENCY) ? MAX_FREQUENCY : config.frequency;
+    return result;
+}
+
+ServoDriver::ServoDriver(uint start_pin, uint end_pin, const Config& config) :
+    _config(_sanitize(config)),
+    _servos(pio0, 0, start_pin, (end_pin - start_pin) + 1, servo::ANGULAR, _config.frequency, _config.autoPhase),
     _start_pin(start_pin),
     _end_pin(end_pin),
-    _servo_count((end_pin - start_pin) + 1) {
+    _servo_count((end_pin - start_pin) + 1),
+    _enabledCount(0),
+    _nextEnable_us(0),
+    _framePending(false),
+    _periodUs((uint)(1000000.0f / _config.frequency + 0.5f)),
+    _pwmEpoch(0),
+    _hostFramePending(false),
+    _newTargets(false),
+    _framesCommitted(0),
+    _framesCoalesced(0),
+    _committed() {
+    for (uint i = 0; i < servo_defs::NUM_SERVOS; i++) {
+        _minPulse[i] = 500;
+        _maxPulse[i] = 2500;
+    }
 }
 
 void ServoDriver::init() {
     _servos.init();
-    _servos.enable_all();
+    _pwmEpoch = time_us_32();
+    
+    if (_config.enableStaggerUs == 0) {
+        _servos.enable_all();
+        _enabledCount = _servo_count;
+        for (uint i = 0; i < _servo_count && i < servo_defs::NUM_SERVOS; i++) {
+            _committed[i] = (uint16_t)_servos.pulse(i);
+        }
+        return;
+    }
+    
+    // Servolar sırayla etkinleşir, o zamana kadar orta konumda sayılır
+    _enabledCount = 0;
+    _nextEnable_us = _pwmEpoch;
+    for (uint i = 0; i < _servo_count && i < servo_defs::NUM_SERVOS; i++) {
+        _committed[i] = (uint16_t)servo::ServoState::DEFAULT_MID_PULSE;
+    }
+}
+
+bool ServoDriver::updateEnable(uint32_t now_us) {
+    if (_enabledCount >= _servo_count) {
+        return true;
+    }
+    if ((int32_t)(now_us - _nextEnable_us) < 0) {
+        return false;
+    }
+    
+    // Komutla zaten etkinleşmiş servo olduğu gibi kalır; yükleme hazırlanan kareyi bölmez
+    uint8_t servo_index = (uint8_t)_enabledCount;
+    if (!_servos.is_enabled(servo_index)) {
+        _servos.pulse(servo_index, (float)_committed[servo_index], false);
+        if (!_framePending) {
+            _servos.load();
+        }
+    }
+    _enabledCount++;
+    _nextEnable_us = now_us + _config.enableStaggerUs;
+    return _enabledCount >= _servo_count;
 }
 
 bool ServoDriver::moveServo(uint servo_pin, uint pulse_width, bool wait_for_move) {
+    return _writePulse(servo_pin, pulse_width, true);
+}
+
+bool ServoDriver::stageServo(uint servo_pin, uint pulse_width) {
+    if (!_writePulse(servo_pin, pulse_width, false)) {
+        return false;
+    }
+    
+    _framePending = true;
+    _newTargets = true;
+    return true;
+}
+
+bool ServoDriver::stageServoDelta(uint servo_pin, int delta) {
     if (!_isValidPin(servo_pin)) {
         return false;
     }
     
-    // Darbe genişliğini 500-2500 us arasında sınırla
-    pulse_width = (pulse_width < 500) ? 500 : (pulse_width > 2500) ? 2500 : pulse_width;
+    int pulse_width = (int)_committed[servo_pin - _start_pin] + delta;
+    return stageServo(servo_pin, (pulse_width < 0) ? 0 : (uint)pulse_width);
+}
+
+bool ServoDriver::setPulseLimits(uint servo_pin, uint min_pulse, uint max_pulse) {
+    if (!_isValidPin(servo_pin) || servo_pin - _start_pin >= servo_defs::NUM_SERVOS || min_pulse > max_pulse) {
+        return false;
+    }
+    
+    _minPulse[servo_pin - _start_pin] = (uint16_t)min_pulse;
+    _maxPulse[servo_pin - _start_pin] = (uint16_t)max_pulse;
+    return true;
+}
+
+uint ServoDriver::clampPulse(uint servo_pin, uint pulse_width) const {
+    // Sınır dizisi dışındaki pinler varsayılan 500-2500 us aralığında
+    uint servo_index = servo_pin - _start_pin;
+    uint min_pulse = (servo_index < servo_defs::NUM_SERVOS) ? _minPulse[servo_index] : 500;
+    uint max_pulse = (servo_index < servo_defs::NUM_SERVOS) ? _maxPulse[servo_index] : 2500;
+    return (pulse_width < min_pulse) ? min_pulse : (pulse_width > max_pulse) ? max_pulse : pulse_width;
+}
+
+void ServoDriver::submitFrame() {
+    if (!_newTargets) {
+        return;
+    }
+    _newTargets = false;
+    
+    if (_hostFramePending) {
+        _framesCoalesced++;
+    }
+    _hostFramePending = true;
+    
+    // Sonraki fark kareleri commit beklemeden bu kareye göre uygulanır
+    _latchFrame();
+}
+
+bool ServoDriver::commitFrame() {
+    _hostFramePending = false;
+    _newTargets = false;
+    if (!_framePending) {
+        return false;
+    }
+    
+    // Tek yükleme: yeni darbeler bir sonraki PWM wrap'inde birlikte devreye girer
+    _servos.load();
+    _framePending = false;
+    _framesCommitted++;
+    
+    // Fark kareleri bu kareye göre uygulanır
+    _latchFrame();
+    
+    return true;
+}
+
+uint32_t ServoDriver::getFramesCommitted() const {
+    return _framesCommitted;
+}
+
+uint32_t ServoDriver::getFramesCoalesced() const {
+    return _framesCoalesced;
+}
+
+uint ServoDriver::getPeriodUs() const {
+    return _periodUs;
+}
+
+uint32_t ServoDriver::getNextWrap(uint32_t now_us) const {
+    return now_us + (_periodUs - (now_us - _pwmEpoch) % _periodUs);
+}
+
+void ServoDriver::_latchFrame() {
+    for (uint i = 0; i < _servo_count && i < servo_defs::NUM_SERVOS; i++) {
+        _committed[i] = (uint16_t)_servos.pulse(i);
+    }
+}
+
+bool ServoDriver::_writePulse(uint servo_pin, uint pulse_width, bool load) {
+    if (!_isValidPin(servo_pin)) {
+        return false;
+    }
     
     // Convert to the correct pin index (relative to start_pin)
     uint8_t servo_index = servo_pin - _start_pin;
     
+    // Darbe genişliğini servonun sınırlarına çek (kalibrasyonla ayarlanır, varsayılan 500-2500 us)
+    pulse_width = clampPulse(servo_pin, pulse_width);
+    
     // Use the float version of pulse width
-    _servos.pulse(servo_index, (float)pulse_width);
+    _servos.pulse(servo_index, (float)pulse_width, load);
+    
+    // Anında yüklenen darbe de son uygulanan kareye girer
+    if (load && servo_index < servo_defs::NUM_SERVOS) {
+        _committed[servo_index] = (uint16_t)pulse_width;
+    }
     
     return true;
 }
@@ -38,14 +206,26 @@ uint ServoDriver::getServoPosition(uint servo_pin) {
     // Convert to the correct pin index (relative to start_pin)
     uint8_t servo_index = servo_pin - _start_pin;
     
+    // Henüz etkinleşmemiş servo son commit edilen (açılışta orta) değeri gösterir
+    if (!_servos.is_enabled(servo_index) && servo_index < servo_defs::NUM_SERVOS) {
+        return _committed[servo_index];
+    }
     return (uint)_servos.pulse(servo_index);
 }
 
+uint ServoDriver::getCommittedPosition(uint servo_pin) {
+    if (!_isValidPin(servo_pin)) {
+        return 0;
+    }
+    
+    return _committed[servo_pin - _start_pin];
+}
+
 void ServoDriver::centerAllServos(uint center_pos) {
     for (uint i = 0; i < _servo_count; i++) {
-        uint8_t servo_index = i;
-        _servos.pulse(servo_index, (float)center_pos);
+        stageServo(_start_pin + i, center_pos);
     }
+    commitFrame();
 }
 
 void ServoDriver::disableAllServos() {
@@ -66,8 +246,9 @@ bool ServoDriver::moveMultipleServos(const uint* servo_pins, const uint* pulse_w
     bool success = true;
     
     for (uint i = 0; i < count; i++) {
-        success &= moveServo(servo_pins[i], pulse_widths[i], false);
+        success &= stageServo(servo_pins[i], pulse_widths[i]);
     }
+    commitFrame();
     
     return success;
 }
@@ -77,8 +258,9 @@ bool ServoDriver::moveAllServos(const uint* pulse_widths) {
     
     for (uint i = 0; i < _servo_count; i++) {
         uint servo_pin = _start_pin + i;
-        success &= moveServo(servo_pin, pulse_widths[i], false);
+        success &= stageServo(servo_pin, pulse_widths[i]);
     }
+    commitFrame();
     
     return success;
 }
@@ -88,8 +270,9 @@ bool ServoDriver::moveServosByAngle(const uint* servo_pins, const float* angles,
     
     for (uint i = 0; i < count; i++) {
         uint pulse = angleToPulseWidth(angles[i]);
-        success &= moveServo(servo_pins[i], pulse, false);
+        success &= stageServo(servo_pins[i], pulse);
     }
+    commitFrame();
     
     return success;
 }
@@ -5,43 +5,212 @@
 #include "servo2040_defs.hpp"
 #include "servo_cluster.hpp"
 
+// Kart başına PWM ayarı, derlemede -D ile (CMake önbellek değişkenleri) değiştirilir
+#ifndef SERVO2040_PWM_FREQUENCY
+#define SERVO2040_PWM_FREQUENCY 50          // Servo PWM frekansı (Hz), dijital servolarda 200-333
+#endif
+#ifndef SERVO2040_PWM_AUTO_PHASE
+#define SERVO2040_PWM_AUTO_PHASE 1          // Kanalların darbe başlangıçları periyoda yayılsın mı
+#endif
+#ifndef SERVO2040_ENABLE_STAGGER_US
+#define SERVO2040_ENABLE_STAGGER_US 5000    // Açılışta ardışık servo etkinleştirmeleri arası süre (μs), 0 = hepsi birlikte
+#endif
+
 /**
  * @brief Servo sürücü sınıfı, servo motorların kontrolünü sağlar
  */
 class ServoDriver {
 public:
+    static constexpr float MIN_FREQUENCY = 10.0f;    // En düşük PWM frekansı (Hz)
+    static constexpr float MAX_FREQUENCY = 350.0f;   // En yüksek PWM frekansı, periyot 2600 μs darbe sınırından uzun kalır
+    
+    /**
+     * @brief PWM ve açılış ayarı
+     */
+    struct Config {
+        float frequency;          // PWM frekansı (Hz), MIN_FREQUENCY..MAX_FREQUENCY aralığına çekilir
+        bool autoPhase;           // Kanal i'nin darbesi periyodun i/n'inde başlar; aynı kenarda toplanan kalkış akımı dağılır
+        uint enableStaggerUs;     // Servolar açılışta bu aralıkla tek tek etkinleşir, 0 = hepsi birlikte
+    };
+    
+    /**
+     * @brief Kartın derleme ayarlarından (SERVO2040_PWM_*) gelen yapılandırma
+     */
+    static Config boardConfig();
+    
     /**
      * @brief Yapılandırıcı, servo cluster'ı başlatır
      * 
      * @param start_pin İlk servo pini
      * @param end_pin Son servo pini
+     * @param config PWM ve açılış ayarı
      */
     ServoDriver(uint start_pin = servo_defs::SERVO_1, 
-                uint end_pin = servo_defs::SERVO_18);
+                uint end_pin = servo_defs::SERVO_18,
+                const Config& config = boardConfig());
     
     /**
-     * @brief Sistemi başlatır ve tüm servoları etkinleştirir
+     * @brief Sistemi başlatır
+     * 
+     * enableStaggerUs 0 ise tüm servolar hemen etkinleşir; değilse
+     * servolar orta konumda bekler ve updateEnable() ile tek tek etkinleşir.
      */
     void init();
     
+    /**
+     * @brief Kademeli etkinleştirmeyi ilerletir (bloklamaz)
+     * 
+     * Zamanı gelen sıradaki servoyu etkinleştirir. Bekleyen bir kare varsa
+     * yükleme onun commit'ine bırakılır, böylece kare bölünmez. Komut alan
+     * servo sırasını beklemeden etkinleşir.
+     * 
+     * @param now_us Şu anki zaman (μs)
+     * @return true Tüm servolar etkin
+     */
+    bool updateEnable(uint32_t now_us);
+    
+    /**
+     * @brief Kademeli etkinleştirmede sırası gelmiş servo sayısı
+     */
+    uint getEnabledCount() const {
+        return _enabledCount;
+    }
+    
+    /**
+     * @brief PWM frekansını döndürür (Hz)
+     */
+    float getFrequency() const {
+        return _config.frequency;
+    }
+    
+    /**
+     * @brief Kanal darbe başlangıçları periyoda yayılmış mı
+     */
+    bool isAutoPhase() const {
+        return _config.autoPhase;
+    }
+    
     /**
      * @brief Belirli bir servoyu belirli bir pozisyona hareket ettirir
      * 
      * @param servo_pin Servo pin numarası
-     * @param pulse_width PWM darbe genişliği (500-2500 μs arası)
+     * @param pulse_width PWM darbe genişliği (servonun darbe sınırlarına çekilir)
      * @param wait_for_move Hareketin tamamlanması beklensin mi
      * @return Başarı/hata durumu
      */
     bool moveServo(uint servo_pin, uint pulse_width, bool wait_for_move = false);
     
+    /**
+     * @brief Servo hedefini PWM'e yüklemeden hazırlar (ertelenmiş yükleme)
+     * 
+     * Hazırlanan hedefler commitFrame() çağrılana kadar çıkışa yansımaz.
+     * 
+     * @param servo_pin Servo pin numarası
+     * @param pulse_width PWM darbe genişliği (servonun darbe sınırlarına çekilir)
+     * @return Başarı/hata durumu
+     */
+    bool stageServo(uint servo_pin, uint pulse_width);
+    
+    /**
+     * @brief Servo hedefini son uygulanan kareye göre farkla hazırlar
+     * 
+     * Fark, aynı karede daha önce hazırlanmış hedeflere değil son gönderilen
+     * (submitFrame) veya commit edilen kareye eklenir; sonuç servonun darbe
+     * sınırlarına çekilir.
+     * 
+     * @param servo_pin Servo pin numarası
+     * @param delta Darbe genişliği farkı (μs)
+     * @return Başarı/hata durumu
+     */
+    bool stageServoDelta(uint servo_pin, int delta);
+    
+    /**
+     * @brief Servonun darbe sınırlarını ayarlar (varsayılan 500-2500 μs)
+     * 
+     * Sonraki tüm hedefler bu aralığa çekilir; mevcut pozisyon değişmez.
+     * 
+     * @param servo_pin Servo pin numarası
+     * @param min_pulse Alt sınır (μs)
+     * @param max_pulse Üst sınır (μs)
+     * @return Başarı/hata durumu
+     */
+    bool setPulseLimits(uint servo_pin, uint min_pulse, uint max_pulse);
+    
+    /**
+     * @brief Darbe genişliğini servonun darbe sınırlarına çeker
+     * 
+     * @param servo_pin Servo pin numarası
+     * @param pulse_width PWM darbe genişliği (μs)
+     * @return uint Sınırlanmış darbe genişliği (μs)
+     */
+    uint clampPulse(uint servo_pin, uint pulse_width) const;
+    
+    /**
+     * @brief Hazırlanan host karesini bir sonraki commitFrame() çağrısına bırakır
+     * 
+     * Hedefler stageServo() ile zaten yazılmıştır; bu çağrı sadece karenin
+     * sınırını işaretler. Önceki host karesi henüz commit edilmediyse bu kare
+     * onun hedeflerini çıkışa hiç yansımadan ezer ve birleştirilmiş
+     * (coalesced) olarak sayılır.
+     */
+    void submitFrame();
+    
+    /**
+     * @brief Hazırlanan tüm hedefleri tek bir PWM yüklemesiyle uygular
+     * 
+     * PWM cluster yeni diziyi bir sonraki periyot sonunda (wrap) devreye aldığı
+     * için tüm servolar aynı periyotta birlikte değişir. Kontrol adımı bunu
+     * periyot başına bir kez, wrap'ten önce çağırır (bkz. getNextWrap()).
+     * 
+     * @return true Hazırlanmış hedef vardı ve yüklendi
+     * @return false Hazırlanmış hedef yok
+     */
+    bool commitFrame();
+    
+    /**
+     * @brief Uygulanan kare sayısını döndürür
+     */
+    uint32_t getFramesCommitted() const;
+    
+    /**
+     * @brief Commit edilmeden bir sonraki host karesiyle ezilen kare sayısını döndürür
+     */
+    uint32_t getFramesCoalesced() const;
+    
+    /**
+     * @brief PWM periyodunu döndürür
+     * 
+     * @return uint PWM periyodu (μs)
+     */
+    uint getPeriodUs() const;
+    
+    /**
+     * @brief Verilen zamandan sonraki ilk PWM wrap zamanını döndürür
+     * 
+     * PIO servo cluster'ı wrap sayacı veya kesmesi sunmaz; wrap'ler init()'te
+     * cluster'ın başladığı andan itibaren periyot katlarında varsayılır.
+     * 
+     * @param now_us Şu anki zaman (μs)
+     * @return uint32_t Sonraki wrap zamanı (μs)
+     */
+    uint32_t getNextWrap(uint32_t now_us) const;
+    
     /**
      * @brief Servodan şu anki pozisyonu okur
      * 
      * @param servo_pin Servo pin numarası
-     * @return uint Servo pozisyonu (pulse width - μs)
+     * @return uint Servo pozisyonu (pulse width - μs); henüz etkinleşmemiş servoda son commit edilen (açılışta orta) değer
      */
     uint getServoPosition(uint servo_pin);
     
+    /**
+     * @brief Son gönderilen (submitFrame) veya commit edilen karedeki pozisyonu döndürür
+     * 
+     * @param servo_pin Servo pin numarası
+     * @return uint Servo pozisyonu (pulse width - μs), geçersiz pinde 0
+     */
+    uint getCommittedPosition(uint servo_pin);
+    
     /**
      * @brief Tüm servoları merkez pozisyona getirir
      * 
@@ -98,10 +267,40 @@ public:
     uint angleToPulseWidth(float angle, uint min_pulse = 500, uint max_pulse = 2500);
     
 private:
+    const Config _config;         // PWM ve açılış ayarı (sınırlanmış)
     servo::ServoCluster _servos;  // Servo kontrol nesnesi
     const uint _start_pin;        // İlk servo pini
     const uint _end_pin;          // Son servo pini
     const uint _servo_count;      // Toplam servo sayısı
+    uint _enabledCount;           // Kademeli etkinleştirmede sırası gelmiş servolar
+    uint32_t _nextEnable_us;      // Sıradaki servonun etkinleşme zamanı
+    
+    // Kare uygulama durumu
+    bool _framePending;           // Hazırlanmış, henüz yüklenmemiş hedef var
+    uint _periodUs;               // PWM periyodu (μs)
+    uint32_t _pwmEpoch;           // PWM başlangıç zamanı, wrap zamanları için
+    bool _hostFramePending;       // Gönderilmiş, henüz commit edilmemiş host karesi var
+    bool _newTargets;             // Son submitFrame() veya commitFrame()'den beri hazırlanan hedef var
+    uint32_t _framesCommitted;    // Uygulanan kare sayısı
+    uint32_t _framesCoalesced;    // Ezilen kare sayısı
+    uint16_t _committed[servo_defs::NUM_SERVOS];  // Son gönderilen veya commit edilen kare (μs)
+    uint16_t _minPulse[servo_defs::NUM_SERVOS];   // Servo başına alt darbe sınırı (μs)
+    uint16_t _maxPulse[servo_defs::NUM_SERVOS];   // Servo başına üst darbe sınırı (μs)
+    
+    /**
+     * @brief Hazırlanan darbeleri fark karelerinin tabanı olarak saklar
+     */
+    void _latchFrame();
+    
+    /**
+     * @brief Darbe genişliğini sınırlayıp servoya yazar
+     * 
+     * @param servo_pin Servo pin numarası
+     * @param pulse_width PWM darbe genişliği
+     * @param load PWM'e hemen yüklensin mi
+     * @return Başarı/hata durumu
+     */
+    bool _writePulse(uint servo_pin, uint pulse_width, bool load);
     
     /**
      * @brief Verilen pin numarasının geçerli olup olmadığını kontrol eder
@@ -111,4 +310,9 @@ private:
      * @return false Geçersiz
      */
     bool _isValidPin(uint servo_pin);
+    
+    /**
+     * @brief Frekansı desteklenen aralığa çeker
+     */
+    static Config _sanitize(const Config& config);
 }; 
\ No newline at end of file
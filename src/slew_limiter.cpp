@@ -0,0 +1,150 @@
+#include "slew_limiter.hpp"
+#include "int_math.hpp"
+
+SlewLimiter::SlewLimiter() :
+    _servos(),
+    _limitedSteps(0),
+    _scale(SCALE_ONE),
+    _jumpCredit(0),
+    _staggerNext(0) {
+    for (size_t i = 0; i < NUM_SERVOS; i++) {
+        reset(i, 1500);
+    }
+}
+
+void SlewLimiter::setMaxVelocity(size_t servo, uint32_t velocity) {
+    if (servo < NUM_SERVOS) {
+        _servos[servo].maxVelocity = velocity;
+    }
+}
+
+void SlewLimiter::setMaxAccel(size_t servo, uint32_t accel) {
+    if (servo < NUM_SERVOS) {
+        _servos[servo].maxAccel = accel;
+    }
+}
+
+void SlewLimiter::setTarget(size_t servo, uint16_t pulse) {
+    if (servo < NUM_SERVOS) {
+        _servos[servo].target = pulse;
+    }
+}
+
+void SlewLimiter::reset(size_t servo, uint16_t pulse) {
+    if (servo >= NUM_SERVOS) {
+        return;
+    }
+    
+    ServoState& state = _servos[servo];
+    state.target = pulse;
+    state.position = (int32_t)pulse << 8;
+    state.velocity = 0;
+}
+
+uint32_t SlewLimiter::update(uint32_t dt_us, uint16_t* pulses) {
+    dt_us = (dt_us > MAX_STEP_US) ? MAX_STEP_US : dt_us;
+    
+    // Bu adımda hedefine geçebilecek sınırsız servolar: her adım NUM_SERVOS * ölçek kadar
+    // hak birikir (Q8), düşük ölçekte bir sıçrama birkaç adıma yayılır; sıra servolar arasında döner
+    _jumpCredit += NUM_SERVOS * _scale;
+    uint32_t jumps = _jumpCredit / SCALE_ONE;
+    uint32_t allowed = jumps;
+    size_t first = (_scale < SCALE_ONE) ? _staggerNext : 0;
+    
+    uint32_t changed = 0;
+    for (size_t k = 0; k < NUM_SERVOS; k++) {
+        size_t i = (first + k) % NUM_SERVOS;
+        ServoState& state = _servos[i];
+        int32_t target = (int32_t)state.target << 8;
+        int32_t previous = (state.position + 128) >> 8;
+        
+        if (state.position == target && state.velocity == 0) {
+            continue;
+        }
+        
+        if (state.maxVelocity == 0 || dt_us == 0) {
+            // Sınırsız servo (veya sınırı yeni kaldırılmış): hedef doğrudan çıkışa
+            if (state.maxVelocity == 0 && jumps != 0) {
+                state.position = target;
+                state.velocity = 0;
+                jumps--;
+                _staggerNext = (i + 1) % NUM_SERVOS;
+            }
+        } else {
+            int64_t error = (int64_t)target - state.position;
+            int64_t distance = (error < 0) ? -error : error;
+            
+            // Hedefe doğru istenen hız: hız sınırı, kalan mesafede durabilecek hız
+            // ve bu adımda hedefi aşmayacak hızın en küçüğü (Q8 μs/s); sınırlar ölçeklenir
+            uint32_t maxAccel = (uint32_t)((uint64_t)state.maxAccel * _scale / SCALE_ONE);
+            maxAccel = (state.maxAccel != 0 && maxAccel == 0) ? 1 : maxAccel;
+            int64_t desired = (int64_t)state.maxVelocity * _scale;
+            if (maxAccel != 0) {
+                int64_t stopping = IntMath::isqrt(2 * (uint64_t)maxAccel * (uint64_t)distance * 256);
+                desired = (stopping < desired) ? stopping : desired;
+            }
+            int64_t reach = distance * 1000000 / dt_us;
+            bool arrive = reach <= desired;
+            desired = arrive ? reach : desired;
+            desired = (error < 0) ? -desired : desired;
+            
+            // Hız istenen değere en fazla ivme sınırı kadar yaklaşır
+            int64_t velocity = desired;
+            if (maxAccel != 0) {
+                int64_t dv = ((int64_t)maxAccel << 8) * dt_us / 1000000;
+                dv = (dv < 1) ? 1 : dv;
+                velocity = state.velocity;
+                if (desired > velocity + dv) {
+                    velocity += dv;
+                } else if (desired < velocity - dv) {
+                    velocity -= dv;
+                } else {
+                    velocity = desired;
+                }
+            }
+            
+            // Kesir kaybı hareketi durdurmasın, en az 1/256 μs ilerlenir
+            int32_t step = (int32_t)(velocity * dt_us / 1000000);
+            if (step == 0 && velocity != 0) {
+                step = (velocity < 0) ? -1 : 1;
+            }
+            int32_t position = state.position + step;
+            
+            // Bu adımda hedefe varılabiliyorsa veya hedef geçildiyse (hedef yavaşlayan
+            // servonun arkasına alındıysa) hedefte durur
+            if ((arrive && velocity == desired) || position == target ||
+                ((int64_t)target - position < 0) != (error < 0)) {
+                state.position = target;
+                state.velocity = 0;
+            } else {
+                state.position = position;
+                state.velocity = (int32_t)velocity;
+            }
+        }
+        
+        if (state.position != target) {
+            _limitedSteps++;
+        }
+        
+        int32_t output = (state.position + 128) >> 8;
+        if (output != previous) {
+            pulses[i] = (uint16_t)output;
+            changed |= 1u << i;
+        }
+    }
+    
+    // Kullanılmayan hak bir adımlık sıçramayla sınırlı kalır, boşta biriktirilmez
+    _jumpCredit -= (allowed - jumps) * SCALE_ONE;
+    _jumpCredit = (_jumpCredit > NUM_SERVOS * SCALE_ONE) ? NUM_SERVOS * SCALE_ONE : _jumpCredit;
+    return changed;
+}
+
+uint32_t SlewLimiter::reachedMask() const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < NUM_SERVOS; i++) {
+        if (_servos[i].position == ((int32_t)_servos[i].target << 8)) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
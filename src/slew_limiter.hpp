@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Servo başına hız ve ivme sınırlayıcı
+ * 
+ * Her servo için komut edilen hedef ile çıkışa giden darbe genişliği ayrı
+ * tutulur. update() sabit periyotlu kontrol adımında çağrılır ve çıkışı
+ * hedefe en fazla maxVelocity hızla, hızı da en fazla maxAccel ivmeyle
+ * değiştirerek yaklaştırır. Kalan mesafede durabilecek hızdan fazlasına
+ * çıkılmaz, bu yüzden çıkış hedefi aşmadan yavaşlayarak durur. Büyük
+ * sıçramalar servoyu tam hızda çarptırmaz; akım tepeleri ve servo hattındaki
+ * gerilim düşmeleri azalır.
+ * 
+ * Sınırı 0 olan servo sınırlanmaz, hedef bir sonraki adımda çıkışa geçer.
+ * Akım kısıcısı setScale() ile ölçeği düşürdüğünde sınırlı servoların hız ve
+ * ivme sınırları ölçeklenir, sınırsız servolar da hedeflerine her adımda
+ * sadece bir kısmı (sırayla) geçecek şekilde dağıtılır.
+ * Konum ve hız Q8 sabit noktalıdır; donanımdan bağımsızdır, host üzerinde
+ * de derlenebilir.
+ */
+class SlewLimiter {
+public:
+    static constexpr size_t NUM_SERVOS = 18;                  // Servo sayısı
+    static constexpr uint32_t ALL_SERVOS = (1u << NUM_SERVOS) - 1;
+    static constexpr uint32_t MAX_STEP_US = 100000;            // Bir adımda en fazla ilerlenen süre
+    static constexpr uint16_t SCALE_ONE = 256;                 // Tam hız ölçeği (Q8)
+    
+    /**
+     * @brief Yapılandırıcı, tüm servolar sınırsız başlar
+     */
+    SlewLimiter();
+    
+    /**
+     * @brief Servonun hız sınırını ayarlar
+     * 
+     * @param servo Servo indeksi
+     * @param velocity En yüksek hız (μs/s), 0 = sınırsız
+     */
+    void setMaxVelocity(size_t servo, uint32_t velocity);
+    
+    /**
+     * @brief Servonun ivme sınırını ayarlar
+     * 
+     * Hız sınırı 0 iken etkisizdir.
+     * 
+     * @param servo Servo indeksi
+     * @param accel En yüksek ivme (μs/s²), 0 = sınırsız
+     */
+    void setMaxAccel(size_t servo, uint32_t accel);
+    
+    /**
+     * @brief Hareket ölçeğini ayarlar
+     * 
+     * SCALE_ONE'ın altında sınırlı servoların sınırları ölçekle çarpılır ve
+     * bir adımda hedefine geçen sınırsız servo sayısı ortalama NUM_SERVOS *
+     * ölçek ile sınırlanır. Bekletilen hedefler atılmaz, sonraki adımlarda
+     * uygulanır.
+     * 
+     * @param scale Ölçek (Q8, 1..SCALE_ONE)
+     */
+    void setScale(uint16_t scale) {
+        _scale = (scale == 0) ? 1 : ((scale > SCALE_ONE) ? SCALE_ONE : scale);
+    }
+    
+    /**
+     * @brief Servo hız sınırlı mı (hedef çıkışa adım adım taşınır)
+     * 
+     * Ölçek düşürülmüşken tüm servolar sınırlıdır.
+     */
+    bool isLimited(size_t servo) const {
+        return servo < NUM_SERVOS && (_servos[servo].maxVelocity != 0 || _scale < SCALE_ONE);
+    }
+    
+    /**
+     * @brief Servonun yeni hedefini ayarlar, çıkış update() ile yaklaşır
+     * 
+     * @param servo Servo indeksi
+     * @param pulse Hedef darbe genişliği (μs)
+     */
+    void setTarget(size_t servo, uint16_t pulse);
+    
+    /**
+     * @brief Hedefi ve çıkışı doğrudan ayarlar, hızı sıfırlar
+     * 
+     * Sınırsız servolarda her doğrudan yazımda çağrılır; sınır sonradan
+     * açılırsa hareket buradan başlar.
+     * 
+     * @param servo Servo indeksi
+     * @param pulse Darbe genişliği (μs)
+     */
+    void reset(size_t servo, uint16_t pulse);
+    
+    /**
+     * @brief Servonun hedefini döndürür
+     */
+    uint16_t getTarget(size_t servo) const {
+        return _servos[(servo < NUM_SERVOS) ? servo : 0].target;
+    }
+    
+    /**
+     * @brief Çıkışları bir kontrol adımı kadar hedeflere yaklaştırır
+     * 
+     * @param dt_us Önceki adımdan bu yana geçen süre (μs, MAX_STEP_US ile sınırlanır)
+     * @param pulses NUM_SERVOS elemanlı çıkış dizisi; sadece maskedeki servolar yazılır
+     * @return uint32_t Çıkışı değişen servoların bit maskesi
+     */
+    uint32_t update(uint32_t dt_us, uint16_t* pulses);
+    
+    /**
+     * @brief Çıkışı hedefine ulaşmış servoların bit maskesi
+     */
+    uint32_t reachedMask() const;
+    
+    /**
+     * @brief Sınırlayıcının çıkışı hedeften geride tuttuğu servo adımları (toplam)
+     */
+    uint32_t getLimitedSteps() const {
+        return _limitedSteps;
+    }
+
+private:
+    /**
+     * @brief Servo durumu; konum Q8 μs, hız Q8 μs/s
+     */
+    struct ServoState {
+        uint32_t maxVelocity;   // μs/s, 0 = sınırsız
+        uint32_t maxAccel;      // μs/s², 0 = sınırsız
+        uint16_t target;        // Hedef darbe genişliği (μs)
+        int32_t position;       // Çıkış (Q8 μs)
+        int32_t velocity;       // Hız (Q8 μs/s), işaretli
+    };
+    
+    ServoState _servos[NUM_SERVOS];
+    uint32_t _limitedSteps;
+    uint16_t _scale;              // Hareket ölçeği (Q8)
+    uint32_t _jumpCredit;         // Sınırsız servo sıçrama hakkı (Q8 servo)
+    size_t _staggerNext;          // Ölçek düşükken sıradaki ilk sınırsız servo
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Tek üretici / tek tüketici kilitsiz halka kuyruk
+ * 
+ * Çekirdekler arası (core0 <-> core1) komut ve telemetri aktarımı için
+ * kullanılır. Üretici sadece _head'i, tüketici sadece _tail'i yazar;
+ * acquire/release sıralaması eleman verisinin indeksten önce görünmesini
+ * sağlar. Kesme veya kilit gerektirmez, host üzerinde iş parçacıklarıyla
+ * da derlenip denenebilir.
+ * 
+ * @tparam T Eleman tipi (kopyalanabilir olmalı)
+ * @tparam N Kapasite (2'nin kuvveti)
+ */
+template <typename T, size_t N>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue kapasitesi 2'nin kuvveti olmalı");
+    
+public:
+    SpscQueue() : _head(0), _tail(0) {}
+    
+    /**
+     * @brief Kuyruğa eleman ekler (sadece üretici çağırır)
+     * 
+     * @param item Eklenecek eleman
+     * @return true Eklendi
+     * @return false Kuyruk dolu
+     */
+    bool push(const T& item) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= N) {
+            return false;
+        }
+        
+        _items[head & (N - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Kuyruktan eleman alır (sadece tüketici çağırır)
+     * 
+     * @param item Alınan eleman
+     * @return true Eleman alındı
+     * @return false Kuyruk boş
+     */
+    bool pop(T& item) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        
+        item = _items[tail & (N - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Kuyruktaki eleman sayısını döndürür (anlık, yaklaşık)
+     */
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Kuyruk boş mu
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+    
+private:
+    T _items[N];                        // Elemanlar
+    std::atomic<uint32_t> _head;        // Üretici indeksi (serbest sayaç)
+    std::atomic<uint32_t> _tail;        // Tüketici indeksi (serbest sayaç)
+};
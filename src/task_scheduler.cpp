@@ -0,0 +1,214 @@
+#include "task_scheduler.hpp"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+TaskScheduler::TaskScheduler() :
+    _resetRequested(false),
+    _windowStart_us(0),
+    _windowBusy_us(0),
+    _loadPermille(0) {
+    for (Task& task : _tasks) {
+        task.fn = nullptr;
+        task.context = nullptr;
+        task.config = Config{};
+        task.stats = Stats{};
+        task.release_us = 0;
+        task.pending.store(false, std::memory_order_relaxed);
+        task.signal_us.store(0, std::memory_order_relaxed);
+        task.total_us = 0;
+        task.windowBusy_us = 0;
+    }
+}
+
+bool TaskScheduler::addTask(uint32_t id, TaskFn fn, void* context, const Config& config) {
+    if (id >= MAX_TASKS || fn == nullptr || (!config.event && config.period_us == 0)) {
+        return false;
+    }
+    
+    Task& task = _tasks[id];
+    task.fn = fn;
+    task.context = context;
+    task.config = config;
+    task.config.wake = config.event && config.wake;
+    return true;
+}
+
+void TaskScheduler::start(uint32_t now_us) {
+    for (Task& task : _tasks) {
+        task.release_us = now_us;
+    }
+    _windowStart_us = now_us;
+}
+
+void TaskScheduler::setRelease(uint32_t id, uint32_t release_us) {
+    if (id < MAX_TASKS && !_tasks[id].config.event) {
+        _tasks[id].release_us = release_us;
+    }
+}
+
+void TaskScheduler::signal(uint32_t id) {
+    if (id >= MAX_TASKS) {
+        return;
+    }
+    
+    _markPending(_tasks[id], time_us_32());
+    __sev();
+}
+
+bool TaskScheduler::runNext(uint32_t now_us) {
+    _housekeeping(now_us);
+    
+    // Önceliği en yüksek hazır görev; eşitlikte en uzun bekleyen
+    Task* next = nullptr;
+    uint32_t nextReady = 0;
+    for (Task& task : _tasks) {
+        uint32_t readyAt;
+        if (task.fn == nullptr || !_isReady(task, now_us, readyAt)) {
+            continue;
+        }
+        if (next == nullptr || task.config.priority < next->config.priority ||
+            (task.config.priority == next->config.priority && (int32_t)(readyAt - nextReady) < 0)) {
+            next = &task;
+            nextReady = readyAt;
+        }
+    }
+    if (next == nullptr) {
+        return false;
+    }
+    
+    // Sinyal çalışmadan önce temizlenir, çalışma sırasında gelen sinyal kaybolmaz
+    uint32_t deadline;
+    if (next->config.event) {
+        next->pending.store(false, std::memory_order_release);
+        deadline = nextReady + next->config.period_us;
+    } else {
+        // Geride kalan periyodik görev yetişmeye çalışmaz, saat şimdiden yeniden başlar
+        deadline = next->release_us + next->config.period_us;
+        next->release_us = deadline;
+        if ((int32_t)(now_us - next->release_us) >= 0) {
+            next->release_us = now_us + next->config.period_us;
+        }
+    }
+    
+    uint32_t start = time_us_32();
+    next->fn(next->context);
+    uint32_t end = time_us_32();
+    uint32_t exec = end - start;
+    
+    Stats& stats = next->stats;
+    stats.runs++;
+    next->total_us += exec;
+    stats.avg_us = (uint32_t)(next->total_us / stats.runs);
+    if (exec > stats.wcet_us) {
+        stats.wcet_us = exec;
+    }
+    uint32_t latency = start - nextReady;
+    if ((int32_t)latency > 0 && latency > stats.maxLatency_us) {
+        stats.maxLatency_us = latency;
+    }
+    if ((int32_t)(end - deadline) > 0) {
+        stats.deadlineMisses++;
+    }
+    if (exec > next->config.budget_us) {
+        stats.overruns++;
+    }
+    next->windowBusy_us += exec;
+    _windowBusy_us += exec;
+    
+    // Meşgul çekirdekte de yoklama görevleri her turda bir kez çalışır, aç kalmaz
+    if (!next->config.wake) {
+        _markWakeTasks(end);
+    }
+    return true;
+}
+
+void TaskScheduler::idle() {
+    uint32_t now = time_us_32();
+    _housekeeping(now);
+    
+    // En yakın periyodik sürüm; bekleyen olay varsa uyunmaz
+    int32_t wait = (int32_t)LOAD_WINDOW_US;
+    for (const Task& task : _tasks) {
+        if (task.fn == nullptr) {
+            continue;
+        }
+        if (task.config.event) {
+            if (task.pending.load(std::memory_order_acquire)) {
+                return;
+            }
+            continue;
+        }
+        int32_t until = (int32_t)(task.release_us - now);
+        if (until < wait) {
+            wait = until;
+        }
+    }
+    
+    if (wait > 0) {
+        // Zamanlayıcı alarmı veya herhangi bir kesme/olay uyandırır
+        best_effort_wfe_or_timeout(from_us_since_boot(time_us_64() + (uint32_t)wait));
+    }
+    
+    _markWakeTasks(time_us_32());
+}
+
+void TaskScheduler::_markWakeTasks(uint32_t now_us) {
+    // Aynı çekirdek: __sev() gerekmez, kendi olay bayrağını kurup sonraki uykuyu boşa çıkarırdı
+    for (Task& task : _tasks) {
+        if (task.fn != nullptr && task.config.wake) {
+            _markPending(task, now_us);
+        }
+    }
+}
+
+void TaskScheduler::_markPending(Task& task, uint32_t now_us) {
+    // Çalışmamış sinyallerin ilki gecikmenin başlangıcıdır
+    if (!task.pending.load(std::memory_order_acquire)) {
+        task.signal_us.store(now_us, std::memory_order_relaxed);
+    }
+    task.pending.store(true, std::memory_order_release);
+}
+
+bool TaskScheduler::_isReady(const Task& task, uint32_t now_us, uint32_t& readyAt_us) {
+    if (task.config.event) {
+        if (!task.pending.load(std::memory_order_acquire)) {
+            return false;
+        }
+        readyAt_us = task.signal_us.load(std::memory_order_relaxed);
+        return true;
+    }
+    
+    readyAt_us = task.release_us;
+    return (int32_t)(now_us - task.release_us) >= 0;
+}
+
+void TaskScheduler::_housekeeping(uint32_t now_us) {
+    // Cortex-M0+'da LDREX/STREX yok, exchange yerine okuma ve ayrı yazma: ikisi
+    // arasında gelen istek de hemen ardından yapılan bu sıfırlamayla karşılanır
+    if (_resetRequested.load(std::memory_order_acquire)) {
+        _resetRequested.store(false, std::memory_order_release);
+        for (Task& task : _tasks) {
+            task.stats = Stats{};
+            task.total_us = 0;
+            task.windowBusy_us = 0;
+        }
+        _windowStart_us = now_us;
+        _windowBusy_us = 0;
+        _loadPermille = 0;
+        return;
+    }
+    
+    uint32_t elapsed = now_us - _windowStart_us;
+    if (elapsed < LOAD_WINDOW_US) {
+        return;
+    }
+    
+    // Pencere kapanır: çekirdek ve görev payları binde olarak yayınlanır
+    _loadPermille = (uint32_t)((uint64_t)_windowBusy_us * 1000 / elapsed);
+    for (Task& task : _tasks) {
+        task.stats.loadPermille = (uint32_t)((uint64_t)task.windowBusy_us * 1000 / elapsed);
+        task.windowBusy_us = 0;
+    }
+    _windowStart_us = now_us;
+    _windowBusy_us = 0;
+}
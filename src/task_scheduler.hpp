@@ -0,0 +1,201 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Tek çekirdek için işbirlikçi, sabit öncelikli görev zamanlayıcı
+ * 
+ * Görevler ya sabit periyotlu (sürüm zamanı her periyotta ilerler) ya da
+ * olay güdümlüdür (signal() ile hazır olur). runNext() hazır görevlerden
+ * önceliği en yüksek olanı (en küçük numara) çalıştırır; görevler kesilmez,
+ * öncelik sadece sıradaki görevin seçiminde etkilidir. Hazır görev yoksa
+ * idle() bir sonraki sürüm zamanına kadar WFE ile uyur; kesmeler ve diğer
+ * çekirdeğin __sev() çağrısı uykuyu erken bitirir.
+ * 
+ * Her görev için en uzun (WCET) ve ortalama çalışma süresi, hazır olmaktan
+ * başlamaya kadar en uzun gecikme, son tarih kaçırma ve bütçe aşımı sayılır.
+ * Sabit periyotlu görevin son tarihi bir sonraki sürümdür; olay görevinde
+ * periyot, sinyalden bitişe izin verilen süredir. Çekirdek yükü LOAD_WINDOW_US
+ * pencerelerinde görevlerin çalışma sürelerinden hesaplanır.
+ * 
+ * İstatistikleri sadece sahibi olan çekirdek yazar; diğer çekirdek 32-bit
+ * alanları okuyabilir ve requestReset() ile sıfırlama isteyebilir.
+ */
+class TaskScheduler {
+public:
+    static constexpr uint32_t MAX_TASKS = 8;
+    static constexpr uint32_t LOAD_WINDOW_US = 1000000;  // Yük ölçüm penceresi
+    
+    /**
+     * @brief Görev fonksiyonu, kayıtta verilen bağlamla çağrılır
+     */
+    using TaskFn = void (*)(void* context);
+    
+    /**
+     * @brief Görev ayarı
+     */
+    struct Config {
+        uint32_t period_us;   // Sabit periyot; olay görevinde sinyalden bitişe son tarih
+        uint32_t budget_us;   // Çalışma başına izin verilen süre
+        uint8_t priority;     // 0 en yüksek
+        bool event;           // true: signal() ile hazır olur, periyodik sürüm yok
+        bool wake;            // Olay görevi her uyanışta ve diğer her görevden sonra hazır olur (ör. USB yığını)
+    };
+    
+    /**
+     * @brief Görev istatistikleri (son sıfırlamadan beri)
+     */
+    struct Stats {
+        uint32_t runs;             // Çalışma sayısı
+        uint32_t wcet_us;          // En uzun çalışma süresi
+        uint32_t avg_us;           // Ortalama çalışma süresi
+        uint32_t maxLatency_us;    // Sürüm veya sinyalden başlamaya kadar en uzun bekleme
+        uint32_t loadPermille;     // Son yük penceresinde çekirdek süresinden payı (‰)
+        uint32_t deadlineMisses;   // Son tarihten sonra biten çalışmalar
+        uint32_t overruns;         // Bütçeyi aşan çalışmalar
+    };
+    
+    /**
+     * @brief Yapılandırıcı, görev yok
+     */
+    TaskScheduler();
+    
+    /**
+     * @brief Görevi kaydeder; periyodik görevin ilk sürümü start() zamanıdır
+     * 
+     * @param id Görev numarası (< MAX_TASKS)
+     * @param fn Görev fonksiyonu
+     * @param context Fonksiyona verilen bağlam
+     * @param config Görev ayarı
+     * @return true Kaydedildi
+     * @return false Geçersiz numara, fonksiyon veya periyot
+     */
+    bool addTask(uint32_t id, TaskFn fn, void* context, const Config& config);
+    
+    /**
+     * @brief Periyodik görevlerin sürüm saatini başlatır (sahibi olan çekirdekte)
+     * 
+     * @param now_us Şu anki zaman (μs)
+     */
+    void start(uint32_t now_us);
+    
+    /**
+     * @brief Periyodik görevin sonraki sürüm zamanını ayarlar (sahibi olan çekirdekte)
+     * 
+     * Görevi dış bir periyoda (ör. PWM wrap) faz kilitlemek için kullanılır;
+     * görevin kendi içinden çağrılırsa runNext()'in hesapladığı sürümü ezer.
+     * 
+     * @param id Görev numarası
+     * @param release_us Sonraki sürüm zamanı (μs)
+     */
+    void setRelease(uint32_t id, uint32_t release_us);
+    
+    /**
+     * @brief Olay görevini hazır yapar ve bekleyen çekirdekleri uyandırır
+     * 
+     * Kesmeden ve diğer çekirdekten çağrılabilir. Görev çalışmadan önce
+     * gelen sinyaller birleşir; gecikme ilk sinyalden ölçülür.
+     * 
+     * @param id Görev numarası
+     */
+    void signal(uint32_t id);
+    
+    /**
+     * @brief Hazır görevlerden önceliği en yüksek olanı çalıştırır
+     * 
+     * @param now_us Şu anki zaman (μs)
+     * @return true Bir görev çalıştı
+     * @return false Hazır görev yok
+     */
+    bool runNext(uint32_t now_us);
+    
+    /**
+     * @brief Sonraki sürüm zamanına kadar veya bir olaya kadar uyur
+     * 
+     * Uyanıştan sonra wake işaretli olay görevleri hazır olur.
+     */
+    void idle();
+    
+    /**
+     * @brief İstatistiklerin sıfırlanmasını ister (sahibi olan çekirdek sonraki turda uygular)
+     */
+    void requestReset() {
+        _resetRequested.store(true, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Görev kayıtlı mı
+     */
+    bool hasTask(uint32_t id) const {
+        return id < MAX_TASKS && _tasks[id].fn != nullptr;
+    }
+    
+    /**
+     * @brief Görevin ayarı (kayıtsız görevde sıfırlar)
+     */
+    const Config& getConfig(uint32_t id) const {
+        return _tasks[(id < MAX_TASKS) ? id : 0].config;
+    }
+    
+    /**
+     * @brief Görevin istatistikleri
+     */
+    const Stats& getStats(uint32_t id) const {
+        return _tasks[(id < MAX_TASKS) ? id : 0].stats;
+    }
+    
+    /**
+     * @brief Son yük penceresinde görevlerin çekirdek süresinden toplam payı (‰)
+     */
+    uint32_t getLoadPermille() const {
+        return _loadPermille;
+    }
+    
+private:
+    /**
+     * @brief Görev durumu
+     */
+    struct Task {
+        TaskFn fn;
+        void* context;
+        Config config;
+        Stats stats;
+        uint32_t release_us;              // Periyodik: sonraki sürüm zamanı
+        std::atomic<bool> pending;        // Olay: sinyal bekliyor
+        std::atomic<uint32_t> signal_us;  // Olay: ilk bekleyen sinyalin zamanı
+        uint64_t total_us;                // Ortalama için toplam çalışma süresi
+        uint32_t windowBusy_us;           // Bu yük penceresindeki çalışma süresi
+    };
+    
+    Task _tasks[MAX_TASKS];
+    std::atomic<bool> _resetRequested;
+    uint32_t _windowStart_us;             // Yük penceresinin başlangıcı
+    uint32_t _windowBusy_us;              // Pencerede tüm görevlerin çalışma süresi
+    uint32_t _loadPermille;               // Son pencerenin yükü
+    
+    /**
+     * @brief Görev hazır mı
+     * 
+     * @param task Görev
+     * @param now_us Şu anki zaman
+     * @param readyAt_us Hazır olduğu zaman (gecikme ölçümü için)
+     */
+    static bool _isReady(const Task& task, uint32_t now_us, uint32_t& readyAt_us);
+    
+    /**
+     * @brief Olay görevini hazır işaretler (uyandırma yapmaz)
+     */
+    static void _markPending(Task& task, uint32_t now_us);
+    
+    /**
+     * @brief wake işaretli olay görevlerini hazır işaretler
+     */
+    void _markWakeTasks(uint32_t now_us);
+    
+    /**
+     * @brief Bekleyen sıfırlama isteğini uygular, dolan yük penceresini kapatır
+     */
+    void _housekeeping(uint32_t now_us);
+};
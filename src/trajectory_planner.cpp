@@ -0,0 +1,229 @@
+#include "trajectory_planner.hpp"
+
+namespace {
+    constexpr int32_t Q15_ONE = 1 << 15;
+    
+    /**
+     * @brief Geçen süreyi segment süresine göre Q15 (0-32768) normalize eder
+     * 
+     * Bölme 32-bit kalsın diye süre 16 bite sığana kadar iki değer birlikte kaydırılır.
+     */
+    int32_t normalize(uint32_t elapsed_us, uint32_t duration_us) {
+        while (duration_us >= (1u << 16)) {
+            duration_us >>= 1;
+            elapsed_us >>= 1;
+        }
+        return (int32_t)((elapsed_us << 15) / duration_us);
+    }
+    
+    /**
+     * @brief İki Q15 değeri çarpar
+     */
+    inline int64_t mulQ15(int64_t a, int64_t b) {
+        return (a * b) >> 15;
+    }
+}
+
+TrajectoryPlanner::TrajectoryPlanner() {
+    uint16_t center[NUM_SERVOS];
+    for (size_t i = 0; i < NUM_SERVOS; i++) {
+        center[i] = 1500;
+    }
+    reset(center);
+}
+
+void TrajectoryPlanner::reset(const uint16_t* pulses) {
+    for (size_t i = 0; i < NUM_SERVOS; i++) {
+        ServoTrack& track = _tracks[i];
+        track.head = 0;
+        track.count = 0;
+        track.active = false;
+        track.position = pulses[i];
+        track.from = pulses[i];
+        track.segment = {pulses[i], 0, Interpolation::LINEAR};
+        track.start_us = 0;
+        track.m0 = 0;
+        track.m1 = 0;
+    }
+}
+
+bool TrajectoryPlanner::push(uint8_t servo, uint16_t target, uint32_t duration_us, Interpolation mode, uint32_t now_us) {
+    if (servo >= NUM_SERVOS || (uint8_t)mode > (uint8_t)Interpolation::MIN_JERK) {
+        return false;
+    }
+    
+    ServoTrack& track = _tracks[servo];
+    if (track.count >= QUEUE_DEPTH) {
+        return false;
+    }
+    
+    track.queue[(track.head + track.count) % QUEUE_DEPTH] = {target, duration_us, mode};
+    track.count++;
+    
+    // Boştaki servo hemen başlar
+    if (!track.active) {
+        track.from = track.position;
+        _startNext(track, now_us, 0, 0);
+    }
+    
+    return true;
+}
+
+void TrajectoryPlanner::cancel(uint8_t servo, uint16_t pulse) {
+    if (servo >= NUM_SERVOS) {
+        return;
+    }
+    
+    ServoTrack& track = _tracks[servo];
+    track.count = 0;
+    track.active = false;
+    track.position = pulse;
+}
+
+uint32_t TrajectoryPlanner::update(uint32_t now_us, uint16_t* pulses) {
+    uint32_t mask = 0;
+    
+    for (size_t i = 0; i < NUM_SERVOS; i++) {
+        ServoTrack& track = _tracks[i];
+        if (!track.active) {
+            continue;
+        }
+        
+        mask |= (1u << i);
+        
+        while (true) {
+            uint32_t elapsed = now_us - track.start_us;
+            if ((int32_t)elapsed < 0) {
+                track.position = track.from;   // Segment henüz başlamadı
+                break;
+            }
+            
+            if (elapsed < track.segment.duration_us) {
+                track.position = _evaluate(track, elapsed);
+                break;
+            }
+            
+            // Segment bitti: hedefe otur ve sıradakini kayma olmadan bitiş anında başlat
+            track.position = track.segment.target;
+            
+            int32_t endTangent = 0;
+            if (track.segment.mode == Interpolation::LINEAR) {
+                endTangent = (int32_t)track.segment.target - (int32_t)track.from;
+            } else if (track.segment.mode == Interpolation::CUBIC) {
+                endTangent = track.m1;
+            }
+            
+            track.from = track.segment.target;
+            if (!_startNext(track, track.start_us + track.segment.duration_us,
+                            endTangent, track.segment.duration_us)) {
+                track.active = false;
+                break;
+            }
+        }
+        
+        pulses[i] = track.position;
+    }
+    
+    return mask;
+}
+
+uint32_t TrajectoryPlanner::activeMask() const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < NUM_SERVOS; i++) {
+        if (_tracks[i].active) {
+            mask |= (1u << i);
+        }
+    }
+    return mask;
+}
+
+size_t TrajectoryPlanner::freeSlots(uint8_t servo) const {
+    if (servo >= NUM_SERVOS) {
+        return 0;
+    }
+    return QUEUE_DEPTH - _tracks[servo].count;
+}
+
+int32_t TrajectoryPlanner::shape(Interpolation mode, int32_t u) {
+    // Polinomlar azalan bir çarpan içerir; ara sonuçlar kırpılırsa eğri yer yer
+    // 1-2 LSB geri adım atar. Bu yüzden tam sayı olarak hesaplanıp tek seferde kırpılır.
+    switch (mode) {
+        case Interpolation::CUBIC:
+            // 3u² - 2u³ = u² (3 - 2u) (uçlarda sıfır hız), Q30 · Q15
+            return (int32_t)(((int64_t)u * u * (3 * Q15_ONE - 2 * (int64_t)u)) >> 30);
+        
+        case Interpolation::MIN_JERK: {
+            // u³ (10 - 15u + 6u²), Q45 · Q30; çarpım 64 bite sığmadığı için
+            // ikinci çarpan 17-bit parçalara bölünür
+            int64_t u3 = (int64_t)u * u * u;
+            int64_t inner = 6 * (int64_t)u * u - 15 * (int64_t)u * Q15_ONE + 10 * ((int64_t)Q15_ONE << 15);
+            int64_t high = u3 * (inner >> 17);
+            int64_t low = u3 * (inner & 0x1FFFF);
+            return (int32_t)((high + (low >> 17)) >> 43);
+        }
+        
+        case Interpolation::LINEAR:
+        default:
+            return u;
+    }
+}
+
+bool TrajectoryPlanner::_startNext(ServoTrack& track, uint32_t start_us, int32_t m0, uint32_t prev_duration_us) {
+    if (track.count == 0) {
+        return false;
+    }
+    
+    track.segment = track.queue[track.head];
+    track.head = (track.head + 1) % QUEUE_DEPTH;
+    track.count--;
+    track.start_us = start_us;
+    track.active = true;
+    track.m0 = 0;
+    track.m1 = 0;
+    
+    if (track.segment.mode == Interpolation::CUBIC) {
+        uint32_t duration = track.segment.duration_us;
+        
+        // Başlangıç teğeti: önceki segmentin bitiş hızı, bu segmentin süresine ölçeklenir
+        if (prev_duration_us > 0) {
+            track.m0 = (int32_t)(((int64_t)m0 * duration) / prev_duration_us);
+        }
+        
+        // Bitiş teğeti: sıradaki kare kuyruktaysa Catmull-Rom eğimi, değilse sıfır
+        if (track.count > 0) {
+            const Keyframe& next = track.queue[track.head];
+            uint64_t span = (uint64_t)duration + next.duration_us;
+            if (span > 0) {
+                track.m1 = (int32_t)(((int64_t)next.target - track.from) * (int64_t)duration / (int64_t)span);
+            }
+        }
+    }
+    
+    return true;
+}
+
+uint16_t TrajectoryPlanner::_evaluate(const ServoTrack& track, uint32_t elapsed_us) {
+    int32_t u = normalize(elapsed_us, track.segment.duration_us);
+    int64_t delta = (int64_t)track.segment.target - track.from;
+    int64_t offset;
+    
+    if (track.segment.mode == Interpolation::CUBIC) {
+        // Hermite: p = p0 + Δ·h01 + m0·h10 + m1·h11
+        int64_t u2 = mulQ15(u, u);
+        int64_t u3 = mulQ15(u2, u);
+        int64_t h01 = shape(Interpolation::CUBIC, u);
+        int64_t h10 = u3 - 2 * u2 + u;
+        int64_t h11 = u3 - u2;
+        offset = (delta * h01 + (int64_t)track.m0 * h10 + (int64_t)track.m1 * h11) >> 15;
+    } else {
+        offset = (delta * shape(track.segment.mode, u)) >> 15;
+    }
+    
+    int64_t pulse = track.from + offset;
+    if (pulse < 0) {
+        pulse = 0;
+    } else if (pulse > 0xFFFF) {
+        pulse = 0xFFFF;
+    }
+    return (uint16_t)pulse;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Servo yörüngeleri için anahtar kare (keyframe) enterpolasyon motoru
+ * 
+ * Her servo için bir anahtar kare kuyruğu tutulur. Anahtar kareler zincir
+ * halinde çalışır: her kare bir öncekinin bittiği anda başlar ve kendi
+ * süresi sonunda hedef darbe genişliğine ulaşır. update() sabit periyotlu
+ * kontrol adımında çağrılır ve o andaki darbe genişliklerini hesaplar.
+ * 
+ * Tüm hesaplar Q15 sabit noktalıdır; donanımdan bağımsızdır, host üzerinde
+ * de derlenebilir.
+ */
+class TrajectoryPlanner {
+public:
+    static constexpr size_t NUM_SERVOS = 18;      // Servo sayısı
+    static constexpr size_t QUEUE_DEPTH = 8;      // Servo başına bekleyen anahtar kare sayısı
+    
+    /**
+     * @brief Enterpolasyon türleri
+     */
+    enum class Interpolation : uint8_t {
+        LINEAR = 0,     // Doğrusal
+        CUBIC = 1,      // Kübik Hermite, komşu karelerden hız sürekliliği
+        MIN_JERK = 2    // Minimum sarsıntı (5. derece, uçlarda sıfır hız ve ivme)
+    };
+    
+    /**
+     * @brief Yapılandırıcı
+     */
+    TrajectoryPlanner();
+    
+    /**
+     * @brief Tüm yörüngeleri iptal eder ve başlangıç pozisyonlarını ayarlar
+     * 
+     * @param pulses NUM_SERVOS adet darbe genişliği (μs)
+     */
+    void reset(const uint16_t* pulses);
+    
+    /**
+     * @brief Servo kuyruğuna bir anahtar kare ekler
+     * 
+     * Servo boştaysa kare now_us anında başlar, değilse kuyruktaki son
+     * karenin bitişinde başlar.
+     * 
+     * @param servo Servo indeksi
+     * @param target Hedef darbe genişliği (μs)
+     * @param duration_us Kare süresi (μs)
+     * @param mode Enterpolasyon türü
+     * @param now_us Şu anki zaman (μs)
+     * @return true Eklendi
+     * @return false Geçersiz servo, geçersiz tür veya kuyruk dolu
+     */
+    bool push(uint8_t servo, uint16_t target, uint32_t duration_us, Interpolation mode, uint32_t now_us);
+    
+    /**
+     * @brief Servonun yörüngesini iptal eder ve pozisyonunu doğrudan ayarlar
+     * 
+     * @param servo Servo indeksi
+     * @param pulse Yeni darbe genişliği (μs)
+     */
+    void cancel(uint8_t servo, uint16_t pulse);
+    
+    /**
+     * @brief Yörüngeleri verilen zamana göre ilerletir
+     * 
+     * @param now_us Şu anki zaman (μs)
+     * @param pulses NUM_SERVOS elemanlı çıkış dizisi; sadece maskedeki servolar yazılır
+     * @return uint32_t Bu adımda yörüngesi olan servoların bit maskesi
+     */
+    uint32_t update(uint32_t now_us, uint16_t* pulses);
+    
+    /**
+     * @brief Yörüngesi devam eden servoların bit maskesini döndürür
+     */
+    uint32_t activeMask() const;
+    
+    /**
+     * @brief Servonun kuyruğundaki boş yer sayısını döndürür
+     * 
+     * @param servo Servo indeksi
+     */
+    size_t freeSlots(uint8_t servo) const;
+    
+    /**
+     * @brief Q15 normalize zamandan (0-32768) Q15 ilerleme oranı hesaplar
+     * 
+     * LINEAR ve MIN_JERK için kullanılır; CUBIC uç hızlarına bağlı olduğu için update() içinde hesaplanır.
+     * 
+     * @param mode Enterpolasyon türü
+     * @param u Normalize zaman (Q15)
+     * @return int32_t İlerleme oranı (Q15)
+     */
+    static int32_t shape(Interpolation mode, int32_t u);
+    
+private:
+    /**
+     * @brief Kuyruktaki bir anahtar kare
+     */
+    struct Keyframe {
+        uint16_t target;        // Hedef darbe genişliği
+        uint32_t duration_us;   // Süre
+        Interpolation mode;     // Enterpolasyon türü
+    };
+    
+    /**
+     * @brief Servo başına yörünge durumu
+     */
+    struct ServoTrack {
+        Keyframe queue[QUEUE_DEPTH];   // Bekleyen kareler (halka tampon)
+        uint8_t head;                  // İlk bekleyen kare
+        uint8_t count;                 // Bekleyen kare sayısı
+        bool active;                   // Bir segment çalışıyor mu
+        uint16_t position;             // Son hesaplanan pozisyon
+        uint16_t from;                 // Segment başlangıç pozisyonu
+        Keyframe segment;              // Çalışan segment
+        uint32_t start_us;             // Segment başlangıç zamanı
+        int32_t m0;                    // Başlangıç teğeti (segment süresiyle ölçeklenmiş, μs darbe)
+        int32_t m1;                    // Bitiş teğeti (segment süresiyle ölçeklenmiş, μs darbe)
+    };
+    
+    ServoTrack _tracks[NUM_SERVOS];
+    
+    /**
+     * @brief Kuyruktan sıradaki segmenti başlatır
+     * 
+     * @param track Servo durumu
+     * @param start_us Segment başlangıç zamanı
+     * @param m0 Önceki segmentten devralınan bitiş teğeti (önceki süreyle ölçekli)
+     * @param prev_duration_us Önceki segmentin süresi (0: önceki segment yok)
+     * @return true Yeni segment başladı
+     * @return false Kuyruk boş
+     */
+    bool _startNext(ServoTrack& track, uint32_t start_us, int32_t m0, uint32_t prev_duration_us);
+    
+    /**
+     * @brief Segment içindeki pozisyonu hesaplar
+     * 
+     * @param track Servo durumu
+     * @param elapsed_us Segment başından beri geçen süre (< süre)
+     * @return uint16_t Darbe genişliği
+     */
+    static uint16_t _evaluate(const ServoTrack& track, uint32_t elapsed_us);
+};